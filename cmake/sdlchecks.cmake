@@ -857,17 +857,41 @@ macro(CheckPTHREAD)
         endif()
       endif()
 
+      if(SDL_FUTEX)
+        check_c_source_compiles("
+            #include <linux/futex.h>
+            #include <sys/syscall.h>
+            #include <unistd.h>
+            int main(int argc, char **argv) {
+              int word = 0;
+              return (int)syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+            }" HAVE_LINUX_FUTEX)
+      endif()
+
       sdl_sources(
         "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_systhread.c"
-        "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_sysmutex.c"   # Can be faked, if necessary
-        "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_syscond.c"    # Can be faked, if necessary
-        "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_sysrwlock.c"   # Can be faked, if necessary
         "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_systls.c"
       )
-      if(HAVE_PTHREADS_SEM)
-        sdl_sources("${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_syssem.c")
+      if(HAVE_LINUX_FUTEX)
+        set(SDL_THREAD_FUTEX 1)
+        set(HAVE_FUTEX TRUE)
+        sdl_sources(
+          "${SDL3_SOURCE_DIR}/src/thread/linux/SDL_sysmutex.c"
+          "${SDL3_SOURCE_DIR}/src/thread/linux/SDL_syscond.c"
+          "${SDL3_SOURCE_DIR}/src/thread/linux/SDL_sysrwlock.c"
+          "${SDL3_SOURCE_DIR}/src/thread/linux/SDL_syssem.c"
+        )
       else()
-        sdl_sources("${SDL3_SOURCE_DIR}/src/thread/generic/SDL_syssem.c")
+        sdl_sources(
+          "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_sysmutex.c"   # Can be faked, if necessary
+          "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_syscond.c"    # Can be faked, if necessary
+          "${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_sysrwlock.c"   # Can be faked, if necessary
+        )
+        if(HAVE_PTHREADS_SEM)
+          sdl_sources("${SDL3_SOURCE_DIR}/src/thread/pthread/SDL_syssem.c")
+        else()
+          sdl_sources("${SDL3_SOURCE_DIR}/src/thread/generic/SDL_syssem.c")
+        endif()
       endif()
       set(HAVE_SDL_THREADS TRUE)
     endif()
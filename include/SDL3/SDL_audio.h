@@ -1123,6 +1123,42 @@ extern DECLSPEC int SDLCALL SDL_SetAudioStreamGetCallback(SDL_AudioStream *strea
  */
 extern DECLSPEC int SDLCALL SDL_SetAudioStreamPutCallback(SDL_AudioStream *stream, SDL_AudioStreamCallback callback, void *userdata);
 
+/**
+ * Set whether an audio stream is fed by a single producer thread.
+ *
+ * Normally, SDL_PutAudioStreamData() obtains the stream's lock, so a thread
+ * putting data into a stream can make the thread getting data from it wait,
+ * and vice versa. If a stream is bound to an audio device, that second thread
+ * is the device's real-time audio thread.
+ *
+ * In single producer mode, SDL_PutAudioStreamData() hands its data to the
+ * consumer through a wait-free ring buffer instead, and doesn't touch the
+ * stream's lock at all, unless the ring is full (if the consumer has fallen
+ * behind), or a put callback is set. The data is moved into the stream the
+ * next time it is read, flushed, queried or cleared.
+ *
+ * In exchange, only one thread at a time may call SDL_PutAudioStreamData()
+ * on the stream, and the stream's input format should only be changed from
+ * that same thread. Any number of threads may still read from the stream.
+ *
+ * This function obtains the stream's lock, so it should be called from the
+ * producer thread, or while no other thread is putting data into the stream.
+ *
+ * \param stream the audio stream to change
+ * \param single_producer SDL_TRUE to enable single producer mode, SDL_FALSE to
+ *                        go back to locking on every put.
+ * \returns 0 on success, or -1 on error; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from the thread that puts
+ *               data into the stream.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PutAudioStreamData
+ */
+extern DECLSPEC int SDLCALL SDL_SetAudioStreamSingleProducer(SDL_AudioStream *stream, SDL_bool single_producer);
+
 
 /**
  * Free an audio stream
@@ -985,6 +985,34 @@ extern DECLSPEC SDL_bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 t
  */
 extern DECLSPEC int SDLCALL SDL_PushEvent(SDL_Event *event);
 
+/**
+ * Add several events to the event queue at once.
+ *
+ * This behaves like calling SDL_PushEvent() for each event in turn, but the
+ * event filter and event watchers are run for the whole batch under a single
+ * lock, and the events that pass the filter are added to the queue under a
+ * single lock as well. This is useful when pushing many events per frame.
+ *
+ * Events that are removed by the event filter are dropped, and the events
+ * that were added to the queue are moved to the front of `events`, in their
+ * original order, so the first N entries of the array are the events that
+ * were actually queued when this function returns N.
+ *
+ * This function is thread-safe, and can be called from other threads safely.
+ *
+ * \param events an array of events to be added to the queue
+ * \param numevents the number of events in `events`
+ * \returns the number of events added to the queue, or a negative error
+ *          code on failure; call SDL_GetError() for more information. If
+ *          the event queue fills up, the events that fit are still added.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_PushEvent
+ */
+extern DECLSPEC int SDLCALL SDL_PushEvents(SDL_Event *events, int numevents);
+
 /**
  * A function pointer used for callbacks that watch the event queue.
  *
@@ -430,6 +430,40 @@ extern "C" {
  */
 #define SDL_HINT_EVENT_LOGGING   "SDL_EVENT_LOGGING"
 
+/**
+ *  A variable controlling whether motion events are merged in the event queue
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Every motion event is queued separately (default)
+ *    "1"       - A motion event is merged into the last queued event if it
+ *                is the same kind of motion from the same device and window
+ *
+ *  When merging, mouse motion and finger motion keep the latest position and
+ *  add up the relative motion, pen motion keeps the latest position and
+ *  axes, and joystick and gamepad axis motion keep the latest value. This
+ *  keeps the event queue short with high polling rate devices, for
+ *  applications that only need the state once per frame.
+ *
+ *  This hint can be changed at any time.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
+/**
+ *  A variable controlling whether SDL_PushEvent() uses a lock-free queue
+ *
+ *  This variable can be set to the following values:
+ *    "0"       - Events are added to the event queue under a lock (default)
+ *    "1"       - Events pushed with SDL_PushEvent() are added to a lock-free
+ *                ring, and moved into the event queue by the thread that
+ *                next polls for events
+ *
+ *  This is useful when many threads are pushing events at a high rate.
+ *  Event filters and event watchers are called as usual.
+ *
+ *  This hint must be set before the events subsystem is initialized.
+ */
+#define SDL_HINT_EVENT_QUEUE_LOCKFREE "SDL_EVENT_QUEUE_LOCKFREE"
+
 /**
  *  A variable controlling whether raising the window should be done more forcefully
  *
@@ -618,6 +652,25 @@ extern "C" {
  */
 #define SDL_HINT_IOS_HIDE_HOME_INDICATOR "SDL_IOS_HIDE_HOME_INDICATOR"
 
+/**
+ *  A variable specifying how many worker threads the SDL job system uses.
+ *
+ *  Jobs submitted with SDL_SubmitJob() and SDL_ParallelFor(), and SDL's own
+ *  parallel work, run on these threads. Threads waiting for a job also run
+ *  jobs while they wait.
+ *
+ *  This variable can be set to the following values:
+ *    "0"         - No worker threads, jobs run on the threads that submit or wait for them
+ *    "N"         - N worker threads
+ *
+ *  By default SDL uses one fewer thread than the number of CPU cores, and at
+ *  least one.
+ *
+ *  This hint is checked when the first job is submitted, and stays in effect
+ *  until SDL_Quit() is called.
+ */
+#define SDL_HINT_JOB_THREADS "SDL_JOB_THREADS"
+
 /**
  *  A variable that lets you enable joystick (and gamecontroller) events even when your app is in the background.
  *
@@ -1620,12 +1673,27 @@ extern "C" {
  *    "opengles"
  *    "metal"
  *    "software"
+ *    "software-mt"
  *
  *  The default varies by platform, but it's the first one in the list that
  *  is available on the current platform.
  */
 #define SDL_HINT_RENDER_DRIVER              "SDL_RENDER_DRIVER"
 
+/**
+ *  A variable specifying how many threads the "software-mt" render driver uses.
+ *
+ *  The "software-mt" driver splits the render target into tiles and draws
+ *  them in parallel on the SDL job threads, with the same results as the
+ *  "software" driver. This sets how many threads can draw tiles at once, in
+ *  addition to the thread that renders. If this is "0" or isn't set, one
+ *  fewer than the number of CPU cores is used. The job threads themselves
+ *  are set with SDL_HINT_JOB_THREADS.
+ *
+ *  This hint is checked when a "software-mt" renderer is created.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS    "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  *  A variable controlling whether the OpenGL render driver uses shaders if they are available.
  *
@@ -1748,6 +1816,25 @@ extern "C" {
  */
 #define SDL_HINT_SCREENSAVER_INHIBIT_ACTIVITY_NAME "SDL_SCREENSAVER_INHIBIT_ACTIVITY_NAME"
 
+/**
+ *  A variable specifying how many threads large software surface operations use.
+ *
+ *  SDL_BlitSurface(), SDL_BlitSurfaceScaled(), SDL_SoftStretch(),
+ *  SDL_ConvertSurface() and SDL_ConvertPixels() can split large images into
+ *  horizontal bands and process them in parallel on the SDL job threads
+ *  (see SDL_HINT_JOB_THREADS), with the same results. This sets the most
+ *  bands an operation is split into, and so the most threads it uses,
+ *  including the calling thread. Small operations always run on the calling
+ *  thread.
+ *
+ *  This variable can be set to the following values:
+ *    "0" or "1"  - Operations run on the calling thread (default)
+ *    "N"         - Operations use up to N threads
+ *
+ *  This hint is checked for each large operation.
+ */
+#define SDL_HINT_SURFACE_THREADS "SDL_SURFACE_THREADS"
+
 /**
  *  Specifies whether SDL_THREAD_PRIORITY_TIME_CRITICAL should be treated as realtime.
  *
@@ -2706,6 +2793,28 @@ extern "C" {
  */
 #define SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES "SDL_AUDIO_DEVICE_SAMPLE_FRAMES"
 
+/**
+ * A variable controlling whether playback devices convert their audio
+ * streams in parallel.
+ *
+ * By default, each playback device's thread converts and resamples its
+ * bound audio streams one after another before mixing them. If this is
+ * enabled, the streams bound to a device are converted in parallel on the
+ * SDL job threads (see SDL_HINT_JOB_THREADS), and then mixed in the usual
+ * order. The mixed output is the same either way.
+ *
+ * This can help when many resampled streams are bound to a device with a
+ * small buffer. Audio stream callbacks are still called from the device's
+ * thread.
+ *
+ * This variable can be set to the following values:
+ *   "0"       - Convert streams on the device's thread (default)
+ *   "1"       - Convert streams in parallel on the job threads
+ *
+ * This hint is checked when the audio subsystem is initialized.
+ */
+#define SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT "SDL_AUDIO_DEVICE_PARALLEL_CONVERT"
+
 
 /**
  * Request SDL_AppIterate() be called at a specific rate.
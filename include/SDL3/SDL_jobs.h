@@ -0,0 +1,177 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_jobs_h_
+#define SDL_jobs_h_
+
+/**
+ *  \file SDL_jobs.h
+ *
+ *  Header file for the SDL job system.
+ *
+ *  Jobs are small functions that SDL runs on a shared pool of worker
+ *  threads, set by SDL_HINT_JOB_THREADS. Each worker keeps its own queue of
+ *  jobs and takes work from the other queues when it runs out, and threads
+ *  that wait for a job run other jobs in the meantime. SDL uses the same
+ *  threads for its own parallel work, such as large surface conversions.
+ */
+
+#include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_error.h>
+
+#include <SDL3/SDL_begin_code.h>
+/* Set up for C function definitions, even when using C++ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A handle to a submitted job.
+ */
+struct SDL_Job;
+typedef struct SDL_Job SDL_Job;
+
+/**
+ * The function run by a job.
+ *
+ * \param userdata the `userdata` passed to SDL_SubmitJob()
+ */
+typedef void (SDLCALL * SDL_JobFunction) (void *userdata);
+
+/**
+ * The function run for each part of the range given to SDL_ParallelFor().
+ *
+ * \param userdata the `userdata` passed to SDL_ParallelFor()
+ * \param start the first index to process
+ * \param end one past the last index to process
+ */
+typedef void (SDLCALL * SDL_ParallelForFunction) (void *userdata, int start, int end);
+
+/**
+ * Submit a job to run on the SDL job threads.
+ *
+ * The job runs once all of its dependencies have finished, which may be
+ * before this function returns. Every job handle must be passed to either
+ * SDL_WaitJob() or SDL_DetachJob() exactly once.
+ *
+ * The job threads are started the first time a job is submitted, and their
+ * number is set by SDL_HINT_JOB_THREADS.
+ *
+ * \param func the function to run
+ * \param userdata a pointer that is passed to `func`
+ * \param dependencies an array of jobs that must finish before this one
+ *                     starts, or NULL. These handles must not have been
+ *                     waited for or detached yet.
+ * \param num_dependencies the number of jobs in `dependencies`
+ * \returns a handle to the job, or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, including
+ *               from a running job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DetachJob
+ * \sa SDL_IsJobFinished
+ * \sa SDL_WaitJob
+ */
+extern DECLSPEC SDL_Job *SDLCALL SDL_SubmitJob(SDL_JobFunction func, void *userdata, SDL_Job **dependencies, int num_dependencies);
+
+/**
+ * Check whether a job has finished running.
+ *
+ * \param job the job to check
+ * \returns SDL_TRUE if the job has finished, SDL_FALSE otherwise.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_IsJobFinished(SDL_Job *job);
+
+/**
+ * Wait for a job to finish, and release its handle.
+ *
+ * While it waits, the calling thread runs other queued jobs, so it is safe
+ * to wait for a job from inside another job.
+ *
+ * The job handle is not valid after this function returns. It is safe to
+ * pass NULL to this function; it is a no-op.
+ *
+ * \param job the job to wait for
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_DetachJob
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC void SDLCALL SDL_WaitJob(SDL_Job *job);
+
+/**
+ * Release a job handle without waiting for the job to finish.
+ *
+ * The job still runs once its dependencies have finished. The job handle is
+ * not valid after this function returns. It is safe to pass NULL to this
+ * function; it is a no-op.
+ *
+ * \param job the job to release
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ */
+extern DECLSPEC void SDLCALL SDL_DetachJob(SDL_Job *job);
+
+/**
+ * Run a function over a range of indices, in parallel on the SDL job
+ * threads.
+ *
+ * The range is split into chunks of `chunk_size` indices, and `func` is
+ * called once for each chunk, on the calling thread and any job threads
+ * that are available. This function returns when every chunk is done.
+ *
+ * \param start the first index
+ * \param end one past the last index
+ * \param chunk_size the number of indices to pass to each call of `func`,
+ *                   or 0 to pick a size based on the number of threads
+ * \param func the function to call for each chunk
+ * \param userdata a pointer that is passed to `func`
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread, including
+ *               from a running job.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+extern DECLSPEC int SDLCALL SDL_ParallelFor(int start, int end, int chunk_size, SDL_ParallelForFunction func, void *userdata);
+
+/* Ends C function definitions when using C++ */
+#ifdef __cplusplus
+}
+#endif
+#include <SDL3/SDL_close_code.h>
+
+#endif /* SDL_jobs_h_ */
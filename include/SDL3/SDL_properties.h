@@ -52,6 +52,15 @@ typedef enum
     SDL_PROPERTY_TYPE_BOOLEAN,
 } SDL_PropertyType;
 
+/**
+ * SDL property atom
+ *
+ * An atom is a small integer that stands for a property name, and can be
+ * used to look up that property on any set of properties without hashing or
+ * comparing the name.
+ */
+typedef Uint32 SDL_PropertyAtom;
+
 /**
  * Get the global SDL properties
  *
@@ -348,6 +357,135 @@ extern DECLSPEC float SDLCALL SDL_GetFloatProperty(SDL_PropertiesID props, const
  */
 extern DECLSPEC SDL_bool SDLCALL SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value);
 
+/**
+ * Get the atom for a property name
+ *
+ * The atom is valid until SDL_Quit() is called, and may be passed to
+ * SDL_GetPropertyByAtom() and the related functions to look up the property
+ * with that name on any set of properties. This is faster than looking the
+ * property up by name when it is queried often.
+ *
+ * \param name the name of the property
+ * \returns the atom for the property name, or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyByAtom
+ * \sa SDL_GetStringPropertyByAtom
+ * \sa SDL_GetNumberPropertyByAtom
+ * \sa SDL_GetFloatPropertyByAtom
+ * \sa SDL_GetBooleanPropertyByAtom
+ */
+extern DECLSPEC SDL_PropertyAtom SDLCALL SDL_GetPropertyAtom(const char *name);
+
+/**
+ * Get a pointer property on a set of properties using a property atom
+ *
+ * This is the same as SDL_GetProperty(), but looks the property up by the atom
+ * returned from SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a pointer property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetProperty
+ */
+extern DECLSPEC void *SDLCALL SDL_GetPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, void *default_value);
+
+/**
+ * Get a string property on a set of properties using a property atom
+ *
+ * This is the same as SDL_GetStringProperty(), but looks the property up by the atom
+ * returned from SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a string property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetStringProperty
+ */
+extern DECLSPEC const char *SDLCALL SDL_GetStringPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, const char *default_value);
+
+/**
+ * Get a number property on a set of properties using a property atom
+ *
+ * This is the same as SDL_GetNumberProperty(), but looks the property up by the atom
+ * returned from SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a number property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetNumberProperty
+ */
+extern DECLSPEC Sint64 SDLCALL SDL_GetNumberPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, Sint64 default_value);
+
+/**
+ * Get a float property on a set of properties using a property atom
+ *
+ * This is the same as SDL_GetFloatProperty(), but looks the property up by the atom
+ * returned from SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a float property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetFloatProperty
+ */
+extern DECLSPEC float SDLCALL SDL_GetFloatPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, float default_value);
+
+/**
+ * Get a boolean property on a set of properties using a property atom
+ *
+ * This is the same as SDL_GetBooleanProperty(), but looks the property up by the atom
+ * returned from SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query
+ * \param atom the atom of the property to query
+ * \param default_value the default value of the property
+ * \returns the value of the property, or `default_value` if it is not set or
+ *          not a boolean property.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetBooleanProperty
+ */
+extern DECLSPEC SDL_bool SDLCALL SDL_GetBooleanPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, SDL_bool default_value);
+
 /**
  * Clear a property on a set of properties
  *
@@ -370,7 +508,8 @@ typedef void (SDLCALL *SDL_EnumeratePropertiesCallback)(void *userdata, SDL_Prop
  * Enumerate the properties on a set of properties
  *
  * The callback function is called for each property on the set of properties.
- * The properties are locked during enumeration.
+ * The property names are gathered before the first call, so the callback may
+ * set or clear properties, including the one it was called for.
  *
  * \param props the properties to query
  * \param callback the function to call for each property
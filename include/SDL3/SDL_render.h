@@ -247,6 +247,12 @@ extern DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window, co
  *   one is desired
  * - "present_vsync" (boolean) - true if you want present synchronized with
  *   the refresh rate
+ * - "batch_draws" (boolean) - true if consecutive draws with the same
+ *   texture, blend mode and color should be merged into one draw call, if
+ *   the rendering driver supports it, defaults to true
+ * - "reorder_draws" (boolean) - true if draws that don't overlap may be
+ *   drawn out of order, so draws with the same texture can be merged,
+ *   defaults to false
  *
  * \param props the properties to use
  * \returns a valid rendering context or NULL if there was an error; call
@@ -331,8 +337,12 @@ extern DECLSPEC int SDLCALL SDL_GetRendererInfo(SDL_Renderer *renderer, SDL_Rend
  * "SDL.renderer.d3d11.device" (pointer) - the ID3D11Device associated with the renderer
  * "SDL.renderer.d3d12.device" (pointer) - the ID3D12Device associated with the renderer
  * "SDL.renderer.d3d12.command_queue" (pointer) - the ID3D12CommandQueue associated with the renderer
+ * "SDL.renderer.commands_queued" (number) - the number of render commands queued so far, if draws are batched
+ * "SDL.renderer.commands_submitted" (number) - the number of render commands left after merging draws, if draws are batched
  * ```
  *
+ * The command counts are updated each time this function is called.
+ *
  * \param renderer the rendering context
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
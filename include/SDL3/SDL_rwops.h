@@ -189,6 +189,14 @@ typedef struct SDL_RWops
  * effect. For example, "t" is sometimes appended to make explicit the file is
  * a text file.
  *
+ * On platforms that support it, adding "m" to a read-only mode, such as
+ * "rbm", maps the file into memory instead of reading it through the C
+ * library. The stream then reads straight from the mapping, SDL_RWpeek()
+ * works for any size, and the mapping is available through the
+ * "SDL.rwops.mapped.base" and "SDL.rwops.mapped.size" properties from
+ * SDL_GetRWProperties(). If the file can't be mapped, it is opened normally.
+ * The file must not be truncated while it is mapped.
+ *
  * This function supports Unicode filenames, but they must be encoded in UTF-8
  * format, regardless of the underlying operating system.
  *
@@ -280,6 +288,35 @@ extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromMem(void *mem, size_t size);
  */
 extern DECLSPEC SDL_RWops *SDLCALL SDL_RWFromConstMem(const void *mem, size_t size);
 
+/**
+ * Use this function to add a buffer to another SDL_RWops stream.
+ *
+ * Reads from the new stream are satisfied from a buffer that is refilled
+ * from `base` in large blocks, and writes are collected in the buffer and
+ * passed on to `base` when it fills up, the stream is seeked, or the stream
+ * is closed. This makes many small reads and writes, such as SDL_ReadU32LE()
+ * and SDL_WriteU32LE(), much cheaper, and allows SDL_RWpeek() to look at the
+ * buffered data without copying it.
+ *
+ * While the buffered stream is open, `base` should not be used directly.
+ * Closing the buffered stream writes out any buffered data and leaves `base`
+ * at the position the buffered stream was at, but does not close `base`.
+ *
+ * \param base the SDL_RWops stream to read from and write to
+ * \param bufsize the size of the buffer, in bytes, or 0 to use a default
+ *                size
+ * \returns a pointer to a new SDL_RWops structure, or NULL if it fails; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWclose
+ * \sa SDL_RWpeek
+ * \sa SDL_RWread
+ * \sa SDL_RWwrite
+ */
+extern DECLSPEC SDL_RWops *SDLCALL SDL_CreateBufferedRW(SDL_RWops *base, size_t bufsize);
+
 /* @} *//* RWFrom functions */
 
 
@@ -336,6 +373,13 @@ extern DECLSPEC void SDLCALL SDL_DestroyRW(SDL_RWops *context);
 /**
  * Get the properties associated with an SDL_RWops.
  *
+ * The following read-only properties are provided by SDL:
+ *
+ * ```
+ * "SDL.rwops.mapped.base" (pointer) - the start of the file data, for files opened with "m" in the mode string that could be mapped
+ * "SDL.rwops.mapped.size" (number) - the size of the file data, for files opened with "m" in the mode string that could be mapped
+ * ```
+ *
  * \param context a pointer to an SDL_RWops structure
  * \returns a valid property ID on success or 0 on failure; call
  *          SDL_GetError() for more information.
@@ -457,6 +501,49 @@ extern DECLSPEC Sint64 SDLCALL SDL_RWtell(SDL_RWops *context);
  */
 extern DECLSPEC size_t SDLCALL SDL_RWread(SDL_RWops *context, void *ptr, size_t size);
 
+/**
+ * Look at the next bytes of a data source without reading them.
+ *
+ * This returns a pointer to at least `size` bytes of data at the current
+ * position of the stream, without copying it. The stream position doesn't
+ * change until SDL_RWconsume() is called. The pointer is valid until the
+ * next call to any other function on the stream.
+ *
+ * This is supported by streams created with SDL_CreateBufferedRW(), where
+ * `size` can't be larger than the buffer size, and by memory streams.
+ *
+ * If there are fewer than `size` bytes left in the stream, this returns NULL
+ * and the status of the stream is set to SDL_RWOPS_STATUS_EOF, or to
+ * SDL_RWOPS_STATUS_ERROR if reading failed.
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param size the number of bytes to look at
+ * \returns a pointer to the data, or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_CreateBufferedRW
+ * \sa SDL_RWconsume
+ * \sa SDL_RWread
+ */
+extern DECLSPEC const void *SDLCALL SDL_RWpeek(SDL_RWops *context, size_t size);
+
+/**
+ * Move past data returned by SDL_RWpeek().
+ *
+ * \param context a pointer to an SDL_RWops structure
+ * \param size the number of bytes to move past, which must not be more than
+ *             the size passed to the last call to SDL_RWpeek()
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_RWpeek
+ */
+extern DECLSPEC int SDLCALL SDL_RWconsume(SDL_RWops *context, size_t size);
+
 /**
  * Write to an SDL_RWops data stream.
  *
@@ -605,6 +692,46 @@ extern DECLSPEC void *SDLCALL SDL_LoadFile_RW(SDL_RWops *src, size_t *datasize,
  */
 extern DECLSPEC void *SDLCALL SDL_LoadFile(const char *file, size_t *datasize);
 
+/**
+ * Map all the data from a file path into memory.
+ *
+ * This is like SDL_LoadFile(), but on platforms that support it the file is
+ * mapped into memory instead of copied, so the data is read from disk as it
+ * is used. The data is read-only and is not null terminated. The file must
+ * not be truncated while it is mapped.
+ *
+ * If the file can't be mapped, for example because it isn't a regular file,
+ * this function fails, and SDL_LoadFile() can be used instead. On platforms
+ * that don't support mapping files, the data is loaded into memory.
+ *
+ * The data should be released with SDL_UnmapFile().
+ *
+ * \param file the path to map
+ * \param datasize if not NULL, will store the number of bytes mapped
+ * \returns the data, or NULL if there was an error; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_LoadFile
+ * \sa SDL_UnmapFile
+ */
+extern DECLSPEC const void *SDLCALL SDL_MapFile(const char *file, size_t *datasize);
+
+/**
+ * Release data returned by SDL_MapFile().
+ *
+ * It is safe to pass NULL to this function; it is a no-op.
+ *
+ * \param mem the data returned by SDL_MapFile()
+ * \param datasize the size returned by SDL_MapFile()
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_MapFile
+ */
+extern DECLSPEC void SDLCALL SDL_UnmapFile(const void *mem, size_t datasize);
+
 /**
  *  \name Read endian functions
  *
@@ -690,9 +690,14 @@ extern DECLSPEC int SDLCALL SDL_ConvertPixels(int width, int height,
 /**
  * Premultiply the alpha on a block of pixels.
  *
+ * Each color channel is multiplied by the alpha of its pixel and divided by
+ * 255, rounded to the nearest value.
+ *
  * This is safe to use with src == dst, but not for other overlapping areas.
  *
- * This function is currently only implemented for SDL_PIXELFORMAT_ARGB8888.
+ * This function is implemented for SDL_PIXELFORMAT_ARGB8888,
+ * SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_ABGR8888 and
+ * SDL_PIXELFORMAT_BGRA8888, in any combination.
  *
  * \param width the width of the block to convert, in pixels
  * \param height the height of the block to convert, in pixels
@@ -713,6 +718,41 @@ extern DECLSPEC int SDLCALL SDL_PremultiplyAlpha(int width, int height,
                                                  Uint32 dst_format,
                                                  void *dst, int dst_pitch);
 
+/**
+ * Undo the alpha premultiplication on a block of pixels.
+ *
+ * Each color channel is multiplied by 255 and divided by the alpha of its
+ * pixel, rounded to the nearest value and clamped to 255. Pixels with an
+ * alpha of 0 become transparent black. Since premultiplying loses precision
+ * in translucent pixels, this gives back the original colors only for
+ * opaque pixels.
+ *
+ * This is safe to use with src == dst, but not for other overlapping areas.
+ *
+ * This function is implemented for the same formats as
+ * SDL_PremultiplyAlpha().
+ *
+ * \param width the width of the block to convert, in pixels
+ * \param height the height of the block to convert, in pixels
+ * \param src_format an SDL_PixelFormatEnum value of the `src` pixels format
+ * \param src a pointer to the source premultiplied pixels
+ * \param src_pitch the pitch of the source pixels, in bytes
+ * \param dst_format an SDL_PixelFormatEnum value of the `dst` pixels format
+ * \param dst a pointer to be filled in with straight alpha pixel data
+ * \param dst_pitch the pitch of the destination pixels, in bytes
+ * \returns 0 on success or a negative error code on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.0.0.
+ *
+ * \sa SDL_PremultiplyAlpha
+ */
+extern DECLSPEC int SDLCALL SDL_UnpremultiplyAlpha(int width, int height,
+                                                   Uint32 src_format,
+                                                   const void *src, int src_pitch,
+                                                   Uint32 dst_format,
+                                                   void *dst, int dst_pitch);
+
 /**
  * Perform a fast fill of a rectangle with a specific color.
  *
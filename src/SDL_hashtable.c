@@ -21,17 +21,34 @@
 #include "SDL_internal.h"
 #include "SDL_hashtable.h"
 
+// This is an open addressing hash table using Robin Hood hashing with
+//  linear probing. Items live directly in the table, so inserting doesn't
+//  allocate unless the table has to grow, and a lookup walks a short run of
+//  adjacent slots instead of chasing pointers.
+//
+// Each slot keeps the full hash of its key and how far it is from its ideal
+//  slot. On insert, an item that is further from home than the item in the
+//  slot it's probing takes that slot, and the displaced item continues on.
+//  This keeps probe lengths short and even, and lets a lookup stop as soon as
+//  it sees an item closer to home than the one it's looking for.
+
+#define SDL_HASHTABLE_MAX_LOAD_NUMERATOR   7
+#define SDL_HASHTABLE_MAX_LOAD_DENOMINATOR 8
+
 typedef struct SDL_HashItem
 {
     const void *key;
     const void *value;
-    struct SDL_HashItem *next;
+    Uint32 hash;
+    Uint32 probe_len;  // distance from the ideal slot plus one, 0 if the slot is empty.
 } SDL_HashItem;
 
 struct SDL_HashTable
 {
-    SDL_HashItem **table;
+    SDL_HashItem *table;
     Uint32 table_len;
+    Uint32 num_occupied_slots;
+    Uint32 max_load;
     SDL_bool stackable;
     void *data;
     SDL_HashTable_HashFn hash;
@@ -39,6 +56,11 @@ struct SDL_HashTable
     SDL_HashTable_NukeFn nuke;
 };
 
+static Uint32 calc_max_load(Uint32 table_len)
+{
+    return (Uint32)(((Uint64)table_len * SDL_HASHTABLE_MAX_LOAD_NUMERATOR) / SDL_HASHTABLE_MAX_LOAD_DENOMINATOR);
+}
+
 SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const SDL_HashTable_HashFn hashfn,
                                    const SDL_HashTable_KeyMatchFn keymatchfn,
                                    const SDL_HashTable_NukeFn nukefn,
@@ -57,13 +79,14 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
         return NULL;
     }
 
-    table->table = (SDL_HashItem **) SDL_calloc(num_buckets, sizeof (SDL_HashItem *));
+    table->table = (SDL_HashItem *) SDL_calloc(num_buckets, sizeof (SDL_HashItem));
     if (!table->table) {
         SDL_free(table);
         return NULL;
     }
 
     table->table_len = num_buckets;
+    table->max_load = calc_max_load(num_buckets);
     table->stackable = stackable;
     table->data = data;
     table->hash = hashfn;
@@ -74,114 +97,234 @@ SDL_HashTable *SDL_CreateHashTable(void *data, const Uint32 num_buckets, const S
 
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    return table->hash(key, table->data) & (table->table_len - 1);
+    return table->hash(key, table->data);
 }
 
+/* Place an item in the table, displacing richer items along the way. The table must have a free slot.
+ *
+ * Items with the same home slot stay in the order they're placed. With `first`, the item goes in front
+ * of the others from its home slot instead of behind them, so duplicate keys in stackable tables are
+ * found newest first, like the old chained buckets.
+ */
+static void insert_item(SDL_HashItem *table, const Uint32 table_len, SDL_HashItem item, SDL_bool first)
+{
+    const Uint32 mask = table_len - 1;
+    Uint32 idx = item.hash & mask;
+
+    item.probe_len = 1;
+    for (;;) {
+        SDL_HashItem *slot = &table[idx];
+
+        if (slot->probe_len == 0) {
+            *slot = item;
+            return;
+        }
+
+        // An item the same distance from its home slot has the same home slot.
+        if (slot->probe_len < item.probe_len || (first && slot->probe_len == item.probe_len)) {
+            const SDL_HashItem displaced = *slot;
+            first = SDL_TRUE;  // the displaced item was in front of the rest from its home slot, keep it there.
+            *slot = item;
+            item = displaced;
+        }
+
+        ++item.probe_len;
+        idx = (idx + 1) & mask;
+    }
+}
+
+static SDL_bool resize(SDL_HashTable *table, Uint32 new_len)
+{
+    SDL_HashItem *old_table = table->table;
+    const Uint32 old_len = table->table_len;
+    SDL_HashItem *new_table;
+    Uint32 i, start;
+
+    new_table = (SDL_HashItem *) SDL_calloc(new_len, sizeof (SDL_HashItem));
+    if (!new_table) {
+        return SDL_FALSE;
+    }
+
+    /* Start after an empty slot, so no run of items wraps around the end of the
+     * table while we walk it, and items from the same home slot keep their order.
+     * The load limit guarantees there's an empty slot.
+     */
+    start = 0;
+    while (old_table[start].probe_len) {
+        ++start;
+    }
+    for (i = 1; i <= old_len; i++) {
+        const SDL_HashItem *item = &old_table[(start + i) & (old_len - 1)];
+        if (item->probe_len) {
+            insert_item(new_table, new_len, *item, SDL_FALSE);
+        }
+    }
+
+    table->table = new_table;
+    table->table_len = new_len;
+    table->max_load = calc_max_load(new_len);
+    SDL_free(old_table);
+    return SDL_TRUE;
+}
+
+// Find the first slot holding `key`, starting the probe after `start` if it's not NULL.
+static SDL_HashItem *find_item(const SDL_HashTable *table, const void *key, Uint32 hash, SDL_HashItem *start)
+{
+    const Uint32 mask = table->table_len - 1;
+    void *data = table->data;
+    Uint32 idx, probe_len;
+
+    if (start) {
+        idx = (Uint32)(start - table->table);
+        probe_len = start->probe_len;
+        idx = (idx + 1) & mask;
+        ++probe_len;
+    } else {
+        idx = hash & mask;
+        probe_len = 1;
+    }
+
+    for (;;) {
+        SDL_HashItem *slot = &table->table[idx];
+
+        // An empty slot, or one closer to home than we are, means the key isn't here.
+        if (slot->probe_len < probe_len) {
+            return NULL;
+        }
+
+        if (slot->hash == hash && table->keymatch(key, slot->key, data)) {
+            return slot;
+        }
+
+        ++probe_len;
+        idx = (idx + 1) & mask;
+    }
+}
 
 SDL_bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
 {
-    SDL_HashItem *item;
-    const Uint32 hash = calc_hash(table, key);
+    SDL_HashItem item;
 
-    if ( (!table->stackable) && (SDL_FindInHashTable(table, key, NULL)) ) {
+    if (!table) {
         return SDL_FALSE;
     }
 
-    // !!! FIXME: grow and rehash table if it gets too saturated.
-    item = (SDL_HashItem *) SDL_malloc(sizeof (SDL_HashItem));
-    if (!item) {
+    item.hash = calc_hash(table, key);
+
+    if ( (!table->stackable) && (find_item(table, key, item.hash, NULL)) ) {
         return SDL_FALSE;
     }
 
-    item->key = key;
-    item->value = value;
-    item->next = table->table[hash];
-    table->table[hash] = item;
+    if (table->num_occupied_slots >= table->max_load) {
+        if (table->table_len >= 0x80000000u || !resize(table, table->table_len * 2)) {
+            return SDL_FALSE;
+        }
+    }
+
+    item.key = key;
+    item.value = value;
+    insert_item(table->table, table->table_len, item, SDL_TRUE);
+    ++table->num_occupied_slots;
 
     return SDL_TRUE;
 }
 
 SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value)
 {
-    const Uint32 hash = calc_hash(table, key);
-    void *data = table->data;
-    SDL_HashItem *i;
+    SDL_HashItem *item;
 
-    for (i = table->table[hash]; i; i = i->next) {
-        if (table->keymatch(key, i->key, data)) {
-            if (_value) {
-                *_value = i->value;
-            }
-            return SDL_TRUE;
-        }
+    if (!table) {
+        return SDL_FALSE;
     }
 
-    return SDL_FALSE;
+    item = find_item(table, key, calc_hash(table, key), NULL);
+    if (!item) {
+        return SDL_FALSE;
+    }
+
+    if (_value) {
+        *_value = item->value;
+    }
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
-    const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = NULL;
-    SDL_HashItem *prev = NULL;
-    void *data = table->data;
+    SDL_HashItem *item;
+    SDL_HashItem removed;
+    Uint32 mask, idx;
 
-    for (item = table->table[hash]; item; item = item->next) {
-        if (table->keymatch(key, item->key, data)) {
-            if (prev) {
-                prev->next = item->next;
-            } else {
-                table->table[hash] = item->next;
-            }
+    if (!table) {
+        return SDL_FALSE;
+    }
+
+    item = find_item(table, key, calc_hash(table, key), NULL);
+    if (!item) {
+        return SDL_FALSE;
+    }
+    removed = *item;
+
+    // Shift the following items back one slot, until one is already home or the run ends.
+    mask = table->table_len - 1;
+    idx = (Uint32)(item - table->table);
+    for (;;) {
+        const Uint32 next_idx = (idx + 1) & mask;
+        SDL_HashItem *next = &table->table[next_idx];
 
-            table->nuke(item->key, item->value, data);
-            SDL_free(item);
-            return SDL_TRUE;
+        if (next->probe_len <= 1) {
+            break;
         }
 
-        prev = item;
+        table->table[idx] = *next;
+        --table->table[idx].probe_len;
+        idx = next_idx;
     }
+    SDL_zero(table->table[idx]);
+    --table->num_occupied_slots;
 
-    return SDL_FALSE;
+    table->nuke(removed.key, removed.value, table->data);
+
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = *iter ? ((SDL_HashItem *) *iter)->next : table->table[calc_hash(table, key)];
+    SDL_HashItem *item = NULL;
 
-    while (item) {
-        if (table->keymatch(key, item->key, table->data)) {
-            *_value = item->value;
-            *iter = item;
-            return SDL_TRUE;
-        }
-        item = item->next;
+    if (table) {
+        item = find_item(table, key, calc_hash(table, key), (SDL_HashItem *) *iter);
     }
 
-    // no more matches.
-    *_value = NULL;
-    *iter = NULL;
-    return SDL_FALSE;
+    if (!item) {
+        // no more matches.
+        *_value = NULL;
+        *iter = NULL;
+        return SDL_FALSE;
+    }
+
+    *_value = item->value;
+    *iter = item;
+    return SDL_TRUE;
 }
 
 SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const void **_value, void **iter)
 {
     SDL_HashItem *item = (SDL_HashItem *) *iter;
-    Uint32 idx = 0;
+    SDL_HashItem *end;
 
-    if (item) {
-        const SDL_HashItem *orig = item;
-        item = item->next;
-        if (!item) {
-            idx = calc_hash(table, orig->key) + 1;  // !!! FIXME: we probably shouldn't rehash each time.
-        }
+    if (!table) {
+        *_key = NULL;
+        *iter = NULL;
+        return SDL_FALSE;
     }
 
-    while (!item && (idx < table->table_len)) {
-        item = table->table[idx++];  // skip empty buckets...
+    item = item ? item + 1 : table->table;
+    end = table->table + table->table_len;
+    while (item < end && !item->probe_len) {
+        ++item;  // skip empty slots...
     }
 
-    if (!item) {  // no more matches?
+    if (item >= end) {  // no more matches?
         *_key = NULL;
         *iter = NULL;
         return SDL_FALSE;
@@ -196,17 +339,7 @@ SDL_bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, con
 
 SDL_bool SDL_HashTableEmpty(SDL_HashTable *table)
 {
-    if (table) {
-        Uint32 i;
-
-        for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            if (item) {
-                return SDL_FALSE;
-            }
-        }
-    }
-    return SDL_TRUE;
+    return (!table || table->num_occupied_slots == 0) ? SDL_TRUE : SDL_FALSE;
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
@@ -216,12 +349,9 @@ void SDL_DestroyHashTable(SDL_HashTable *table)
         Uint32 i;
 
         for (i = 0; i < table->table_len; i++) {
-            SDL_HashItem *item = table->table[i];
-            while (item) {
-                SDL_HashItem *next = item->next;
+            SDL_HashItem *item = &table->table[i];
+            if (item->probe_len) {
                 table->nuke(item->key, item->value, data);
-                SDL_free(item);
-                item = next;
             }
         }
 
@@ -42,7 +42,7 @@ SDL_bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key);
 SDL_bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value);
 SDL_bool SDL_HashTableEmpty(SDL_HashTable *table);
 
-// iterate all values for a specific key. This only makes sense if the hash is stackable. If not-stackable, just use SDL_FindInHashTable().
+// iterate all values for a specific key, newest first. This only makes sense if the hash is stackable. If not-stackable, just use SDL_FindInHashTable().
 SDL_bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter);
 
 // iterate all key/value pairs in a hash (stackable hashes can have duplicate keys with multiple values).
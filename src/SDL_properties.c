@@ -42,16 +42,52 @@ typedef struct
     void *userdata;
 } SDL_Property;
 
+/* Properties are keyed by atom, so lookups don't need to hash or compare strings.
+ *
+ * Reads take the lock shared, so they don't block each other. Writers and
+ * SDL_LockProperties() take it exclusively, and remember the owning thread so
+ * that thread can keep getting and setting properties while it holds the lock.
+ */
 typedef struct
 {
+    SDL_PropertiesID id;
     SDL_HashTable *props;
-    SDL_Mutex *lock;
+    SDL_RWLock *lock;
+    void *owner;
+    int lock_count;
 } SDL_Properties;
 
-static SDL_HashTable *SDL_properties;
-static SDL_Mutex *SDL_properties_lock;
-static SDL_PropertiesID SDL_last_properties_id;
+/* Sets of properties live in slots, in pages that don't move and aren't freed
+ * until SDL_QuitProperties(), so finding a set by ID doesn't take any lock.
+ *
+ * An SDL_PropertiesID is the slot in the low bits and the number of times the
+ * slot has been used in the high bits, so the ID of a destroyed set doesn't
+ * find a newer set that reuses its slot. Slot 0 is never used.
+ */
+#define SDL_PROPERTIES_SLOT_BITS  20
+#define SDL_PROPERTIES_SLOT_MASK  ((1u << SDL_PROPERTIES_SLOT_BITS) - 1)
+#define SDL_PROPERTIES_MAX_GENERATION (SDL_MAX_UINT32 >> SDL_PROPERTIES_SLOT_BITS)
+#define SDL_PROPERTIES_PAGE_BITS  10
+#define SDL_PROPERTIES_PAGE_SIZE  (1u << SDL_PROPERTIES_PAGE_BITS)
+#define SDL_PROPERTIES_PAGE_MASK  (SDL_PROPERTIES_PAGE_SIZE - 1)
+#define SDL_MAX_PROPERTIES_PAGES  (1u << (SDL_PROPERTIES_SLOT_BITS - SDL_PROPERTIES_PAGE_BITS))
+
+typedef struct
+{
+    void *slots[SDL_PROPERTIES_PAGE_SIZE];
+    Uint32 generations[SDL_PROPERTIES_PAGE_SIZE];
+    Uint32 next_free[SDL_PROPERTIES_PAGE_SIZE];
+} SDL_PropertiesPage;
+
+/* SDL_properties_lock protects adding and removing sets of properties, and the table of atoms */
+static void *SDL_properties_pages[SDL_MAX_PROPERTIES_PAGES];
+static Uint32 SDL_num_properties_slots;
+static Uint32 SDL_first_free_properties_slot;
+static SDL_RWLock *SDL_properties_lock;
 static SDL_PropertiesID SDL_global_properties;
+static SDL_HashTable *SDL_property_atoms;
+static char **SDL_property_atom_names;
+static SDL_PropertyAtom SDL_num_property_atoms;
 
 
 static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, SDL_bool cleanup)
@@ -74,7 +110,6 @@ static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void
             SDL_free(property->string_storage);
         }
     }
-    SDL_free((void *)key);
     SDL_free((void *)value);
 }
 
@@ -83,33 +118,55 @@ static void SDL_FreeProperty(const void *key, const void *value, void *data)
     SDL_FreePropertyWithCleanup(key, value, data, SDL_TRUE);
 }
 
+static void SDL_UnlinkProperty(const void *key, const void *value, void *data)
+{
+    /* Properties are freed by the caller once they're out of the table and
+     * no lock is held, so cleanup callbacks can use properties themselves.
+     */
+}
+
+/* Free a set of properties that is no longer in its slot, with no locks held */
 static void SDL_FreeProperties(const void *key, const void *value, void *data)
 {
     SDL_Properties *properties = (SDL_Properties *)value;
     if (properties) {
         if (properties->props) {
+            const void *atom, *property;
+            void *iter = NULL;
+
+            while (SDL_IterateHashTable(properties->props, &atom, &property, &iter)) {
+                SDL_FreeProperty(atom, property, NULL);
+            }
             SDL_DestroyHashTable(properties->props);
             properties->props = NULL;
         }
         if (properties->lock) {
-            SDL_DestroyMutex(properties->lock);
+            SDL_DestroyRWLock(properties->lock);
             properties->lock = NULL;
         }
         SDL_free(properties);
     }
 }
 
+static void SDL_FreePropertyAtom(const void *key, const void *value, void *data)
+{
+    /* The names are owned by SDL_property_atom_names */
+}
+
 int SDL_InitProperties(void)
 {
     if (!SDL_properties_lock) {
-        SDL_properties_lock = SDL_CreateMutex();
+        SDL_properties_lock = SDL_CreateRWLock();
         if (!SDL_properties_lock) {
             return -1;
         }
     }
-    if (!SDL_properties) {
-        SDL_properties = SDL_CreateHashTable(NULL, 16, SDL_HashID, SDL_KeyMatchID, SDL_FreeProperties, SDL_FALSE);
-        if (!SDL_properties) {
+    if (!SDL_num_properties_slots) {
+        SDL_num_properties_slots = 1;
+    }
+    if (!SDL_property_atoms) {
+        SDL_property_atoms = SDL_CreateHashTable(NULL, 64, SDL_HashString, SDL_KeyMatchString, SDL_FreePropertyAtom, SDL_FALSE);
+        if (!SDL_property_atoms) {
             return -1;
         }
     }
@@ -118,20 +175,232 @@ int SDL_InitProperties(void)
 
 void SDL_QuitProperties(void)
 {
+    SDL_PropertyAtom i;
+
     if (SDL_global_properties) {
         SDL_DestroyProperties(SDL_global_properties);
         SDL_global_properties = 0;
     }
-    if (SDL_properties) {
-        SDL_DestroyHashTable(SDL_properties);
-        SDL_properties = NULL;
+    if (SDL_num_properties_slots) {
+        SDL_bool freed;
+        Uint32 slot;
+
+        /* Cleanup callbacks may create or destroy other properties, so go until there are none left */
+        do {
+            freed = SDL_FALSE;
+            for (slot = 1; slot < SDL_num_properties_slots; ++slot) {
+                SDL_PropertiesPage *page = (SDL_PropertiesPage *)SDL_AtomicGetPtr(&SDL_properties_pages[slot >> SDL_PROPERTIES_PAGE_BITS]);
+                SDL_Properties *properties = (SDL_Properties *)SDL_AtomicSetPtr(&page->slots[slot & SDL_PROPERTIES_PAGE_MASK], NULL);
+                if (properties) {
+                    SDL_FreeProperties(NULL, properties, NULL);
+                    freed = SDL_TRUE;
+                }
+            }
+        } while (freed);
+
+        for (slot = 0; slot < SDL_MAX_PROPERTIES_PAGES; ++slot) {
+            SDL_free(SDL_AtomicSetPtr(&SDL_properties_pages[slot], NULL));
+        }
+        SDL_num_properties_slots = 0;
+        SDL_first_free_properties_slot = 0;
+    }
+    if (SDL_property_atoms) {
+        SDL_DestroyHashTable(SDL_property_atoms);
+        SDL_property_atoms = NULL;
+    }
+    if (SDL_property_atom_names) {
+        for (i = 1; i <= SDL_num_property_atoms; ++i) {
+            SDL_free(SDL_property_atom_names[i]);
+        }
+        SDL_free(SDL_property_atom_names);
+        SDL_property_atom_names = NULL;
+        SDL_num_property_atoms = 0;
     }
     if (SDL_properties_lock) {
-        SDL_DestroyMutex(SDL_properties_lock);
+        SDL_DestroyRWLock(SDL_properties_lock);
         SDL_properties_lock = NULL;
     }
 }
 
+/* Find the atom for a name, called with SDL_properties_lock held */
+static SDL_PropertyAtom SDL_FindPropertyAtom(const char *name)
+{
+    const void *atom = NULL;
+
+    SDL_FindInHashTable(SDL_property_atoms, name, &atom);
+    return (SDL_PropertyAtom)(uintptr_t)atom;
+}
+
+SDL_PropertyAtom SDL_GetPropertyAtom(const char *name)
+{
+    SDL_PropertyAtom atom;
+
+    if (!name || !*name) {
+        SDL_InvalidParamError("name");
+        return 0;
+    }
+
+    if (!SDL_property_atoms && SDL_InitProperties() < 0) {
+        return 0;
+    }
+
+    SDL_LockRWLockForReading(SDL_properties_lock);
+    atom = SDL_FindPropertyAtom(name);
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    if (atom) {
+        return atom;
+    }
+
+    SDL_LockRWLockForWriting(SDL_properties_lock);
+    {
+        /* Another thread may have added it while we weren't holding the lock */
+        atom = SDL_FindPropertyAtom(name);
+        if (!atom) {
+            char **names = (char **)SDL_realloc(SDL_property_atom_names, (SDL_num_property_atoms + 2) * sizeof(*names));
+            if (names) {
+                SDL_property_atom_names = names;
+
+                names[SDL_num_property_atoms + 1] = SDL_strdup(name);
+                if (names[SDL_num_property_atoms + 1]) {
+                    if (SDL_InsertIntoHashTable(SDL_property_atoms, names[SDL_num_property_atoms + 1], (const void *)(uintptr_t)(SDL_num_property_atoms + 1))) {
+                        atom = ++SDL_num_property_atoms;
+                    } else {
+                        SDL_free(names[SDL_num_property_atoms + 1]);
+                    }
+                }
+            }
+        }
+    }
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    return atom;
+}
+
+static const char *SDL_GetPropertyAtomName(SDL_PropertyAtom atom)
+{
+    const char *name = NULL;
+
+    /* The names are never freed until SDL_QuitProperties(), only the array may move */
+    SDL_LockRWLockForReading(SDL_properties_lock);
+    if (atom > 0 && atom <= SDL_num_property_atoms) {
+        name = SDL_property_atom_names[atom];
+    }
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    return name ? name : "(invalid)";
+}
+
+static SDL_PropertiesPage *SDL_GetPropertiesPage(Uint32 slot)
+{
+    return (SDL_PropertiesPage *)SDL_AtomicGetPtr(&SDL_properties_pages[slot >> SDL_PROPERTIES_PAGE_BITS]);
+}
+
+/* Find a set of properties and optionally the atom for a property name.
+ * Only looking up the name takes SDL_properties_lock.
+ */
+static SDL_Properties *SDL_FindProperties(SDL_PropertiesID props, const char *name, SDL_PropertyAtom *atom)
+{
+    const Uint32 slot = props & SDL_PROPERTIES_SLOT_MASK;
+    SDL_PropertiesPage *page = SDL_GetPropertiesPage(slot);
+    SDL_Properties *properties;
+
+    if (!page) {
+        return NULL;
+    }
+    properties = (SDL_Properties *)SDL_AtomicGetPtr(&page->slots[slot & SDL_PROPERTIES_PAGE_MASK]);
+    if (!properties || properties->id != props) {
+        return NULL;
+    }
+
+    if (name) {
+        SDL_LockRWLockForReading(SDL_properties_lock);
+        *atom = SDL_FindPropertyAtom(name);
+        SDL_UnlockRWLock(SDL_properties_lock);
+    }
+    return properties;
+}
+
+/* Find a free slot for a set of properties, called with SDL_properties_lock held for writing */
+static Uint32 SDL_AllocPropertiesSlot(void)
+{
+    SDL_PropertiesPage *page;
+    Uint32 slot = SDL_first_free_properties_slot;
+
+    if (slot) {
+        page = SDL_GetPropertiesPage(slot);
+        SDL_first_free_properties_slot = page->next_free[slot & SDL_PROPERTIES_PAGE_MASK];
+        return slot;
+    }
+
+    slot = SDL_num_properties_slots;
+    if (slot > SDL_PROPERTIES_SLOT_MASK) {
+        SDL_SetError("Too many properties");
+        return 0;
+    }
+    if (!SDL_GetPropertiesPage(slot)) {
+        page = (SDL_PropertiesPage *)SDL_calloc(1, sizeof(*page));
+        if (!page) {
+            return 0;
+        }
+        /* Make sure the page is zeroed before anyone can see it */
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSetPtr(&SDL_properties_pages[slot >> SDL_PROPERTIES_PAGE_BITS], page);
+    }
+    ++SDL_num_properties_slots;
+    return slot;
+}
+
+static void SDL_LockPropertiesForWriting(SDL_Properties *properties)
+{
+    void *self = (void *)(uintptr_t)SDL_ThreadID();
+
+    if (SDL_AtomicGetPtr(&properties->owner) == self) {
+        ++properties->lock_count;
+        return;
+    }
+    SDL_LockRWLockForWriting(properties->lock);
+    SDL_AtomicSetPtr(&properties->owner, self);
+    properties->lock_count = 1;
+}
+
+static void SDL_UnlockPropertiesForWriting(SDL_Properties *properties)
+{
+    if (--properties->lock_count == 0) {
+        SDL_AtomicSetPtr(&properties->owner, NULL);
+        SDL_UnlockRWLock(properties->lock);
+    }
+}
+
+/* Returns SDL_TRUE if the lock was taken, or SDL_FALSE if this thread already holds it for writing */
+static SDL_bool SDL_LockPropertiesForReading(SDL_Properties *properties)
+{
+    if (SDL_AtomicGetPtr(&properties->owner) == (void *)(uintptr_t)SDL_ThreadID()) {
+        return SDL_FALSE;
+    }
+    SDL_LockRWLockForReading(properties->lock);
+    return SDL_TRUE;
+}
+
+static void SDL_UnlockPropertiesForReading(SDL_Properties *properties, SDL_bool locked)
+{
+    if (locked) {
+        SDL_UnlockRWLock(properties->lock);
+    }
+}
+
+/* Find a property, called with the properties locked */
+static SDL_Property *SDL_FindProperty(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name)
+{
+    SDL_Property *property = NULL;
+
+    if (!atom || !SDL_FindInHashTable(properties->props, (const void *)(uintptr_t)atom, (const void **)&property)) {
+        SDL_SetError("Couldn't find property named %s", name ? name : SDL_GetPropertyAtomName(atom));
+        return NULL;
+    }
+    return property;
+}
+
 SDL_PropertiesID SDL_GetGlobalProperties(void)
 {
     if (!SDL_global_properties) {
@@ -146,7 +415,7 @@ SDL_PropertiesID SDL_CreateProperties(void)
     SDL_Properties *properties = NULL;
     SDL_bool inserted = SDL_FALSE;
 
-    if (!SDL_properties && SDL_InitProperties() < 0) {
+    if (!SDL_property_atoms && SDL_InitProperties() < 0) {
         return 0;
     }
 
@@ -154,11 +423,11 @@ SDL_PropertiesID SDL_CreateProperties(void)
     if (!properties) {
         goto error;
     }
-    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, SDL_FALSE);
+    properties->props = SDL_CreateHashTable(NULL, 4, SDL_HashID, SDL_KeyMatchID, SDL_UnlinkProperty, SDL_FALSE);
     if (!properties->props) {
         goto error;
     }
-    properties->lock = SDL_CreateMutex();
+    properties->lock = SDL_CreateRWLock();
     if (!properties->lock) {
         goto error;
     }
@@ -167,16 +436,26 @@ SDL_PropertiesID SDL_CreateProperties(void)
         goto error;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    ++SDL_last_properties_id;
-    if (SDL_last_properties_id == 0) {
-        ++SDL_last_properties_id;
-    }
-    props = SDL_last_properties_id;
-    if (SDL_InsertIntoHashTable(SDL_properties, (const void *)(uintptr_t)props, properties)) {
-        inserted = SDL_TRUE;
+    SDL_LockRWLockForWriting(SDL_properties_lock);
+    {
+        const Uint32 slot = SDL_AllocPropertiesSlot();
+        if (slot) {
+            SDL_PropertiesPage *page = SDL_GetPropertiesPage(slot);
+            Uint32 *generation = &page->generations[slot & SDL_PROPERTIES_PAGE_MASK];
+
+            if (++*generation > SDL_PROPERTIES_MAX_GENERATION) {
+                *generation = 1;
+            }
+            props = (*generation << SDL_PROPERTIES_SLOT_BITS) | slot;
+            properties->id = props;
+
+            /* Make sure the properties are set up before anyone can find them */
+            SDL_MemoryBarrierRelease();
+            SDL_AtomicSetPtr(&page->slots[slot & SDL_PROPERTIES_PAGE_MASK], properties);
+            inserted = SDL_TRUE;
+        }
     }
-    SDL_UnlockMutex(SDL_properties_lock);
+    SDL_UnlockRWLock(SDL_properties_lock);
 
     if (inserted) {
         /* All done! */
@@ -196,15 +475,12 @@ int SDL_LockProperties(SDL_PropertiesID props)
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, NULL, NULL);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     return 0;
 }
 
@@ -216,20 +492,19 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, NULL, NULL);
     if (!properties) {
         return;
     }
 
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
 }
 
 static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
+    SDL_PropertyAtom atom = 0;
+    SDL_Property *old_property = NULL;
     int result = 0;
 
     if (!props) {
@@ -241,27 +516,41 @@ static int SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_
         return SDL_InvalidParamError("name");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    if (property) {
+        atom = SDL_GetPropertyAtom(name);
+        if (!atom) {
+            SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
+            return -1;
+        }
+        properties = SDL_FindProperties(props, NULL, NULL);
+    } else {
+        /* Clearing a property that never existed doesn't need a new atom */
+        properties = SDL_FindProperties(props, name, &atom);
+    }
 
     if (!properties) {
         SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    SDL_LockPropertiesForWriting(properties);
     {
-        SDL_RemoveFromHashTable(properties->props, name);
+        if (atom && SDL_FindInHashTable(properties->props, (const void *)(uintptr_t)atom, (const void **)&old_property)) {
+            SDL_RemoveFromHashTable(properties->props, (const void *)(uintptr_t)atom);
+        }
         if (property) {
-            char *key = SDL_strdup(name);
-            if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
-                SDL_FreePropertyWithCleanup(key, property, NULL, SDL_FALSE);
+            if (!SDL_InsertIntoHashTable(properties->props, (const void *)(uintptr_t)atom, property)) {
+                SDL_FreePropertyWithCleanup(NULL, property, NULL, SDL_FALSE);
                 result = -1;
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForWriting(properties);
+
+    /* Run the cleanup for the old value outside the lock */
+    if (old_property) {
+        SDL_FreeProperty(NULL, old_property, NULL);
+    }
 
     return result;
 }
@@ -360,7 +649,9 @@ int SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool va
 SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
     SDL_Properties *properties = NULL;
+    SDL_PropertyAtom atom = 0;
     SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
+    SDL_bool locked;
 
     if (!props) {
         SDL_InvalidParamError("props");
@@ -371,96 +662,77 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, name, &atom);
     if (!properties) {
         SDL_InvalidParamError("props");
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom, name);
+        if (property) {
             type = property->type;
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return type;
 }
 
-void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_value)
+static void *SDL_GetPropertyInternal(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, void *default_value)
 {
-    SDL_Properties *properties = NULL;
     void *value = default_value;
-
-    if (!props) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
-        return value;
-    }
-
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
+    SDL_bool locked;
 
     /* Note that taking the lock here only guarantees that we won't read the
      * hashtable while it's being modified. The value itself can easily be
      * freed from another thread after it is returned here.
      */
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom, name);
+        if (property) {
             if (property->type == SDL_PROPERTY_TYPE_POINTER) {
                 value = property->value.pointer_value;
             } else {
-                SDL_SetError("Property %s isn't a pointer value", name);
+                SDL_SetError("Property %s isn't a pointer value", name ? name : SDL_GetPropertyAtomName(atom));
             }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
 
-const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
+/* Format a number as a string the first time it's needed, called with the properties locked */
+static const char *SDL_GetPropertyStringStorage(SDL_Property *property)
 {
-    SDL_Properties *properties = NULL;
-    const char *value = default_value;
-
-    if (!props) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
-        return value;
-    }
+    char *storage = (char *)SDL_AtomicGetPtr((void **)&property->string_storage);
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
+    if (!storage) {
+        if (property->type == SDL_PROPERTY_TYPE_NUMBER) {
+            SDL_asprintf(&storage, "%" SDL_PRIs64 "", property->value.number_value);
+        } else {
+            SDL_asprintf(&storage, "%f", property->value.float_value);
+        }
+        if (!storage) {
+            return NULL;
+        }
 
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
+        /* Other readers may be doing the same thing, the first one wins */
+        if (!SDL_AtomicCASPtr((void **)&property->string_storage, NULL, storage)) {
+            SDL_free(storage);
+            storage = (char *)SDL_AtomicGetPtr((void **)&property->string_storage);
+        }
     }
+    return storage;
+}
+
+static const char *SDL_GetStringPropertyInternal(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, const char *default_value)
+{
+    const char *value = default_value;
+    SDL_bool locked;
 
     /* Note that taking the lock here only guarantees that we won't read the
      * hashtable while it's being modified. The value itself can easily be
@@ -468,77 +740,46 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
      *
      * FIXME: Should we SDL_strdup() the return value to avoid this?
      */
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = property->value.string_value;
                 break;
             case SDL_PROPERTY_TYPE_NUMBER:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%" SDL_PRIs64 "", property->value.number_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
-                }
-                break;
             case SDL_PROPERTY_TYPE_FLOAT:
-                if (property->string_storage) {
-                    value = property->string_storage;
-                } else {
-                    SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
-                    if (property->string_storage) {
-                        value = property->string_storage;
-                    }
+            {
+                const char *storage = SDL_GetPropertyStringStorage(property);
+                if (storage) {
+                    value = storage;
                 }
                 break;
+            }
             case SDL_PROPERTY_TYPE_BOOLEAN:
                 value = property->value.boolean_value ? "true" : "false";
                 break;
             default:
-                SDL_SetError("Property %s isn't a string value", name);
+                SDL_SetError("Property %s isn't a string value", name ? name : SDL_GetPropertyAtomName(atom));
                 break;
             }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
 
-Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+static Sint64 SDL_GetNumberPropertyInternal(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, Sint64 default_value)
 {
-    SDL_Properties *properties = NULL;
     Sint64 value = default_value;
+    SDL_bool locked;
 
-    if (!props) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
-        return value;
-    }
-
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_strtoll(property->value.string_value, NULL, 0);
@@ -553,45 +794,25 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
                 value = property->value.boolean_value;
                 break;
             default:
-                SDL_SetError("Property %s isn't a number value", name);
+                SDL_SetError("Property %s isn't a number value", name ? name : SDL_GetPropertyAtomName(atom));
                 break;
             }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
 
-float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+static float SDL_GetFloatPropertyInternal(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, float default_value)
 {
-    SDL_Properties *properties = NULL;
     float value = default_value;
+    SDL_bool locked;
 
-    if (!props) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
-        return value;
-    }
-
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (float)SDL_atof(property->value.string_value);
@@ -606,45 +827,25 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
                 value = (float)property->value.boolean_value;
                 break;
             default:
-                SDL_SetError("Property %s isn't a float value", name);
+                SDL_SetError("Property %s isn't a float value", name ? name : SDL_GetPropertyAtomName(atom));
                 break;
             }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
 
-SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value)
+static SDL_bool SDL_GetBooleanPropertyInternal(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, SDL_bool default_value)
 {
-    SDL_Properties *properties = NULL;
     SDL_bool value = default_value;
+    SDL_bool locked;
 
-    if (!props) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-    if (!name || !*name) {
-        SDL_InvalidParamError("name");
-        return value;
-    }
-
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
-    if (!properties) {
-        SDL_InvalidParamError("props");
-        return value;
-    }
-
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom, name);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_GetStringBoolean(property->value.string_value, default_value);
@@ -659,18 +860,155 @@ SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bo
                 value = property->value.boolean_value;
                 break;
             default:
-                SDL_SetError("Property %s isn't a boolean value", name);
+                SDL_SetError("Property %s isn't a boolean value", name ? name : SDL_GetPropertyAtomName(atom));
                 break;
             }
-        } else {
-            SDL_SetError("Couldn't find property named %s", name);
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
     return value;
 }
 
+/* Validate the parameters and find the properties for the SDL_Get*Property() functions */
+static SDL_Properties *SDL_FindPropertiesByName(SDL_PropertiesID props, const char *name, SDL_PropertyAtom *atom)
+{
+    SDL_Properties *properties;
+
+    if (!props) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+    if (!name || !*name) {
+        SDL_InvalidParamError("name");
+        return NULL;
+    }
+
+    properties = SDL_FindProperties(props, name, atom);
+    if (!properties) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+    return properties;
+}
+
+/* Validate the parameters and find the properties for the SDL_Get*PropertyByAtom() functions */
+static SDL_Properties *SDL_FindPropertiesByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom)
+{
+    SDL_Properties *properties;
+
+    if (!props) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+    if (!atom) {
+        SDL_InvalidParamError("atom");
+        return NULL;
+    }
+
+    properties = SDL_FindProperties(props, NULL, NULL);
+    if (!properties) {
+        SDL_InvalidParamError("props");
+        return NULL;
+    }
+    return properties;
+}
+
+void *SDL_GetProperty(SDL_PropertiesID props, const char *name, void *default_value)
+{
+    SDL_PropertyAtom atom = 0;
+    SDL_Properties *properties = SDL_FindPropertiesByName(props, name, &atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetPropertyInternal(properties, atom, name, default_value);
+}
+
+void *SDL_GetPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, void *default_value)
+{
+    SDL_Properties *properties = SDL_FindPropertiesByAtom(props, atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetPropertyInternal(properties, atom, NULL, default_value);
+}
+
+const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
+{
+    SDL_PropertyAtom atom = 0;
+    SDL_Properties *properties = SDL_FindPropertiesByName(props, name, &atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetStringPropertyInternal(properties, atom, name, default_value);
+}
+
+const char *SDL_GetStringPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, const char *default_value)
+{
+    SDL_Properties *properties = SDL_FindPropertiesByAtom(props, atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetStringPropertyInternal(properties, atom, NULL, default_value);
+}
+
+Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+{
+    SDL_PropertyAtom atom = 0;
+    SDL_Properties *properties = SDL_FindPropertiesByName(props, name, &atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetNumberPropertyInternal(properties, atom, name, default_value);
+}
+
+Sint64 SDL_GetNumberPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, Sint64 default_value)
+{
+    SDL_Properties *properties = SDL_FindPropertiesByAtom(props, atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetNumberPropertyInternal(properties, atom, NULL, default_value);
+}
+
+float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+{
+    SDL_PropertyAtom atom = 0;
+    SDL_Properties *properties = SDL_FindPropertiesByName(props, name, &atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetFloatPropertyInternal(properties, atom, name, default_value);
+}
+
+float SDL_GetFloatPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, float default_value)
+{
+    SDL_Properties *properties = SDL_FindPropertiesByAtom(props, atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetFloatPropertyInternal(properties, atom, NULL, default_value);
+}
+
+SDL_bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, SDL_bool default_value)
+{
+    SDL_PropertyAtom atom = 0;
+    SDL_Properties *properties = SDL_FindPropertiesByName(props, name, &atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetBooleanPropertyInternal(properties, atom, name, default_value);
+}
+
+SDL_bool SDL_GetBooleanPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, SDL_bool default_value)
+{
+    SDL_Properties *properties = SDL_FindPropertiesByAtom(props, atom);
+    if (!properties) {
+        return default_value;
+    }
+    return SDL_GetBooleanPropertyInternal(properties, atom, NULL, default_value);
+}
+
 int SDL_ClearProperty(SDL_PropertiesID props, const char *name)
 {
     return SDL_PrivateSetProperty(props, name, NULL);
@@ -679,6 +1017,10 @@ int SDL_ClearProperty(SDL_PropertiesID props, const char *name)
 int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallback callback, void *userdata)
 {
     SDL_Properties *properties = NULL;
+    SDL_PropertyAtom *atoms = NULL;
+    int num_atoms = 0, max_atoms = 0;
+    int i, result = 0;
+    SDL_bool locked;
 
     if (!props) {
         return SDL_InvalidParamError("props");
@@ -687,36 +1029,64 @@ int SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallb
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
-    SDL_UnlockMutex(SDL_properties_lock);
-
+    properties = SDL_FindProperties(props, NULL, NULL);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_LockMutex(properties->lock);
+    /* Copy the names first, so the callback can modify the properties */
+    locked = SDL_LockPropertiesForReading(properties);
     {
         void *iter;
         const void *key, *value;
 
         iter = NULL;
         while (SDL_IterateHashTable(properties->props, &key, &value, &iter)) {
-            callback(userdata, props, (const char *)key);
+            if (num_atoms == max_atoms) {
+                int new_max = max_atoms ? (max_atoms * 2) : 16;
+                SDL_PropertyAtom *new_atoms = (SDL_PropertyAtom *)SDL_realloc(atoms, new_max * sizeof(*atoms));
+                if (!new_atoms) {
+                    result = -1;
+                    break;
+                }
+                atoms = new_atoms;
+                max_atoms = new_max;
+            }
+            atoms[num_atoms++] = (SDL_PropertyAtom)(uintptr_t)key;
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    SDL_UnlockPropertiesForReading(properties, locked);
 
-    return 0;
+    if (result == 0) {
+        for (i = 0; i < num_atoms; ++i) {
+            callback(userdata, props, SDL_GetPropertyAtomName(atoms[i]));
+        }
+    }
+    SDL_free(atoms);
+
+    return result;
 }
 
 void SDL_DestroyProperties(SDL_PropertiesID props)
 {
-    if (!props) {
+    SDL_Properties *properties = NULL;
+
+    if (!props || !SDL_properties_lock) {
         return;
     }
 
-    SDL_LockMutex(SDL_properties_lock);
-    SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props);
-    SDL_UnlockMutex(SDL_properties_lock);
+    SDL_LockRWLockForWriting(SDL_properties_lock);
+    properties = SDL_FindProperties(props, NULL, NULL);
+    if (properties) {
+        const Uint32 slot = props & SDL_PROPERTIES_SLOT_MASK;
+        SDL_PropertiesPage *page = SDL_GetPropertiesPage(slot);
+
+        SDL_AtomicSetPtr(&page->slots[slot & SDL_PROPERTIES_PAGE_MASK], NULL);
+        page->next_free[slot & SDL_PROPERTIES_PAGE_MASK] = SDL_first_free_properties_slot;
+        SDL_first_free_properties_slot = slot;
+    }
+    SDL_UnlockRWLock(SDL_properties_lock);
+
+    /* The cleanup callbacks may destroy other properties, so they run without the lock */
+    SDL_FreeProperties(NULL, properties, NULL);
 }
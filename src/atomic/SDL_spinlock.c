@@ -44,6 +44,14 @@
 #include <libkern/OSAtomic.h>
 #endif
 
+/* On Linux, threads that can't get a spinlock quickly sleep on it with a futex.
+   The lock is 2 instead of 1 while anyone might be sleeping, so unlocking
+   knows whether it has to wake them. */
+#if defined(SDL_THREAD_FUTEX) && defined(HAVE_GCC_ATOMICS) && !defined(SDL_ATOMIC_DISABLED)
+#define SDL_SPINLOCK_FUTEX
+#include "../thread/linux/SDL_sysfutex_c.h"
+#endif
+
 /* *INDENT-OFF* */ /* clang-format off */
 #if defined(__WATCOMC__) && defined(__386__)
 SDL_COMPILE_TIME_ASSERT(locksize, 4==sizeof(SDL_SpinLock));
@@ -77,6 +85,10 @@ SDL_bool SDL_AtomicTryLock(SDL_SpinLock *lock)
         return SDL_FALSE;
     }
 
+#elif defined(SDL_SPINLOCK_FUTEX)
+    /* Swapping in 1 would hide that someone is sleeping on the lock */
+    return __sync_bool_compare_and_swap(lock, 0, 1);
+
 #elif defined(HAVE_GCC_ATOMICS) || defined(HAVE_GCC_SYNC_LOCK_TEST_AND_SET)
     return __sync_lock_test_and_set(lock, 1) == 0;
 
@@ -174,15 +186,27 @@ void SDL_AtomicLock(SDL_SpinLock *lock)
             iterations++;
             SDL_CPUPauseInstruction();
         } else {
+#ifdef SDL_SPINLOCK_FUTEX
+            while (__sync_lock_test_and_set(lock, 2) != 0) {
+                SDL_FutexWait(lock, 2, -1);
+            }
+            return;
+#else
             /* !!! FIXME: this doesn't definitely give up the current timeslice, it does different things on various platforms. */
             SDL_Delay(0);
+#endif
         }
     }
 }
 
 void SDL_AtomicUnlock(SDL_SpinLock *lock)
 {
-#if defined(HAVE_GCC_ATOMICS) || defined(HAVE_GCC_SYNC_LOCK_TEST_AND_SET)
+#ifdef SDL_SPINLOCK_FUTEX
+    if (__atomic_exchange_n(lock, 0, __ATOMIC_RELEASE) == 2) {
+        SDL_FutexWake(lock, 1);
+    }
+
+#elif defined(HAVE_GCC_ATOMICS) || defined(HAVE_GCC_SYNC_LOCK_TEST_AND_SET)
     __sync_lock_release(lock);
 
 #elif defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
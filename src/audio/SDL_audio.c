@@ -801,6 +801,92 @@ static void NukeAudioDeviceHashItem(const void *key, const void *value, void *da
     // no-op, keys and values in this hashtable are treated as Plain Old Data and don't get freed here.
 }
 
+// Converting the streams bound to a playback device in parallel, on the SDL job threads.
+
+typedef struct SDL_AudioConvertJob
+{
+    SDL_LogicalAudioDevice *logdev;
+    SDL_AudioStream *stream;
+    Uint8 *buffer;
+    int buflen;
+    int result;  // return value of SDL_GetAudioStreamData
+} SDL_AudioConvertJob;
+
+static void SDLCALL ConvertAudioStreams(void *userdata, int start, int end)
+{
+    SDL_AudioConvertJob *jobs = (SDL_AudioConvertJob *)userdata;
+    for (int i = start; i < end; i++) {
+        SDL_AudioConvertJob *job = &jobs[i];
+        job->result = GetAudioStreamDataWithoutCallback(job->stream, job->buffer, job->buflen);  // the device thread already ran the get callback.
+    }
+}
+
+/* Convert every stream bound to an unpaused logical device on the job threads, into its own scratch buffer.
+   Returns the number of jobs that ran, or zero if the streams should be converted one at a time instead. */
+static int ConvertBoundStreamsInParallel(SDL_AudioDevice *device, int work_buffer_size)
+{
+    // keep each scratch buffer aligned for SIMD.
+    const int alignment = (int) SDL_SIMDGetAlignment();
+    const int stride = ((device->work_buffer_size + alignment - 1) / alignment) * alignment;
+    int num_jobs = 0;
+
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            num_jobs++;
+        }
+    }
+
+    if (num_jobs < 2) {
+        return 0;  // nothing to do in parallel.
+    }
+
+    // the buffers are reallocated if the device's buffer size changed, since the stride changes with it.
+    if ((num_jobs > device->num_convert_jobs) || (stride != device->convert_stride)) {
+        SDL_AudioConvertJob *jobs = (SDL_AudioConvertJob *)SDL_malloc(num_jobs * sizeof(*jobs));
+        Uint8 *buffers = (Uint8 *)SDL_aligned_alloc(alignment, (size_t)num_jobs * stride);
+        if (!jobs || !buffers) {
+            SDL_free(jobs);
+            SDL_aligned_free(buffers);
+            return 0;  // just do it the slow way.
+        }
+        SDL_free(device->convert_jobs);
+        SDL_aligned_free(device->convert_buffers);
+        device->convert_jobs = jobs;
+        device->convert_buffers = buffers;
+        device->num_convert_jobs = num_jobs;
+        device->convert_stride = stride;
+    }
+
+    // Paused devices are checked once here, so the mix sees the same set of streams we converted.
+    num_jobs = 0;
+    for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
+        if (SDL_AtomicGet(&logdev->paused)) {
+            continue;
+        }
+        for (SDL_AudioStream *stream = logdev->bound_streams; stream; stream = stream->next_binding) {
+            SDL_AudioConvertJob *job = &device->convert_jobs[num_jobs];
+            job->logdev = logdev;
+            job->stream = stream;
+            job->buffer = device->convert_buffers + ((size_t)num_jobs * stride);
+            job->buflen = work_buffer_size;
+            job->result = 0;
+            num_jobs++;
+        }
+    }
+
+    if (num_jobs > 0) {
+        /* Get callbacks run app code that might lock the device, which this thread holds while it
+           waits for the jobs, so they run here, one after another, before the conversions start. */
+        for (int i = 0; i < num_jobs; i++) {
+            RequestAudioStreamData(device->convert_jobs[i].stream, work_buffer_size);
+        }
+
+        SDL_ParallelFor(0, num_jobs, 1, ConvertAudioStreams, device->convert_jobs);
+    }
+
+    return num_jobs;
+}
+
 // !!! FIXME: the video subsystem does SDL_VideoInit, not SDL_InitVideo. Make this match.
 int SDL_InitAudio(const char *driver_name)
 {
@@ -913,6 +999,8 @@ int SDL_InitAudio(const char *driver_name)
 
     CompleteAudioEntryPoints();
 
+    current_audio.parallel_convert = SDL_GetHintBoolean(SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT, SDL_FALSE);
+
     // Make sure we have a list of devices available at startup...
     SDL_AudioDevice *default_output = NULL;
     SDL_AudioDevice *default_capture = NULL;
@@ -1062,8 +1150,17 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
 
             SDL_memset(final_mix_buffer, '\0', work_buffer_size);  // start with silence.
 
+            // When converting in parallel, convert all the streams up front, then mix them in the same order as below.
+            const int num_jobs = current_audio.parallel_convert ? ConvertBoundStreamsInParallel(device, work_buffer_size) : 0;
+            int job = 0;
+
             for (SDL_LogicalAudioDevice *logdev = device->logical_devices; logdev; logdev = logdev->next) {
-                if (SDL_AtomicGet(&logdev->paused)) {
+                if (num_jobs > 0) {
+                    // only use the converted streams; this logical device might have been (un)paused since then.
+                    if ((job >= num_jobs || device->convert_jobs[job].logdev != logdev) && (logdev->bound_streams || SDL_AtomicGet(&logdev->paused))) {
+                        continue;
+                    }
+                } else if (SDL_AtomicGet(&logdev->paused)) {
                     continue;  // paused? Skip this logical device.
                 }
 
@@ -1082,12 +1179,22 @@ SDL_bool SDL_OutputAudioThreadIterate(SDL_AudioDevice *device)
                        for iterating here because the binding linked list can only change while the device lock is held.
                        (we _do_ lock the stream during binding/unbinding to make sure that two threads can't try to bind
                        the same stream to different devices at the same time, though.) */
-                    const int br = SDL_GetAudioStreamData(stream, device->work_buffer, work_buffer_size);
+                    const Uint8 *stream_buffer = device->work_buffer;
+                    int br;
+                    if (num_jobs > 0) {
+                        SDL_assert(device->convert_jobs[job].stream == stream);
+                        stream_buffer = device->convert_jobs[job].buffer;
+                        br = device->convert_jobs[job].result;
+                        job++;
+                    } else {
+                        br = SDL_GetAudioStreamData(stream, device->work_buffer, work_buffer_size);
+                    }
+
                     if (br < 0) {  // Probably OOM. Kill the audio device; the whole thing is likely dying soon anyhow.
                         failed = SDL_TRUE;
                         break;
                     } else if (br > 0) {  // it's okay if we get less than requested, we mix what we have.
-                        MixFloat32Audio(mix_buffer, (float *) device->work_buffer, br);
+                        MixFloat32Audio(mix_buffer, (const float *) stream_buffer, br);
                     }
                 }
 
@@ -1432,6 +1539,13 @@ static void ClosePhysicalAudioDevice(SDL_AudioDevice *device)
     SDL_aligned_free(device->postmix_buffer);
     device->postmix_buffer = NULL;
 
+    SDL_aligned_free(device->convert_buffers);
+    device->convert_buffers = NULL;
+    SDL_free(device->convert_jobs);
+    device->convert_jobs = NULL;
+    device->num_convert_jobs = 0;
+    device->convert_stride = 0;
+
     SDL_copyp(&device->spec, &device->default_spec);
     device->sample_frames = 0;
     device->silence_value = SDL_GetSilenceValueForFormat(device->spec.format);
@@ -377,6 +377,21 @@ static Sint64 GetAudioStreamResampleRate(SDL_AudioStream* stream, int src_freq,
     return resample_rate;
 }
 
+// Returns the polyphase filters for resampling at this rate, (re)building them if the rates changed.
+static const SDL_ResamplerPolyphase *GetAudioStreamPolyphase(SDL_AudioStream *stream, int src_freq, int dst_freq, Sint64 resample_rate)
+{
+    if (stream->freq_ratio != 1.0f) {
+        return NULL;  // arbitrary ratios rarely reduce to a small number of phases.
+    }
+
+    if (!stream->polyphase || (stream->polyphase->resample_rate != resample_rate)) {
+        SDL_DestroyResamplerPolyphase(stream->polyphase);
+        stream->polyphase = SDL_CreateResamplerPolyphase(src_freq, dst_freq);
+    }
+
+    return stream->polyphase;
+}
+
 static int UpdateAudioStreamInputSpec(SDL_AudioStream *stream, const SDL_AudioSpec *spec)
 {
     if (AUDIO_SPECS_EQUAL(stream->input_spec, *spec)) {
@@ -614,6 +629,51 @@ int SDL_SetAudioStreamFrequencyRatio(SDL_AudioStream *stream, float freq_ratio)
     return 0;
 }
 
+// How many chunks a single producer can put before it has to wait for the stream lock.
+#define AUDIO_STREAM_RING_SLOTS 64
+
+// Move anything the single producer put into the ring over to the queue.
+// REQUIRES: The stream lock must be held
+static int DrainAudioStreamRing(SDL_AudioStream *stream)
+{
+    if (!stream->ring) {
+        return 0;
+    }
+
+    size_t len = 0;
+    const int retval = SDL_DrainAudioRing(stream->ring, stream->queue, &len);
+    stream->total_bytes_queued += len;
+    return retval;
+}
+
+int SDL_SetAudioStreamSingleProducer(SDL_AudioStream *stream, SDL_bool single_producer)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+
+    int retval = 0;
+
+    SDL_LockMutex(stream->lock);
+
+    if (single_producer && !stream->ring) {
+        stream->ring = SDL_CreateAudioRing(SDL_GetAudioQueueChunkSize(stream->queue), AUDIO_STREAM_RING_SLOTS);
+        if (!stream->ring) {
+            retval = -1;
+        }
+    } else if (!single_producer && stream->ring) {
+        retval = DrainAudioStreamRing(stream);
+        if (retval == 0) {
+            SDL_DestroyAudioRing(stream->ring);
+            stream->ring = NULL;
+        }
+    }
+
+    SDL_UnlockMutex(stream->lock);
+
+    return retval;
+}
+
 static int CheckAudioStreamIsFullySetup(SDL_AudioStream *stream)
 {
     if (stream->src_spec.format == 0) {
@@ -641,6 +701,22 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return 0; // nothing to do.
     }
 
+    // In single producer mode, hand the data over without touching the lock, so we never wait on the consumer (or make it wait on us).
+    if (stream->ring && !stream->put_callback) {
+        SDL_AudioSpec src_spec;
+        SDL_copyp(&src_spec, &stream->src_spec);
+
+        if (src_spec.format == 0) {
+            return SDL_SetError("Stream has no source format");
+        } else if ((len % SDL_AUDIO_FRAMESIZE(src_spec)) != 0) {
+            return SDL_SetError("Can't add partial sample frames");
+        } else if (SDL_WriteToAudioRing(stream->ring, &src_spec, buf, len)) {
+            return 0;
+        }
+
+        // The ring is full, so the consumer is falling behind anyhow. Queue it the usual way.
+    }
+
     SDL_LockMutex(stream->lock);
 
     if (CheckAudioStreamIsFullySetup(stream) != 0) {
@@ -653,6 +729,12 @@ int SDL_PutAudioStreamData(SDL_AudioStream *stream, const void *buf, int len)
         return SDL_SetError("Can't add partial sample frames");
     }
 
+    // Anything already in the ring has to go first. Only this thread puts data there, so nothing new can arrive meanwhile.
+    if (DrainAudioStreamRing(stream) != 0) {
+        SDL_UnlockMutex(stream->lock);
+        return -1;
+    }
+
     SDL_AudioTrack* track = NULL;
 
     // When copying in large amounts of data, try and do as much work as possible
@@ -705,6 +787,7 @@ int SDL_FlushAudioStream(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    DrainAudioStreamRing(stream);
     SDL_FlushAudioQueue(stream->queue);
     SDL_UnlockMutex(stream->lock);
 
@@ -1004,7 +1087,8 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
     SDL_ResampleAudio(resample_channels,
                   (const float *) input_buffer, input_frames,
                   (float*) resample_buffer, output_frames,
-                  resample_rate, &stream->resample_offset);
+                  resample_rate, &stream->resample_offset,
+                  GetAudioStreamPolyphase(stream, src_spec->freq, dst_spec->freq, resample_rate));
 
     // Convert to the final format, if necessary
     if (buf != resample_buffer) {
@@ -1015,7 +1099,45 @@ static int GetAudioStreamDataInternal(SDL_AudioStream *stream, void *buf, int ou
 }
 
 // get converted/resampled data from the stream
-int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
+// Give the get callback a chance to fill in more stream data for `len` bytes of output. Called with the stream locked.
+static void CallAudioStreamGetCallback(SDL_AudioStream *stream, int len)
+{
+    if (stream->get_callback) {
+        const int dst_frame_size = SDL_AUDIO_FRAMESIZE(stream->dst_spec);
+        Sint64 total_request = len / dst_frame_size;  // start with sample frames desired
+        Sint64 additional_request = total_request;
+
+        Sint64 resample_offset = 0;
+        Sint64 available_frames = GetAudioStreamAvailableFrames(stream, &resample_offset);
+
+        additional_request -= SDL_min(additional_request, available_frames);
+
+        Sint64 resample_rate = GetAudioStreamResampleRate(stream, stream->src_spec.freq, resample_offset);
+
+        if (resample_rate) {
+            total_request = SDL_GetResamplerInputFrames(total_request, resample_rate, resample_offset);
+            additional_request = SDL_GetResamplerInputFrames(additional_request, resample_rate, resample_offset);
+        }
+
+        total_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
+        additional_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
+        stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
+        DrainAudioStreamRing(stream);  // in case the callback put data in single producer mode.
+    }
+}
+
+void RequestAudioStreamData(SDL_AudioStream *stream, int len)
+{
+    SDL_LockMutex(stream->lock);
+    if (CheckAudioStreamIsFullySetup(stream) == 0) {
+        len -= len % SDL_AUDIO_FRAMESIZE(stream->dst_spec);  // chop off any fractional sample frame.
+        DrainAudioStreamRing(stream);
+        CallAudioStreamGetCallback(stream, len);
+    }
+    SDL_UnlockMutex(stream->lock);
+}
+
+static int GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len, SDL_bool call_get_callback)
 {
     Uint8 *buf = (Uint8 *) voidbuf;
 
@@ -1044,26 +1166,11 @@ int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
 
     len -= len % dst_frame_size;  // chop off any fractional sample frame.
 
-    // give the callback a chance to fill in more stream data if it wants.
-    if (stream->get_callback) {
-        Sint64 total_request = len / dst_frame_size;  // start with sample frames desired
-        Sint64 additional_request = total_request;
+    DrainAudioStreamRing(stream);
 
-        Sint64 resample_offset = 0;
-        Sint64 available_frames = GetAudioStreamAvailableFrames(stream, &resample_offset);
-
-        additional_request -= SDL_min(additional_request, available_frames);
-
-        Sint64 resample_rate = GetAudioStreamResampleRate(stream, stream->src_spec.freq, resample_offset);
-
-        if (resample_rate) {
-            total_request = SDL_GetResamplerInputFrames(total_request, resample_rate, resample_offset);
-            additional_request = SDL_GetResamplerInputFrames(additional_request, resample_rate, resample_offset);
-        }
-
-        total_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
-        additional_request *= SDL_AUDIO_FRAMESIZE(stream->src_spec);  // convert sample frames to bytes.
-        stream->get_callback(stream->get_callback_userdata, stream, (int) SDL_min(additional_request, SDL_INT_MAX), (int) SDL_min(total_request, SDL_INT_MAX));
+    // give the callback a chance to fill in more stream data if it wants.
+    if (call_get_callback) {
+        CallAudioStreamGetCallback(stream, len);
     }
 
     // Process the data in chunks to avoid allocating too much memory (and potential integer overflows)
@@ -1116,6 +1223,16 @@ int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
     return total;
 }
 
+int SDL_GetAudioStreamData(SDL_AudioStream *stream, void *voidbuf, int len)
+{
+    return GetAudioStreamData(stream, voidbuf, len, SDL_TRUE);
+}
+
+int GetAudioStreamDataWithoutCallback(SDL_AudioStream *stream, void *voidbuf, int len)
+{
+    return GetAudioStreamData(stream, voidbuf, len, SDL_FALSE);
+}
+
 // number of converted/resampled bytes available for output
 int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
 {
@@ -1130,6 +1247,8 @@ int SDL_GetAudioStreamAvailable(SDL_AudioStream *stream)
         return 0;
     }
 
+    DrainAudioStreamRing(stream);
+
     Sint64 count = GetAudioStreamAvailableFrames(stream, NULL);
 
     // convert from sample frames to bytes in destination format.
@@ -1149,6 +1268,7 @@ int SDL_GetAudioStreamQueued(SDL_AudioStream *stream)
     }
 
     SDL_LockMutex(stream->lock);
+    DrainAudioStreamRing(stream);
     const Uint64 total = stream->total_bytes_queued;
     SDL_UnlockMutex(stream->lock);
 
@@ -1164,6 +1284,9 @@ int SDL_ClearAudioStream(SDL_AudioStream *stream)
 
     SDL_LockMutex(stream->lock);
 
+    if (stream->ring) {
+        SDL_ClearAudioRing(stream->ring);
+    }
     SDL_ClearAudioQueue(stream->queue);
     SDL_zero(stream->input_spec);
     stream->resample_offset = 0;
@@ -1195,6 +1318,8 @@ void SDL_DestroyAudioStream(SDL_AudioStream *stream)
 
     SDL_aligned_free(stream->history_buffer);
     SDL_aligned_free(stream->work_buffer);
+    SDL_DestroyResamplerPolyphase(stream->polyphase);
+    SDL_DestroyAudioRing(stream->ring);
     SDL_DestroyAudioQueue(stream->queue);
     SDL_DestroyMutex(stream->lock);
 
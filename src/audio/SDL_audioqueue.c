@@ -512,3 +512,122 @@ int SDL_PeekIntoAudioQueue(SDL_AudioQueue *queue, Uint8 *data, size_t len)
         track = track->next;
     }
 }
+
+typedef struct SDL_AudioRingSlot
+{
+    SDL_AudioSpec spec;
+    size_t len;
+} SDL_AudioRingSlot;
+
+struct SDL_AudioRing
+{
+    SDL_AtomicInt head;  // next slot to read, only changed by the consumer.
+    SDL_AtomicInt tail;  // next slot to write, only changed by the producer.
+    int num_slots;  // a power of two
+    size_t slot_size;
+    SDL_AudioRingSlot *slots;
+    Uint8 *data;
+};
+
+SDL_AudioRing *SDL_CreateAudioRing(size_t slot_size, int num_slots)
+{
+    SDL_assert(num_slots > 0 && (num_slots & (num_slots - 1)) == 0);
+
+    SDL_AudioRing *ring = (SDL_AudioRing *)SDL_calloc(1, sizeof(*ring));
+
+    if (!ring) {
+        return NULL;
+    }
+
+    ring->num_slots = num_slots;
+    ring->slot_size = slot_size;
+    ring->slots = (SDL_AudioRingSlot *)SDL_calloc(num_slots, sizeof(*ring->slots));
+    ring->data = (Uint8 *)SDL_malloc(slot_size * num_slots);
+
+    if (!ring->slots || !ring->data) {
+        SDL_DestroyAudioRing(ring);
+        return NULL;
+    }
+
+    return ring;
+}
+
+void SDL_DestroyAudioRing(SDL_AudioRing *ring)
+{
+    if (ring) {
+        SDL_free(ring->slots);
+        SDL_free(ring->data);
+        SDL_free(ring);
+    }
+}
+
+SDL_bool SDL_WriteToAudioRing(SDL_AudioRing *ring, const SDL_AudioSpec *spec, const Uint8 *data, size_t len)
+{
+    const Uint32 mask = (Uint32)ring->num_slots - 1;
+    const size_t slots_needed = (len + ring->slot_size - 1) / ring->slot_size;
+    Uint32 tail = (Uint32)SDL_AtomicGet(&ring->tail);
+    const Uint32 head = (Uint32)SDL_AtomicGet(&ring->head);
+
+    // The consumer only ever frees up more space, so if it fits now, it will still fit after copying.
+    if (slots_needed > (size_t)ring->num_slots - (tail - head)) {
+        return SDL_FALSE;
+    }
+
+    // Don't overwrite slots before the consumer is done reading them.
+    SDL_MemoryBarrierAcquire();
+
+    while (len > 0) {
+        const size_t cpy = SDL_min(len, ring->slot_size);
+        SDL_AudioRingSlot *slot = &ring->slots[tail & mask];
+
+        SDL_copyp(&slot->spec, spec);
+        slot->len = cpy;
+        SDL_memcpy(&ring->data[(tail & mask) * ring->slot_size], data, cpy);
+
+        data += cpy;
+        len -= cpy;
+        ++tail;
+    }
+
+    // Publish all the slots at once, so the consumer never sees part of a write.
+    // SDL_AtomicSet() isn't a release barrier everywhere, so the copies need one first.
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->tail, (int)tail);
+
+    return SDL_TRUE;
+}
+
+int SDL_DrainAudioRing(SDL_AudioRing *ring, SDL_AudioQueue *queue, size_t *out_len)
+{
+    const Uint32 mask = (Uint32)ring->num_slots - 1;
+    const Uint32 tail = (Uint32)SDL_AtomicGet(&ring->tail);
+    Uint32 head = (Uint32)SDL_AtomicGet(&ring->head);
+    int retval = 0;
+
+    *out_len = 0;
+
+    // Don't read the slots before the producer's writes to them are visible.
+    SDL_MemoryBarrierAcquire();
+
+    while (head != tail) {
+        const SDL_AudioRingSlot *slot = &ring->slots[head & mask];
+
+        retval = SDL_WriteToAudioQueue(queue, &slot->spec, &ring->data[(head & mask) * ring->slot_size], slot->len);
+
+        if (retval != 0) {
+            break;  // leave the rest for next time.
+        }
+
+        *out_len += slot->len;
+        ++head;
+        SDL_MemoryBarrierRelease();  // finish reading the slot before the producer can reuse it.
+        SDL_AtomicSet(&ring->head, (int)head);
+    }
+
+    return retval;
+}
+
+void SDL_ClearAudioRing(SDL_AudioRing *ring)
+{
+    SDL_AtomicSet(&ring->head, SDL_AtomicGet(&ring->tail));
+}
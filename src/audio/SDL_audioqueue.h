@@ -74,4 +74,26 @@ int SDL_ReadFromAudioQueue(SDL_AudioQueue *queue, Uint8 *data, size_t len);
 // REQUIRES: There must be enough data in the queue, unless it has been flushed, in which case missing data is filled with silence.
 int SDL_PeekIntoAudioQueue(SDL_AudioQueue *queue, Uint8 *data, size_t len);
 
+// A wait-free ring of chunks, for one producer thread to hand data to a consumer without taking locks.
+typedef struct SDL_AudioRing SDL_AudioRing;
+
+// Create a ring of `num_slots` chunks of `slot_size` bytes each
+// REQUIRES: `num_slots` must be a power of two
+SDL_AudioRing *SDL_CreateAudioRing(size_t slot_size, int num_slots);
+
+// Destroy a ring, discarding anything left in it
+void SDL_DestroyAudioRing(SDL_AudioRing *ring);
+
+// Write data to the end of the ring, or nothing at all if it doesn't fit
+// This must only be called from the producer thread, and never blocks
+SDL_bool SDL_WriteToAudioRing(SDL_AudioRing *ring, const SDL_AudioSpec *spec, const Uint8 *data, size_t len);
+
+// Move everything in the ring to the end of the queue, and report how many bytes were moved
+// REQUIRES: Only one consumer may drain or clear the ring at a time
+int SDL_DrainAudioRing(SDL_AudioRing *ring, SDL_AudioQueue *queue, size_t *out_len);
+
+// Discard everything currently in the ring
+// REQUIRES: Only one consumer may drain or clear the ring at a time
+void SDL_ClearAudioRing(SDL_AudioRing *ring);
+
 #endif // SDL_audioqueue_h_
@@ -39,16 +39,19 @@
 
 #define RESAMPLER_FULL_FILTER_SIZE (RESAMPLER_SAMPLES_PER_FRAME * (RESAMPLER_SAMPLES_PER_ZERO_CROSSING + 1))
 
-static void ResampleFrame_Scalar(const float *src, float *dst, const float *raw_filter, float interp, int chans)
-{
-    int i, chan;
+// How many output frames are set up before handing them to ResampleFrames()
+#define RESAMPLER_BLOCK_FRAMES 64
 
-    float filter[RESAMPLER_SAMPLES_PER_FRAME];
+// The largest polyphase table: 44.1kHz <-> 48kHz needs 147 or 160 phases, 11.025kHz -> 48kHz needs 640.
+#define RESAMPLER_MAX_POLYPHASE_PHASES 1024
 
-    // Interpolate between the nearest two filters
-    for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
-        filter[i] = (raw_filter[i] * (1.0f - interp)) + (raw_filter[i + RESAMPLER_SAMPLES_PER_FRAME] * interp);
-    }
+// How far (in 1/2^32 of a frame) the position may be from a phase, to use the polyphase table
+#define RESAMPLER_POLYPHASE_TOLERANCE (1 << 20)
+
+// Apply an already interpolated filter to one frame of each channel
+static void ApplyFilter_Scalar(const float *src, float *dst, const float *filter, int chans)
+{
+    int i, chan;
 
     if (chans == 2) {
         float out[2];
@@ -88,29 +91,39 @@ static void ResampleFrame_Scalar(const float *src, float *dst, const float *raw_
     }
 }
 
+// Resample `frames` output frames. If `interp` is NULL, each filter is already interpolated (from a polyphase table).
+static void ResampleFrames_Scalar(const float *const *src, const float *const *raw_filter, const float *interp, int frames, float *dst, int chans)
+{
+    float filter[RESAMPLER_SAMPLES_PER_FRAME];
+    int i, frame;
+
+    for (frame = 0; frame < frames; frame++) {
+        if (interp) {
+            const float *raw = raw_filter[frame];
+            const float t = interp[frame];
+
+            // Interpolate between the nearest two filters
+            for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
+                filter[i] = (raw[i] * (1.0f - t)) + (raw[i + RESAMPLER_SAMPLES_PER_FRAME] * t);
+            }
+            ApplyFilter_Scalar(src[frame], dst, filter, chans);
+        } else {
+            ApplyFilter_Scalar(src[frame], dst, raw_filter[frame], chans);
+        }
+
+        dst += chans;
+    }
+}
+
 #ifdef SDL_SSE_INTRINSICS
-static void SDL_TARGETING("sse") ResampleFrame_SSE(const float *src, float *dst, const float *raw_filter, float interp, int chans)
+// Apply the filter in f0, f1 and f2 to one frame of each channel
+static void SDL_TARGETING("sse") ApplyFilter_SSE(const float *src, float *dst, __m128 f0, __m128 f1, __m128 f2, int chans)
 {
 #if RESAMPLER_SAMPLES_PER_FRAME != 10
 #error Invalid samples per frame
 #endif
 
-    // Load the filter
-    __m128 f0 = _mm_loadu_ps(raw_filter + 0);
-    __m128 f1 = _mm_loadu_ps(raw_filter + 4);
-    __m128 f2 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(raw_filter + 8));
-
-    __m128 g0 = _mm_loadu_ps(raw_filter + 10);
-    __m128 g1 = _mm_loadu_ps(raw_filter + 14);
-    __m128 g2 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(raw_filter + 18));
-
-    __m128 interp1 = _mm_set1_ps(interp);
-    __m128 interp2 = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_set1_ps(interp));
-
-    // Linear interpolate the filter
-    f0 = _mm_add_ps(_mm_mul_ps(f0, interp2), _mm_mul_ps(g0, interp1));
-    f1 = _mm_add_ps(_mm_mul_ps(f1, interp2), _mm_mul_ps(g1, interp1));
-    f2 = _mm_add_ps(_mm_mul_ps(f2, interp2), _mm_mul_ps(g2, interp1));
+    __m128 g0, g1;
 
     if (chans == 2) {
         // Duplicate each of the filter elements
@@ -179,9 +192,185 @@ static void SDL_TARGETING("sse") ResampleFrame_SSE(const float *src, float *dst,
         _mm_store_ss(&dst[chan], f0);
     }
 }
+
+static void SDL_TARGETING("sse") ResampleFrames_SSE(const float *const *src, const float *const *raw_filter, const float *interp, int frames, float *dst, int chans)
+{
+    int frame;
+
+    for (frame = 0; frame < frames; frame++) {
+        const float *raw = raw_filter[frame];
+
+        // Load the filter
+        __m128 f0 = _mm_loadu_ps(raw + 0);
+        __m128 f1 = _mm_loadu_ps(raw + 4);
+        __m128 f2 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(raw + 8));
+
+        if (interp) {
+            __m128 g0 = _mm_loadu_ps(raw + 10);
+            __m128 g1 = _mm_loadu_ps(raw + 14);
+            __m128 g2 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(raw + 18));
+
+            __m128 interp1 = _mm_set1_ps(interp[frame]);
+            __m128 interp2 = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_set1_ps(interp[frame]));
+
+            // Linear interpolate the filter
+            f0 = _mm_add_ps(_mm_mul_ps(f0, interp2), _mm_mul_ps(g0, interp1));
+            f1 = _mm_add_ps(_mm_mul_ps(f1, interp2), _mm_mul_ps(g1, interp1));
+            f2 = _mm_add_ps(_mm_mul_ps(f2, interp2), _mm_mul_ps(g2, interp1));
+        }
+
+        ApplyFilter_SSE(src[frame], dst, f0, f1, f2, chans);
+        dst += chans;
+    }
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") ResampleFrames_AVX2(const float *const *src, const float *const *raw_filter, const float *interp, int frames, float *dst, int chans)
+{
+    // Taps 8 and 9 of the filter, and the channels in the last partial group of 8
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i taps_mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(RESAMPLER_SAMPLES_PER_FRAME - 8), lane);
+    const __m256i chans_mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(chans & 7), lane);
+    float filter[RESAMPLER_SAMPLES_PER_FRAME];
+    int frame = 0;
+    int i;
+
+    if (chans == 1) {
+        // Mono: four output frames at a time, one filter per frame, summed together at the end.
+        for (; frame + 4 <= frames; frame += 4) {
+            __m256 sums[4];
+
+            for (i = 0; i < 4; i++) {
+                const float *raw = raw_filter[frame + i];
+                __m256 f0 = _mm256_loadu_ps(raw);
+                __m256 f1 = _mm256_maskload_ps(raw + 8, taps_mask);
+
+                if (interp) {
+                    const __m256 t = _mm256_set1_ps(interp[frame + i]);
+                    f0 = _mm256_add_ps(f0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(raw + RESAMPLER_SAMPLES_PER_FRAME), f0), t));
+                    f1 = _mm256_add_ps(f1, _mm256_mul_ps(_mm256_sub_ps(_mm256_maskload_ps(raw + RESAMPLER_SAMPLES_PER_FRAME + 8, taps_mask), f1), t));
+                }
+
+                sums[i] = _mm256_add_ps(_mm256_mul_ps(f0, _mm256_loadu_ps(src[frame + i])),
+                                        _mm256_mul_ps(f1, _mm256_maskload_ps(src[frame + i] + 8, taps_mask)));
+            }
+
+            // Reduce each frame's sum to one lane: frame N ends up in lanes N and N + 4
+            const __m256 s = _mm256_hadd_ps(_mm256_hadd_ps(sums[0], sums[1]), _mm256_hadd_ps(sums[2], sums[3]));
+            _mm_storeu_ps(&dst[frame], _mm_add_ps(_mm256_castps256_ps128(s), _mm256_extractf128_ps(s, 1)));
+        }
+    }
+
+    for (; frame < frames; frame++) {
+        const float *raw = raw_filter[frame];
+        const float *frame_src = src[frame];
+        float *frame_dst = &dst[frame * chans];
+        const float *f = raw;
+        int chan = 0;
+
+        if (interp) {
+            const __m256 t = _mm256_set1_ps(interp[frame]);
+            __m256 f0 = _mm256_loadu_ps(raw);
+            __m256 f1 = _mm256_maskload_ps(raw + 8, taps_mask);
+            f0 = _mm256_add_ps(f0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(raw + RESAMPLER_SAMPLES_PER_FRAME), f0), t));
+            f1 = _mm256_add_ps(f1, _mm256_mul_ps(_mm256_sub_ps(_mm256_maskload_ps(raw + RESAMPLER_SAMPLES_PER_FRAME + 8, taps_mask), f1), t));
+            _mm256_storeu_ps(filter, f0);
+            _mm256_maskstore_ps(filter + 8, taps_mask, f1);
+            f = filter;
+        }
+
+        // Eight channels at a time, with two sums to shorten the dependency chain
+        for (; chan + 8 <= chans; chan += 8) {
+            __m256 sum0 = _mm256_mul_ps(_mm256_loadu_ps(&frame_src[chan]), _mm256_broadcast_ss(&f[0]));
+            __m256 sum1 = _mm256_mul_ps(_mm256_loadu_ps(&frame_src[chans + chan]), _mm256_broadcast_ss(&f[1]));
+
+            for (i = 2; i < RESAMPLER_SAMPLES_PER_FRAME; i += 2) {
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(&frame_src[i * chans + chan]), _mm256_broadcast_ss(&f[i])));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(&frame_src[(i + 1) * chans + chan]), _mm256_broadcast_ss(&f[i + 1])));
+            }
+
+            _mm256_storeu_ps(&frame_dst[chan], _mm256_add_ps(sum0, sum1));
+        }
+
+        if (chan < chans) {
+            __m256 sum0 = _mm256_mul_ps(_mm256_maskload_ps(&frame_src[chan], chans_mask), _mm256_broadcast_ss(&f[0]));
+            __m256 sum1 = _mm256_mul_ps(_mm256_maskload_ps(&frame_src[chans + chan], chans_mask), _mm256_broadcast_ss(&f[1]));
+
+            for (i = 2; i < RESAMPLER_SAMPLES_PER_FRAME; i += 2) {
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_maskload_ps(&frame_src[i * chans + chan], chans_mask), _mm256_broadcast_ss(&f[i])));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_maskload_ps(&frame_src[(i + 1) * chans + chan], chans_mask), _mm256_broadcast_ss(&f[i + 1])));
+            }
+
+            _mm256_maskstore_ps(&frame_dst[chan], chans_mask, _mm256_add_ps(sum0, sum1));
+        }
+    }
+}
 #endif
 
-static void (*ResampleFrame)(const float *src, float *dst, const float *raw_filter, float interp, int chans);
+#ifdef SDL_NEON_INTRINSICS
+static void ResampleFrames_NEON(const float *const *src, const float *const *raw_filter, const float *interp, int frames, float *dst, int chans)
+{
+    float filter[12];  // padded to a whole number of vectors
+    int frame, i;
+
+    for (frame = 0; frame < frames; frame++) {
+        const float *raw = raw_filter[frame];
+        const float *frame_src = src[frame];
+        float32x4_t f0 = vld1q_f32(raw);
+        float32x4_t f1 = vld1q_f32(raw + 4);
+        float32x4_t f2 = vcombine_f32(vld1_f32(raw + 8), vdup_n_f32(0.0f));
+        int chan = 0;
+
+        if (interp) {
+            const float t = interp[frame];
+            f0 = vmlaq_n_f32(f0, vsubq_f32(vld1q_f32(raw + 10), f0), t);
+            f1 = vmlaq_n_f32(f1, vsubq_f32(vld1q_f32(raw + 14), f1), t);
+            f2 = vmlaq_n_f32(f2, vsubq_f32(vcombine_f32(vld1_f32(raw + 18), vdup_n_f32(0.0f)), f2), t);
+        }
+
+        if (chans == 1) {
+            float32x4_t sum = vmulq_f32(f0, vld1q_f32(frame_src));
+            float32x2_t sum2;
+
+            sum = vmlaq_f32(sum, f1, vld1q_f32(frame_src + 4));
+            sum = vmlaq_f32(sum, f2, vcombine_f32(vld1_f32(frame_src + 8), vdup_n_f32(0.0f)));
+            sum2 = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+            dst[0] = vget_lane_f32(vpadd_f32(sum2, sum2), 0);
+            dst += 1;
+            continue;
+        }
+
+        vst1q_f32(filter, f0);
+        vst1q_f32(filter + 4, f1);
+        vst1q_f32(filter + 8, f2);
+
+        for (; chan + 4 <= chans; chan += 4) {
+            float32x4_t sum = vmulq_n_f32(vld1q_f32(&frame_src[chan]), filter[0]);
+
+            for (i = 1; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
+                sum = vmlaq_n_f32(sum, vld1q_f32(&frame_src[i * chans + chan]), filter[i]);
+            }
+
+            vst1q_f32(&dst[chan], sum);
+        }
+
+        for (; chan < chans; chan++) {
+            float sum = 0.0f;
+
+            for (i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
+                sum += frame_src[i * chans + chan] * filter[i];
+            }
+
+            dst[chan] = sum;
+        }
+
+        dst += chans;
+    }
+}
+#endif
+
+static void (*ResampleFrames)(const float *const *src, const float *const *raw_filter, const float *interp, int frames, float *dst, int chans);
 
 static float FullResamplerFilter[RESAMPLER_FULL_FILTER_SIZE];
 
@@ -214,11 +403,23 @@ void SDL_SetupAudioResampler(void)
         FullResamplerFilter[rwing] = 0.0f;
     }
 
-    ResampleFrame = ResampleFrame_Scalar;
+    ResampleFrames = ResampleFrames_Scalar;
 
 #ifdef SDL_SSE_INTRINSICS
     if (SDL_HasSSE()) {
-        ResampleFrame = ResampleFrame_SSE;
+        ResampleFrames = ResampleFrames_SSE;
+    }
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        ResampleFrames = ResampleFrames_AVX2;
+    }
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        ResampleFrames = ResampleFrames_NEON;
     }
 #endif
 
@@ -307,28 +508,163 @@ Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, S
     return output_frames;
 }
 
+SDL_ResamplerPolyphase *SDL_CreateResamplerPolyphase(int src_rate, int dst_rate)
+{
+    int a = src_rate, b = dst_rate;
+
+    if (src_rate <= 0 || dst_rate <= 0 || src_rate == dst_rate) {
+        return NULL;
+    }
+
+    while (b) {
+        const int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    // Output frame N is at input position N * src_step / phases.
+    const int src_step = src_rate / a;
+    const int phases = dst_rate / a;
+    if (phases > RESAMPLER_MAX_POLYPHASE_PHASES) {
+        return NULL;  // not worth a table; the filter is interpolated for each frame instead.
+    }
+
+    SDL_ResamplerPolyphase *polyphase = (SDL_ResamplerPolyphase *)SDL_malloc(sizeof(*polyphase));
+    if (!polyphase) {
+        return NULL;
+    }
+    polyphase->filters = (float *)SDL_malloc((phases + 1) * RESAMPLER_SAMPLES_PER_FRAME * sizeof(float));
+    if (!polyphase->filters) {
+        SDL_free(polyphase);
+        return NULL;
+    }
+    polyphase->resample_rate = SDL_GetResampleRate(src_rate, dst_rate);
+    polyphase->src_step = src_step;
+    polyphase->phases = phases;
+
+    // There's one extra phase for a fraction of exactly 1.0, see SDL_ResampleAudio().
+    for (int phase = 0; phase <= phases; phase++) {
+        const float *raw;
+        float interp;
+
+        if (phase == phases) {
+            raw = &FullResamplerFilter[(RESAMPLER_SAMPLES_PER_ZERO_CROSSING - 1) * RESAMPLER_SAMPLES_PER_FRAME];
+            interp = 1.0f;
+        } else {
+            const Uint32 srcfraction = (Uint32)(((Uint64)phase << 32) / phases);
+            raw = &FullResamplerFilter[(srcfraction >> RESAMPLER_FILTER_INTERP_BITS) * RESAMPLER_SAMPLES_PER_FRAME];
+            interp = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+        }
+
+        float *filter = &polyphase->filters[phase * RESAMPLER_SAMPLES_PER_FRAME];
+        for (int i = 0; i < RESAMPLER_SAMPLES_PER_FRAME; i++) {
+            filter[i] = (raw[i] * (1.0f - interp)) + (raw[i + RESAMPLER_SAMPLES_PER_FRAME] * interp);
+        }
+    }
+
+    return polyphase;
+}
+
+void SDL_DestroyResamplerPolyphase(SDL_ResamplerPolyphase *polyphase)
+{
+    if (polyphase) {
+        SDL_free(polyphase->filters);
+        SDL_free(polyphase);
+    }
+}
+
+static SDL_bool ResampleAudioPolyphase(int chans, const float *src, int inframes, float *dst, int outframes,
+                                       Sint64 resample_rate, Sint64 *inout_resample_offset, const SDL_ResamplerPolyphase *polyphase)
+{
+    const float *frame_src[RESAMPLER_BLOCK_FRAMES];
+    const float *frame_filter[RESAMPLER_BLOCK_FRAMES];
+    const Uint32 phases = (Uint32)polyphase->phases;
+    const Uint32 src_step = (Uint32)polyphase->src_step;
+    Sint64 srcpos = *inout_resample_offset;
+    int i;
+
+    // Find the nearest phase. Unless something else moved the stream, we're exactly on it, since we put it there last time.
+    Sint64 exact_index = srcpos >> 32;
+    const Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+    Uint32 phase = (Uint32)((((Uint64)srcfraction * phases) + 0x80000000) >> 32);
+    const Sint64 error = (Sint64)srcfraction - (Sint64)(((Uint64)phase << 32) / phases);
+    if (error < -RESAMPLER_POLYPHASE_TOLERANCE || error > RESAMPLER_POLYPHASE_TOLERANCE) {
+        return SDL_FALSE;
+    }
+    if (phase == phases) {
+        exact_index++;
+        phase = 0;
+    }
+
+    while (outframes > 0) {
+        const int frames = SDL_min(outframes, RESAMPLER_BLOCK_FRAMES);
+
+        for (i = 0; i < frames; i++) {
+            /* The fixed-point position picks the input frames, as SDL_GetResamplerInputFrames() expects.
+               The exact position runs very slightly ahead of it, so the fixed-point position can be just
+               short of the next input frame when the exact one is on it: that's the extra phase at the end. */
+            const int srcindex = (int)(Sint32)(srcpos >> 32);
+            const Sint64 row = phase + ((exact_index - srcindex) * phases);
+            srcpos += resample_rate;
+
+            SDL_assert(srcindex >= -1 && srcindex < inframes);
+            SDL_assert(row >= 0 && row <= phases);
+
+            frame_src[i] = &src[(srcindex - (RESAMPLER_ZERO_CROSSINGS - 1)) * chans];
+            frame_filter[i] = &polyphase->filters[row * RESAMPLER_SAMPLES_PER_FRAME];
+
+            phase += src_step;
+            exact_index += phase / phases;
+            phase %= phases;
+        }
+
+        ResampleFrames(frame_src, frame_filter, NULL, frames, dst, chans);
+
+        dst += frames * chans;
+        outframes -= frames;
+    }
+
+    // Put the position back on the nearest phase, so it doesn't drift away from them over time.
+    srcpos = (exact_index << 32) + (Sint64)((((Uint64)phase << 32) + (phases / 2)) / phases);
+    *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
+    return SDL_TRUE;
+}
+
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
-                       Sint64 resample_rate, Sint64 *inout_resample_offset)
+                       Sint64 resample_rate, Sint64 *inout_resample_offset, const SDL_ResamplerPolyphase *polyphase)
 {
+    const float *frame_src[RESAMPLER_BLOCK_FRAMES];
+    const float *frame_filter[RESAMPLER_BLOCK_FRAMES];
+    float frame_interp[RESAMPLER_BLOCK_FRAMES];
     int i;
     Sint64 srcpos = *inout_resample_offset;
 
     SDL_assert(resample_rate > 0);
 
-    for (i = 0; i < outframes; i++) {
-        int srcindex = (int)(Sint32)(srcpos >> 32);
-        Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
-        srcpos += resample_rate;
+    if (polyphase && (polyphase->resample_rate == resample_rate) &&
+        ResampleAudioPolyphase(chans, src, inframes, dst, outframes, resample_rate, inout_resample_offset, polyphase)) {
+        return;
+    }
 
-        SDL_assert(srcindex >= -1 && srcindex < inframes);
+    while (outframes > 0) {
+        const int frames = SDL_min(outframes, RESAMPLER_BLOCK_FRAMES);
 
-        const float *filter = &FullResamplerFilter[(srcfraction >> RESAMPLER_FILTER_INTERP_BITS) * RESAMPLER_SAMPLES_PER_FRAME];
-        const float interp = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+        for (i = 0; i < frames; i++) {
+            int srcindex = (int)(Sint32)(srcpos >> 32);
+            Uint32 srcfraction = (Uint32)(srcpos & 0xFFFFFFFF);
+            srcpos += resample_rate;
 
-        const float *frame = &src[(srcindex - (RESAMPLER_ZERO_CROSSINGS - 1)) * chans];
-        ResampleFrame(frame, dst, filter, interp, chans);
+            SDL_assert(srcindex >= -1 && srcindex < inframes);
 
-        dst += chans;
+            frame_filter[i] = &FullResamplerFilter[(srcfraction >> RESAMPLER_FILTER_INTERP_BITS) * RESAMPLER_SAMPLES_PER_FRAME];
+            frame_interp[i] = (float)(srcfraction & (RESAMPLER_FILTER_INTERP_RANGE - 1)) * (1.0f / RESAMPLER_FILTER_INTERP_RANGE);
+            frame_src[i] = &src[(srcindex - (RESAMPLER_ZERO_CROSSINGS - 1)) * chans];
+        }
+
+        ResampleFrames(frame_src, frame_filter, frame_interp, frames, dst, chans);
+
+        dst += frames * chans;
+        outframes -= frames;
     }
 
     *inout_resample_offset = srcpos - ((Sint64)inframes << 32);
@@ -34,10 +34,24 @@ int SDL_GetResamplerPaddingFrames(Sint64 resample_rate);
 Sint64 SDL_GetResamplerInputFrames(Sint64 output_frames, Sint64 resample_rate, Sint64 resample_offset);
 Sint64 SDL_GetResamplerOutputFrames(Sint64 input_frames, Sint64 resample_rate, Sint64 *inout_resample_offset);
 
+// Filters for every phase of a fixed rational ratio between two rates, so they don't need to be interpolated for each frame.
+typedef struct SDL_ResamplerPolyphase
+{
+    Sint64 resample_rate;  // the rate this table was made for
+    int src_step;  // input frames per `phases` output frames
+    int phases;
+    float *filters;  // (phases + 1) filters
+} SDL_ResamplerPolyphase;
+
+// Returns NULL if the ratio between the rates needs too many phases, or on failure.
+SDL_ResamplerPolyphase *SDL_CreateResamplerPolyphase(int src_rate, int dst_rate);
+void SDL_DestroyResamplerPolyphase(SDL_ResamplerPolyphase *polyphase);
+
 // Resample some audio.
 // REQUIRES: `inframes >= SDL_GetResamplerInputFrames(outframes)`
 // REQUIRES: At least `SDL_GetResamplerPaddingFrames(...)` extra frames to the left of src, and right of src+inframes
+// `polyphase` is optional, and is used when it matches `resample_rate`.
 void SDL_ResampleAudio(int chans, const float *src, int inframes, float *dst, int outframes,
-                       Sint64 resample_rate, Sint64 *inout_resample_offset);
+                       Sint64 resample_rate, Sint64 *inout_resample_offset, const SDL_ResamplerPolyphase *polyphase);
 
 #endif // SDL_audioresample_h_
@@ -81,8 +81,350 @@ static const Uint8 mix8[] = {
 #define ADJUST_VOLUME(type, s, v) ((s) = (type)(((s) * (v)) / SDL_MIX_MAXVOLUME))
 #define ADJUST_VOLUME_U8(s, v)    ((s) = (Uint8)(((((s) - 128) * (v)) / SDL_MIX_MAXVOLUME) + 128))
 
+// The SIMD mixers divide by SDL_MIX_MAXVOLUME with a shift
+SDL_COMPILE_TIME_ASSERT(mix_maxvolume, SDL_MIX_MAXVOLUME == 128);
 
-// !!! FIXME: this needs some SIMD magic.
+/* Native byte order mixers, used for any volume from 0 to SDL_MIX_MAXVOLUME.
+ * These produce exactly the same results as the generic code below, and
+ * are used by the SIMD versions to handle unaligned heads and short tails.
+ */
+static void SDL_MixAudio_S16_Scalar(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        const int dst_sample = dst[i] + ((src[i] * volume) / SDL_MIX_MAXVOLUME);
+        dst[i] = (Sint16)SDL_clamp(dst_sample, SDL_MIN_SINT16, SDL_MAX_SINT16);
+    }
+}
+
+static void SDL_MixAudio_S32_Scalar(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        const Sint64 dst_sample = (Sint64)dst[i] + (((Sint64)src[i] * volume) / SDL_MIX_MAXVOLUME);
+        dst[i] = (Sint32)SDL_clamp(dst_sample, SDL_MIN_SINT32, SDL_MAX_SINT32);
+    }
+}
+
+static void SDL_MixAudio_F32_Scalar(float *dst, const float *src, int num_samples, int volume)
+{
+    const float fmaxvolume = 1.0f / ((float)SDL_MIX_MAXVOLUME);
+    const float fvolume = (float)volume;
+    const double max_audioval = 3.402823466e+38F;
+    const double min_audioval = -3.402823466e+38F;
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        double dst_sample = ((double)((src[i] * fvolume) * fmaxvolume)) + ((double)dst[i]);
+        if (dst_sample > max_audioval) {
+            dst_sample = max_audioval;
+        } else if (dst_sample < min_audioval) {
+            dst_sample = min_audioval;
+        }
+        dst[i] = (float)dst_sample;
+    }
+}
+
+/* Number of samples to mix one at a time before dst is aligned to `alignment` bytes.
+ * dst is only guaranteed to be byte aligned, so the vector loops still use unaligned
+ * loads and stores; this just keeps them from splitting cache lines when possible.
+ */
+#define MIX_HEAD_SAMPLES(dst, alignment, num_samples) \
+    SDL_min((int)((((alignment) - ((uintptr_t)(dst) & ((alignment) - 1))) & ((alignment) - 1)) / sizeof(*(dst))), (num_samples))
+
+#ifdef SDL_SSE2_INTRINSICS
+static void SDL_TARGETING("sse2") SDL_MixAudio_S16_SSE2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    const __m128i vol = _mm_set1_epi16((Sint16)volume);
+    const __m128i round = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    int i = MIX_HEAD_SAMPLES(dst, 16, num_samples);
+
+    SDL_MixAudio_S16_Scalar(dst, src, i, volume);
+
+    for (; i + 8 <= num_samples; i += 8) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        const __m128i lo = _mm_mullo_epi16(s, vol);
+        const __m128i hi = _mm_mulhi_epi16(s, vol);
+        __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+        __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+
+        // Divide by SDL_MIX_MAXVOLUME, rounding toward zero like the scalar code
+        p0 = _mm_srai_epi32(_mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), round)), 7);
+        p1 = _mm_srai_epi32(_mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), round)), 7);
+
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_adds_epi16(_mm_loadu_si128((const __m128i *)&dst[i]), _mm_packs_epi32(p0, p1)));
+    }
+
+    SDL_MixAudio_S16_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+static void SDL_TARGETING("sse2") SDL_MixAudio_S32_SSE2(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    const __m128i vol = _mm_set1_epi32(volume);
+    const __m128i mask = _mm_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    const __m128i maxval = _mm_set1_epi32(SDL_MAX_SINT32);
+    const __m128i zero = _mm_setzero_si128();
+    int i = MIX_HEAD_SAMPLES(dst, 16, num_samples);
+
+    SDL_MixAudio_S32_Scalar(dst, src, i, volume);
+
+    for (; i + 4 <= num_samples; i += 4) {
+        const __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        const __m128i d = _mm_loadu_si128((const __m128i *)&dst[i]);
+
+        /* s * volume doesn't fit in 32 bits, so split s into (hi * 128 + lo),
+         * then s * volume / 128 == hi * volume + (lo * volume) / 128, rounded down.
+         * Neither product overflows, and lo * volume fits in 16 bits for madd.
+         */
+        const __m128i hi = _mm_srai_epi32(s, 7);
+        const __m128i lo_vol = _mm_madd_epi16(_mm_and_si128(s, mask), vol);
+        const __m128i hi_vol_even = _mm_mul_epu32(hi, vol);
+        const __m128i hi_vol_odd = _mm_mul_epu32(_mm_srli_epi64(hi, 32), vol);
+        const __m128i hi_vol = _mm_unpacklo_epi32(_mm_shuffle_epi32(hi_vol_even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(hi_vol_odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        __m128i adj = _mm_add_epi32(hi_vol, _mm_srli_epi32(lo_vol, 7));
+
+        // Round negative values with a remainder toward zero, like the scalar code
+        adj = _mm_sub_epi32(adj, _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(lo_vol, mask), zero), _mm_srai_epi32(s, 31)));
+
+        {
+            // Saturating add: clamp if both inputs have the same sign and the sum doesn't
+            const __m128i sum = _mm_add_epi32(d, adj);
+            const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(d, sum), _mm_xor_si128(adj, sum)), 31);
+            const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(d, 31), maxval);
+            _mm_storeu_si128((__m128i *)&dst[i], _mm_or_si128(_mm_and_si128(overflow, saturated), _mm_andnot_si128(overflow, sum)));
+        }
+    }
+
+    SDL_MixAudio_S32_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+static void SDL_TARGETING("sse2") SDL_MixAudio_F32_SSE2(float *dst, const float *src, int num_samples, int volume)
+{
+    const __m128 fvolume = _mm_set1_ps((float)volume);
+    const __m128 fmaxvolume = _mm_set1_ps(1.0f / ((float)SDL_MIX_MAXVOLUME));
+    const __m128 maxval = _mm_set1_ps(3.402823466e+38F);
+    const __m128 minval = _mm_set1_ps(-3.402823466e+38F);
+    int i = MIX_HEAD_SAMPLES(dst, 16, num_samples);
+
+    SDL_MixAudio_F32_Scalar(dst, src, i, volume);
+
+    for (; i + 8 <= num_samples; i += 8) {
+        const __m128 s0 = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&src[i]), fvolume), fmaxvolume);
+        const __m128 s1 = _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&src[i + 4]), fvolume), fmaxvolume);
+        const __m128 d0 = _mm_add_ps(_mm_loadu_ps(&dst[i]), s0);
+        const __m128 d1 = _mm_add_ps(_mm_loadu_ps(&dst[i + 4]), s1);
+
+        // The limits go first so NaN passes through, like the scalar code
+        _mm_storeu_ps(&dst[i], _mm_max_ps(minval, _mm_min_ps(maxval, d0)));
+        _mm_storeu_ps(&dst[i + 4], _mm_max_ps(minval, _mm_min_ps(maxval, d1)));
+    }
+
+    SDL_MixAudio_F32_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_MixAudio_S16_AVX2(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    const __m256i vol = _mm256_set1_epi16((Sint16)volume);
+    const __m256i round = _mm256_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    int i = MIX_HEAD_SAMPLES(dst, 32, num_samples);
+
+    SDL_MixAudio_S16_Scalar(dst, src, i, volume);
+
+    for (; i + 16 <= num_samples; i += 16) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i lo = _mm256_mullo_epi16(s, vol);
+        const __m256i hi = _mm256_mulhi_epi16(s, vol);
+
+        // These unpack and pack within each 128-bit lane, so the order is preserved
+        __m256i p0 = _mm256_unpacklo_epi16(lo, hi);
+        __m256i p1 = _mm256_unpackhi_epi16(lo, hi);
+
+        p0 = _mm256_srai_epi32(_mm256_add_epi32(p0, _mm256_and_si256(_mm256_srai_epi32(p0, 31), round)), 7);
+        p1 = _mm256_srai_epi32(_mm256_add_epi32(p1, _mm256_and_si256(_mm256_srai_epi32(p1, 31), round)), 7);
+
+        _mm256_storeu_si256((__m256i *)&dst[i], _mm256_adds_epi16(_mm256_loadu_si256((const __m256i *)&dst[i]), _mm256_packs_epi32(p0, p1)));
+    }
+
+    SDL_MixAudio_S16_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+static void SDL_TARGETING("avx2") SDL_MixAudio_S32_AVX2(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    const __m256i vol = _mm256_set1_epi32(volume);
+    const __m256i mask = _mm256_set1_epi32(SDL_MIX_MAXVOLUME - 1);
+    const __m256i maxval = _mm256_set1_epi32(SDL_MAX_SINT32);
+    const __m256i zero = _mm256_setzero_si256();
+    int i = MIX_HEAD_SAMPLES(dst, 32, num_samples);
+
+    SDL_MixAudio_S32_Scalar(dst, src, i, volume);
+
+    for (; i + 8 <= num_samples; i += 8) {
+        const __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        const __m256i d = _mm256_loadu_si256((const __m256i *)&dst[i]);
+
+        // See the SSE2 version for how this avoids 64-bit products
+        const __m256i lo_vol = _mm256_madd_epi16(_mm256_and_si256(s, mask), vol);
+        __m256i adj = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(s, 7), vol), _mm256_srli_epi32(lo_vol, 7));
+        adj = _mm256_sub_epi32(adj, _mm256_andnot_si256(_mm256_cmpeq_epi32(_mm256_and_si256(lo_vol, mask), zero), _mm256_srai_epi32(s, 31)));
+
+        {
+            const __m256i sum = _mm256_add_epi32(d, adj);
+            const __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(d, sum), _mm256_xor_si256(adj, sum)), 31);
+            const __m256i saturated = _mm256_xor_si256(_mm256_srai_epi32(d, 31), maxval);
+            _mm256_storeu_si256((__m256i *)&dst[i], _mm256_blendv_epi8(sum, saturated, overflow));
+        }
+    }
+
+    SDL_MixAudio_S32_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+static void SDL_TARGETING("avx2") SDL_MixAudio_F32_AVX2(float *dst, const float *src, int num_samples, int volume)
+{
+    const __m256 fvolume = _mm256_set1_ps((float)volume);
+    const __m256 fmaxvolume = _mm256_set1_ps(1.0f / ((float)SDL_MIX_MAXVOLUME));
+    const __m256 maxval = _mm256_set1_ps(3.402823466e+38F);
+    const __m256 minval = _mm256_set1_ps(-3.402823466e+38F);
+    int i = MIX_HEAD_SAMPLES(dst, 32, num_samples);
+
+    SDL_MixAudio_F32_Scalar(dst, src, i, volume);
+
+    for (; i + 16 <= num_samples; i += 16) {
+        const __m256 s0 = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&src[i]), fvolume), fmaxvolume);
+        const __m256 s1 = _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&src[i + 8]), fvolume), fmaxvolume);
+        const __m256 d0 = _mm256_add_ps(_mm256_loadu_ps(&dst[i]), s0);
+        const __m256 d1 = _mm256_add_ps(_mm256_loadu_ps(&dst[i + 8]), s1);
+
+        _mm256_storeu_ps(&dst[i], _mm256_max_ps(minval, _mm256_min_ps(maxval, d0)));
+        _mm256_storeu_ps(&dst[i + 8], _mm256_max_ps(minval, _mm256_min_ps(maxval, d1)));
+    }
+
+    SDL_MixAudio_F32_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+/* dst and src may be only byte aligned, so the NEON mixers load and store them as bytes,
+ * which never needs more than byte alignment on any ARM core.
+ */
+#define MIX_LOAD_NEON(type, p)      vreinterpretq_##type##_u8(vld1q_u8((const Uint8 *)(p)))
+#define MIX_STORE_NEON(type, p, v)  vst1q_u8((Uint8 *)(p), vreinterpretq_u8_##type(v))
+
+static void SDL_MixAudio_S16_NEON(Sint16 *dst, const Sint16 *src, int num_samples, int volume)
+{
+    const int16x4_t vol = vdup_n_s16((Sint16)volume);
+    const int32x4_t round = vdupq_n_s32(SDL_MIX_MAXVOLUME - 1);
+    int i = MIX_HEAD_SAMPLES(dst, 16, num_samples);
+
+    SDL_MixAudio_S16_Scalar(dst, src, i, volume);
+
+    for (; i + 8 <= num_samples; i += 8) {
+        const int16x8_t s = MIX_LOAD_NEON(s16, &src[i]);
+        int32x4_t p0 = vmull_s16(vget_low_s16(s), vol);
+        int32x4_t p1 = vmull_s16(vget_high_s16(s), vol);
+
+        // Divide by SDL_MIX_MAXVOLUME, rounding toward zero like the scalar code
+        p0 = vshrq_n_s32(vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), round)), 7);
+        p1 = vshrq_n_s32(vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), round)), 7);
+
+        MIX_STORE_NEON(s16, &dst[i], vqaddq_s16(MIX_LOAD_NEON(s16, &dst[i]), vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1))));
+    }
+
+    SDL_MixAudio_S16_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+static void SDL_MixAudio_S32_NEON(Sint32 *dst, const Sint32 *src, int num_samples, int volume)
+{
+    const int32x2_t vol = vdup_n_s32(volume);
+    const int64x2_t round = vdupq_n_s64(SDL_MIX_MAXVOLUME - 1);
+    int i = MIX_HEAD_SAMPLES(dst, 16, num_samples);
+
+    SDL_MixAudio_S32_Scalar(dst, src, i, volume);
+
+    for (; i + 4 <= num_samples; i += 4) {
+        const int32x4_t s = MIX_LOAD_NEON(s32, &src[i]);
+        int64x2_t p0 = vmull_s32(vget_low_s32(s), vol);
+        int64x2_t p1 = vmull_s32(vget_high_s32(s), vol);
+
+        // The quotients fit in 32 bits, so only the final add needs to saturate
+        p0 = vshrq_n_s64(vaddq_s64(p0, vandq_s64(vshrq_n_s64(p0, 63), round)), 7);
+        p1 = vshrq_n_s64(vaddq_s64(p1, vandq_s64(vshrq_n_s64(p1, 63), round)), 7);
+
+        MIX_STORE_NEON(s32, &dst[i], vqaddq_s32(MIX_LOAD_NEON(s32, &dst[i]), vcombine_s32(vmovn_s64(p0), vmovn_s64(p1))));
+    }
+
+    SDL_MixAudio_S32_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+static void SDL_MixAudio_F32_NEON(float *dst, const float *src, int num_samples, int volume)
+{
+    const float fvolume = (float)volume;
+    const float fmaxvolume = 1.0f / ((float)SDL_MIX_MAXVOLUME);
+    const float32x4_t maxval = vdupq_n_f32(3.402823466e+38F);
+    const float32x4_t minval = vdupq_n_f32(-3.402823466e+38F);
+    int i = MIX_HEAD_SAMPLES(dst, 16, num_samples);
+
+    SDL_MixAudio_F32_Scalar(dst, src, i, volume);
+
+    for (; i + 8 <= num_samples; i += 8) {
+        const float32x4_t s0 = vmulq_n_f32(vmulq_n_f32(MIX_LOAD_NEON(f32, &src[i]), fvolume), fmaxvolume);
+        const float32x4_t s1 = vmulq_n_f32(vmulq_n_f32(MIX_LOAD_NEON(f32, &src[i + 4]), fvolume), fmaxvolume);
+        const float32x4_t d0 = vaddq_f32(MIX_LOAD_NEON(f32, &dst[i]), s0);
+        const float32x4_t d1 = vaddq_f32(MIX_LOAD_NEON(f32, &dst[i + 4]), s1);
+
+        // vminq/vmaxq propagate NaN, like the scalar code
+        MIX_STORE_NEON(f32, &dst[i], vmaxq_f32(minval, vminq_f32(maxval, d0)));
+        MIX_STORE_NEON(f32, &dst[i + 4], vmaxq_f32(minval, vminq_f32(maxval, d1)));
+    }
+
+    SDL_MixAudio_F32_Scalar(&dst[i], &src[i], num_samples - i, volume);
+}
+
+#undef MIX_LOAD_NEON
+#undef MIX_STORE_NEON
+#endif
+
+// Function pointers set to a CPU-specific implementation, for native byte order samples.
+static void (*SDL_MixAudio_S16)(Sint16 *dst, const Sint16 *src, int num_samples, int volume);
+static void (*SDL_MixAudio_S32)(Sint32 *dst, const Sint32 *src, int num_samples, int volume);
+static void (*SDL_MixAudio_F32)(float *dst, const float *src, int num_samples, int volume);
+
+static void SDL_ChooseAudioMixers(void)
+{
+#define SET_MIXER_FUNCS(fntype) \
+    SDL_MixAudio_S16 = SDL_MixAudio_S16_##fntype; \
+    SDL_MixAudio_S32 = SDL_MixAudio_S32_##fntype; \
+    SDL_MixAudio_F32 = SDL_MixAudio_F32_##fntype
+
+    // This may run on several threads at once, but they all pick the same functions.
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SET_MIXER_FUNCS(AVX2);
+        return;
+    }
+#endif
+
+#ifdef SDL_SSE2_INTRINSICS
+    if (SDL_HasSSE2()) {
+        SET_MIXER_FUNCS(SSE2);
+        return;
+    }
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+    if (SDL_HasNEON()) {
+        SET_MIXER_FUNCS(NEON);
+        return;
+    }
+#endif
+
+    SET_MIXER_FUNCS(Scalar);
+
+#undef SET_MIXER_FUNCS
+}
 
 int SDL_MixAudioFormat(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format,
                         Uint32 len, int volume)
@@ -91,6 +433,27 @@ int SDL_MixAudioFormat(Uint8 *dst, const Uint8 *src, SDL_AudioFormat format,
         return 0;
     }
 
+    // Native byte order samples at a normal volume use the fastest mixer available
+    if (volume > 0 && volume <= SDL_MIX_MAXVOLUME && len <= SDL_MAX_SINT32) {
+        if (!SDL_MixAudio_S16 || !SDL_MixAudio_S32 || !SDL_MixAudio_F32) {
+            SDL_ChooseAudioMixers();
+        }
+
+        switch (format) {
+        case SDL_AUDIO_S16:
+            SDL_MixAudio_S16((Sint16 *)dst, (const Sint16 *)src, (int)(len / 2), volume);
+            return 0;
+        case SDL_AUDIO_S32:
+            SDL_MixAudio_S32((Sint32 *)dst, (const Sint32 *)src, (int)(len / 4), volume);
+            return 0;
+        case SDL_AUDIO_F32:
+            SDL_MixAudio_F32((float *)dst, (const float *)src, (int)(len / 4), volume);
+            return 0;
+        default:
+            break;
+        }
+    }
+
     switch (format) {
 
     case SDL_AUDIO_U8:
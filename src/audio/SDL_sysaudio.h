@@ -123,6 +123,10 @@ extern void SDL_AudioThreadFinalize(SDL_AudioDevice *device);
 extern void ConvertAudio(int num_frames, const void *src, SDL_AudioFormat src_format, int src_channels,
                          void *dst, SDL_AudioFormat dst_format, int dst_channels, void* scratch);
 
+// Used by the audio worker pool: the device thread runs the app's get callback, and a worker does the conversion.
+extern void RequestAudioStreamData(SDL_AudioStream *stream, int len);
+extern int GetAudioStreamDataWithoutCallback(SDL_AudioStream *stream, void *buf, int len);
+
 // Special case to let something in SDL_audiocvt.c access something in SDL_audio.c. Don't use this.
 extern void OnAudioStreamCreated(SDL_AudioStream *stream);
 extern void OnAudioStreamDestroy(SDL_AudioStream *stream);
@@ -171,6 +175,7 @@ typedef struct SDL_AudioDriver
     SDL_AudioDeviceID default_capture_device_id;
     SDL_PendingAudioDeviceEvent pending_events;
     SDL_PendingAudioDeviceEvent *pending_events_tail;
+    SDL_bool parallel_convert;  // convert bound streams in parallel on the job threads, if SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT is set.
 
     // !!! FIXME: most (all?) of these don't have to be atomic.
     SDL_AtomicInt output_device_count;
@@ -179,6 +184,7 @@ typedef struct SDL_AudioDriver
 } SDL_AudioDriver;
 
 struct SDL_AudioQueue; // forward decl.
+struct SDL_AudioRing; // forward decl.
 
 struct SDL_AudioStream
 {
@@ -198,8 +204,11 @@ struct SDL_AudioStream
     struct SDL_AudioQueue* queue;
     Uint64 total_bytes_queued;
 
+    struct SDL_AudioRing *ring;  // non-NULL in single producer mode: puts land here without taking `lock`.
+
     SDL_AudioSpec input_spec; // The spec of input data currently being processed
     Sint64 resample_offset;
+    struct SDL_ResamplerPolyphase *polyphase;  // precalculated filters for the current rates, if the ratio between them allows it.
 
     Uint8 *work_buffer;    // used for scratch space during data conversion/resampling.
     size_t work_buffer_allocation;
@@ -313,6 +322,12 @@ struct SDL_AudioDevice
     // Size of work_buffer (and mix_buffer) in bytes.
     int work_buffer_size;
 
+    // Per-stream scratch buffers and jobs, when converting bound streams on the worker pool.
+    Uint8 *convert_buffers;
+    struct SDL_AudioConvertJob *convert_jobs;
+    int num_convert_jobs;  // how many jobs (and buffers) are allocated.
+    int convert_stride;  // bytes between the start of each scratch buffer in convert_buffers.
+
     // A thread to feed the audio device
     SDL_Thread *thread;
 
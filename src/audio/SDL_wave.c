@@ -1504,6 +1504,7 @@ static void WaveFreeChunkData(WaveChunk *chunk)
 
 static int WaveNextChunk(SDL_RWops *src, WaveChunk *chunk)
 {
+    const void *header;
     Uint32 chunkheader[2];
     Sint64 nextposition = chunk->position + chunk->length;
 
@@ -1523,9 +1524,14 @@ static int WaveNextChunk(SDL_RWops *src, WaveChunk *chunk)
     if (SDL_RWseek(src, nextposition, SDL_RW_SEEK_SET) != nextposition) {
         /* Not sure how we ended up here. Just abort. */
         return -2;
-    } else if (SDL_RWread(src, chunkheader, sizeof(Uint32) * 2) != (sizeof(Uint32) * 2)) {
+    }
+
+    header = SDL_RWpeek(src, sizeof(chunkheader));
+    if (!header) {
         return -1;
     }
+    SDL_memcpy(chunkheader, header, sizeof(chunkheader));
+    SDL_RWconsume(src, sizeof(chunkheader));
 
     chunk->fourcc = SDL_SwapLE32(chunkheader[0]);
     chunk->length = SDL_SwapLE32(chunkheader[1]);
@@ -2077,11 +2083,13 @@ static int WaveLoad(SDL_RWops *src, WaveFile *file, SDL_AudioSpec *spec, Uint8 *
 
 int SDL_LoadWAV_RW(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec, Uint8 **audio_buf, Uint32 *audio_len)
 {
+    SDL_RWops *base = src;
     int result = -1;
     WaveFile file;
 
     /* Make sure we are passed a valid data source */
-    if (!src) {
+    src = NULL;
+    if (!base) {
         goto done;  /* Error may come from RWops. */
     } else if (!spec) {
         SDL_InvalidParamError("spec");
@@ -2102,6 +2110,17 @@ int SDL_LoadWAV_RW(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec, Uint8
     file.trunchint = WaveGetTruncationHint();
     file.facthint = WaveGetFactChunkHint();
 
+    /* The chunk headers are small reads between seeks, so buffer them
+       unless they're already in memory */
+    if (base->type == SDL_RWOPS_MEMORY || base->type == SDL_RWOPS_MEMORY_RO) {
+        src = base;
+    } else {
+        src = SDL_CreateBufferedRW(base, 0);
+        if (!src) {
+            goto done;
+        }
+    }
+
     result = WaveLoad(src, &file, spec, audio_buf, audio_len);
     if (result < 0) {
         SDL_free(*audio_buf);
@@ -2115,10 +2134,13 @@ int SDL_LoadWAV_RW(SDL_RWops *src, SDL_bool freesrc, SDL_AudioSpec *spec, Uint8
     }
     WaveFreeChunkData(&file.chunk);
     SDL_free(file.decoderdata);
-done:
-    if (freesrc && src) {
+    if (src != base) {
         SDL_RWclose(src);
     }
+done:
+    if (freesrc && base) {
+        SDL_RWclose(base);
+    }
     return result;
 }
 
@@ -988,3 +988,22 @@
 #define SDL_wcsnstr SDL_wcsnstr_REAL
 #define SDL_SyncWindow SDL_SyncWindow_REAL
 #define SDL_GetGamepadSteamHandle SDL_GetGamepadSteamHandle_REAL
+#define SDL_PushEvents SDL_PushEvents_REAL
+#define SDL_GetPropertyAtom SDL_GetPropertyAtom_REAL
+#define SDL_GetPropertyByAtom SDL_GetPropertyByAtom_REAL
+#define SDL_GetStringPropertyByAtom SDL_GetStringPropertyByAtom_REAL
+#define SDL_GetNumberPropertyByAtom SDL_GetNumberPropertyByAtom_REAL
+#define SDL_GetFloatPropertyByAtom SDL_GetFloatPropertyByAtom_REAL
+#define SDL_GetBooleanPropertyByAtom SDL_GetBooleanPropertyByAtom_REAL
+#define SDL_SetAudioStreamSingleProducer SDL_SetAudioStreamSingleProducer_REAL
+#define SDL_UnpremultiplyAlpha SDL_UnpremultiplyAlpha_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_IsJobFinished SDL_IsJobFinished_REAL
+#define SDL_WaitJob SDL_WaitJob_REAL
+#define SDL_DetachJob SDL_DetachJob_REAL
+#define SDL_ParallelFor SDL_ParallelFor_REAL
+#define SDL_CreateBufferedRW SDL_CreateBufferedRW_REAL
+#define SDL_RWpeek SDL_RWpeek_REAL
+#define SDL_RWconsume SDL_RWconsume_REAL
+#define SDL_MapFile SDL_MapFile_REAL
+#define SDL_UnmapFile SDL_UnmapFile_REAL
@@ -1013,3 +1013,22 @@ SDL_DYNAPI_PROC(char*,SDL_strnstr,(const char *a, const char *b, size_t c),(a,b,
 SDL_DYNAPI_PROC(wchar_t*,SDL_wcsnstr,(const wchar_t *a, const wchar_t *b, size_t c),(a,b,c),return)
 SDL_DYNAPI_PROC(int,SDL_SyncWindow,(SDL_Window *a),(a),return)
 SDL_DYNAPI_PROC(Uint64,SDL_GetGamepadSteamHandle,(SDL_Gamepad *a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_PushEvents,(SDL_Event *a, int b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_PropertyAtom,SDL_GetPropertyAtom,(const char *a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_GetPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetStringPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, const char *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetNumberPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, Sint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(float,SDL_GetFloatPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, float c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_GetBooleanPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, SDL_bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(int,SDL_SetAudioStreamSingleProducer,(SDL_AudioStream *a, SDL_bool b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_UnpremultiplyAlpha,(int a, int b, Uint32 c, const void *d, int e, Uint32 f, void *g, int h),(a,b,c,d,e,f,g,h),return)
+SDL_DYNAPI_PROC(SDL_Job*,SDL_SubmitJob,(SDL_JobFunction a, void *b, SDL_Job **c, int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_bool,SDL_IsJobFinished,(SDL_Job *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_WaitJob,(SDL_Job *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_DetachJob,(SDL_Job *a),(a),)
+SDL_DYNAPI_PROC(int,SDL_ParallelFor,(int a, int b, int c, SDL_ParallelForFunction d, void *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(SDL_RWops*,SDL_CreateBufferedRW,(SDL_RWops *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(const void*,SDL_RWpeek,(SDL_RWops *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_RWconsume,(SDL_RWops *a, size_t b),(a,b),return)
+SDL_DYNAPI_PROC(const void*,SDL_MapFile,(const char *a, size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_UnmapFile,(const void *a, size_t b),(a,b),)
@@ -44,6 +44,9 @@
 /* An arbitrary limit so we don't have unbounded growth */
 #define SDL_MAX_QUEUED_EVENTS 65535
 
+/* The number of slots in the lock-free producer ring, must be a power of two */
+#define SDL_EVENT_RING_SIZE 4096
+
 /* Determines how often we wake to call SDL_PumpEvents() in SDL_WaitEventTimeout_Device() */
 #define PERIODIC_POLL_INTERVAL_NS (3 * SDL_NS_PER_SECOND)
 
@@ -63,6 +66,13 @@ static SDL_bool SDL_event_watchers_removed = SDL_FALSE;
 static SDL_AtomicInt SDL_sentinel_pending;
 static Uint32 SDL_last_event_id = 0;
 
+/* High frequency events sent while pumping events are collected here and
+   pushed as a single batch, only by the thread that is pumping events. */
+#define SDL_EVENT_BATCH_SIZE 128
+static void *SDL_event_batch_thread;
+static SDL_Event SDL_event_batch[SDL_EVENT_BATCH_SIZE];
+static int SDL_event_batch_count;
+
 typedef struct
 {
     Uint32 bits[8];
@@ -90,41 +100,197 @@ static struct
     SDL_EventEntry *free;
 } SDL_EventQ = { NULL, SDL_FALSE, { 0 }, 0, NULL, NULL, NULL };
 
+/* Lock-free multi-producer ring in front of the event queue.
+
+   When SDL_HINT_EVENT_QUEUE_LOCKFREE is enabled, SDL_PushEvent() stores
+   events here without taking SDL_EventQ.lock. Whoever next takes the queue
+   lock moves them into the linked list, so there is only ever one consumer.
+   Each slot carries a sequence number: a slot is free for the producer that
+   claimed position N when sequence == N, and ready for the consumer when
+   sequence == N + 1. Events in the ring are already included in
+   SDL_EventQ.count, so the queue limit covers both.
+
+   Producers register in `producers` before touching the ring, and
+   SDL_StopEventLoop() waits for them to leave after clearing `enabled`,
+   so the slots are never freed underneath a producer.
+ */
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicInt sequence;
+    SDL_Event event;
+} SDL_EventRingSlot;
+
+static struct
+{
+    SDL_EventRingSlot *slots;
+    SDL_AtomicInt head;     /* next position to be claimed by a producer */
+    int tail;               /* next position to be consumed, protected by SDL_EventQ.lock */
+    SDL_AtomicInt enabled;  /* non-zero while producers may use the ring */
+    SDL_AtomicInt producers; /* producers currently using the ring */
+} SDL_EventRing;
+
+static void SDL_CreateEventRing(void)
+{
+    int i;
+
+    if (SDL_EventRing.slots || !SDL_GetHintBoolean(SDL_HINT_EVENT_QUEUE_LOCKFREE, SDL_FALSE)) {
+        return;
+    }
+
+    SDL_EventRing.slots = (SDL_EventRingSlot *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*SDL_EventRing.slots));
+    if (!SDL_EventRing.slots) {
+        /* We'll just use the locked queue */
+        return;
+    }
+    for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+        SDL_AtomicSet(&SDL_EventRing.slots[i].sequence, i);
+    }
+    SDL_AtomicSet(&SDL_EventRing.head, 0);
+    SDL_EventRing.tail = 0;
+
+    /* Make the initialized slots visible before producers can see the ring */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&SDL_EventRing.enabled, 1);
+}
+
+/* Stop producers from using the ring, and wait for the ones using it now to finish -- called without the queue lock */
+static void SDL_DisableEventRing(void)
+{
+    /* SDL_AtomicCAS() is a full barrier, so this is ordered before the loads below */
+    if (!SDL_AtomicCAS(&SDL_EventRing.enabled, 1, 0)) {
+        return;
+    }
+    while (SDL_AtomicGet(&SDL_EventRing.producers) > 0) {
+        SDL_Delay(0);
+    }
+}
+
+/* Register as a producer, returns SDL_FALSE if the ring isn't available */
+static SDL_bool SDL_BeginEventRing(void)
+{
+    if (!SDL_AtomicGet(&SDL_EventRing.enabled)) {
+        return SDL_FALSE;
+    }
+    SDL_AtomicAdd(&SDL_EventRing.producers, 1);
+    if (!SDL_AtomicGet(&SDL_EventRing.enabled)) {
+        /* The ring was disabled after we checked */
+        SDL_AtomicAdd(&SDL_EventRing.producers, -1);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static void SDL_EndEventRing(void)
+{
+    SDL_AtomicAdd(&SDL_EventRing.producers, -1);
+}
+
+static void SDL_DestroyEventRing(void)
+{
+    SDL_assert(!SDL_AtomicGet(&SDL_EventRing.enabled));
+    SDL_assert(SDL_AtomicGet(&SDL_EventRing.producers) == 0);
+
+    if (SDL_EventRing.slots) {
+        SDL_free(SDL_EventRing.slots);
+        SDL_EventRing.slots = NULL;
+    }
+    SDL_AtomicSet(&SDL_EventRing.head, 0);
+    SDL_EventRing.tail = 0;
+}
+
+/* Memory handed out by SDL_AllocateEventMemory() comes from a chain of
+   blocks, carved up with a bump pointer. Each block remembers the newest
+   event id it holds, and once the event queue has moved past that id the
+   whole block is recycled at once.
+ */
+#define SDL_EVENT_MEMORY_BLOCK_SIZE (64 * 1024)
+#define SDL_EVENT_MEMORY_ALIGNMENT  16
+#define SDL_EVENT_MEMORY_MAX_SPARE  2
+
 typedef struct SDL_EventMemory
 {
     Uint32 eventID;
-    void *memory;
+    size_t size;
+    size_t used;
     struct SDL_EventMemory *next;
 } SDL_EventMemory;
 
+#define SDL_EVENT_MEMORY_HEADER_SIZE ((sizeof(SDL_EventMemory) + (SDL_EVENT_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_EVENT_MEMORY_ALIGNMENT - 1))
+
 static SDL_Mutex *SDL_event_memory_lock;
 static SDL_EventMemory *SDL_event_memory_head;
 static SDL_EventMemory *SDL_event_memory_tail;
+static SDL_EventMemory *SDL_event_memory_spare;
+static int SDL_event_memory_spare_count;
+
+static SDL_EventMemory *SDL_NewEventMemoryBlock(size_t size)
+{
+    SDL_EventMemory *block;
+
+    if (size <= SDL_EVENT_MEMORY_BLOCK_SIZE && SDL_event_memory_spare) {
+        block = SDL_event_memory_spare;
+        SDL_event_memory_spare = block->next;
+        --SDL_event_memory_spare_count;
+    } else {
+        if (size < SDL_EVENT_MEMORY_BLOCK_SIZE) {
+            size = SDL_EVENT_MEMORY_BLOCK_SIZE;
+        }
+        block = (SDL_EventMemory *)SDL_malloc(SDL_EVENT_MEMORY_HEADER_SIZE + size);
+        if (!block) {
+            return NULL;
+        }
+        block->size = size;
+    }
+    block->used = 0;
+    block->next = NULL;
+
+    if (SDL_event_memory_tail) {
+        SDL_event_memory_tail->next = block;
+    } else {
+        SDL_event_memory_head = block;
+    }
+    SDL_event_memory_tail = block;
+
+    return block;
+}
+
+static void SDL_RecycleEventMemoryBlock(SDL_EventMemory *block)
+{
+    if (block->size == SDL_EVENT_MEMORY_BLOCK_SIZE &&
+        SDL_event_memory_spare_count < SDL_EVENT_MEMORY_MAX_SPARE) {
+        block->next = SDL_event_memory_spare;
+        SDL_event_memory_spare = block;
+        ++SDL_event_memory_spare_count;
+    } else {
+        SDL_free(block);
+    }
+}
 
 void *SDL_AllocateEventMemory(size_t size)
 {
-    void *memory = SDL_malloc(size);
-    if (!memory) {
+    SDL_EventMemory *block;
+    void *memory = NULL;
+
+    /* Round up so the next allocation is aligned too */
+    if (size > SDL_SIZE_MAX - SDL_EVENT_MEMORY_HEADER_SIZE - SDL_EVENT_MEMORY_ALIGNMENT) {
+        SDL_OutOfMemory();
         return NULL;
     }
+    size = (size + (SDL_EVENT_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_EVENT_MEMORY_ALIGNMENT - 1);
+    if (size == 0) {
+        size = SDL_EVENT_MEMORY_ALIGNMENT;
+    }
 
     SDL_LockMutex(SDL_event_memory_lock);
     {
-        SDL_EventMemory *entry = (SDL_EventMemory *)SDL_malloc(sizeof(*entry));
-        if (entry) {
-            entry->eventID = SDL_last_event_id;
-            entry->memory = memory;
-            entry->next = NULL;
-
-            if (SDL_event_memory_tail) {
-                SDL_event_memory_tail->next = entry;
-            } else {
-                SDL_event_memory_head = entry;
-            }
-            SDL_event_memory_tail = entry;
-        } else {
-            SDL_free(memory);
-            memory = NULL;
+        block = SDL_event_memory_tail;
+        if (!block || (block->size - block->used) < size) {
+            block = SDL_NewEventMemoryBlock(size);
+        }
+        if (block) {
+            memory = (Uint8 *)block + SDL_EVENT_MEMORY_HEADER_SIZE + block->used;
+            block->used += size;
+            block->eventID = SDL_last_event_id;
         }
     }
     SDL_UnlockMutex(SDL_event_memory_lock);
@@ -136,24 +302,34 @@ static void SDL_FlushEventMemory(Uint32 eventID)
 {
     SDL_LockMutex(SDL_event_memory_lock);
     {
-        if (SDL_event_memory_head) {
-            while (SDL_event_memory_head) {
-                SDL_EventMemory *entry = SDL_event_memory_head;
-
-                if (eventID && (Sint32)(eventID - entry->eventID) < 0) {
-                    break;
-                }
+        while (SDL_event_memory_head) {
+            SDL_EventMemory *block = SDL_event_memory_head;
 
-                /* If you crash here, your application has memory corruption
-                 * or freed memory in an event, which is no longer necessary.
-                 */
-                SDL_event_memory_head = entry->next;
-                SDL_free(entry->memory);
-                SDL_free(entry);
+            if (eventID && (Sint32)(eventID - block->eventID) < 0) {
+                break;
             }
+
+            /* If you crash here, your application has memory corruption
+             * or freed memory in an event, which is no longer necessary.
+             */
+            SDL_event_memory_head = block->next;
             if (!SDL_event_memory_head) {
                 SDL_event_memory_tail = NULL;
             }
+            if (eventID) {
+                SDL_RecycleEventMemoryBlock(block);
+            } else {
+                SDL_free(block);
+            }
+        }
+
+        if (!eventID) {
+            while (SDL_event_memory_spare) {
+                SDL_EventMemory *block = SDL_event_memory_spare;
+                SDL_event_memory_spare = block->next;
+                SDL_free(block);
+            }
+            SDL_event_memory_spare_count = 0;
         }
     }
     SDL_UnlockMutex(SDL_event_memory_lock);
@@ -199,6 +375,13 @@ static void SDLCALL SDL_EventLoggingChanged(void *userdata, const char *name, co
     SDL_EventLoggingVerbosity = (hint && *hint) ? SDL_clamp(SDL_atoi(hint), 0, 3) : 0;
 }
 
+static SDL_bool SDL_coalesce_motion_events = SDL_FALSE;
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_coalesce_motion_events = SDL_GetStringBoolean(hint, SDL_FALSE);
+}
+
 static void SDL_LogEvent(const SDL_Event *event)
 {
     char name[64];
@@ -587,6 +770,8 @@ void SDL_StopEventLoop(void)
     int i;
     SDL_EventEntry *entry;
 
+    SDL_DisableEventRing();
+
     SDL_LockMutex(SDL_EventQ.lock);
 
     SDL_EventQ.active = SDL_FALSE;
@@ -597,6 +782,7 @@ void SDL_StopEventLoop(void)
     }
 
     /* Clean out EventQ */
+    SDL_DestroyEventRing();
     for (entry = SDL_EventQ.head; entry;) {
         SDL_EventEntry *next = entry->next;
         SDL_free(entry);
@@ -614,6 +800,7 @@ void SDL_StopEventLoop(void)
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
     SDL_AtomicSet(&SDL_sentinel_pending, 0);
+    SDL_event_batch_count = 0;
 
     SDL_FlushEventMemory(0);
 
@@ -680,6 +867,8 @@ int SDL_StartEventLoop(void)
             return -1;
         }
     }
+
+    SDL_CreateEventRing();
 #endif /* !SDL_THREADS_DISABLED */
 
     /* Process most event types */
@@ -695,17 +884,10 @@ int SDL_StartEventLoop(void)
     return 0;
 }
 
-/* Add an event to the event queue -- called with the queue locked */
-static int SDL_AddEvent(SDL_Event *event)
+/* Link an event into the event queue -- called with the queue locked */
+static int SDL_LinkEvent(SDL_Event *event)
 {
     SDL_EventEntry *entry;
-    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
-    int final_count;
-
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
 
     if (SDL_EventQ.free == NULL) {
         entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
@@ -739,16 +921,197 @@ static int SDL_AddEvent(SDL_Event *event)
         entry->next = NULL;
     }
 
+    ++SDL_last_event_id;
+
+    return 1;
+}
+
+/* Merge a motion event into the last queued event if it's motion from the same source -- called with the queue locked */
+static SDL_bool SDL_CoalesceEvent(const SDL_Event *event)
+{
+    SDL_Event *last;
+
+    if (!SDL_coalesce_motion_events || !SDL_EventQ.tail) {
+        return SDL_FALSE;
+    }
+
+    last = &SDL_EventQ.tail->event;
+    if (last->type != event->type) {
+        return SDL_FALSE;
+    }
+
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        if (last->motion.which != event->motion.which ||
+            last->motion.windowID != event->motion.windowID ||
+            last->motion.state != event->motion.state) {
+            return SDL_FALSE;
+        }
+        last->motion.x = event->motion.x;
+        last->motion.y = event->motion.y;
+        last->motion.xrel += event->motion.xrel;
+        last->motion.yrel += event->motion.yrel;
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        if (last->tfinger.touchId != event->tfinger.touchId ||
+            last->tfinger.fingerId != event->tfinger.fingerId ||
+            last->tfinger.windowID != event->tfinger.windowID) {
+            return SDL_FALSE;
+        }
+        last->tfinger.x = event->tfinger.x;
+        last->tfinger.y = event->tfinger.y;
+        last->tfinger.dx += event->tfinger.dx;
+        last->tfinger.dy += event->tfinger.dy;
+        last->tfinger.pressure = event->tfinger.pressure;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        if (last->pmotion.which != event->pmotion.which ||
+            last->pmotion.windowID != event->pmotion.windowID ||
+            last->pmotion.pen_state != event->pmotion.pen_state) {
+            return SDL_FALSE;
+        }
+        last->pmotion.x = event->pmotion.x;
+        last->pmotion.y = event->pmotion.y;
+        SDL_memcpy(last->pmotion.axes, event->pmotion.axes, sizeof(last->pmotion.axes));
+        break;
+    case SDL_EVENT_JOYSTICK_AXIS_MOTION:
+        if (last->jaxis.which != event->jaxis.which ||
+            last->jaxis.axis != event->jaxis.axis) {
+            return SDL_FALSE;
+        }
+        last->jaxis.value = event->jaxis.value;
+        break;
+    case SDL_EVENT_GAMEPAD_AXIS_MOTION:
+        if (last->gaxis.which != event->gaxis.which ||
+            last->gaxis.axis != event->gaxis.axis) {
+            return SDL_FALSE;
+        }
+        last->gaxis.value = event->gaxis.value;
+        break;
+    default:
+        return SDL_FALSE;
+    }
+    last->common.timestamp = event->common.timestamp;
+
+    return SDL_TRUE;
+}
+
+/* Add an event to the event queue -- called with the queue locked */
+static int SDL_AddEvent(SDL_Event *event)
+{
+    const int initial_count = SDL_AtomicGet(&SDL_EventQ.count);
+    int final_count;
+
+    if (SDL_CoalesceEvent(event)) {
+        return 1;
+    }
+
+    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_SetError("Event queue is full (%d events)", initial_count);
+        return 0;
+    }
+
+    if (!SDL_LinkEvent(event)) {
+        return 0;
+    }
+
     final_count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
     if (final_count > SDL_EventQ.max_events_seen) {
         SDL_EventQ.max_events_seen = final_count;
     }
 
-    ++SDL_last_event_id;
+    return 1;
+}
+
+/* Add an event to the lock-free ring, returns 0 if the ring is full */
+static int SDL_AddEventToRing(const SDL_Event *event)
+{
+    SDL_EventRingSlot *slot;
+    int pos, seq;
+    int count;
+
+    count = SDL_AtomicAdd(&SDL_EventQ.count, 1) + 1;
+    if (count > SDL_MAX_QUEUED_EVENTS) {
+        SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        return SDL_SetError("Event queue is full (%d events)", count - 1);
+    }
+
+    for (;;) {
+        pos = SDL_AtomicGet(&SDL_EventRing.head);
+        slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+        seq = SDL_AtomicGet(&slot->sequence);
+        if (seq == pos) {
+            if (SDL_AtomicCAS(&SDL_EventRing.head, pos, pos + 1)) {
+                break;
+            }
+        } else if ((Sint32)((Uint32)seq - (Uint32)pos) < 0) {
+            /* The consumer hasn't caught up, the ring is full */
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+            return 0;
+        }
+        /* Another producer claimed this slot, try again */
+    }
+
+    SDL_copyp(&slot->event, event);
+
+    /* Publish the event: the consumer must see the copy before the new sequence */
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&slot->sequence, pos + 1);
 
     return 1;
 }
 
+/* Move events from the lock-free ring into the event queue, returns SDL_FALSE if some
+   events are still being written -- called with the queue locked */
+static SDL_bool SDL_DrainEventRing(void)
+{
+    SDL_EventRingSlot *slot;
+    int pos, head, spins, final_count;
+
+    if (!SDL_EventRing.slots) {
+        return SDL_TRUE;
+    }
+
+    /* Take everything claimed so far, so events pushed before this point
+       are never queued behind events added through the locked path. */
+    head = SDL_AtomicGet(&SDL_EventRing.head);
+    for (pos = SDL_EventRing.tail; pos != head; ++pos) {
+        slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+
+        /* Give the producer a moment to finish writing this slot. We hold the
+           queue lock, so if it was preempted, leave this slot and the ones
+           after it for the next drain; its wakeup event will trigger one. */
+        spins = 0;
+        while (SDL_AtomicGet(&slot->sequence) != pos + 1) {
+            if (++spins > 64) {
+                break;
+            }
+            SDL_CPUPauseInstruction();
+        }
+        if (spins > 64) {
+            break;
+        }
+        SDL_MemoryBarrierAcquire();
+
+        if (SDL_CoalesceEvent(&slot->event) || !SDL_LinkEvent(&slot->event)) {
+            /* Merged into the previous event, or out of memory */
+            SDL_AtomicAdd(&SDL_EventQ.count, -1);
+        }
+
+        /* We're done reading the slot before a producer can reuse it */
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&slot->sequence, pos + SDL_EVENT_RING_SIZE);
+    }
+    SDL_EventRing.tail = pos;
+
+    final_count = SDL_AtomicGet(&SDL_EventQ.count);
+    if (final_count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = final_count;
+    }
+
+    return (pos == head);
+}
+
 /* Remove an event from the queue -- called with the queue locked */
 static void SDL_CutEvent(SDL_EventEntry *entry)
 {
@@ -808,6 +1171,7 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
     /* Lock the event queue */
     used = 0;
 
+retry:
     SDL_LockMutex(SDL_EventQ.lock);
     {
         /* Don't look after we've quit */
@@ -819,6 +1183,16 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
+
+        /* Keep events in the order they were pushed. Added events can't go in
+           front of ones still being written to the ring (they may be this
+           thread's own), so wait for those outside the lock and try again. */
+        if (!SDL_DrainEventRing() && action == SDL_ADDEVENT) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            SDL_Delay(0);
+            goto retry;
+        }
+
         if (action == SDL_ADDEVENT) {
             for (i = 0; i < numevents; ++i) {
                 used += SDL_AddEvent(&events[i]);
@@ -868,6 +1242,7 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_eventact
 int SDL_PeepEvents(SDL_Event *events, int numevents, SDL_eventaction action,
                    Uint32 minType, Uint32 maxType)
 {
+    SDL_FlushEventBatch();
     return SDL_PeepEventsInternal(events, numevents, action, minType, maxType, SDL_FALSE);
 }
 
@@ -899,6 +1274,8 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
     SDL_PumpEvents();
 #endif
 
+    SDL_FlushEventBatch();
+
     /* Lock the event queue */
     SDL_LockMutex(SDL_EventQ.lock);
     {
@@ -907,6 +1284,7 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -922,6 +1300,7 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
 {
     SDL_VideoDevice *_this = SDL_GetVideoDevice();
+    SDL_bool batching;
 
     /* Free old event memory */
     /*SDL_FlushEventMemory(SDL_last_event_id - SDL_MAX_QUEUED_EVENTS);*/
@@ -929,6 +1308,9 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
         SDL_FlushEventMemory(SDL_last_event_id);
     }
 
+    /* Collect motion events into batches while pumping, unless another thread is already doing that */
+    batching = SDL_AtomicCASPtr(&SDL_event_batch_thread, NULL, (void *)(uintptr_t)SDL_ThreadID());
+
     /* Release any keys held down from last frame */
     SDL_ReleaseAutoReleaseKeys();
 
@@ -957,6 +1339,11 @@ static void SDL_PumpEventsInternal(SDL_bool push_sentinel)
 
     SDL_SendPendingSignalEvents(); /* in case we had a signal handler fire, etc. */
 
+    if (batching) {
+        SDL_FlushEventBatch();
+        SDL_AtomicSetPtr(&SDL_event_batch_thread, NULL);
+    }
+
     if (push_sentinel && SDL_EventEnabled(SDL_EVENT_POLL_SENTINEL)) {
         SDL_Event sentinel;
 
@@ -1199,55 +1586,220 @@ SDL_bool SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS)
     }
 }
 
-int SDL_PushEvent(SDL_Event *event)
+/* Run the event filter and event watchers -- called with the watchers locked */
+static SDL_bool SDL_DispatchEventWatchers(SDL_Event *event)
 {
-    if (!event->common.timestamp) {
-        event->common.timestamp = SDL_GetTicksNS();
+    if (SDL_EventOK.callback && !SDL_EventOK.callback(SDL_EventOK.userdata, event)) {
+        return SDL_FALSE;
     }
 
-    if (SDL_EventOK.callback || SDL_event_watchers_count > 0) {
-        SDL_LockMutex(SDL_event_watchers_lock);
-        {
-            if (SDL_EventOK.callback && !SDL_EventOK.callback(SDL_EventOK.userdata, event)) {
-                SDL_UnlockMutex(SDL_event_watchers_lock);
-                return 0;
+    if (SDL_event_watchers_count > 0) {
+        /* Make sure we only dispatch the current watcher list */
+        int i, event_watchers_count = SDL_event_watchers_count;
+
+        SDL_event_watchers_dispatching = SDL_TRUE;
+        for (i = 0; i < event_watchers_count; ++i) {
+            if (!SDL_event_watchers[i].removed) {
+                SDL_event_watchers[i].callback(SDL_event_watchers[i].userdata, event);
             }
+        }
+        SDL_event_watchers_dispatching = SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
 
-            if (SDL_event_watchers_count > 0) {
-                /* Make sure we only dispatch the current watcher list */
-                int i, event_watchers_count = SDL_event_watchers_count;
+/* Remove watchers deleted during dispatch -- called with the watchers locked */
+static void SDL_CleanupEventWatchers(void)
+{
+    if (SDL_event_watchers_removed) {
+        int i;
 
-                SDL_event_watchers_dispatching = SDL_TRUE;
-                for (i = 0; i < event_watchers_count; ++i) {
-                    if (!SDL_event_watchers[i].removed) {
-                        SDL_event_watchers[i].callback(SDL_event_watchers[i].userdata, event);
-                    }
+        for (i = SDL_event_watchers_count; i--;) {
+            if (SDL_event_watchers[i].removed) {
+                --SDL_event_watchers_count;
+                if (i < SDL_event_watchers_count) {
+                    SDL_memmove(&SDL_event_watchers[i], &SDL_event_watchers[i + 1], (SDL_event_watchers_count - i) * sizeof(SDL_event_watchers[i]));
                 }
-                SDL_event_watchers_dispatching = SDL_FALSE;
-
-                if (SDL_event_watchers_removed) {
-                    for (i = SDL_event_watchers_count; i--;) {
-                        if (SDL_event_watchers[i].removed) {
-                            --SDL_event_watchers_count;
-                            if (i < SDL_event_watchers_count) {
-                                SDL_memmove(&SDL_event_watchers[i], &SDL_event_watchers[i + 1], (SDL_event_watchers_count - i) * sizeof(SDL_event_watchers[i]));
-                            }
-                        }
+            }
+        }
+        SDL_event_watchers_removed = SDL_FALSE;
+    }
+}
+
+/* Add filtered events to the queue, returns the number of events added */
+static int SDL_EnqueueEvents(SDL_Event *events, int numevents)
+{
+    int i, used = 0;
+
+    if (numevents <= 0) {
+        return 0;
+    }
+
+    /* Sentinels go through the locked path, so the ring is flushed in front of them */
+    if (SDL_BeginEventRing()) {
+        for (i = 0; i < numevents; ++i) {
+            int result;
+
+            if (events[i].type == SDL_EVENT_POLL_SENTINEL) {
+                break;
+            }
+            result = SDL_AddEventToRing(&events[i]);
+            if (result < 0) {
+                break;
+            }
+            if (result == 0) {
+                /* The ring is full, fall back to the locked queue */
+                break;
+            }
+            ++used;
+        }
+        SDL_EndEventRing();
+
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+        }
+        if (used == numevents || SDL_AtomicGet(&SDL_EventQ.count) >= SDL_MAX_QUEUED_EVENTS) {
+            return used;
+        }
+    }
+
+    i = SDL_PeepEventsInternal(&events[used], numevents - used, SDL_ADDEVENT, 0, 0, SDL_FALSE);
+    if (i > 0) {
+        used += i;
+    }
+    return used;
+}
+
+int SDL_PushEvents(SDL_Event *events, int numevents)
+{
+    Uint64 timestamp = 0;
+    int i, kept, used;
+
+    if (!events) {
+        return SDL_InvalidParamError("events");
+    }
+    if (numevents <= 0) {
+        return 0;
+    }
+
+    for (i = 0; i < numevents; ++i) {
+        if (!events[i].common.timestamp) {
+            if (!timestamp) {
+                timestamp = SDL_GetTicksNS();
+            }
+            events[i].common.timestamp = timestamp;
+        }
+    }
+
+    kept = numevents;
+    if (SDL_EventOK.callback || SDL_event_watchers_count > 0) {
+        kept = 0;
+        SDL_LockMutex(SDL_event_watchers_lock);
+        {
+            for (i = 0; i < numevents; ++i) {
+                if (SDL_DispatchEventWatchers(&events[i])) {
+                    if (kept != i) {
+                        SDL_copyp(&events[kept], &events[i]);
                     }
-                    SDL_event_watchers_removed = SDL_FALSE;
+                    ++kept;
                 }
             }
+            SDL_CleanupEventWatchers();
+        }
+        SDL_UnlockMutex(SDL_event_watchers_lock);
+    }
+
+    if (kept == 0) {
+        return 0;
+    }
+
+    used = SDL_EnqueueEvents(events, kept);
+    if (used <= 0) {
+        return -1;
+    }
+    return used;
+}
+
+int SDL_PushEvent(SDL_Event *event)
+{
+    if (!event->common.timestamp) {
+        event->common.timestamp = SDL_GetTicksNS();
+    }
+
+    SDL_FlushEventBatch();
+
+    if (SDL_EventOK.callback || SDL_event_watchers_count > 0) {
+        SDL_bool keep;
+
+        SDL_LockMutex(SDL_event_watchers_lock);
+        {
+            keep = SDL_DispatchEventWatchers(event);
+            SDL_CleanupEventWatchers();
         }
         SDL_UnlockMutex(SDL_event_watchers_lock);
+
+        if (!keep) {
+            return 0;
+        }
     }
 
-    if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
+    if (SDL_EnqueueEvents(event, 1) <= 0) {
         return -1;
     }
 
     return 1;
 }
 
+int SDL_PushEventBatched(SDL_Event *event)
+{
+    if (SDL_AtomicGetPtr(&SDL_event_batch_thread) != (void *)(uintptr_t)SDL_ThreadID()) {
+        return SDL_PushEvent(event);
+    }
+
+    if (!event->common.timestamp) {
+        event->common.timestamp = SDL_GetTicksNS();
+    }
+
+    /* The filter and watchers run now, like SDL_PushEvent(), only queueing is batched */
+    if (SDL_EventOK.callback || SDL_event_watchers_count > 0) {
+        SDL_bool keep;
+
+        SDL_LockMutex(SDL_event_watchers_lock);
+        {
+            keep = SDL_DispatchEventWatchers(event);
+            SDL_CleanupEventWatchers();
+        }
+        SDL_UnlockMutex(SDL_event_watchers_lock);
+
+        if (!keep) {
+            return 0;
+        }
+    }
+
+    if (SDL_event_batch_count == SDL_arraysize(SDL_event_batch)) {
+        SDL_FlushEventBatch();
+    }
+    SDL_copyp(&SDL_event_batch[SDL_event_batch_count], event);
+    ++SDL_event_batch_count;
+
+    return 1;
+}
+
+void SDL_FlushEventBatch(void)
+{
+    int count;
+
+    if (SDL_event_batch_count == 0 ||
+        SDL_AtomicGetPtr(&SDL_event_batch_thread) != (void *)(uintptr_t)SDL_ThreadID()) {
+        return;
+    }
+
+    /* These already went through the filter and watchers in SDL_PushEventBatched() */
+    count = SDL_event_batch_count;
+    SDL_event_batch_count = 0;
+    SDL_EnqueueEvents(SDL_event_batch, count);
+}
+
 void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 {
     SDL_LockMutex(SDL_event_watchers_lock);
@@ -1332,9 +1884,12 @@ void SDL_DelEventWatch(SDL_EventFilter filter, void *userdata)
 
 void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
 {
+    SDL_FlushEventBatch();
+
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing();
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1475,8 +2030,10 @@ int SDL_InitEvents(void)
     SDL_AddHintCallback(SDL_HINT_AUTO_UPDATE_SENSORS, SDL_AutoUpdateSensorsChanged, NULL);
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     if (SDL_StartEventLoop() < 0) {
+        SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
         SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return -1;
     }
@@ -1491,6 +2048,7 @@ void SDL_QuitEvents(void)
     SDL_QuitQuit();
     SDL_StopEventLoop();
     SDL_DelHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_DelHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_DelHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
     SDL_DelHintCallback(SDL_HINT_AUTO_UPDATE_JOYSTICKS, SDL_AutoUpdateJoysticksChanged, NULL);
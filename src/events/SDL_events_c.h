@@ -47,6 +47,10 @@ extern int SDL_SendSystemThemeChangedEvent(void);
 
 extern int SDL_SendQuit(void);
 
+/* Push an event that may be collected into a batch while events are being pumped */
+extern int SDL_PushEventBatched(SDL_Event *event);
+extern void SDL_FlushEventBatch(void);
+
 extern int SDL_InitEvents(void);
 extern void SDL_QuitEvents(void);
 
@@ -30,6 +30,11 @@
 #ifdef HAVE_LIMITS_H
 #include <limits.h>
 #endif
+#if defined(HAVE_MMAP) && defined(HAVE_STDIO_H) && !defined(__ANDROID__) && !defined(__WIN32__) && !defined(__GDK__) && !defined(__WINRT__)
+#define SDL_RWOPS_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 /* This file provides a general interface for SDL to read and write
    data sources.  It can easily be extended to files, memory, etc.
@@ -457,6 +462,271 @@ static size_t SDLCALL mem_write(SDL_RWops *context, const void *ptr, size_t size
     return mem_io(context, context->hidden.mem.here, ptr, size);
 }
 
+#ifdef SDL_RWOPS_MMAP
+
+/* Functions to read memory-mapped files, which are read-only memory streams */
+
+/* Map an open file into memory, returning NULL if it can't be mapped */
+static void *map_file(FILE *fp, size_t *datasize)
+{
+    struct stat st;
+    void *mem;
+
+    if (fstat(fileno(fp), &st) < 0 || !S_ISREG(st.st_mode) ||
+        st.st_size <= 0 || (Uint64)st.st_size > SDL_SIZE_MAX) {
+        return NULL;
+    }
+
+    mem = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+#ifdef HAVE_MADVISE
+    /* Files are almost always read from start to end, so ask for aggressive read-ahead */
+    madvise(mem, (size_t)st.st_size, MADV_SEQUENTIAL);
+#endif
+    *datasize = (size_t)st.st_size;
+    return mem;
+}
+
+static int SDLCALL mapped_close(SDL_RWops *context)
+{
+    munmap(context->hidden.mem.base, (size_t)(context->hidden.mem.stop - context->hidden.mem.base));
+    SDL_DestroyRW(context);
+    return 0;
+}
+
+static SDL_RWops *SDL_RWFromMappedFP(FILE *fp)
+{
+    SDL_RWops *rwops;
+    SDL_PropertiesID props;
+    size_t size;
+    void *mem;
+
+    mem = map_file(fp, &size);
+    if (!mem) {
+        return NULL;
+    }
+
+    rwops = SDL_CreateRW();
+    if (!rwops) {
+        munmap(mem, size);
+        return NULL;
+    }
+    rwops->size = mem_size;
+    rwops->seek = mem_seek;
+    rwops->read = mem_read;
+    rwops->close = mapped_close;
+    rwops->hidden.mem.base = (Uint8 *)mem;
+    rwops->hidden.mem.here = rwops->hidden.mem.base;
+    rwops->hidden.mem.stop = rwops->hidden.mem.base + size;
+    rwops->type = SDL_RWOPS_MEMORY_RO;
+
+    props = SDL_GetRWProperties(rwops);
+    if (props) {
+        SDL_SetProperty(props, "SDL.rwops.mapped.base", mem);
+        SDL_SetNumberProperty(props, "SDL.rwops.mapped.size", (Sint64)size);
+    }
+    return rwops;
+}
+
+#endif /* SDL_RWOPS_MMAP */
+
+/* Functions to read/write through a buffer in front of another SDL_RWops */
+
+#define SDL_RW_DEFAULT_BUFFER_SIZE 4096
+
+typedef struct SDL_BufferedRW
+{
+    SDL_RWops *base;
+    Sint64 position;    /* The position of the buffered stream */
+    SDL_bool writing;   /* Whether data holds unwritten data rather than read-ahead */
+    size_t pos;         /* The current position in data */
+    size_t len;         /* The amount of valid data */
+    size_t size;        /* The size of data */
+    Uint8 *data;
+} SDL_BufferedRW;
+
+/* Pass any buffered writes on to the base stream */
+static int buffered_flush(SDL_BufferedRW *buffered)
+{
+    if (buffered->writing) {
+        if (buffered->len > 0) {
+            const size_t written = SDL_RWwrite(buffered->base, buffered->data, buffered->len);
+            if (written < buffered->len) {
+                /* Keep what couldn't be written, so a later flush can try again */
+                SDL_memmove(buffered->data, buffered->data + written, buffered->len - written);
+                buffered->len -= written;
+                buffered->pos = buffered->len;
+                return -1;
+            }
+        }
+        buffered->writing = SDL_FALSE;
+        buffered->pos = buffered->len = 0;
+    }
+    return 0;
+}
+
+/* Read more data from the base stream, keeping the unread data */
+static size_t buffered_fill(SDL_BufferedRW *buffered)
+{
+    size_t bytes;
+
+    if (buffered->pos > 0) {
+        buffered->len -= buffered->pos;
+        SDL_memmove(buffered->data, buffered->data + buffered->pos, buffered->len);
+        buffered->pos = 0;
+    }
+    bytes = SDL_RWread(buffered->base, buffered->data + buffered->len, buffered->size - buffered->len);
+    buffered->len += bytes;
+    return bytes;
+}
+
+static Sint64 SDLCALL buffered_size(SDL_RWops *context)
+{
+    SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+
+    if (buffered_flush(buffered) < 0) {
+        return -1;
+    }
+    return SDL_RWsize(buffered->base);
+}
+
+static Sint64 SDLCALL buffered_seek(SDL_RWops *context, Sint64 offset, int whence)
+{
+    SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+    Sint64 target, start, result;
+
+    if (buffered_flush(buffered) < 0) {
+        return -1;
+    }
+
+    switch (whence) {
+    case SDL_RW_SEEK_SET:
+        target = offset;
+        break;
+    case SDL_RW_SEEK_CUR:
+        target = buffered->position + offset;
+        break;
+    case SDL_RW_SEEK_END:
+        result = SDL_RWseek(buffered->base, offset, SDL_RW_SEEK_END);
+        if (result >= 0) {
+            buffered->pos = buffered->len = 0;
+            buffered->position = result;
+        }
+        return result;
+    default:
+        return SDL_SetError("Unknown value for 'whence'");
+    }
+
+    /* Seeking within the buffered data doesn't need the base stream */
+    start = buffered->position - (Sint64)buffered->pos;
+    if (target >= start && target <= start + (Sint64)buffered->len) {
+        buffered->pos = (size_t)(target - start);
+        buffered->position = target;
+        return target;
+    }
+
+    result = SDL_RWseek(buffered->base, target, SDL_RW_SEEK_SET);
+    if (result >= 0) {
+        buffered->pos = buffered->len = 0;
+        buffered->position = result;
+    }
+    return result;
+}
+
+static size_t SDLCALL buffered_read(SDL_RWops *context, void *ptr, size_t size)
+{
+    SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+    size_t bytes;
+
+    if (buffered_flush(buffered) < 0) {
+        context->status = SDL_RWOPS_STATUS_ERROR;
+        return 0;
+    }
+
+    while (total < size) {
+        bytes = SDL_min(buffered->len - buffered->pos, size - total);
+        if (bytes > 0) {
+            SDL_memcpy(dst + total, buffered->data + buffered->pos, bytes);
+            buffered->pos += bytes;
+            total += bytes;
+            continue;
+        }
+
+        buffered->pos = buffered->len = 0;
+        if ((size - total) >= buffered->size) {
+            /* Large reads go straight into the caller's memory */
+            bytes = SDL_RWread(buffered->base, dst + total, size - total);
+            if (bytes == 0) {
+                break;
+            }
+            total += bytes;
+        } else if (buffered_fill(buffered) == 0) {
+            break;
+        }
+    }
+    buffered->position += total;
+
+    if (total == 0 && buffered->base->status != SDL_RWOPS_STATUS_READY) {
+        context->status = buffered->base->status;
+    }
+    return total;
+}
+
+static size_t SDLCALL buffered_write(SDL_RWops *context, const void *ptr, size_t size)
+{
+    SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+    size_t bytes;
+
+    if (!buffered->writing) {
+        /* The base stream is ahead of us by the read-ahead, move it back */
+        if (buffered->pos < buffered->len &&
+            SDL_RWseek(buffered->base, buffered->position, SDL_RW_SEEK_SET) < 0) {
+            context->status = SDL_RWOPS_STATUS_ERROR;
+            return 0;
+        }
+        buffered->writing = SDL_TRUE;
+        buffered->pos = buffered->len = 0;
+    }
+
+    if (size > buffered->size - buffered->len && buffered_flush(buffered) < 0) {
+        context->status = SDL_RWOPS_STATUS_ERROR;
+        return 0;
+    }
+
+    if (size >= buffered->size) {
+        /* Large writes go straight to the base stream */
+        bytes = SDL_RWwrite(buffered->base, ptr, size);
+    } else {
+        buffered->writing = SDL_TRUE;
+        SDL_memcpy(buffered->data + buffered->len, ptr, size);
+        buffered->len += size;
+        buffered->pos = buffered->len;
+        bytes = size;
+    }
+    buffered->position += bytes;
+    return bytes;
+}
+
+static int SDLCALL buffered_close(SDL_RWops *context)
+{
+    SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+    int status = 0;
+
+    if (buffered->writing) {
+        status = buffered_flush(buffered);
+    } else if (buffered->pos < buffered->len) {
+        /* Leave the base stream where the caller thinks it is */
+        SDL_RWseek(buffered->base, buffered->position, SDL_RW_SEEK_SET);
+    }
+    SDL_free(buffered);
+    SDL_DestroyRW(context);
+    return status;
+}
+
 /* Functions to create SDL_RWops structures from various data sources */
 
 SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
@@ -541,6 +811,16 @@ SDL_RWops *SDL_RWFromFile(const char *file, const char *mode)
         if (!fp) {
             SDL_SetError("Couldn't open %s", file);
         } else {
+#ifdef SDL_RWOPS_MMAP
+            if (*mode == 'r' && SDL_strchr(mode, 'm') && !SDL_strchr(mode, '+')) {
+                /* If the file can't be mapped, it's read normally */
+                rwops = SDL_RWFromMappedFP(fp);
+                if (rwops) {
+                    fclose(fp);
+                    return rwops;
+                }
+            }
+#endif
             rwops = SDL_RWFromFP(fp, SDL_TRUE);
         }
     }
@@ -604,6 +884,53 @@ SDL_RWops *SDL_RWFromConstMem(const void *mem, size_t size)
     return rwops;
 }
 
+SDL_RWops *SDL_CreateBufferedRW(SDL_RWops *base, size_t bufsize)
+{
+    SDL_BufferedRW *buffered;
+    SDL_RWops *rwops;
+
+    if (!base) {
+        SDL_InvalidParamError("base");
+        return NULL;
+    }
+    if (!bufsize) {
+        bufsize = SDL_RW_DEFAULT_BUFFER_SIZE;
+    }
+
+    buffered = (SDL_BufferedRW *)SDL_calloc(1, sizeof(*buffered) + bufsize);
+    if (!buffered) {
+        SDL_OutOfMemory();
+        return NULL;
+    }
+    buffered->base = base;
+    buffered->size = bufsize;
+    buffered->data = (Uint8 *)(buffered + 1);
+    if (base->seek) {
+        buffered->position = SDL_RWtell(base);
+        if (buffered->position < 0) {
+            /* The stream can't seek, so positions are relative to here */
+            buffered->position = 0;
+        }
+    }
+
+    rwops = SDL_CreateRW();
+    if (!rwops) {
+        SDL_free(buffered);
+        return NULL;
+    }
+    rwops->size = buffered_size;
+    rwops->seek = buffered_seek;
+    if (base->read) {
+        rwops->read = buffered_read;
+    }
+    if (base->write) {
+        rwops->write = buffered_write;
+    }
+    rwops->close = buffered_close;
+    rwops->hidden.unknown.data1 = buffered;
+    return rwops;
+}
+
 SDL_RWops *SDL_CreateRW(void)
 {
     SDL_RWops *context;
@@ -694,6 +1021,59 @@ void *SDL_LoadFile(const char *file, size_t *datasize)
     return SDL_LoadFile_RW(SDL_RWFromFile(file, "rb"), datasize, SDL_TRUE);
 }
 
+const void *SDL_MapFile(const char *file, size_t *datasize)
+{
+    static const Uint8 empty;
+    SDL_RWops *src;
+    const void *data = NULL;
+    size_t size = 0;
+
+    src = SDL_RWFromFile(file, "rbm");
+    if (!src) {
+        return NULL;
+    }
+
+#ifdef SDL_RWOPS_MMAP
+    if (src->close == mapped_close) {
+        /* Take the mapping over from the stream */
+        data = src->hidden.mem.base;
+        size = (size_t)(src->hidden.mem.stop - src->hidden.mem.base);
+        SDL_DestroyRW(src);
+    } else {
+        if (SDL_RWsize(src) == 0) {
+            /* Empty files can't be mapped, but there's nothing to map */
+            data = &empty;
+        } else {
+            SDL_SetError("Couldn't map %s", file);
+        }
+        SDL_RWclose(src);
+    }
+#else
+    (void)empty;
+    data = SDL_LoadFile_RW(src, &size, SDL_TRUE);
+#endif
+
+    if (data && datasize) {
+        *datasize = size;
+    }
+    return data;
+}
+
+void SDL_UnmapFile(const void *mem, size_t datasize)
+{
+    if (!mem) {
+        return;
+    }
+#ifdef SDL_RWOPS_MMAP
+    if (datasize > 0) {
+        munmap((void *)mem, datasize);
+    }
+#else
+    (void)datasize;
+    SDL_free((void *)mem);
+#endif
+}
+
 SDL_PropertiesID SDL_GetRWProperties(SDL_RWops *context)
 {
     if (!context) {
@@ -803,6 +1183,78 @@ size_t SDL_RWwrite(SDL_RWops *context, const void *ptr, size_t size)
     return bytes;
 }
 
+const void *SDL_RWpeek(SDL_RWops *context, size_t size)
+{
+    if (!context) {
+        SDL_InvalidParamError("context");
+        return NULL;
+    }
+
+    if (context->read == buffered_read) {
+        SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+
+        context->status = SDL_RWOPS_STATUS_READY;
+        if (size > buffered->size) {
+            SDL_SetError("Can't peek at more than the buffer size");
+            return NULL;
+        }
+        if (buffered_flush(buffered) < 0) {
+            context->status = SDL_RWOPS_STATUS_ERROR;
+            return NULL;
+        }
+        while ((buffered->len - buffered->pos) < size) {
+            if (buffered_fill(buffered) == 0) {
+                context->status = buffered->base->status;
+                if (context->status == SDL_RWOPS_STATUS_READY) {
+                    context->status = SDL_RWOPS_STATUS_EOF;
+                }
+                return NULL;
+            }
+        }
+        return buffered->data + buffered->pos;
+    }
+
+    if (context->read == mem_read) {
+        context->status = SDL_RWOPS_STATUS_READY;
+        if ((size_t)(context->hidden.mem.stop - context->hidden.mem.here) < size) {
+            context->status = SDL_RWOPS_STATUS_EOF;
+            return NULL;
+        }
+        return context->hidden.mem.here;
+    }
+
+    SDL_Unsupported();
+    return NULL;
+}
+
+int SDL_RWconsume(SDL_RWops *context, size_t size)
+{
+    if (!context) {
+        return SDL_InvalidParamError("context");
+    }
+
+    if (context->read == buffered_read) {
+        SDL_BufferedRW *buffered = (SDL_BufferedRW *)context->hidden.unknown.data1;
+
+        if (buffered->writing || size > (buffered->len - buffered->pos)) {
+            return SDL_InvalidParamError("size");
+        }
+        buffered->pos += size;
+        buffered->position += size;
+        return 0;
+    }
+
+    if (context->read == mem_read) {
+        if (size > (size_t)(context->hidden.mem.stop - context->hidden.mem.here)) {
+            return SDL_InvalidParamError("size");
+        }
+        context->hidden.mem.here += size;
+        return 0;
+    }
+
+    return SDL_Unsupported();
+}
+
 size_t SDL_RWprintf(SDL_RWops *context, SDL_PRINTF_FORMAT_STRING const char *fmt, ...)
 {
     va_list ap;
@@ -852,12 +1304,54 @@ int SDL_RWclose(SDL_RWops *context)
 
 /* Functions for dynamically reading and writing endian-specific values */
 
+/* Read a value straight out of memory or the buffer of a buffered stream, if it's there */
+static SDL_bool read_value(SDL_RWops *src, void *value, size_t size)
+{
+    if (src && src->read == buffered_read) {
+        SDL_BufferedRW *buffered = (SDL_BufferedRW *)src->hidden.unknown.data1;
+
+        if (size <= (buffered->len - buffered->pos)) {
+            SDL_memcpy(value, buffered->data + buffered->pos, size);
+            buffered->pos += size;
+            buffered->position += size;
+            src->status = SDL_RWOPS_STATUS_READY;
+            return SDL_TRUE;
+        }
+    } else if (src && src->read == mem_read) {
+        if (size <= (size_t)(src->hidden.mem.stop - src->hidden.mem.here)) {
+            SDL_memcpy(value, src->hidden.mem.here, size);
+            src->hidden.mem.here += size;
+            src->status = SDL_RWOPS_STATUS_READY;
+            return SDL_TRUE;
+        }
+    }
+    return (SDL_RWread(src, value, size) == size);
+}
+
+/* Write a value straight into the buffer of a buffered stream, if there's room */
+static SDL_bool write_value(SDL_RWops *dst, const void *value, size_t size)
+{
+    if (dst && dst->write == buffered_write) {
+        SDL_BufferedRW *buffered = (SDL_BufferedRW *)dst->hidden.unknown.data1;
+
+        if (buffered->writing && size <= (buffered->size - buffered->len)) {
+            SDL_memcpy(buffered->data + buffered->len, value, size);
+            buffered->len += size;
+            buffered->pos = buffered->len;
+            buffered->position += size;
+            dst->status = SDL_RWOPS_STATUS_READY;
+            return SDL_TRUE;
+        }
+    }
+    return (SDL_RWwrite(dst, value, size) == size);
+}
+
 SDL_bool SDL_ReadU8(SDL_RWops *src, Uint8 *value)
 {
     Uint8 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -871,7 +1365,7 @@ SDL_bool SDL_ReadU16LE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -890,7 +1384,7 @@ SDL_bool SDL_ReadU16BE(SDL_RWops *src, Uint16 *value)
     Uint16 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -909,7 +1403,7 @@ SDL_bool SDL_ReadU32LE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -928,7 +1422,7 @@ SDL_bool SDL_ReadU32BE(SDL_RWops *src, Uint32 *value)
     Uint32 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -947,7 +1441,7 @@ SDL_bool SDL_ReadU64LE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -966,7 +1460,7 @@ SDL_bool SDL_ReadU64BE(SDL_RWops *src, Uint64 *value)
     Uint64 data = 0;
     SDL_bool result = SDL_FALSE;
 
-    if (SDL_RWread(src, &data, sizeof(data)) == sizeof(data)) {
+    if (read_value(src, &data, sizeof(data))) {
         result = SDL_TRUE;
     }
     if (value) {
@@ -982,13 +1476,13 @@ SDL_bool SDL_ReadS64BE(SDL_RWops *src, Sint64 *value)
 
 SDL_bool SDL_WriteU8(SDL_RWops *dst, Uint8 value)
 {
-    return (SDL_RWwrite(dst, &value, sizeof(value)) == sizeof(value));
+    return write_value(dst, &value, sizeof(value));
 }
 
 SDL_bool SDL_WriteU16LE(SDL_RWops *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_SwapLE16(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return write_value(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16LE(SDL_RWops *dst, Sint16 value)
@@ -999,7 +1493,7 @@ SDL_bool SDL_WriteS16LE(SDL_RWops *dst, Sint16 value)
 SDL_bool SDL_WriteU16BE(SDL_RWops *dst, Uint16 value)
 {
     const Uint16 swapped = SDL_SwapBE16(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return write_value(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS16BE(SDL_RWops *dst, Sint16 value)
@@ -1010,7 +1504,7 @@ SDL_bool SDL_WriteS16BE(SDL_RWops *dst, Sint16 value)
 SDL_bool SDL_WriteU32LE(SDL_RWops *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_SwapLE32(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return write_value(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32LE(SDL_RWops *dst, Sint32 value)
@@ -1021,7 +1515,7 @@ SDL_bool SDL_WriteS32LE(SDL_RWops *dst, Sint32 value)
 SDL_bool SDL_WriteU32BE(SDL_RWops *dst, Uint32 value)
 {
     const Uint32 swapped = SDL_SwapBE32(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return write_value(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS32BE(SDL_RWops *dst, Sint32 value)
@@ -1032,7 +1526,7 @@ SDL_bool SDL_WriteS32BE(SDL_RWops *dst, Sint32 value)
 SDL_bool SDL_WriteU64LE(SDL_RWops *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_SwapLE64(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return write_value(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64LE(SDL_RWops *dst, Sint64 value)
@@ -1043,7 +1537,7 @@ SDL_bool SDL_WriteS64LE(SDL_RWops *dst, Sint64 value)
 SDL_bool SDL_WriteU64BE(SDL_RWops *dst, Uint64 value)
 {
     const Uint64 swapped = SDL_SwapBE64(value);
-    return (SDL_RWwrite(dst, &swapped, sizeof(swapped)) == sizeof(swapped));
+    return write_value(dst, &swapped, sizeof(swapped));
 }
 
 SDL_bool SDL_WriteS64BE(SDL_RWops *dst, Sint64 value)
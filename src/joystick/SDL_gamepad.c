@@ -22,6 +22,7 @@
 
 /* This is the gamepad API for Simple DirectMedia Layer */
 
+#include "../SDL_hashtable.h"
 #include "../SDL_utils_c.h"
 #include "SDL_sysjoystick.h"
 #include "SDL_joystick_c.h"
@@ -82,7 +83,9 @@ typedef enum
 typedef struct GamepadMapping_t
 {
     SDL_JoystickGUID guid _guarded;
-    char *name _guarded;
+    SDL_JoystickGUID index_guid _guarded; /* guid without the CRC and version, the key in s_mappingIndex */
+    Uint32 order _guarded;                /* position in s_pSupportedGamepads */
+    char *name _guarded;                  /* name and mapping share one allocation, owned by name */
     char *mapping _guarded;
     SDL_GamepadMappingPriority priority _guarded;
     struct GamepadMapping_t *next _guarded;
@@ -103,6 +106,9 @@ typedef struct
 
 static SDL_JoystickGUID s_zeroGUID;
 static GamepadMapping_t *s_pSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static GamepadMapping_t *s_pLastSupportedGamepad SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
+static Uint32 s_numSupportedGamepads SDL_GUARDED_BY(SDL_joystick_lock) = 0;
+static SDL_HashTable *s_mappingIndex SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pDefaultMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static GamepadMapping_t *s_pXInputMapping SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
 static MappingChangeTracker *s_mappingChangeTracker SDL_GUARDED_BY(SDL_joystick_lock) = NULL;
@@ -155,6 +161,7 @@ static SDL_vidpid_list SDL_ignored_gamepads = {
 };
 
 static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, const char *mappingString, SDL_bool *existing, SDL_GamepadMappingPriority priority);
+static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMappingPriority priority);
 static void SDL_PrivateLoadButtonMapping(SDL_Gamepad *gamepad, GamepadMapping_t *pGamepadMapping);
 static GamepadMapping_t *SDL_PrivateGetGamepadMapping(SDL_JoystickID instance_id, SDL_bool create_mapping);
 static int SDL_SendGamepadAxis(Uint64 timestamp, SDL_Gamepad *gamepad, SDL_GamepadAxis axis, Sint16 value);
@@ -857,11 +864,48 @@ static GamepadMapping_t *SDL_CreateMappingForWGIGamepad(SDL_JoystickGUID guid)
 }
 
 /*
- * Helper function to scan the mappings database for a gamepad with the specified GUID
+ * The mappings are indexed by GUID without the CRC and version, so every
+ * mapping that could match a GUID is found with one lookup.
+ */
+static Uint32 SDL_HashGamepadGUID(const void *key, void *unused)
+{
+    const Uint8 *data = (const Uint8 *)key;
+    Uint32 hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < sizeof(SDL_JoystickGUID); ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static SDL_bool SDL_KeyMatchGamepadGUID(const void *a, const void *b, void *unused)
+{
+    return (SDL_memcmp(a, b, sizeof(SDL_JoystickGUID)) == 0);
+}
+
+static void SDL_NukeGamepadMappingIndex(const void *key, const void *value, void *unused)
+{
+    /* The mappings are owned by s_pSupportedGamepads */
+}
+
+static SDL_JoystickGUID SDL_GetGamepadMappingIndexGUID(SDL_JoystickGUID guid)
+{
+    SDL_SetJoystickGUIDCRC(&guid, 0);
+    SDL_SetJoystickGUIDVersion(&guid, 0);
+    return guid;
+}
+
+/*
+ * Helper function to search the mappings database for a gamepad with the specified GUID
  */
 static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID guid, SDL_bool match_crc, SDL_bool match_version)
 {
     GamepadMapping_t *mapping;
+    GamepadMapping_t *match = NULL;
+    SDL_JoystickGUID index_guid;
+    const void *value;
+    void *iter = NULL;
     Uint16 crc = 0;
 
     SDL_AssertJoysticksLocked();
@@ -877,10 +921,13 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID
         SDL_SetJoystickGUIDVersion(&guid, 0);
     }
 
-    for (mapping = s_pSupportedGamepads; mapping; mapping = mapping->next) {
+    /* Several mappings can share an index entry, the one added first wins */
+    index_guid = SDL_GetGamepadMappingIndexGUID(guid);
+    while (SDL_IterateHashTableKey(s_mappingIndex, &index_guid, &value, &iter)) {
         SDL_JoystickGUID mapping_guid;
 
-        if (SDL_memcmp(&mapping->guid, &s_zeroGUID, sizeof(mapping->guid)) == 0) {
+        mapping = (GamepadMapping_t *)value;
+        if (match && match->order < mapping->order) {
             continue;
         }
 
@@ -899,11 +946,11 @@ static GamepadMapping_t *SDL_PrivateMatchGamepadMappingForGUID(SDL_JoystickGUID
                 }
             }
             if (crc == mapping_crc) {
-                return mapping;
+                match = mapping;
             }
         }
     }
-    return NULL;
+    return match;
 }
 
 /*
@@ -1431,16 +1478,12 @@ static void SDL_PrivateLoadButtonMapping(SDL_Gamepad *gamepad, GamepadMapping_t
 /*
  * grab the guid string from a mapping string
  */
-static char *SDL_PrivateGetGamepadGUIDFromMappingString(const char *pMapping)
+static SDL_bool SDL_PrivateGetGamepadGUIDFromMappingString(const char *pMapping, char *pchGUID, size_t size)
 {
     const char *pFirstComma = SDL_strchr(pMapping, ',');
     if (pFirstComma) {
-        char *pchGUID = SDL_malloc(pFirstComma - pMapping + 1);
-        if (!pchGUID) {
-            return NULL;
-        }
-        SDL_memcpy(pchGUID, pMapping, pFirstComma - pMapping);
-        pchGUID[pFirstComma - pMapping] = '\0';
+        /* GUIDs are at most 32 characters, anything past that is ignored */
+        SDL_strlcpy(pchGUID, pMapping, SDL_min((size_t)(pFirstComma - pMapping) + 1, size));
 
         /* Convert old style GUIDs to the new style in 2.0.5 */
 #if defined(__WIN32__) || defined(__WINGDK__)
@@ -1460,18 +1503,21 @@ static char *SDL_PrivateGetGamepadGUIDFromMappingString(const char *pMapping)
             SDL_memcpy(&pchGUID[0], "03000000", 8);
         }
 #endif
-        return pchGUID;
+        return SDL_TRUE;
     }
-    return NULL;
+    return SDL_FALSE;
 }
 
 /*
- * grab the name string from a mapping string
+ * grab the name and button mapping string from a mapping string, in a single
+ * allocation holding the name followed by the mapping, with the CRC field
+ * replaced by `crc` if it's not 0
  */
-static char *SDL_PrivateGetGamepadNameFromMappingString(const char *pMapping)
+static char *SDL_PrivateGetGamepadNameAndMappingFromMappingString(const char *pMapping, Uint16 crc, char **mapping)
 {
-    const char *pFirstComma, *pSecondComma;
-    char *pchName;
+    const char *pFirstComma, *pSecondComma, *pEnd, *crc_string, *crc_end;
+    char *result, *dst;
+    size_t name_length, length;
 
     pFirstComma = SDL_strchr(pMapping, ',');
     if (!pFirstComma) {
@@ -1482,48 +1528,65 @@ static char *SDL_PrivateGetGamepadNameFromMappingString(const char *pMapping)
     if (!pSecondComma) {
         return NULL;
     }
+    name_length = pSecondComma - pFirstComma - 1;
 
-    pchName = SDL_malloc(pSecondComma - pFirstComma);
-    if (!pchName) {
-        return NULL;
+    /* Skip whitespace, the mapping is everything after the 3rd comma */
+    while (SDL_isspace(pSecondComma[1])) {
+        ++pSecondComma;
     }
-    SDL_memcpy(pchName, pFirstComma + 1, pSecondComma - pFirstComma);
-    pchName[pSecondComma - pFirstComma - 1] = 0;
-    return pchName;
-}
+    pMapping = pSecondComma + 1;
 
-/*
- * grab the button mapping string from a mapping string
- */
-static char *SDL_PrivateGetGamepadMappingFromMappingString(const char *pMapping)
-{
-    const char *pFirstComma, *pSecondComma;
-    char *result;
-    size_t length;
+    /* Trim whitespace */
+    pEnd = pMapping + SDL_strlen(pMapping);
+    while (pEnd > pMapping && SDL_isspace(pEnd[-1])) {
+        --pEnd;
+    }
 
-    pFirstComma = SDL_strchr(pMapping, ',');
-    if (!pFirstComma) {
-        return NULL;
+    crc_string = NULL;
+    crc_end = pEnd;
+    if (crc) {
+        crc_string = SDL_strstr(pMapping, SDL_GAMEPAD_CRC_FIELD);
+        if (crc_string && crc_string < pEnd) {
+            crc_end = SDL_strchr(crc_string, ',');
+            if (crc_end && crc_end < pEnd) {
+                ++crc_end;
+            } else {
+                crc_end = pEnd;
+            }
+        } else {
+            crc_string = pEnd;
+        }
     }
 
-    pSecondComma = SDL_strchr(pFirstComma + 1, ',');
-    if (!pSecondComma) {
-        return NULL;
+    length = name_length + 1 + (pEnd - pMapping) + 1;
+    if (crc) {
+        length += 1 + SDL_GAMEPAD_CRC_FIELD_SIZE + 4 + 1;
     }
 
-    /* Skip whitespace */
-    while (SDL_isspace(pSecondComma[1])) {
-        ++pSecondComma;
+    result = (char *)SDL_malloc(length);
+    if (!result) {
+        return NULL;
     }
 
-    result = SDL_strdup(pSecondComma + 1); /* mapping is everything after the 3rd comma */
+    SDL_memcpy(result, pFirstComma + 1, name_length);
+    result[name_length] = '\0';
+    dst = result + name_length + 1;
+    *mapping = dst;
 
-    /* Trim whitespace */
-    length = SDL_strlen(result);
-    while (SDL_isspace(result[length - 1])) {
-        --length;
+    if (crc) {
+        /* Make sure there's a comma before the CRC */
+        const size_t prefix_length = crc_string - pMapping;
+        SDL_memcpy(dst, pMapping, prefix_length);
+        dst += prefix_length;
+        if (prefix_length > 0 && dst[-1] != ',') {
+            *dst++ = ',';
+        }
+        (void)SDL_snprintf(dst, length - (dst - result), "%s%.4x,", SDL_GAMEPAD_CRC_FIELD, crc);
+        dst += SDL_strlen(dst);
+        pMapping = crc_end;
     }
-    result[length] = '\0';
+    SDL_memcpy(dst, pMapping, pEnd - pMapping);
+    dst[pEnd - pMapping] = '\0';
 
     return result;
 }
@@ -1540,51 +1603,17 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
 
     SDL_AssertJoysticksLocked();
 
-    pchName = SDL_PrivateGetGamepadNameFromMappingString(mappingString);
-    if (!pchName) {
-        SDL_SetError("Couldn't parse name from %s", mappingString);
-        return NULL;
-    }
+    /* Fix up the GUID and the mapping with the CRC, if needed */
+    SDL_GetJoystickGUIDInfo(jGUID, NULL, NULL, NULL, &crc);
 
-    pchMapping = SDL_PrivateGetGamepadMappingFromMappingString(mappingString);
-    if (!pchMapping) {
-        SDL_free(pchName);
+    /* Parse the name and mapping, making sure the mapping has the CRC */
+    pchName = SDL_PrivateGetGamepadNameAndMappingFromMappingString(mappingString, crc, &pchMapping);
+    if (!pchName) {
         SDL_SetError("Couldn't parse %s", mappingString);
         return NULL;
     }
 
-    /* Fix up the GUID and the mapping with the CRC, if needed */
-    SDL_GetJoystickGUIDInfo(jGUID, NULL, NULL, NULL, &crc);
-    if (crc) {
-        /* Make sure the mapping has the CRC */
-        char *new_mapping;
-        const char *optional_comma;
-        size_t mapping_length;
-        char *crc_end = "";
-        char *crc_string = SDL_strstr(pchMapping, SDL_GAMEPAD_CRC_FIELD);
-        if (crc_string) {
-            crc_end = SDL_strchr(crc_string, ',');
-            if (crc_end) {
-                ++crc_end;
-            } else {
-                crc_end = "";
-            }
-            *crc_string = '\0';
-        }
-
-        /* Make sure there's a comma before the CRC */
-        mapping_length = SDL_strlen(pchMapping);
-        if (mapping_length == 0 || pchMapping[mapping_length - 1] == ',') {
-            optional_comma = "";
-        } else {
-            optional_comma = ",";
-        }
-
-        if (SDL_asprintf(&new_mapping, "%s%s%s%.4x,%s", pchMapping, optional_comma, SDL_GAMEPAD_CRC_FIELD, crc, crc_end) >= 0) {
-            SDL_free(pchMapping);
-            pchMapping = new_mapping;
-        }
-    } else {
+    if (!crc) {
         /* Make sure the GUID has the CRC, for matching purposes */
         char *crc_string = SDL_strstr(pchMapping, SDL_GAMEPAD_CRC_FIELD);
         if (crc_string) {
@@ -1604,23 +1633,23 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
             /* Update existing mapping */
             SDL_free(pGamepadMapping->name);
             pGamepadMapping->name = pchName;
-            SDL_free(pGamepadMapping->mapping);
             pGamepadMapping->mapping = pchMapping;
             pGamepadMapping->priority = priority;
         } else {
             SDL_free(pchName);
-            SDL_free(pchMapping);
         }
         if (existing) {
             *existing = SDL_TRUE;
         }
         AddMappingChangeTracking(pGamepadMapping);
     } else {
-        pGamepadMapping = SDL_malloc(sizeof(*pGamepadMapping));
+        if (!s_mappingIndex) {
+            s_mappingIndex = SDL_CreateHashTable(NULL, 1024, SDL_HashGamepadGUID, SDL_KeyMatchGamepadGUID, SDL_NukeGamepadMappingIndex, SDL_TRUE);
+        }
+        pGamepadMapping = s_mappingIndex ? SDL_malloc(sizeof(*pGamepadMapping)) : NULL;
         if (!pGamepadMapping) {
             PopMappingChangeTracking();
             SDL_free(pchName);
-            SDL_free(pchMapping);
             return NULL;
         }
         /* Clear the CRC, we've already added it to the mapping */
@@ -1628,24 +1657,31 @@ static GamepadMapping_t *SDL_PrivateAddMappingForGUID(SDL_JoystickGUID jGUID, co
             SDL_SetJoystickGUIDCRC(&jGUID, 0);
         }
         pGamepadMapping->guid = jGUID;
+        pGamepadMapping->index_guid = SDL_GetGamepadMappingIndexGUID(jGUID);
+        pGamepadMapping->order = s_numSupportedGamepads;
         pGamepadMapping->name = pchName;
         pGamepadMapping->mapping = pchMapping;
         pGamepadMapping->next = NULL;
         pGamepadMapping->priority = priority;
 
-        if (s_pSupportedGamepads) {
-            /* Add the mapping to the end of the list */
-            GamepadMapping_t *pCurrMapping, *pPrevMapping;
+        /* Mappings without a GUID are only used as defaults, they're never matched */
+        if (SDL_memcmp(&jGUID, &s_zeroGUID, sizeof(jGUID)) != 0 &&
+            !SDL_InsertIntoHashTable(s_mappingIndex, &pGamepadMapping->index_guid, pGamepadMapping)) {
+            PopMappingChangeTracking();
+            SDL_free(pchName);
+            SDL_free(pGamepadMapping);
+            return NULL;
+        }
 
-            for (pPrevMapping = s_pSupportedGamepads, pCurrMapping = pPrevMapping->next;
-                 pCurrMapping;
-                 pPrevMapping = pCurrMapping, pCurrMapping = pCurrMapping->next) {
-                /* continue; */
-            }
-            pPrevMapping->next = pGamepadMapping;
+        /* Add the mapping to the end of the list */
+        if (s_pLastSupportedGamepad) {
+            s_pLastSupportedGamepad->next = pGamepadMapping;
         } else {
             s_pSupportedGamepads = pGamepadMapping;
         }
+        s_pLastSupportedGamepad = pGamepadMapping;
+        ++s_numSupportedGamepads;
+
         if (existing) {
             *existing = SDL_FALSE;
         }
@@ -1832,7 +1868,7 @@ int SDL_AddGamepadMappingsFromRW(SDL_RWops *src, SDL_bool freesrc)
                 if (platform_len + 1 < SDL_arraysize(line_platform)) {
                     SDL_strlcpy(line_platform, tmp, platform_len);
                     if (SDL_strncasecmp(line_platform, platform, platform_len) == 0 &&
-                        SDL_AddGamepadMapping(line) > 0) {
+                        SDL_PrivateAddGamepadMapping(line, SDL_GAMEPAD_MAPPING_PRIORITY_API) > 0) {
                         gamepads++;
                     }
                 }
@@ -1882,7 +1918,7 @@ int SDL_ReloadGamepadMappings(void)
  */
 static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMappingPriority priority)
 {
-    char *pchGUID;
+    char pchGUID[64];
     SDL_JoystickGUID jGUID;
     SDL_bool is_default_mapping = SDL_FALSE;
     SDL_bool is_xinput_mapping = SDL_FALSE;
@@ -1957,8 +1993,7 @@ static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMa
     }
 #endif
 
-    pchGUID = SDL_PrivateGetGamepadGUIDFromMappingString(mappingString);
-    if (!pchGUID) {
+    if (!SDL_PrivateGetGamepadGUIDFromMappingString(mappingString, pchGUID, sizeof(pchGUID))) {
         return SDL_SetError("Couldn't parse GUID from %s", mappingString);
     }
     if (!SDL_strcasecmp(pchGUID, "default")) {
@@ -1967,7 +2002,6 @@ static int SDL_PrivateAddGamepadMapping(const char *mappingString, SDL_GamepadMa
         is_xinput_mapping = SDL_TRUE;
     }
     jGUID = SDL_GetJoystickGUIDFromString(pchGUID);
-    SDL_free(pchGUID);
 
     pGamepadMapping = SDL_PrivateAddMappingForGUID(jGUID, mappingString, &existing, priority);
     if (!pGamepadMapping) {
@@ -3612,13 +3646,17 @@ void SDL_QuitGamepadMappings(void)
 
     SDL_AssertJoysticksLocked();
 
+    SDL_DestroyHashTable(s_mappingIndex);
+    s_mappingIndex = NULL;
+
     while (s_pSupportedGamepads) {
         pGamepadMap = s_pSupportedGamepads;
         s_pSupportedGamepads = s_pSupportedGamepads->next;
         SDL_free(pGamepadMap->name);
-        SDL_free(pGamepadMap->mapping);
         SDL_free(pGamepadMap);
     }
+    s_pLastSupportedGamepad = NULL;
+    s_numSupportedGamepads = 0;
 
     SDL_FreeVIDPIDList(&SDL_allowed_gamepads);
     SDL_FreeVIDPIDList(&SDL_ignored_gamepads);
@@ -117,7 +117,8 @@ static const SDL_RenderDriver *render_drivers[] = {
     &VITA_GXM_RenderDriver,
 #endif
 #if SDL_VIDEO_RENDER_SW
-    &SW_RenderDriver
+    &SW_RenderDriver,
+    &SW_MT_RenderDriver
 #endif
 };
 #endif /* !SDL_RENDER_DISABLED */
@@ -225,6 +226,200 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+/* How far back a draw can move to join others with the same texture, when reordering draws */
+#define MAX_REORDER_DISTANCE 64
+
+/* Do two draws use the same state, so they could be one draw call? */
+static SDL_bool DrawStateMatches(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    return a->data.draw.texture == b->data.draw.texture &&
+           a->data.draw.blend == b->data.draw.blend &&
+           a->data.draw.r == b->data.draw.r &&
+           a->data.draw.g == b->data.draw.g &&
+           a->data.draw.b == b->data.draw.b &&
+           a->data.draw.a == b->data.draw.a;
+}
+
+static SDL_bool DrawsOverlap(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    /* Grow the bounds by a pixel, in case the edges share pixels */
+    SDL_FRect rect = a->data.draw.bounds;
+    rect.x -= 1.0f;
+    rect.y -= 1.0f;
+    rect.w += 2.0f;
+    rect.h += 2.0f;
+    return SDL_HasRectIntersectionFloat(&rect, &b->data.draw.bounds);
+}
+
+/* Group the draws in a run of geometry by texture, as long as no draw moves past one it overlaps.
+   The draws' vertex data must be contiguous, and it's rewritten in the new order so they can be merged. */
+static void ReorderRenderCommands(SDL_Renderer *renderer, SDL_RenderCommand *prev, SDL_RenderCommand **draws, int num_draws)
+{
+    SDL_RenderCommand *next = draws[num_draws - 1]->next;
+    const size_t start = draws[0]->data.draw.first;
+    const size_t size = draws[num_draws - 1]->data.draw.end - start;
+    SDL_bool moved = SDL_FALSE;
+    size_t alignment = 16;
+    Uint8 *vertices;
+    size_t offset;
+    int i, j;
+
+    for (i = 1; i < num_draws; ++i) {
+        SDL_RenderCommand *cmd = draws[i];
+        for (j = i - 1; j >= 0 && j >= i - MAX_REORDER_DISTANCE; --j) {
+            if (DrawStateMatches(draws[j], cmd)) {
+                if (j + 1 < i) {
+                    SDL_memmove(&draws[j + 2], &draws[j + 1], (i - j - 1) * sizeof(*draws));
+                    draws[j + 1] = cmd;
+                    moved = SDL_TRUE;
+                }
+                break;
+            }
+            if (DrawsOverlap(draws[j], cmd)) {
+                break;
+            }
+        }
+    }
+
+    if (!moved) {
+        return;
+    }
+
+    /* Backends may have aligned their vertex data, so make sure every draw stays as aligned as they all were */
+    for (i = 0; i < num_draws; ++i) {
+        while (draws[i]->data.draw.first & (alignment - 1)) {
+            alignment >>= 1;
+        }
+    }
+    offset = start;
+    for (i = 0; i < num_draws; ++i) {
+        if (offset & (alignment - 1)) {
+            return;
+        }
+        offset += draws[i]->data.draw.end - draws[i]->data.draw.first;
+    }
+
+    vertices = (Uint8 *)SDL_malloc(size);
+    if (!vertices) {
+        return; /* leave the draws in the original order */
+    }
+    SDL_memcpy(vertices, (Uint8 *)renderer->vertex_data + start, size);
+
+    offset = start;
+    for (i = 0; i < num_draws; ++i) {
+        SDL_RenderCommand *cmd = draws[i];
+        const size_t len = cmd->data.draw.end - cmd->data.draw.first;
+        SDL_memcpy((Uint8 *)renderer->vertex_data + offset, vertices + (cmd->data.draw.first - start), len);
+        cmd->data.draw.first = offset;
+        cmd->data.draw.end = offset + len;
+        offset += len;
+    }
+    SDL_free(vertices);
+
+    if (prev) {
+        prev->next = draws[0];
+    } else {
+        renderer->render_commands = draws[0];
+    }
+    for (i = 0; i < num_draws - 1; ++i) {
+        draws[i]->next = draws[i + 1];
+    }
+    draws[num_draws - 1]->next = next;
+    if (!next) {
+        renderer->render_commands_tail = draws[num_draws - 1];
+    }
+}
+
+/* Find runs of geometry with no state changes in between, and group them by texture */
+static void ReorderRenderCommandQueue(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *draws[MAX_REORDER_DISTANCE * 4];
+    SDL_RenderCommand *prev = NULL;
+    SDL_RenderCommand *cmd = renderer->render_commands;
+
+    while (cmd) {
+        SDL_RenderCommand *before = prev;
+        int num_draws = 0;
+
+        while (cmd && cmd->command == SDL_RENDERCMD_GEOMETRY && cmd->data.draw.end &&
+               (num_draws == 0 || cmd->data.draw.first == draws[num_draws - 1]->data.draw.end) &&
+               num_draws < (int)SDL_arraysize(draws)) {
+            draws[num_draws++] = cmd;
+            prev = cmd;
+            cmd = cmd->next;
+        }
+
+        if (num_draws > 1) {
+            ReorderRenderCommands(renderer, before, draws, num_draws);
+            prev = draws[num_draws - 1];
+        } else if (num_draws == 0) {
+            prev = cmd;
+            cmd = cmd->next;
+        }
+    }
+}
+
+/* Merge runs of geometry that share state and contiguous vertex data into single draws */
+static void MergeRenderCommandQueue(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *cmd = renderer->render_commands;
+
+    while (cmd) {
+        SDL_RenderCommand *next = cmd->next;
+
+        if (next && cmd->command == SDL_RENDERCMD_GEOMETRY && next->command == SDL_RENDERCMD_GEOMETRY &&
+            cmd->data.draw.end && next->data.draw.first == cmd->data.draw.end && DrawStateMatches(cmd, next)) {
+            cmd->data.draw.count += next->data.draw.count;
+            cmd->data.draw.end = next->data.draw.end;
+            SDL_GetRectUnionFloat(&cmd->data.draw.bounds, &next->data.draw.bounds, &cmd->data.draw.bounds);
+
+            /* Put the merged command back in the pool */
+            cmd->next = next->next;
+            if (renderer->render_commands_tail == next) {
+                renderer->render_commands_tail = cmd;
+            }
+            next->next = renderer->render_commands_pool;
+            renderer->render_commands_pool = next;
+        } else {
+            cmd = next;
+        }
+    }
+}
+
+static int CountRenderCommands(const SDL_RenderCommand *cmd)
+{
+    int count = 0;
+    while (cmd) {
+        ++count;
+        cmd = cmd->next;
+    }
+    return count;
+}
+
+static void BatchRenderCommands(SDL_Renderer *renderer)
+{
+    int queued;
+
+    if (!renderer->batch_draws) {
+        return;
+    }
+
+    queued = CountRenderCommands(renderer->render_commands);
+    if (renderer->reorder_draws) {
+        ReorderRenderCommandQueue(renderer);
+    }
+    MergeRenderCommandQueue(renderer);
+
+    renderer->num_commands_queued += queued;
+    renderer->num_commands_submitted += CountRenderCommands(renderer->render_commands);
+}
+
+/* Vertex data goes in fixed size blocks when the backend maps them for us, so it never has to move while
+   the GPU may be reading it. System memory starts out this big, and grows while a frame is being built. */
+#define VERTEX_BLOCK_SIZE (256 * 1024)
+
+static int NextVertexBlock(SDL_Renderer *renderer, size_t minsize);
+
 static int FlushRenderCommands(SDL_Renderer *renderer)
 {
     int retval;
@@ -232,10 +427,12 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
     SDL_assert((renderer->render_commands == NULL) == (renderer->render_commands_tail == NULL));
 
     if (!renderer->render_commands) { /* nothing to do! */
-        SDL_assert(renderer->vertex_data_used == 0);
+        SDL_assert(renderer->vertex_data_used == renderer->vertex_data_start);
         return 0;
     }
 
+    BatchRenderCommands(renderer);
+
     DebugLogRenderCommands(renderer->render_commands);
 
     retval = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
@@ -247,7 +444,16 @@ static int FlushRenderCommands(SDL_Renderer *renderer)
         renderer->render_commands_tail = NULL;
         renderer->render_commands = NULL;
     }
-    renderer->vertex_data_used = 0;
+    if (renderer->vertex_data_mapped) {
+        /* The GPU may still be reading what we just submitted, so carry on after it */
+        renderer->vertex_data_start = renderer->vertex_data_used;
+    } else {
+        renderer->vertex_data_used = 0;
+        if (renderer->GetVertexBlock) {
+            /* See if the backend can map a block again next time */
+            renderer->vertex_data = NULL;
+        }
+    }
     renderer->render_command_generation++;
     renderer->color_queued = SDL_FALSE;
     renderer->viewport_queued = SDL_FALSE;
@@ -274,36 +480,51 @@ int SDL_FlushRenderer(SDL_Renderer *renderer)
     return 0;
 }
 
-void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
+/* System memory is only read when the whole queue is submitted, so it can move, and doesn't need a flush to grow */
+static int GrowVertexHeap(SDL_Renderer *renderer, size_t needed)
 {
-    const size_t needed = renderer->vertex_data_used + numbytes + alignment;
-    const size_t current_offset = renderer->vertex_data_used;
+    size_t newsize = SDL_max(renderer->vertex_data_heap_allocation, VERTEX_BLOCK_SIZE / 2) * 2;
+    void *ptr;
 
-    const size_t aligner = (alignment && ((current_offset & (alignment - 1)) != 0)) ? (alignment - (current_offset & (alignment - 1))) : 0;
-    const size_t aligned = current_offset + aligner;
+    while (newsize < needed) {
+        newsize *= 2;
+    }
 
-    if (renderer->vertex_data_allocation < needed) {
-        const size_t current_allocation = renderer->vertex_data ? renderer->vertex_data_allocation : 1024;
-        size_t newsize = current_allocation * 2;
-        void *ptr;
-        while (newsize < needed) {
-            newsize *= 2;
-        }
+    ptr = SDL_realloc(renderer->vertex_data_heap, newsize);
+    if (!ptr) {
+        return -1;
+    }
+    renderer->vertex_data_heap = ptr;
+    renderer->vertex_data_heap_allocation = newsize;
+    renderer->vertex_data = ptr;
+    renderer->vertex_data_allocation = newsize;
+    return 0;
+}
 
-        ptr = SDL_realloc(renderer->vertex_data, newsize);
+void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset)
+{
+    size_t current_offset = renderer->vertex_data_used;
+    size_t aligner = (alignment && ((current_offset & (alignment - 1)) != 0)) ? (alignment - (current_offset & (alignment - 1))) : 0;
+    size_t aligned = current_offset + aligner;
 
-        if (!ptr) {
+    if (renderer->vertex_data && !renderer->vertex_data_mapped && (aligned + numbytes) > renderer->vertex_data_allocation) {
+        if (GrowVertexHeap(renderer, aligned + numbytes) < 0) {
+            return NULL;
+        }
+    } else if (!renderer->vertex_data || (aligned + numbytes) > renderer->vertex_data_allocation) {
+        if (NextVertexBlock(renderer, numbytes + alignment) < 0) {
             return NULL;
         }
-        renderer->vertex_data = ptr;
-        renderer->vertex_data_allocation = newsize;
+        current_offset = renderer->vertex_data_used;
+        aligner = (alignment && ((current_offset & (alignment - 1)) != 0)) ? (alignment - (current_offset & (alignment - 1))) : 0;
+        aligned = current_offset + aligner;
     }
 
     if (offset) {
         *offset = aligned;
     }
 
-    renderer->vertex_data_used += aligner + numbytes;
+    renderer->vertex_data_used = aligned + numbytes;
 
     return ((Uint8 *)renderer->vertex_data) + aligned;
 }
@@ -451,6 +672,97 @@ static int QueueCmdClear(SDL_Renderer *renderer)
     return 0;
 }
 
+/* Start a new vertex block, submitting anything that's still using the current one */
+static int NextVertexBlock(SDL_Renderer *renderer, size_t minsize)
+{
+    SDL_RenderCommand *cmd = NULL;
+    int retval = 0;
+
+    if (renderer->vertex_data && renderer->vertex_data_used > renderer->vertex_data_start) {
+        /* The last command is the one being queued, hold it back until its vertices are in the new block */
+        cmd = renderer->render_commands_tail;
+        if (cmd == renderer->render_commands) {
+            renderer->render_commands = NULL;
+            renderer->render_commands_tail = NULL;
+        } else {
+            SDL_RenderCommand *prev = renderer->render_commands;
+            while (prev->next != cmd) {
+                prev = prev->next;
+            }
+            prev->next = NULL;
+            renderer->render_commands_tail = prev;
+        }
+        retval = FlushRenderCommands(renderer);
+    }
+
+    renderer->vertex_data = NULL;
+    if (renderer->GetVertexBlock) {
+        renderer->vertex_data = renderer->GetVertexBlock(renderer, minsize, &renderer->vertex_data_allocation);
+    }
+    if (renderer->vertex_data) {
+        renderer->vertex_data_mapped = SDL_TRUE;
+    } else {
+        renderer->vertex_data_mapped = SDL_FALSE;
+        if (renderer->vertex_data_heap_allocation < minsize) {
+            /* Nothing is using the old block anymore, so there's nothing to copy */
+            const size_t newsize = SDL_max(minsize, VERTEX_BLOCK_SIZE);
+            SDL_free(renderer->vertex_data_heap);
+            renderer->vertex_data_heap = SDL_malloc(newsize);
+            renderer->vertex_data_heap_allocation = renderer->vertex_data_heap ? newsize : 0;
+        }
+        renderer->vertex_data = renderer->vertex_data_heap;
+        renderer->vertex_data_allocation = renderer->vertex_data_heap_allocation;
+    }
+    renderer->vertex_data_used = 0;
+    renderer->vertex_data_start = 0;
+
+    if (cmd) {
+        /* The backends expect the state they need right before each draw, so queue it again */
+        if (cmd->command != SDL_RENDERCMD_SETVIEWPORT) {
+            QueueCmdSetViewport(renderer);
+        }
+        if (cmd->command != SDL_RENDERCMD_SETCLIPRECT) {
+            QueueCmdSetClipRect(renderer);
+        }
+        switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_COPY:
+        case SDL_RENDERCMD_COPY_EX:
+        {
+            SDL_Color color;
+            color.r = cmd->data.draw.r;
+            color.g = cmd->data.draw.g;
+            color.b = cmd->data.draw.b;
+            color.a = cmd->data.draw.a;
+            QueueCmdSetDrawColor(renderer, &color);
+            break;
+        }
+        default:
+            break;
+        }
+
+        cmd->next = NULL;
+        if (renderer->render_commands_tail) {
+            renderer->render_commands_tail->next = cmd;
+        } else {
+            renderer->render_commands = cmd;
+        }
+        renderer->render_commands_tail = cmd;
+
+        if (cmd->command >= SDL_RENDERCMD_DRAW_POINTS && cmd->data.draw.texture) {
+            /* This command is in the new queue now */
+            cmd->data.draw.texture->last_command_generation = renderer->render_command_generation;
+        }
+    }
+
+    if (!renderer->vertex_data) {
+        return -1;
+    }
+    return retval;
+}
+
 static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_RenderCommandType cmdtype, SDL_Texture *texture)
 {
     SDL_RenderCommand *cmd = NULL;
@@ -491,6 +803,7 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
             cmd->data.draw.a = color->a;
             cmd->data.draw.blend = blendMode;
             cmd->data.draw.texture = texture;
+            cmd->data.draw.end = 0; /* filled in after the backend queues it, if it can be merged */
         }
     }
     return cmd;
@@ -624,6 +937,31 @@ static int QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
     return retval;
 }
 
+static void GetGeometryBounds(const float *xy, int xy_stride, int num_vertices, float scale_x, float scale_y, SDL_FRect *bounds)
+{
+    float minx = 0.0f, miny = 0.0f, maxx = 0.0f, maxy = 0.0f;
+    int i;
+
+    for (i = 0; i < num_vertices; ++i) {
+        const float *p = (const float *)((const Uint8 *)xy + i * xy_stride);
+        const float x = p[0] * scale_x;
+        const float y = p[1] * scale_y;
+        if (i == 0) {
+            minx = maxx = x;
+            miny = maxy = y;
+        } else {
+            minx = SDL_min(minx, x);
+            maxx = SDL_max(maxx, x);
+            miny = SDL_min(miny, y);
+            maxy = SDL_max(maxy, y);
+        }
+    }
+    bounds->x = minx;
+    bounds->y = miny;
+    bounds->w = maxx - minx;
+    bounds->h = maxy - miny;
+}
+
 static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                             const float *xy, int xy_stride,
                             const SDL_Color *color, int color_stride,
@@ -643,6 +981,11 @@ static int QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          scale_x, scale_y);
         if (retval < 0) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            cmd->data.draw.end = renderer->vertex_data_used;
+            if (renderer->reorder_draws) {
+                GetGeometryBounds(xy, xy_stride, num_vertices, scale_x, scale_y, &cmd->data.draw.bounds);
+            }
         }
     }
     return retval;
@@ -908,6 +1251,9 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
     /* new textures start at zero, so we start at 1 so first render doesn't flush by accident. */
     renderer->render_command_generation = 1;
 
+    renderer->batch_draws = renderer->can_merge_draws && SDL_GetBooleanProperty(props, "batch_draws", SDL_TRUE);
+    renderer->reorder_draws = renderer->batch_draws && SDL_GetBooleanProperty(props, "reorder_draws", SDL_FALSE);
+
     renderer->line_method = SDL_GetRenderLineMethod();
 
     if (SDL_GetWindowFlags(window) & (SDL_WINDOW_HIDDEN | SDL_WINDOW_MINIMIZED)) {
@@ -985,6 +1331,8 @@ SDL_Renderer *SDL_CreateSoftwareRenderer(SDL_Surface *surface)
         /* new textures start at zero, so we start at 1 so first render doesn't flush by accident. */
         renderer->render_command_generation = 1;
 
+        renderer->batch_draws = renderer->can_merge_draws;
+
         /* Software renderer always uses line method, for speed */
         renderer->line_method = SDL_RENDERLINEMETHOD_LINES;
 
@@ -1023,6 +1371,12 @@ SDL_PropertiesID SDL_GetRendererProperties(SDL_Renderer *renderer)
     if (renderer->props == 0) {
         renderer->props = SDL_CreateProperties();
     }
+
+    /* The counts change with every flush, so they're only updated when someone asks */
+    if (renderer->props && renderer->batch_draws) {
+        SDL_SetNumberProperty(renderer->props, "SDL.renderer.commands_queued", (Sint64)renderer->num_commands_queued);
+        SDL_SetNumberProperty(renderer->props, "SDL.renderer.commands_submitted", (Sint64)renderer->num_commands_submitted);
+    }
     return renderer->props;
 }
 
@@ -4136,7 +4490,7 @@ void SDL_DestroyRenderer(SDL_Renderer *renderer)
         SDL_assert(tex != renderer->textures); /* satisfy static analysis. */
     }
 
-    SDL_free(renderer->vertex_data);
+    SDL_free(renderer->vertex_data_heap);
 
     if (renderer->window) {
         SDL_ClearProperty(SDL_GetWindowProperties(renderer->window), SDL_PROPERTY_WINDOW_RENDERER);
@@ -129,6 +129,8 @@ typedef struct SDL_RenderCommand
             Uint8 r, g, b, a;
             SDL_BlendMode blend;
             SDL_Texture *texture;
+            size_t end;       /* where the vertex data ends, filled in by the front end for merging draws. */
+            SDL_FRect bounds; /* the area drawn to, relative to the viewport, if reordering draws. */
         } draw;
         struct
         {
@@ -181,6 +183,9 @@ struct SDL_Renderer
 
     void (*InvalidateCachedState)(SDL_Renderer *renderer);
     int (*RunCommandQueue)(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize);
+    /* Optional: return a block of at least `minsize` bytes of memory the GPU can read vertices from directly,
+       or NULL to use system memory. The block has to stay valid until this is called again. */
+    void *(*GetVertexBlock)(SDL_Renderer *renderer, size_t minsize, size_t *size);
     int (*UpdateTexture)(SDL_Renderer *renderer, SDL_Texture *texture,
                          const SDL_Rect *rect, const void *pixels,
                          int pitch);
@@ -267,9 +272,22 @@ struct SDL_Renderer
     SDL_bool viewport_queued;
     SDL_bool cliprect_queued;
 
+    /* Merging draws before they go to the backend. Backends set can_merge_draws if they draw a geometry
+       command as a list of `count` vertices starting `first` bytes into the vertex data. */
+    SDL_bool can_merge_draws;
+    SDL_bool batch_draws;
+    SDL_bool reorder_draws;
+    Uint64 num_commands_queued;
+    Uint64 num_commands_submitted;
+
+    /* The block that vertex data is queued in, see SDL_AllocateRenderVertices() */
     void *vertex_data;
     size_t vertex_data_used;
     size_t vertex_data_allocation;
+    size_t vertex_data_start; /* where the vertices that haven't been submitted yet start */
+    SDL_bool vertex_data_mapped; /* the block came from GetVertexBlock() */
+    void *vertex_data_heap;
+    size_t vertex_data_heap_allocation;
 
     SDL_PropertiesID props;
 
@@ -295,6 +313,7 @@ extern SDL_RenderDriver METAL_RenderDriver;
 extern SDL_RenderDriver PS2_RenderDriver;
 extern SDL_RenderDriver PSP_RenderDriver;
 extern SDL_RenderDriver SW_RenderDriver;
+extern SDL_RenderDriver SW_MT_RenderDriver;
 extern SDL_RenderDriver VITA_GXM_RenderDriver;
 
 /* Blend mode functions */
@@ -306,8 +325,11 @@ extern SDL_BlendFactor SDL_GetBlendModeDstAlphaFactor(SDL_BlendMode blendMode);
 extern SDL_BlendOperation SDL_GetBlendModeAlphaOperation(SDL_BlendMode blendMode);
 
 /* drivers call this during their Queue*() methods to make space in a array that are used
-   for a vertex buffer during RunCommandQueue(). Pointers returned here are only valid until
-   the next call, because it might be in an array that gets realloc()'d. */
+   for a vertex buffer during RunCommandQueue(). Commands refer to their vertices by the
+   returned offset. The pointer is only valid until the next call, because system memory
+   vertex data is grown with SDL_realloc(). Only a block from GetVertexBlock() stays put;
+   when it's full, the commands queued before the one being queued now are submitted first,
+   and its data goes at the start of a new block. */
 extern void *SDL_AllocateRenderVertices(SDL_Renderer *renderer, const size_t numbytes, const size_t alignment, size_t *offset);
 
 /* Ends C function definitions when using C++ */
@@ -51,6 +51,22 @@
 
 static const float inv255f = 1.0f / 255.0f;
 
+/* Vertices are written straight into persistently mapped buffers when we can.
+   The front end fills the blocks in turn, and the fences make sure the GPU is
+   done with a block before it gets written over. */
+#define GL_VERTEX_BLOCK_SIZE  (1024 * 1024)
+#define GL_NUM_VERTEX_BLOCKS  3
+
+/* How long to wait for the GPU to finish with a block, before giving it a new buffer instead */
+#define GL_VERTEX_BLOCK_WAIT_NS  SDL_MS_TO_NS(100)
+
+typedef struct
+{
+    GLuint buffer;
+    void *pointer;
+    GLsync fence;
+} GL_VertexBlock;
+
 typedef struct GL_FBOList GL_FBOList;
 
 struct GL_FBOList
@@ -119,6 +135,19 @@ typedef struct
     PFNGLBINDFRAMEBUFFEREXTPROC glBindFramebufferEXT;
     PFNGLCHECKFRAMEBUFFERSTATUSEXTPROC glCheckFramebufferStatusEXT;
 
+    /* Persistently mapped vertex buffer support */
+    SDL_bool GL_ARB_buffer_storage_supported;
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERSTORAGEPROC glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+    GL_VertexBlock vertex_blocks[GL_NUM_VERTEX_BLOCKS];
+    int vertex_block;
+
     /* Shader support */
     GL_ShaderContext *shaders;
 
@@ -1049,6 +1078,60 @@ static int GL_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     return 0;
 }
 
+static void *GL_GetVertexBlock(SDL_Renderer *renderer, size_t minsize, size_t *size)
+{
+    GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_VertexBlock *block;
+
+    if (!data->GL_ARB_buffer_storage_supported || minsize > GL_VERTEX_BLOCK_SIZE) {
+        return NULL;
+    }
+    if (GL_ActivateRenderer(renderer) < 0) {
+        return NULL;
+    }
+
+    data->vertex_block = (data->vertex_block + 1) % GL_NUM_VERTEX_BLOCKS;
+    block = &data->vertex_blocks[data->vertex_block];
+
+    if (block->fence) {
+        /* Wait for the GPU to finish drawing what we put in this block last time around */
+        const GLenum status = data->glClientWaitSync(block->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_VERTEX_BLOCK_WAIT_NS);
+        data->glDeleteSync(block->fence);
+        block->fence = NULL;
+
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            /* Orphan the buffer rather than wait any longer. The driver keeps its storage
+               alive until the GPU is done with it, and we start over with a fresh one. */
+            if (status == GL_WAIT_FAILED) {
+                GL_ClearErrors(renderer);
+            }
+            data->glDeleteBuffers(1, &block->buffer);
+            block->buffer = 0;
+            block->pointer = NULL;
+        }
+    }
+
+    if (!block->pointer) {
+        data->glGenBuffers(1, &block->buffer);
+        data->glBindBuffer(GL_ARRAY_BUFFER, block->buffer);
+        data->glBufferStorage(GL_ARRAY_BUFFER, GL_VERTEX_BLOCK_SIZE, NULL, flags);
+        block->pointer = data->glMapBufferRange(GL_ARRAY_BUFFER, 0, GL_VERTEX_BLOCK_SIZE, flags);
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        if (!block->pointer) {
+            /* Fall back to client side vertex arrays */
+            GL_ClearErrors(renderer);
+            data->glDeleteBuffers(1, &block->buffer);
+            block->buffer = 0;
+            data->GL_ARB_buffer_storage_supported = SDL_FALSE;
+            return NULL;
+        }
+    }
+
+    *size = GL_VERTEX_BLOCK_SIZE;
+    return block->pointer;
+}
+
 static int SetDrawState(GL_RenderData *data, const SDL_RenderCommand *cmd, const GL_Shader shader)
 {
     const SDL_BlendMode blend = cmd->data.draw.blend;
@@ -1218,13 +1301,25 @@ static void GL_InvalidateCachedState(SDL_Renderer *renderer)
 
 static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
-    /* !!! FIXME: it'd be nice to use a vertex buffer instead of immediate mode... */
     GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    GL_VertexBlock *block = NULL;
+    uintptr_t vertex_base = (uintptr_t)vertices;
 
     if (GL_ActivateRenderer(renderer) < 0) {
         return -1;
     }
 
+    if (data->GL_ARB_buffer_storage_supported) {
+        /* If the vertices are already in a mapped buffer, draw from there, otherwise from client memory */
+        if (vertices == data->vertex_blocks[data->vertex_block].pointer) {
+            block = &data->vertex_blocks[data->vertex_block];
+            data->glBindBuffer(GL_ARRAY_BUFFER, block->buffer);
+            vertex_base = 0;
+        } else {
+            data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
     data->drawstate.target = renderer->target;
     if (!data->drawstate.target) {
         int w, h;
@@ -1325,7 +1420,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         {
             if (SetDrawState(data, cmd, SHADER_SOLID) == 0) {
                 size_t count = cmd->data.draw.count;
-                const GLfloat *verts = (GLfloat *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                const GLfloat *verts = (const GLfloat *)(vertex_base + cmd->data.draw.first);
 
                 /* SetDrawState handles glEnableClientState. */
                 data->glVertexPointer(2, GL_FLOAT, sizeof(float) * 2, verts);
@@ -1393,7 +1488,7 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
             }
 
             if (ret == 0) {
-                const GLfloat *verts = (GLfloat *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                const GLfloat *verts = (const GLfloat *)(vertex_base + cmd->data.draw.first);
                 int op = GL_TRIANGLES; /* SDL_RENDERCMD_GEOMETRY */
                 if (thiscmdtype == SDL_RENDERCMD_DRAW_POINTS) {
                     op = GL_POINTS;
@@ -1453,6 +1548,15 @@ static int GL_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
         data->drawstate.texture_array = SDL_FALSE;
     }
 
+    if (block) {
+        /* Mark where the GPU is done with this block, the front end keeps filling it after what we just drew */
+        if (block->fence) {
+            data->glDeleteSync(block->fence);
+        }
+        block->fence = data->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        data->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
     return GL_CheckError("", renderer);
 }
 
@@ -1576,6 +1680,7 @@ static void GL_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 static void GL_DestroyRenderer(SDL_Renderer *renderer)
 {
     GL_RenderData *data = (GL_RenderData *)renderer->driverdata;
+    int i;
 
     if (data) {
         if (data->context) {
@@ -1603,6 +1708,15 @@ static void GL_DestroyRenderer(SDL_Renderer *renderer)
                 SDL_free(data->framebuffers);
                 data->framebuffers = nextnode;
             }
+            for (i = 0; i < GL_NUM_VERTEX_BLOCKS; ++i) {
+                GL_VertexBlock *block = &data->vertex_blocks[i];
+                if (block->fence) {
+                    data->glDeleteSync(block->fence);
+                }
+                if (block->buffer) {
+                    data->glDeleteBuffers(1, &block->buffer);
+                }
+            }
             SDL_GL_DeleteContext(data->context);
         }
         SDL_free(data);
@@ -1821,6 +1935,7 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
     renderer->QueueDrawPoints = GL_QueueDrawPoints;
     renderer->QueueDrawLines = GL_QueueDrawLines;
     renderer->QueueGeometry = GL_QueueGeometry;
+    renderer->can_merge_draws = SDL_TRUE;
     renderer->InvalidateCachedState = GL_InvalidateCachedState;
     renderer->RunCommandQueue = GL_RunCommandQueue;
     renderer->RenderReadPixels = GL_RenderReadPixels;
@@ -1948,6 +2063,28 @@ static SDL_Renderer *GL_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
         }
     }
 
+    /* Check for persistently mapped vertex buffer support */
+    if (SDL_GL_ExtensionSupported("GL_ARB_buffer_storage") &&
+        SDL_GL_ExtensionSupported("GL_ARB_map_buffer_range") &&
+        SDL_GL_ExtensionSupported("GL_ARB_sync")) {
+        data->glGenBuffers = (PFNGLGENBUFFERSPROC)SDL_GL_GetProcAddress("glGenBuffers");
+        data->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)SDL_GL_GetProcAddress("glDeleteBuffers");
+        data->glBindBuffer = (PFNGLBINDBUFFERPROC)SDL_GL_GetProcAddress("glBindBuffer");
+        data->glBufferStorage = (PFNGLBUFFERSTORAGEPROC)SDL_GL_GetProcAddress("glBufferStorage");
+        data->glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)SDL_GL_GetProcAddress("glMapBufferRange");
+        data->glFenceSync = (PFNGLFENCESYNCPROC)SDL_GL_GetProcAddress("glFenceSync");
+        data->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)SDL_GL_GetProcAddress("glClientWaitSync");
+        data->glDeleteSync = (PFNGLDELETESYNCPROC)SDL_GL_GetProcAddress("glDeleteSync");
+        if (data->glGenBuffers && data->glDeleteBuffers && data->glBindBuffer &&
+            data->glBufferStorage && data->glMapBufferRange &&
+            data->glFenceSync && data->glClientWaitSync && data->glDeleteSync) {
+            data->GL_ARB_buffer_storage_supported = SDL_TRUE;
+            renderer->GetVertexBlock = GL_GetVertexBlock;
+        }
+    }
+    SDL_LogInfo(SDL_LOG_CATEGORY_RENDER, "OpenGL persistent vertex buffers: %s",
+                data->GL_ARB_buffer_storage_supported ? "ENABLED" : "DISABLED");
+
     /* Check for shader support */
     if (SDL_GetHintBoolean(SDL_HINT_RENDER_OPENGL_SHADERS, SDL_TRUE)) {
         data->shaders = GL_CreateShaderContext();
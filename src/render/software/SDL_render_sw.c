@@ -33,6 +33,7 @@
 #include "SDL_drawpoint.h"
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
+#include "../../SDL_hashtable.h"
 
 /* SDL surface based renderer implementation */
 
@@ -47,6 +48,7 @@ typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+    struct SW_TileRenderer *tiler; /* NULL unless this is the "software-mt" renderer */
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -112,7 +114,8 @@ static int SW_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_Pr
     /* Only RLE encode textures without an alpha channel since the RLE coder
      * discards the color values of pixels with an alpha value of zero.
      */
-    if (texture->access == SDL_TEXTUREACCESS_STATIC && !surface->format->Amask) {
+    if (texture->access == SDL_TEXTUREACCESS_STATIC && !surface->format->Amask &&
+        !((SW_RenderData *)renderer->driverdata)->tiler) { /* RLE surfaces can't be shared by the tile jobs */
         SDL_SetSurfaceRLE(texture->driverdata, 1);
     }
 
@@ -613,15 +616,13 @@ static int SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_
     return 0;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd)
+static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SDL_Surface *surface)
 {
     const Uint8 r = cmd->data.draw.r;
     const Uint8 g = cmd->data.draw.g;
     const Uint8 b = cmd->data.draw.b;
     const Uint8 a = cmd->data.draw.a;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
     const SDL_bool colormod = ((r & g & b) != 0xFF);
     const SDL_bool alphamod = (a != 0xFF);
     const SDL_bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -636,24 +637,30 @@ static void PrepTextureForCopy(const SDL_RenderCommand *cmd)
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
+/* The area drawing is limited to by the viewport and clip rect, before clipping to the surface */
+static void GetDrawClipRect(const SW_DrawStateCache *drawstate, SDL_Rect *clip_rect)
+{
+    const SDL_Rect *viewport = drawstate->viewport;
+    const SDL_Rect *cliprect = drawstate->cliprect;
+    SDL_assert_release(viewport != NULL); /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
+
+    if (cliprect && viewport) {
+        clip_rect->x = cliprect->x + viewport->x;
+        clip_rect->y = cliprect->y + viewport->y;
+        clip_rect->w = cliprect->w;
+        clip_rect->h = cliprect->h;
+        SDL_GetRectIntersection(viewport, clip_rect, clip_rect);
+    } else {
+        *clip_rect = *viewport;
+    }
+}
+
 static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
 {
     if (drawstate->surface_cliprect_dirty) {
-        const SDL_Rect *viewport = drawstate->viewport;
-        const SDL_Rect *cliprect = drawstate->cliprect;
-        SDL_assert_release(viewport != NULL); /* the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT */
-
-        if (cliprect && viewport) {
-            SDL_Rect clip_rect;
-            clip_rect.x = cliprect->x + viewport->x;
-            clip_rect.y = cliprect->y + viewport->y;
-            clip_rect.w = cliprect->w;
-            clip_rect.h = cliprect->h;
-            SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
-            SDL_SetSurfaceClipRect(surface, &clip_rect);
-        } else {
-            SDL_SetSurfaceClipRect(surface, drawstate->viewport);
-        }
+        SDL_Rect clip_rect;
+        GetDrawClipRect(drawstate, &clip_rect);
+        SDL_SetSurfaceClipRect(surface, &clip_rect);
         drawstate->surface_cliprect_dirty = SDL_FALSE;
     }
 }
@@ -664,6 +671,272 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
 }
 
 
+static void SW_RunCommand(SDL_Renderer *renderer, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
+{
+    switch (cmd->command) {
+    case SDL_RENDERCMD_SETDRAWCOLOR:
+    {
+        break; /* Not used in this backend. */
+    }
+
+    case SDL_RENDERCMD_SETVIEWPORT:
+    {
+        drawstate->viewport = &cmd->data.viewport.rect;
+        drawstate->surface_cliprect_dirty = SDL_TRUE;
+        break;
+    }
+
+    case SDL_RENDERCMD_SETCLIPRECT:
+    {
+        drawstate->cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
+        drawstate->surface_cliprect_dirty = SDL_TRUE;
+        break;
+    }
+
+    case SDL_RENDERCMD_CLEAR:
+    {
+        const Uint8 r = cmd->data.color.r;
+        const Uint8 g = cmd->data.color.g;
+        const Uint8 b = cmd->data.color.b;
+        const Uint8 a = cmd->data.color.a;
+        /* By definition the clear ignores the clip rect */
+        SDL_SetSurfaceClipRect(surface, NULL);
+        SDL_FillSurfaceRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
+        drawstate->surface_cliprect_dirty = SDL_TRUE;
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_POINTS:
+    {
+        const Uint8 r = cmd->data.draw.r;
+        const Uint8 g = cmd->data.draw.g;
+        const Uint8 b = cmd->data.draw.b;
+        const Uint8 a = cmd->data.draw.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+        } else {
+            SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_DRAW_LINES:
+    {
+        const Uint8 r = cmd->data.draw.r;
+        const Uint8 g = cmd->data.draw.g;
+        const Uint8 b = cmd->data.draw.b;
+        const Uint8 a = cmd->data.draw.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+        } else {
+            SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const Uint8 r = cmd->data.draw.r;
+        const Uint8 g = cmd->data.draw.g;
+        const Uint8 b = cmd->data.draw.b;
+        const Uint8 a = cmd->data.draw.a;
+        const int count = (int)cmd->data.draw.count;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+        SetDrawState(surface, drawstate);
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            int i;
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        if (blend == SDL_BLENDMODE_NONE) {
+            SDL_FillSurfaceRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+        } else {
+            SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const SDL_Rect *srcrect = verts;
+        SDL_Rect *dstrect = verts + 1;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        SDL_Surface *src = (SDL_Surface *)texture->driverdata;
+
+        SetDrawState(surface, drawstate);
+
+        PrepTextureForCopy(cmd, (SDL_Surface *)cmd->data.draw.texture->driverdata);
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            dstrect->x += drawstate->viewport->x;
+            dstrect->y += drawstate->viewport->y;
+        }
+
+        if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
+            SDL_BlitSurface(src, srcrect, surface, dstrect);
+        } else {
+            /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
+             * to avoid potentially frequent RLE encoding/decoding.
+             */
+            SDL_SetSurfaceRLE(surface, 0);
+
+            /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
+            if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
+                SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format->format);
+                /* Scale to an intermediate surface, then blit */
+                if (tmp) {
+                    SDL_Rect r;
+                    SDL_BlendMode blendmode;
+                    Uint8 alphaMod, rMod, gMod, bMod;
+
+                    SDL_GetSurfaceBlendMode(src, &blendmode);
+                    SDL_GetSurfaceAlphaMod(src, &alphaMod);
+                    SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
+
+                    r.x = 0;
+                    r.y = 0;
+                    r.w = dstrect->w;
+                    r.h = dstrect->h;
+
+                    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
+                    SDL_SetSurfaceColorMod(src, 255, 255, 255);
+                    SDL_SetSurfaceAlphaMod(src, 255);
+
+                    SDL_BlitSurfaceScaled(src, srcrect, tmp, &r, texture->scaleMode);
+
+                    SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
+                    SDL_SetSurfaceAlphaMod(tmp, alphaMod);
+                    SDL_SetSurfaceBlendMode(tmp, blendmode);
+
+                    SDL_BlitSurface(tmp, NULL, surface, dstrect);
+                    SDL_DestroySurface(tmp);
+                    /* No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy() */
+                }
+            } else {
+                SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, texture->scaleMode);
+            }
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_COPY_EX:
+    {
+        CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        SetDrawState(surface, drawstate);
+        PrepTextureForCopy(cmd, (SDL_Surface *)cmd->data.draw.texture->driverdata);
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            copydata->dstrect.x += drawstate->viewport->x;
+            copydata->dstrect.y += drawstate->viewport->y;
+        }
+
+        SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
+                        &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
+                        copydata->scale_x, copydata->scale_y);
+        break;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        int i;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        const int count = (int)cmd->data.draw.count;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        const SDL_BlendMode blend = cmd->data.draw.blend;
+
+        SetDrawState(surface, drawstate);
+
+        if (texture) {
+            SDL_Surface *src = (SDL_Surface *)texture->driverdata;
+
+            GeometryCopyData *ptr = (GeometryCopyData *)verts;
+
+            PrepTextureForCopy(cmd, (SDL_Surface *)cmd->data.draw.texture->driverdata);
+
+            /* Apply viewport */
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                SDL_Point vp;
+                vp.x = drawstate->viewport->x;
+                vp.y = drawstate->viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_SW_BlitTriangle(
+                    src,
+                    &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
+                    surface,
+                    &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                    ptr[0].color, ptr[1].color, ptr[2].color);
+            }
+        } else {
+            GeometryFillData *ptr = (GeometryFillData *)verts;
+
+            /* Apply viewport */
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                SDL_Point vp;
+                vp.x = drawstate->viewport->x;
+                vp.y = drawstate->viewport->y;
+                trianglepoint_2_fixedpoint(&vp);
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+
+            for (i = 0; i < count; i += 3, ptr += 3) {
+                SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
+            }
+        }
+        break;
+    }
+
+    case SDL_RENDERCMD_NO_OP:
+        break;
+    }
+}
+
 static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
@@ -678,272 +951,628 @@ static int SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, vo
     drawstate.surface_cliprect_dirty = SDL_TRUE;
 
     while (cmd) {
-        switch (cmd->command) {
-        case SDL_RENDERCMD_SETDRAWCOLOR:
-        {
-            break; /* Not used in this backend. */
-        }
+        SW_RunCommand(renderer, surface, cmd, vertices, &drawstate);
+        cmd = cmd->next;
+    }
 
-        case SDL_RENDERCMD_SETVIEWPORT:
-        {
-            drawstate.viewport = &cmd->data.viewport.rect;
-            drawstate.surface_cliprect_dirty = SDL_TRUE;
-            break;
-        }
+    return 0;
+}
 
-        case SDL_RENDERCMD_SETCLIPRECT:
-        {
-            drawstate.cliprect = cmd->data.cliprect.enabled ? &cmd->data.cliprect.rect : NULL;
-            drawstate.surface_cliprect_dirty = SDL_TRUE;
-            break;
-        }
+/* Multithreaded tile renderer, used by the "software-mt" driver.
+ *
+ * Commands that give the same pixels no matter how they're clipped (clears, fills, unscaled copies and
+ * triangles) are binned into screen tiles, and the tiles are drawn in parallel by the SDL job system.
+ * Each job draws through its own view of the target surface and its own views of the textures, so clip
+ * rects and blit mappings aren't shared. Anything else (points, lines, scaled and rotated copies) waits
+ * for the tiles in flight and is drawn by the rendering thread exactly like the "software" driver does.
+ */
+
+#define SW_TILE_SIZE 128
+
+typedef struct SW_TiledOp
+{
+    SDL_RenderCommand *cmd;
+    SDL_Rect clip;          /* the viewport and clip rect, in surface coordinates */
+    int first;              /* first vertex of the triangle, for SDL_RENDERCMD_GEOMETRY */
+    SDL_Surface **textures; /* each job's view of the texture, or NULL */
+} SW_TiledOp;
+
+typedef struct SW_TileBin
+{
+    int *ops;
+    int num_ops;
+    int max_ops;
+} SW_TileBin;
+
+typedef struct SW_TileJob
+{
+    struct SW_TileRenderer *tiler;
+    int index;
+    SDL_Surface *target; /* this job's view of the render target */
+} SW_TileJob;
+
+typedef struct SW_TileRenderer
+{
+    SDL_AtomicInt next_tile;
+
+    int num_jobs;             /* how many tiles can be drawn at once */
+    SW_TileJob *jobs;
+
+    SDL_Surface *target;      /* what the jobs' target views were made for */
+    void *vertices;
+    int tiles_x;
+    int num_tiles;
+    SW_TileBin *bins;
+    int max_bins;
+    SW_TiledOp *ops;
+    int num_ops;
+    int max_ops;
+    SDL_HashTable *textures;  /* SDL_Texture * -> SDL_Surface *[num_jobs] */
+} SW_TileRenderer;
+
+static void SW_DrawTile(SW_TileJob *job, int tile)
+{
+    SW_TileRenderer *tiler = job->tiler;
+    const SW_TileBin *bin = &tiler->bins[tile];
+    SDL_Surface *surface = job->target;
+    SDL_Rect tile_rect;
+    int i, j;
+
+    tile_rect.x = (tile % tiler->tiles_x) * SW_TILE_SIZE;
+    tile_rect.y = (tile / tiler->tiles_x) * SW_TILE_SIZE;
+    tile_rect.w = SW_TILE_SIZE;
+    tile_rect.h = SW_TILE_SIZE;
+
+    for (i = 0; i < bin->num_ops; i++) {
+        const SW_TiledOp *op = &tiler->ops[bin->ops[i]];
+        SDL_RenderCommand *cmd = op->cmd;
+        SDL_Rect clip_rect;
 
+        SDL_GetRectIntersection(&op->clip, &tile_rect, &clip_rect);
+        SDL_SetSurfaceClipRect(surface, &clip_rect);
+
+        switch (cmd->command) {
         case SDL_RENDERCMD_CLEAR:
         {
             const Uint8 r = cmd->data.color.r;
             const Uint8 g = cmd->data.color.g;
             const Uint8 b = cmd->data.color.b;
             const Uint8 a = cmd->data.color.a;
-            /* By definition the clear ignores the clip rect */
-            SDL_SetSurfaceClipRect(surface, NULL);
             SDL_FillSurfaceRect(surface, NULL, SDL_MapRGBA(surface->format, r, g, b, a));
-            drawstate.surface_cliprect_dirty = SDL_TRUE;
             break;
         }
 
-        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_FILL_RECTS:
         {
             const Uint8 r = cmd->data.draw.r;
             const Uint8 g = cmd->data.draw.g;
             const Uint8 b = cmd->data.draw.b;
             const Uint8 a = cmd->data.draw.a;
             const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            const SDL_Rect *verts = (const SDL_Rect *)(((Uint8 *)tiler->vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
 
             if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawPoints(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+                SDL_FillSurfaceRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
             } else {
-                SDL_BlendPoints(surface, verts, count, blend, r, g, b, a);
+                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
             }
             break;
         }
 
-        case SDL_RENDERCMD_DRAW_LINES:
+        case SDL_RENDERCMD_COPY:
         {
-            const Uint8 r = cmd->data.draw.r;
-            const Uint8 g = cmd->data.draw.g;
-            const Uint8 b = cmd->data.draw.b;
-            const Uint8 a = cmd->data.draw.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
+            const SDL_Rect *verts = (const SDL_Rect *)(((Uint8 *)tiler->vertices) + cmd->data.draw.first);
+            SDL_Surface *src = op->textures[job->index];
+            SDL_Rect dstrect = verts[1]; /* SDL_BlitSurface() changes this */
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_DrawLines(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
-            } else {
-                SDL_BlendLines(surface, verts, count, blend, r, g, b, a);
-            }
+            PrepTextureForCopy(cmd, src);
+            SDL_BlitSurface(src, &verts[0], surface, &dstrect);
             break;
         }
 
-        case SDL_RENDERCMD_FILL_RECTS:
+        case SDL_RENDERCMD_GEOMETRY:
         {
-            const Uint8 r = cmd->data.draw.r;
-            const Uint8 g = cmd->data.draw.g;
-            const Uint8 b = cmd->data.draw.b;
-            const Uint8 a = cmd->data.draw.a;
-            const int count = (int)cmd->data.draw.count;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
+            const GeometryFillData *fill = (const GeometryFillData *)(((Uint8 *)tiler->vertices) + op->first);
+            const GeometryCopyData *copy = (const GeometryCopyData *)fill;
+            SDL_Rect bounds;
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
+            /* The triangle may have been binned here only because its bounds were rounded out */
+            if (op->textures) {
+                SDL_SW_GetTriangleBounds(&copy[0].dst, &copy[1].dst, &copy[2].dst, &bounds);
+            } else {
+                SDL_SW_GetTriangleBounds(&fill[0].dst, &fill[1].dst, &fill[2].dst, &bounds);
+            }
+            if (!SDL_GetRectIntersection(&bounds, &clip_rect, &bounds)) {
+                break;
             }
 
-            if (blend == SDL_BLENDMODE_NONE) {
-                SDL_FillSurfaceRects(surface, verts, count, SDL_MapRGBA(surface->format, r, g, b, a));
+            if (op->textures) {
+                const GeometryCopyData *ptr = copy;
+                SDL_Surface *src = op->textures[job->index];
+                SDL_Point s[3], d[3];
+
+                /* SDL_SW_BlitTriangle() changes the points, and the next tile needs them too */
+                for (j = 0; j < 3; j++) {
+                    s[j] = ptr[j].src;
+                    d[j] = ptr[j].dst;
+                }
+                PrepTextureForCopy(cmd, src);
+                SDL_SW_BlitTriangle(src, &s[0], &s[1], &s[2], surface, &d[0], &d[1], &d[2],
+                                    ptr[0].color, ptr[1].color, ptr[2].color);
             } else {
-                SDL_BlendFillRects(surface, verts, count, blend, r, g, b, a);
+                const GeometryFillData *ptr = fill;
+                SDL_Point d[3];
+
+                for (j = 0; j < 3; j++) {
+                    d[j] = ptr[j].dst;
+                }
+                SDL_SW_FillTriangle(surface, &d[0], &d[1], &d[2], cmd->data.draw.blend, ptr[0].color, ptr[1].color, ptr[2].color);
             }
             break;
         }
 
-        case SDL_RENDERCMD_COPY:
-        {
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const SDL_Rect *srcrect = verts;
-            SDL_Rect *dstrect = verts + 1;
-            SDL_Texture *texture = cmd->data.draw.texture;
-            SDL_Surface *src = (SDL_Surface *)texture->driverdata;
+        default:
+            SDL_assert(!"Command can't be drawn in tiles");
+            break;
+        }
+    }
+}
 
-            SetDrawState(surface, &drawstate);
+/* Each job takes tiles as it gets to them, so the jobs that start first draw more of them. */
+static void SDLCALL SW_DrawTiles(void *userdata, int start, int end)
+{
+    SW_TileRenderer *tiler = (SW_TileRenderer *)userdata;
+    int i, tile;
 
-            PrepTextureForCopy(cmd);
+    for (i = start; i < end; i++) {
+        SW_TileJob *job = &tiler->jobs[i];
+        while ((tile = SDL_AtomicAdd(&tiler->next_tile, 1)) < tiler->num_tiles) {
+            SW_DrawTile(job, tile);
+        }
+    }
+}
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
-            }
+/* Make sure every job has a view of `surface` to draw into. */
+static int SW_UpdateTileTargets(SW_TileRenderer *tiler, SDL_Surface *surface)
+{
+    int i;
 
-            if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
-                SDL_BlitSurface(src, srcrect, surface, dstrect);
-            } else {
-                /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
-                 * to avoid potentially frequent RLE encoding/decoding.
-                 */
-                SDL_SetSurfaceRLE(surface, 0);
-
-                /* Prevent to do scaling + clipping on viewport boundaries as it may lose proportion */
-                if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                    SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format->format);
-                    /* Scale to an intermediate surface, then blit */
-                    if (tmp) {
-                        SDL_Rect r;
-                        SDL_BlendMode blendmode;
-                        Uint8 alphaMod, rMod, gMod, bMod;
-
-                        SDL_GetSurfaceBlendMode(src, &blendmode);
-                        SDL_GetSurfaceAlphaMod(src, &alphaMod);
-                        SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
-
-                        r.x = 0;
-                        r.y = 0;
-                        r.w = dstrect->w;
-                        r.h = dstrect->h;
-
-                        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_NONE);
-                        SDL_SetSurfaceColorMod(src, 255, 255, 255);
-                        SDL_SetSurfaceAlphaMod(src, 255);
-
-                        SDL_BlitSurfaceScaled(src, srcrect, tmp, &r, texture->scaleMode);
-
-                        SDL_SetSurfaceColorMod(tmp, rMod, gMod, bMod);
-                        SDL_SetSurfaceAlphaMod(tmp, alphaMod);
-                        SDL_SetSurfaceBlendMode(tmp, blendmode);
-
-                        SDL_BlitSurface(tmp, NULL, surface, dstrect);
-                        SDL_DestroySurface(tmp);
-                        /* No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy() */
-                    }
-                } else {
-                    SDL_BlitSurfaceScaled(src, srcrect, surface, dstrect, texture->scaleMode);
+    if (tiler->target == surface && tiler->jobs[0].target &&
+        tiler->jobs[0].target->pixels == surface->pixels &&
+        tiler->jobs[0].target->w == surface->w &&
+        tiler->jobs[0].target->h == surface->h &&
+        tiler->jobs[0].target->pitch == surface->pitch &&
+        tiler->jobs[0].target->format == surface->format) {
+        return 0;
+    }
+
+    tiler->target = NULL;
+    for (i = 0; i < tiler->num_jobs; i++) {
+        SDL_DestroySurface(tiler->jobs[i].target); /* this also resets any blits mapped to it */
+        tiler->jobs[i].target = NULL;
+    }
+
+    for (i = 0; i < tiler->num_jobs; i++) {
+        SDL_Surface *target = SDL_CreateSurfaceFrom(surface->pixels, surface->w, surface->h, surface->pitch, surface->format->format);
+        if (!target) {
+            return -1;
+        }
+        if (surface->format->palette) {
+            SDL_SetSurfacePalette(target, surface->format->palette);
+        }
+        tiler->jobs[i].target = target;
+    }
+    tiler->target = surface;
+    return 0;
+}
+
+static void SW_NukeTileTextures(const void *key, const void *value, void *data)
+{
+    SW_TileRenderer *tiler = (SW_TileRenderer *)data;
+    SDL_Surface **textures = (SDL_Surface **)value;
+    int i;
+
+    for (i = 0; i < tiler->num_jobs; i++) {
+        SDL_DestroySurface(textures[i]);
+    }
+    SDL_free(textures);
+}
+
+/* Get each job's view of a texture, so they can set their own blend and color modulation on it. */
+static SDL_Surface **SW_GetTileTextures(SW_TileRenderer *tiler, SDL_Texture *texture)
+{
+    SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
+    SDL_Surface **textures;
+    int i;
+
+    if (SDL_FindInHashTable(tiler->textures, texture, (const void **)&textures)) {
+        return textures;
+    }
+
+    if (SDL_MUSTLOCK(surface)) {
+        return NULL; /* RLE encoded; this needs to go through the original surface. */
+    }
+
+    textures = (SDL_Surface **)SDL_calloc(tiler->num_jobs, sizeof(*textures));
+    if (!textures) {
+        return NULL;
+    }
+    for (i = 0; i < tiler->num_jobs; i++) {
+        textures[i] = SDL_CreateSurfaceFrom(surface->pixels, surface->w, surface->h, surface->pitch, surface->format->format);
+        if (!textures[i]) {
+            SW_NukeTileTextures(texture, textures, tiler);
+            return NULL;
+        }
+        if (surface->format->palette) {
+            SDL_SetSurfacePalette(textures[i], surface->format->palette);
+        }
+    }
+    if (!SDL_InsertIntoHashTable(tiler->textures, texture, textures)) {
+        SW_NukeTileTextures(texture, textures, tiler);
+        return NULL;
+    }
+    return textures;
+}
+
+/* Add a command to every tile it touches. Returns -1 if it couldn't be binned, and needs to be drawn directly,
+ * in which case it may already be in some of the tiles, and has to be taken out with SW_UnbinTiledOps().
+ */
+static int SW_BinTiledOp(SW_TileRenderer *tiler, SDL_RenderCommand *cmd, const SDL_Rect *clip, const SDL_Rect *bounds, int first, SDL_Surface **textures)
+{
+    SDL_Rect rect;
+    int x, y, x0, y0, x1, y1;
+    int index;
+
+    if (!SDL_GetRectIntersection(clip, bounds, &rect)) {
+        return 0; /* nothing to draw */
+    }
+
+    if (tiler->num_ops == tiler->max_ops) {
+        const int max_ops = tiler->max_ops ? (tiler->max_ops * 2) : 256;
+        SW_TiledOp *ops = (SW_TiledOp *)SDL_realloc(tiler->ops, max_ops * sizeof(*ops));
+        if (!ops) {
+            return -1;
+        }
+        tiler->ops = ops;
+        tiler->max_ops = max_ops;
+    }
+
+    index = tiler->num_ops++;
+    tiler->ops[index].cmd = cmd;
+    tiler->ops[index].clip = *clip;
+    tiler->ops[index].first = first;
+    tiler->ops[index].textures = textures;
+
+    x0 = rect.x / SW_TILE_SIZE;
+    y0 = rect.y / SW_TILE_SIZE;
+    x1 = (rect.x + rect.w - 1) / SW_TILE_SIZE;
+    y1 = (rect.y + rect.h - 1) / SW_TILE_SIZE;
+    for (y = y0; y <= y1; y++) {
+        for (x = x0; x <= x1; x++) {
+            SW_TileBin *bin = &tiler->bins[y * tiler->tiles_x + x];
+            if (bin->num_ops == bin->max_ops) {
+                const int max_ops = bin->max_ops ? (bin->max_ops * 2) : 64;
+                int *ops = (int *)SDL_realloc(bin->ops, max_ops * sizeof(*ops));
+                if (!ops) {
+                    return -1;
                 }
+                bin->ops = ops;
+                bin->max_ops = max_ops;
             }
-            break;
+            bin->ops[bin->num_ops++] = index;
         }
+    }
+    return 0;
+}
 
-        case SDL_RENDERCMD_COPY_EX:
-        {
-            CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd);
+/* Take every op from `first_op` on back out of the tiles. They're always the last ones in each bin. */
+static void SW_UnbinTiledOps(SW_TileRenderer *tiler, int first_op)
+{
+    int i;
 
-            /* Apply viewport */
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
-            }
+    for (i = 0; i < tiler->num_tiles; i++) {
+        SW_TileBin *bin = &tiler->bins[i];
+        while (bin->num_ops > 0 && bin->ops[bin->num_ops - 1] >= first_op) {
+            bin->num_ops--;
+        }
+    }
+    tiler->num_ops = first_op;
+}
 
-            SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
-                            &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
-                            copydata->scale_x, copydata->scale_y);
-            break;
+/* Draw everything that has been binned, and wait for it to finish. The rendering thread helps out. */
+static void SW_FlushTiles(SW_TileRenderer *tiler)
+{
+    int i;
+
+    if (tiler->num_ops == 0) {
+        return;
+    }
+
+    SDL_AtomicSet(&tiler->next_tile, 0);
+    SDL_ParallelFor(0, SDL_min(tiler->num_jobs, tiler->num_tiles), 1, SW_DrawTiles, tiler);
+
+    for (i = 0; i < tiler->max_bins; i++) {
+        tiler->bins[i].num_ops = 0;
+    }
+    tiler->num_ops = 0;
+}
+
+static void SW_DestroyTileRenderer(SW_TileRenderer *tiler)
+{
+    int i;
+
+    if (!tiler) {
+        return;
+    }
+
+    if (tiler->textures) {
+        SDL_DestroyHashTable(tiler->textures);
+    }
+    if (tiler->jobs) {
+        for (i = 0; i < tiler->num_jobs; i++) {
+            SDL_DestroySurface(tiler->jobs[i].target);
         }
+    }
+    for (i = 0; i < tiler->max_bins; i++) {
+        SDL_free(tiler->bins[i].ops);
+    }
+    SDL_free(tiler->bins);
+    SDL_free(tiler->ops);
+    SDL_free(tiler->jobs);
+    SDL_free(tiler);
+}
 
-        case SDL_RENDERCMD_GEOMETRY:
-        {
-            int i;
-            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            const int count = (int)cmd->data.draw.count;
-            SDL_Texture *texture = cmd->data.draw.texture;
-            const SDL_BlendMode blend = cmd->data.draw.blend;
+static SW_TileRenderer *SW_CreateTileRenderer(int num_jobs)
+{
+    SW_TileRenderer *tiler = (SW_TileRenderer *)SDL_calloc(1, sizeof(*tiler));
+    int i;
+
+    if (!tiler) {
+        return NULL;
+    }
 
-            SetDrawState(surface, &drawstate);
+    tiler->num_jobs = num_jobs;
+    tiler->jobs = (SW_TileJob *)SDL_calloc(tiler->num_jobs, sizeof(*tiler->jobs));
+    tiler->textures = SDL_CreateHashTable(tiler, 16, SDL_HashID, SDL_KeyMatchID, SW_NukeTileTextures, SDL_FALSE);
+    if (!tiler->jobs || !tiler->textures) {
+        SW_DestroyTileRenderer(tiler);
+        return NULL;
+    }
 
-            if (texture) {
-                SDL_Surface *src = (SDL_Surface *)texture->driverdata;
+    for (i = 0; i < tiler->num_jobs; i++) {
+        tiler->jobs[i].tiler = tiler;
+        tiler->jobs[i].index = i;
+    }
 
-                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+    return tiler;
+}
 
-                PrepTextureForCopy(cmd);
+/* Set up the tile bins for drawing to `surface`. */
+static int SW_BeginTiles(SW_TileRenderer *tiler, SDL_Surface *surface, void *vertices)
+{
+    const int tiles_x = (surface->w + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    const int tiles_y = (surface->h + SW_TILE_SIZE - 1) / SW_TILE_SIZE;
+    const int num_tiles = tiles_x * tiles_y;
 
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
+    if (SW_UpdateTileTargets(tiler, surface) < 0) {
+        return -1;
+    }
 
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_BlitTriangle(
-                        src,
-                        &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
-                        surface,
-                        &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
-                        ptr[0].color, ptr[1].color, ptr[2].color);
-                }
-            } else {
-                GeometryFillData *ptr = (GeometryFillData *)verts;
-
-                /* Apply viewport */
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
+    if (num_tiles > tiler->max_bins) {
+        SW_TileBin *bins = (SW_TileBin *)SDL_realloc(tiler->bins, num_tiles * sizeof(*bins));
+        if (!bins) {
+            return -1;
+        }
+        SDL_memset(&bins[tiler->max_bins], 0, (num_tiles - tiler->max_bins) * sizeof(*bins));
+        tiler->bins = bins;
+        tiler->max_bins = num_tiles;
+    }
+
+    tiler->vertices = vertices;
+    tiler->tiles_x = tiles_x;
+    tiler->num_tiles = num_tiles;
+    return 0;
+}
+
+/* Bin a command if it can be drawn in tiles. Returns -1 if it has to be drawn directly instead. */
+static int SW_BinCommand(SW_TileRenderer *tiler, SDL_Surface *surface, SDL_RenderCommand *cmd, void *vertices, SW_DrawStateCache *drawstate)
+{
+    SDL_Rect clip_rect;
+    SDL_Rect bounds;
+    int i;
+
+    switch (cmd->command) {
+    case SDL_RENDERCMD_CLEAR:
+    {
+        /* By definition the clear ignores the clip rect */
+        bounds.x = 0;
+        bounds.y = 0;
+        bounds.w = surface->w;
+        bounds.h = surface->h;
+        return SW_BinTiledOp(tiler, cmd, &bounds, &bounds, 0, NULL);
+    }
+
+    case SDL_RENDERCMD_FILL_RECTS:
+    {
+        const int count = (int)cmd->data.draw.count;
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            for (i = 0; i < count; i++) {
+                verts[i].x += drawstate->viewport->x;
+                verts[i].y += drawstate->viewport->y;
+            }
+        }
+
+        GetDrawClipRect(drawstate, &clip_rect);
+        SDL_GetRectUnion(&verts[0], &verts[0], &bounds);
+        for (i = 1; i < count; i++) {
+            SDL_GetRectUnion(&bounds, &verts[i], &bounds);
+        }
+        if (count && SW_BinTiledOp(tiler, cmd, &clip_rect, &bounds, 0, NULL) < 0) {
+            /* It's drawn directly, which applies the viewport again */
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                for (i = 0; i < count; i++) {
+                    verts[i].x -= drawstate->viewport->x;
+                    verts[i].y -= drawstate->viewport->y;
                 }
+            }
+            return -1;
+        }
+        return 0;
+    }
+
+    case SDL_RENDERCMD_COPY:
+    {
+        SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+        SDL_Surface **textures;
 
-                for (i = 0; i < count; i += 3, ptr += 3) {
-                    SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
+        /* Scaling depends on how the copy is clipped, so that has to be done in one piece */
+        if (verts[0].w != verts[1].w || verts[0].h != verts[1].h) {
+            return -1;
+        }
+
+        textures = SW_GetTileTextures(tiler, cmd->data.draw.texture);
+        if (!textures) {
+            return -1;
+        }
+
+        /* Apply viewport */
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            verts[1].x += drawstate->viewport->x;
+            verts[1].y += drawstate->viewport->y;
+        }
+
+        GetDrawClipRect(drawstate, &clip_rect);
+        if (SW_BinTiledOp(tiler, cmd, &clip_rect, &verts[1], 0, textures) < 0) {
+            /* It's drawn directly, which applies the viewport again */
+            if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+                verts[1].x -= drawstate->viewport->x;
+                verts[1].y -= drawstate->viewport->y;
+            }
+            return -1;
+        }
+        return 0;
+    }
+
+    case SDL_RENDERCMD_GEOMETRY:
+    {
+        const int count = (int)cmd->data.draw.count;
+        SDL_Texture *texture = cmd->data.draw.texture;
+        SDL_Surface **textures = NULL;
+        const size_t stride = texture ? sizeof(GeometryCopyData) : sizeof(GeometryFillData);
+        SDL_Point vp;
+
+        if (texture) {
+            textures = SW_GetTileTextures(tiler, texture);
+            if (!textures) {
+                return -1;
+            }
+        }
+
+        /* Apply viewport */
+        vp.x = 0;
+        vp.y = 0;
+        if (drawstate->viewport && (drawstate->viewport->x || drawstate->viewport->y)) {
+            vp.x = drawstate->viewport->x;
+            vp.y = drawstate->viewport->y;
+            trianglepoint_2_fixedpoint(&vp);
+            for (i = 0; i < count; i++) {
+                SDL_Point *dst = texture ? &((GeometryCopyData *)(((Uint8 *)vertices) + cmd->data.draw.first))[i].dst
+                                         : &((GeometryFillData *)(((Uint8 *)vertices) + cmd->data.draw.first))[i].dst;
+                dst->x += vp.x;
+                dst->y += vp.y;
+            }
+        }
+
+        GetDrawClipRect(drawstate, &clip_rect);
+        for (i = 0; i + 3 <= count; i += 3) {
+            const size_t first = cmd->data.draw.first + i * stride;
+            const SDL_Point *d0, *d1, *d2;
+
+            if (texture) {
+                const GeometryCopyData *ptr = (const GeometryCopyData *)(((Uint8 *)vertices) + first);
+                d0 = &ptr[0].dst;
+                d1 = &ptr[1].dst;
+                d2 = &ptr[2].dst;
+            } else {
+                const GeometryFillData *ptr = (const GeometryFillData *)(((Uint8 *)vertices) + first);
+                d0 = &ptr[0].dst;
+                d1 = &ptr[1].dst;
+                d2 = &ptr[2].dst;
+            }
+            SDL_SW_GetTriangleBounds(d0, d1, d2, &bounds);
+            bounds.w += 1; /* the bounds are inclusive of the far edge, to be safe */
+            bounds.h += 1;
+            if (SW_BinTiledOp(tiler, cmd, &clip_rect, &bounds, (int)first, textures) < 0) {
+                /* It's drawn directly, which applies the viewport again */
+                for (i = 0; i < count; i++) {
+                    SDL_Point *dst = texture ? &((GeometryCopyData *)(((Uint8 *)vertices) + cmd->data.draw.first))[i].dst
+                                             : &((GeometryFillData *)(((Uint8 *)vertices) + cmd->data.draw.first))[i].dst;
+                    dst->x -= vp.x;
+                    dst->y -= vp.y;
                 }
+                return -1;
             }
-            break;
         }
+        return 0;
+    }
+
+    default:
+        return -1;
+    }
+}
+
+static int SW_RunCommandQueueTiled(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
+    SW_TileRenderer *tiler = data->tiler;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_DrawStateCache drawstate;
 
+    if (!surface) {
+        return -1;
+    }
+
+    if (SDL_MUSTLOCK(surface) || SW_BeginTiles(tiler, surface, vertices) < 0) {
+        return SW_RunCommandQueue(renderer, cmd, vertices, vertsize);
+    }
+
+    drawstate.viewport = NULL;
+    drawstate.cliprect = NULL;
+    drawstate.surface_cliprect_dirty = SDL_TRUE;
+
+    while (cmd) {
+        switch (cmd->command) {
+        case SDL_RENDERCMD_SETDRAWCOLOR:
+        case SDL_RENDERCMD_SETVIEWPORT:
+        case SDL_RENDERCMD_SETCLIPRECT:
         case SDL_RENDERCMD_NO_OP:
+            SW_RunCommand(renderer, surface, cmd, vertices, &drawstate);
+            break;
+
+        default:
+        {
+            const int first_op = tiler->num_ops;
+            if (SW_BinCommand(tiler, surface, cmd, vertices, &drawstate) < 0) {
+                /* Anything already binned would be drawn twice, which blending would show */
+                SW_UnbinTiledOps(tiler, first_op);
+
+                /* Everything before this has to be drawn first */
+                SW_FlushTiles(tiler);
+                SW_RunCommand(renderer, surface, cmd, vertices, &drawstate);
+            }
             break;
         }
+        }
 
         cmd = cmd->next;
     }
 
+    SW_FlushTiles(tiler);
+
     return 0;
 }
 
@@ -989,8 +1618,12 @@ static int SW_RenderPresent(SDL_Renderer *renderer)
 
 static void SW_DestroyTexture(SDL_Renderer *renderer, SDL_Texture *texture)
 {
+    SW_RenderData *data = (SW_RenderData *)renderer->driverdata;
     SDL_Surface *surface = (SDL_Surface *)texture->driverdata;
 
+    if (data->tiler) {
+        SDL_RemoveFromHashTable(data->tiler->textures, texture);
+    }
     SDL_DestroySurface(surface);
 }
 
@@ -1002,6 +1635,9 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
+    if (data) {
+        SW_DestroyTileRenderer(data->tiler);
+    }
     SDL_free(data);
     SDL_free(renderer);
 }
@@ -1138,6 +1774,7 @@ SDL_Renderer *SW_CreateRendererForSurface(SDL_Surface *surface)
     renderer->QueueCopy = SW_QueueCopy;
     renderer->QueueCopyEx = SW_QueueCopyEx;
     renderer->QueueGeometry = SW_QueueGeometry;
+    renderer->can_merge_draws = SDL_TRUE;
     renderer->InvalidateCachedState = SW_InvalidateCachedState;
     renderer->RunCommandQueue = SW_RunCommandQueue;
     renderer->RenderReadPixels = SW_RenderReadPixels;
@@ -1188,6 +1825,38 @@ static SDL_Renderer *SW_CreateRenderer(SDL_Window *window, SDL_PropertiesID crea
     return SW_CreateRendererForSurface(surface);
 }
 
+static SDL_Renderer *SW_MT_CreateRenderer(SDL_Window *window, SDL_PropertiesID create_props)
+{
+    SDL_Renderer *renderer = SW_CreateRenderer(window, create_props);
+    SW_RenderData *data;
+    const char *hint;
+    int num_workers;
+
+    if (!renderer) {
+        return NULL;
+    }
+    data = (SW_RenderData *)renderer->driverdata;
+
+    hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    num_workers = hint ? SDL_atoi(hint) : 0;
+    if (num_workers <= 0) {
+        num_workers = SDL_GetCPUCount() - 1;
+    }
+    num_workers = SDL_max(num_workers, 0);
+
+    data->tiler = SW_CreateTileRenderer(num_workers + 1);
+    if (!data->tiler) {
+        SW_DestroyRenderer(renderer);
+        return NULL;
+    }
+
+    renderer->RunCommandQueue = SW_RunCommandQueueTiled;
+    renderer->info = SW_MT_RenderDriver.info;
+    SW_SelectBestFormats(renderer, data->surface->format->format);
+
+    return renderer;
+}
+
 SDL_RenderDriver SW_RenderDriver = {
     SW_CreateRenderer,
     { "software",
@@ -1199,4 +1868,15 @@ SDL_RenderDriver SW_RenderDriver = {
       0 }
 };
 
+SDL_RenderDriver SW_MT_RenderDriver = {
+    SW_MT_CreateRenderer,
+    { "software-mt",
+      (SDL_RENDERER_SOFTWARE | SDL_RENDERER_PRESENTVSYNC),
+      0,
+      { /* formats filled in later */
+        SDL_PIXELFORMAT_UNKNOWN },
+      0,
+      0 }
+};
+
 #endif /* SDL_VIDEO_RENDER_SW && !SDL_RENDER_DISABLED */
@@ -132,6 +132,12 @@ static void bounding_rect_fixedpoint(const SDL_Point *a, const SDL_Point *b, con
     r->h = (max_y - min_y) >> FP_BITS;
 }
 
+/* the area SDL_SW_FillTriangle() and SDL_SW_BlitTriangle() may draw to, before clipping */
+void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *rect)
+{
+    bounding_rect_fixedpoint(d0, d1, d2, rect);
+}
+
 /* bounding rect of three points */
 static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Point *c, SDL_Rect *r)
 {
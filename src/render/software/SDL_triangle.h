@@ -37,4 +37,6 @@ extern int SDL_SW_BlitTriangle(
 
 extern void trianglepoint_2_fixedpoint(SDL_Point *a);
 
+extern void SDL_SW_GetTriangleBounds(const SDL_Point *d0, const SDL_Point *d1, const SDL_Point *d2, SDL_Rect *rect);
+
 #endif /* SDL_triangle_h_ */
@@ -0,0 +1,613 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+/* The SDL job system: a pool of worker threads with work-stealing queues */
+
+#include "SDL_jobs_c.h"
+#include "SDL_systhread.h"
+
+#define SDL_MAX_JOB_THREADS 256
+
+/* SDL_ParallelFor() uses bigger chunks rather than more than this many */
+#define SDL_MAX_PARALLEL_CHUNKS (SDL_MAX_SINT32 / 2)
+
+typedef struct SDL_JobPool SDL_JobPool;
+
+/* A job waiting for another job to finish */
+typedef struct SDL_JobLink
+{
+    SDL_Job *job;
+    struct SDL_JobLink *next;
+} SDL_JobLink;
+
+struct SDL_Job
+{
+    SDL_JobPool *pool;
+    SDL_JobFunction func;
+    void *userdata;
+    SDL_AtomicInt refcount; /* one for the handle, and one for the pool until the job has run */
+    SDL_AtomicInt blockers; /* unfinished dependencies, plus one until the job is submitted */
+    SDL_AtomicInt finished;
+    SDL_SpinLock lock;       /* protects `dependents`, and `finished` changing */
+    SDL_JobLink *dependents; /* jobs to unblock when this one finishes */
+};
+
+/* A ring of jobs. The owner pushes and pops at the back, and other threads
+ * steal from the front, so the owner gets the jobs that are likely to be in
+ * its cache and thieves take the oldest, and usually biggest, pieces of work.
+ */
+typedef struct SDL_JobQueue
+{
+    SDL_SpinLock lock;
+    SDL_Job **jobs;
+    int capacity; /* a power of two */
+    int head;
+    int count;
+
+    /* Padding to separate cache lines between threads */
+    char cache_pad[SDL_CACHELINE_SIZE];
+} SDL_JobQueue;
+
+typedef struct SDL_JobWorker
+{
+    SDL_JobPool *pool;
+    int index;
+    SDL_Thread *thread;
+} SDL_JobWorker;
+
+struct SDL_JobPool
+{
+    SDL_Mutex *lock;
+    SDL_Condition *work_cond; /* signaled when jobs are queued, or the threads should exit. */
+    SDL_Condition *done_cond; /* broadcast when a job finishes while someone is waiting. */
+    SDL_AtomicInt shutdown;
+    SDL_AtomicInt num_queued;
+    SDL_AtomicInt num_sleeping;
+    SDL_AtomicInt num_waiting;
+
+    int num_workers;      /* the number of worker queues, even if some threads couldn't be started. */
+    int num_threads;      /* the number of worker threads running. */
+    SDL_JobWorker *workers;
+    SDL_JobQueue *queues; /* one per worker, and a last one for jobs from other threads. */
+};
+
+static SDL_JobPool *SDL_job_pool;
+static SDL_AtomicInt SDL_job_pool_failed; /* don't try to create the pool again until SDL_QuitJobs() */
+static SDL_SpinLock SDL_job_worker_tls_lock;
+static SDL_TLSID SDL_job_worker_tls;
+
+static SDL_bool SDL_PushJob(SDL_JobQueue *queue, SDL_Job *job)
+{
+    SDL_bool pushed = SDL_TRUE;
+
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count == queue->capacity) {
+        const int capacity = queue->capacity ? queue->capacity * 2 : 64;
+        SDL_Job **jobs = (SDL_Job **)SDL_malloc(capacity * sizeof(*jobs));
+        if (jobs) {
+            int i;
+            for (i = 0; i < queue->count; ++i) {
+                jobs[i] = queue->jobs[(queue->head + i) & (queue->capacity - 1)];
+            }
+            SDL_free(queue->jobs);
+            queue->jobs = jobs;
+            queue->capacity = capacity;
+            queue->head = 0;
+        } else {
+            pushed = SDL_FALSE;
+        }
+    }
+    if (pushed) {
+        queue->jobs[(queue->head + queue->count) & (queue->capacity - 1)] = job;
+        ++queue->count;
+    }
+    SDL_AtomicUnlock(&queue->lock);
+
+    return pushed;
+}
+
+static SDL_Job *SDL_PopJob(SDL_JobQueue *queue)
+{
+    SDL_Job *job = NULL;
+
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count > 0) {
+        --queue->count;
+        job = queue->jobs[(queue->head + queue->count) & (queue->capacity - 1)];
+    }
+    SDL_AtomicUnlock(&queue->lock);
+
+    return job;
+}
+
+static SDL_Job *SDL_StealJob(SDL_JobQueue *queue)
+{
+    SDL_Job *job = NULL;
+
+    SDL_AtomicLock(&queue->lock);
+    if (queue->count > 0) {
+        job = queue->jobs[queue->head];
+        queue->head = (queue->head + 1) & (queue->capacity - 1);
+        --queue->count;
+    }
+    SDL_AtomicUnlock(&queue->lock);
+
+    return job;
+}
+
+/* The index of the worker running on this thread, or -1 if this isn't a worker thread */
+static int SDL_GetJobWorkerIndex(void)
+{
+    return (int)(uintptr_t)SDL_GetTLS(SDL_job_worker_tls) - 1;
+}
+
+static void SDL_RunJob(SDL_JobPool *pool, SDL_Job *job);
+
+static void SDL_ScheduleJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    const int worker = SDL_GetJobWorkerIndex();
+    SDL_JobQueue *queue = &pool->queues[worker >= 0 ? worker : pool->num_workers];
+
+    if (!SDL_PushJob(queue, job)) {
+        /* Out of memory, run it right here */
+        SDL_RunJob(pool, job);
+        return;
+    }
+
+    SDL_AtomicIncRef(&pool->num_queued);
+    if (SDL_AtomicGet(&pool->num_sleeping) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_SignalCondition(pool->work_cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static SDL_Job *SDL_FindJob(SDL_JobPool *pool, int worker)
+{
+    const int num_queues = pool->num_workers + 1;
+    SDL_Job *job = NULL;
+    int i;
+
+    if (SDL_AtomicGet(&pool->num_queued) <= 0) {
+        return NULL;
+    }
+
+    /* Take the newest of our own jobs, or steal the oldest of someone else's */
+    if (worker >= 0) {
+        job = SDL_PopJob(&pool->queues[worker]);
+    }
+    for (i = 1; i <= num_queues && !job; ++i) {
+        const int victim = (worker + i) % num_queues;
+        if (victim != worker) {
+            job = SDL_StealJob(&pool->queues[victim]);
+        }
+    }
+
+    if (job) {
+        SDL_AtomicAdd(&pool->num_queued, -1);
+    }
+    return job;
+}
+
+static void SDL_ReleaseJob(SDL_Job *job)
+{
+    if (SDL_AtomicDecRef(&job->refcount)) {
+        SDL_free(job);
+    }
+}
+
+static void SDL_UnblockJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    if (SDL_AtomicDecRef(&job->blockers)) {
+        SDL_ScheduleJob(pool, job);
+    }
+}
+
+static void SDL_RunJob(SDL_JobPool *pool, SDL_Job *job)
+{
+    SDL_JobLink *link, *next;
+
+    job->func(job->userdata);
+
+    SDL_AtomicLock(&job->lock);
+    SDL_AtomicIncRef(&job->finished);
+    link = job->dependents;
+    job->dependents = NULL;
+    SDL_AtomicUnlock(&job->lock);
+
+    for (; link; link = next) {
+        next = link->next;
+        SDL_UnblockJob(pool, link->job);
+        SDL_free(link);
+    }
+
+    if (SDL_AtomicGet(&pool->num_waiting) > 0) {
+        SDL_LockMutex(pool->lock);
+        SDL_BroadcastCondition(pool->done_cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    SDL_ReleaseJob(job);
+}
+
+/* Run queued jobs until `job` is finished, or until there are no queued jobs if `job` is NULL */
+static void SDL_HelpWithJobs(SDL_JobPool *pool, SDL_Job *job)
+{
+    const int worker = SDL_GetJobWorkerIndex();
+
+    while (!job || !SDL_AtomicGet(&job->finished)) {
+        SDL_Job *other = SDL_FindJob(pool, worker);
+        if (other) {
+            SDL_RunJob(pool, other);
+            continue;
+        }
+        if (!job) {
+            break;
+        }
+
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->num_waiting);
+        if (!SDL_AtomicGet(&job->finished) && SDL_AtomicGet(&pool->num_queued) <= 0) {
+            SDL_WaitCondition(pool->done_cond, pool->lock);
+        }
+        SDL_AtomicAdd(&pool->num_waiting, -1);
+        SDL_UnlockMutex(pool->lock);
+    }
+}
+
+static int SDLCALL SDL_JobThreadMain(void *data)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)data;
+    SDL_JobPool *pool = worker->pool;
+
+    SDL_SetTLS(SDL_job_worker_tls, (void *)(uintptr_t)(worker->index + 1), NULL);
+
+    for (;;) {
+        SDL_Job *job = SDL_FindJob(pool, worker->index);
+        if (job) {
+            SDL_RunJob(pool, job);
+            continue;
+        }
+
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicIncRef(&pool->num_sleeping);
+        while (!SDL_AtomicGet(&pool->shutdown) && SDL_AtomicGet(&pool->num_queued) <= 0) {
+            SDL_WaitCondition(pool->work_cond, pool->lock);
+        }
+        SDL_AtomicAdd(&pool->num_sleeping, -1);
+        SDL_UnlockMutex(pool->lock);
+
+        /* Finish the queued jobs before exiting */
+        if (SDL_AtomicGet(&pool->shutdown) && SDL_AtomicGet(&pool->num_queued) <= 0) {
+            break;
+        }
+    }
+    return 0;
+}
+
+static void SDL_DestroyJobPool(SDL_JobPool *pool)
+{
+    int i;
+
+    if (!pool) {
+        return;
+    }
+
+    if (pool->lock) {
+        SDL_LockMutex(pool->lock);
+        SDL_AtomicSet(&pool->shutdown, 1);
+        SDL_BroadcastCondition(pool->work_cond);
+        SDL_UnlockMutex(pool->lock);
+    }
+
+    if (pool->workers) {
+        for (i = 0; i < pool->num_threads; ++i) {
+            SDL_WaitThread(pool->workers[i].thread, NULL);
+        }
+    }
+
+    if (pool->queues) {
+        /* Run anything that was queued after the workers left */
+        SDL_HelpWithJobs(pool, NULL);
+
+        for (i = 0; i <= pool->num_workers; ++i) {
+            SDL_free(pool->queues[i].jobs);
+        }
+    }
+
+    SDL_free(pool->queues);
+    SDL_free(pool->workers);
+    SDL_DestroyCondition(pool->done_cond);
+    SDL_DestroyCondition(pool->work_cond);
+    SDL_DestroyMutex(pool->lock);
+    SDL_free(pool);
+}
+
+static int SDL_GetJobThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_JOB_THREADS);
+
+    /* Threads waiting for jobs help run them, so leave a core for them by default */
+    if (!hint || !*hint) {
+        return SDL_max(SDL_GetCPUCount() - 1, 1);
+    }
+    return SDL_clamp(SDL_atoi(hint), 0, SDL_MAX_JOB_THREADS);
+}
+
+static SDL_JobPool *SDL_CreateJobPool(void)
+{
+    SDL_JobPool *pool;
+    const int num_workers = SDL_GetJobThreadCount();
+    int i;
+
+    SDL_AtomicLock(&SDL_job_worker_tls_lock);
+    if (!SDL_job_worker_tls) {
+        SDL_job_worker_tls = SDL_CreateTLS();
+    }
+    SDL_AtomicUnlock(&SDL_job_worker_tls_lock);
+    if (!SDL_job_worker_tls) {
+        return NULL;
+    }
+
+    pool = (SDL_JobPool *)SDL_calloc(1, sizeof(*pool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->lock = SDL_CreateMutex();
+    pool->work_cond = SDL_CreateCondition();
+    pool->done_cond = SDL_CreateCondition();
+    pool->workers = (SDL_JobWorker *)SDL_calloc(SDL_max(num_workers, 1), sizeof(*pool->workers));
+    pool->queues = (SDL_JobQueue *)SDL_calloc(num_workers + 1, sizeof(*pool->queues));
+    if (!pool->lock || !pool->work_cond || !pool->done_cond || !pool->workers || !pool->queues) {
+        SDL_DestroyJobPool(pool);
+        return NULL;
+    }
+
+    /* The queues are all created up front, so workers can steal from each other as soon as they start */
+    pool->num_workers = num_workers;
+    for (i = 0; i < num_workers; ++i) {
+        char threadname[64];
+        SDL_JobWorker *worker = &pool->workers[i];
+
+        worker->pool = pool;
+        worker->index = i;
+        (void)SDL_snprintf(threadname, sizeof(threadname), "SDLJob%d", i);
+        worker->thread = SDL_CreateThreadInternal(SDL_JobThreadMain, threadname, 0, worker);
+        if (!worker->thread) {
+            /* Make do with the threads we have, down to running jobs on the threads that submit them */
+            break;
+        }
+        ++pool->num_threads;
+    }
+
+    return pool;
+}
+
+static SDL_JobPool *SDL_GetJobPool(void)
+{
+    SDL_JobPool *pool = (SDL_JobPool *)SDL_AtomicGetPtr((void **)&SDL_job_pool);
+
+    if (!pool && !SDL_AtomicGet(&SDL_job_pool_failed)) {
+        /* Starting the threads can take a while, so don't hold a lock while doing it.
+           If another thread got there first, use its pool instead. */
+        SDL_JobPool *new_pool = SDL_CreateJobPool();
+        if (!new_pool) {
+            SDL_AtomicSet(&SDL_job_pool_failed, 1);
+            return NULL;
+        }
+        if (SDL_AtomicCASPtr((void **)&SDL_job_pool, NULL, new_pool)) {
+            pool = new_pool;
+        } else {
+            SDL_DestroyJobPool(new_pool);
+            pool = (SDL_JobPool *)SDL_AtomicGetPtr((void **)&SDL_job_pool);
+        }
+    }
+    return pool;
+}
+
+SDL_Job *SDL_SubmitJob(SDL_JobFunction func, void *userdata, SDL_Job **dependencies, int num_dependencies)
+{
+    SDL_JobPool *pool;
+    SDL_Job *job;
+    int i;
+
+    if (!func) {
+        SDL_InvalidParamError("func");
+        return NULL;
+    }
+    if (num_dependencies < 0 || (num_dependencies > 0 && !dependencies)) {
+        SDL_InvalidParamError("dependencies");
+        return NULL;
+    }
+
+    pool = SDL_GetJobPool();
+    if (!pool) {
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_calloc(1, sizeof(*job));
+    if (!job) {
+        return NULL;
+    }
+    job->pool = pool;
+    job->func = func;
+    job->userdata = userdata;
+    SDL_AtomicSet(&job->refcount, 2);
+    SDL_AtomicSet(&job->blockers, 1);
+
+    for (i = 0; i < num_dependencies; ++i) {
+        SDL_Job *dependency = dependencies[i];
+        SDL_JobLink *link;
+
+        if (!dependency) {
+            continue;
+        }
+
+        link = (SDL_JobLink *)SDL_malloc(sizeof(*link));
+        if (!link) {
+            /* Out of memory, wait for the dependency here instead */
+            SDL_HelpWithJobs(pool, dependency);
+            continue;
+        }
+        link->job = job;
+
+        SDL_AtomicLock(&dependency->lock);
+        if (SDL_AtomicGet(&dependency->finished)) {
+            SDL_free(link);
+        } else {
+            SDL_AtomicIncRef(&job->blockers);
+            link->next = dependency->dependents;
+            dependency->dependents = link;
+        }
+        SDL_AtomicUnlock(&dependency->lock);
+    }
+
+    SDL_UnblockJob(pool, job);
+
+    /* Without worker threads, jobs run on the threads that submit them */
+    if (pool->num_threads == 0) {
+        SDL_HelpWithJobs(pool, NULL);
+    }
+    return job;
+}
+
+SDL_bool SDL_IsJobFinished(SDL_Job *job)
+{
+    if (!job) {
+        SDL_InvalidParamError("job");
+        return SDL_FALSE;
+    }
+    return SDL_AtomicGet(&job->finished) ? SDL_TRUE : SDL_FALSE;
+}
+
+void SDL_WaitJob(SDL_Job *job)
+{
+    if (!job) {
+        return;
+    }
+
+    SDL_HelpWithJobs(job->pool, job);
+    SDL_ReleaseJob(job);
+}
+
+void SDL_DetachJob(SDL_Job *job)
+{
+    if (!job) {
+        return;
+    }
+
+    SDL_ReleaseJob(job);
+}
+
+typedef struct SDL_ParallelForData
+{
+    SDL_ParallelForFunction func;
+    void *userdata;
+    int start;
+    int end;
+    int chunk_size;
+    int num_chunks;
+    SDL_AtomicInt next_chunk;
+} SDL_ParallelForData;
+
+static void SDLCALL SDL_ParallelForJob(void *userdata)
+{
+    SDL_ParallelForData *data = (SDL_ParallelForData *)userdata;
+    int chunk;
+
+    /* Chunks are handed out as threads get to them, so faster threads do more of them */
+    while ((chunk = SDL_AtomicAdd(&data->next_chunk, 1)) < data->num_chunks) {
+        const Sint64 start = (Sint64)data->start + (Sint64)chunk * data->chunk_size;
+        const Sint64 end = SDL_min(start + data->chunk_size, (Sint64)data->end);
+        data->func(data->userdata, (int)start, (int)end);
+    }
+}
+
+int SDL_ParallelFor(int start, int end, int chunk_size, SDL_ParallelForFunction func, void *userdata)
+{
+    SDL_JobPool *pool;
+    SDL_ParallelForData data;
+    SDL_Job **helpers;
+    SDL_bool isstack;
+    Sint64 count;
+    int num_threads, num_helpers, i;
+
+    if (!func) {
+        return SDL_InvalidParamError("func");
+    }
+    if (end <= start) {
+        return 0;
+    }
+
+    pool = SDL_GetJobPool();
+    num_threads = pool ? pool->num_threads + 1 : 1;
+
+    count = (Sint64)end - start;
+    if (chunk_size <= 0) {
+        /* A few chunks per thread balances the load without much overhead */
+        chunk_size = (int)SDL_max((count + num_threads * 4 - 1) / (num_threads * 4), 1);
+    }
+    /* Each thread takes the chunk counter one past the end, so keep it well away from overflowing */
+    chunk_size = (int)SDL_max((Sint64)chunk_size, (count + SDL_MAX_PARALLEL_CHUNKS - 1) / SDL_MAX_PARALLEL_CHUNKS);
+
+    data.func = func;
+    data.userdata = userdata;
+    data.start = start;
+    data.end = end;
+    data.chunk_size = chunk_size;
+    data.num_chunks = (int)((count + chunk_size - 1) / chunk_size);
+    SDL_AtomicSet(&data.next_chunk, 0);
+
+    num_helpers = SDL_min(data.num_chunks, num_threads) - 1;
+    helpers = NULL;
+    if (num_helpers > 0) {
+        helpers = SDL_small_alloc(SDL_Job *, num_helpers, &isstack);
+        if (!helpers) {
+            num_helpers = 0;
+        }
+    }
+    for (i = 0; i < num_helpers; ++i) {
+        helpers[i] = SDL_SubmitJob(SDL_ParallelForJob, &data, NULL, 0);
+    }
+
+    /* The calling thread does its share, and then waits for the others to finish theirs */
+    SDL_ParallelForJob(&data);
+
+    for (i = 0; i < num_helpers; ++i) {
+        SDL_WaitJob(helpers[i]);
+    }
+    if (helpers) {
+        SDL_small_free(helpers, isstack);
+    }
+    return 0;
+}
+
+void SDL_QuitJobs(void)
+{
+    SDL_JobPool *pool;
+
+    pool = (SDL_JobPool *)SDL_AtomicSetPtr((void **)&SDL_job_pool, NULL);
+    SDL_AtomicSet(&SDL_job_pool_failed, 0);
+
+    SDL_DestroyJobPool(pool);
+}
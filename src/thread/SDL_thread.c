@@ -26,6 +26,26 @@
 #include "SDL_systhread.h"
 #include "../SDL_error_c.h"
 
+#ifdef SDL_THREAD_LOCAL
+/* Each thread's storage lives in a compiler thread-local variable,
+   which is much cheaper to get at than asking the OS for it. */
+static SDL_THREAD_LOCAL SDL_TLSData *SDL_tls_data;
+
+static SDL_TLSData *SDL_GetTLSData(void)
+{
+    return SDL_tls_data;
+}
+
+static int SDL_SetTLSData(SDL_TLSData *data)
+{
+    SDL_tls_data = data;
+    return 0;
+}
+#else
+#define SDL_GetTLSData SDL_SYS_GetTLSData
+#define SDL_SetTLSData SDL_SYS_SetTLSData
+#endif
+
 SDL_TLSID SDL_CreateTLS(void)
 {
     static SDL_AtomicInt SDL_tls_id;
@@ -36,7 +56,7 @@ void *SDL_GetTLS(SDL_TLSID id)
 {
     SDL_TLSData *storage;
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (!storage || id == 0 || id > storage->limit) {
         return NULL;
     }
@@ -51,7 +71,7 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
         return SDL_InvalidParamError("id");
     }
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (!storage || (id > storage->limit)) {
         unsigned int i, oldlimit, newlimit;
         SDL_TLSData *new_storage;
@@ -68,7 +88,7 @@ int SDL_SetTLS(SDL_TLSID id, const void *value, void(SDLCALL *destructor)(void *
             storage->array[i].data = NULL;
             storage->array[i].destructor = NULL;
         }
-        if (SDL_SYS_SetTLSData(storage) != 0) {
+        if (SDL_SetTLSData(storage) != 0) {
             return -1;
         }
     }
@@ -82,7 +102,7 @@ void SDL_CleanupTLS(void)
 {
     SDL_TLSData *storage;
 
-    storage = SDL_SYS_GetTLSData();
+    storage = SDL_GetTLSData();
     if (storage) {
         unsigned int i;
         for (i = 0; i < storage->limit; ++i) {
@@ -90,7 +110,7 @@ void SDL_CleanupTLS(void)
                 storage->array[i].destructor(storage->array[i].data);
             }
         }
-        SDL_SYS_SetTLSData(NULL);
+        SDL_SetTLSData(NULL);
         SDL_free(storage);
     }
 }
@@ -200,10 +220,22 @@ static SDL_error *SDL_GetStaticErrBuf(void)
 }
 
 #ifndef SDL_THREADS_DISABLED
+#ifdef SDL_THREAD_LOCAL
+/* This thread's error buffer, so getting and clearing errors doesn't have to look it up */
+static SDL_THREAD_LOCAL SDL_error *SDL_errbuf;
+#endif
+
 static void SDLCALL SDL_FreeErrBuf(void *data)
 {
     SDL_error *errbuf = (SDL_error *)data;
 
+#ifdef SDL_THREAD_LOCAL
+    /* This is called on the thread that owns the buffer, as it cleans up */
+    if (SDL_errbuf == errbuf) {
+        SDL_errbuf = NULL;
+    }
+#endif
+
     if (errbuf->str) {
         errbuf->free_func(errbuf->str);
     }
@@ -227,6 +259,13 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
         return NULL;
     }
 
+#ifdef SDL_THREAD_LOCAL
+    errbuf = SDL_errbuf;
+    if (errbuf || !create) {
+        return errbuf;
+    }
+#endif
+
     /* tls_being_created is there simply to prevent recursion if SDL_CreateTLS() fails.
        It also means it's possible for another thread to also use SDL_global_errbuf,
        but that's very unlikely and hopefully won't cause issues.
@@ -270,7 +309,13 @@ SDL_error *SDL_GetErrBuf(SDL_bool create)
         SDL_zerop(errbuf);
         errbuf->realloc_func = realloc_func;
         errbuf->free_func = free_func;
+#ifdef SDL_THREAD_LOCAL
+        if (SDL_SetTLS(tls_errbuf, errbuf, SDL_FreeErrBuf) == 0) {
+            SDL_errbuf = errbuf;
+        }
+#else
         SDL_SetTLS(tls_errbuf, errbuf, SDL_FreeErrBuf);
+#endif
     }
     return errbuf;
 #endif /* SDL_THREADS_DISABLED */
@@ -48,6 +48,11 @@
 #endif
 #include "../SDL_error_c.h"
 
+/* Compiler thread-local variables, used to skip the OS lookups in SDL_GetTLS() */
+#if defined(HAVE_GCC_THREAD_LOCAL) && !defined(SDL_THREADS_DISABLED)
+#define SDL_THREAD_LOCAL __thread
+#endif
+
 typedef enum SDL_ThreadState
 {
     SDL_THREAD_STATE_ALIVE,
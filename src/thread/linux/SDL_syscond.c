@@ -0,0 +1,100 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+// An implementation of condition variables using Linux futexes
+
+#include "SDL_sysfutex_c.h"
+
+/* Waiters sleep until the sequence number changes from the value they saw
+   before unlocking the mutex, so a signal sent in between isn't lost. */
+struct SDL_Condition
+{
+    SDL_AtomicInt sequence;
+    SDL_AtomicInt waiters;
+};
+
+/* Create a condition variable */
+SDL_Condition *SDL_CreateCondition(void)
+{
+    SDL_Condition *cond;
+
+    cond = (SDL_Condition *)SDL_calloc(1, sizeof(SDL_Condition));
+    return cond;
+}
+
+/* Destroy a condition variable */
+void SDL_DestroyCondition(SDL_Condition *cond)
+{
+    if (cond) {
+        SDL_free(cond);
+    }
+}
+
+/* Restart one of the threads that are waiting on the condition variable */
+int SDL_SignalCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    SDL_AtomicIncRef(&cond->sequence);
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_FutexWake(&cond->sequence.value, 1);
+    }
+    return 0;
+}
+
+/* Restart all threads that are waiting on the condition variable */
+int SDL_BroadcastCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    SDL_AtomicIncRef(&cond->sequence);
+    if (SDL_AtomicGet(&cond->waiters) > 0) {
+        SDL_FutexWake(&cond->sequence.value, SDL_MAX_SINT32);
+    }
+    return 0;
+}
+
+int SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS)
+{
+    int sequence;
+    int retval;
+
+    if (!cond) {
+        return SDL_InvalidParamError("cond");
+    }
+
+    /* Register as a waiter before reading the sequence number, so a signal
+       that changes it after this point also sees the waiter and wakes it. */
+    SDL_AtomicIncRef(&cond->waiters);
+    sequence = SDL_AtomicGet(&cond->sequence);
+
+    SDL_UnlockMutex(mutex);
+    retval = SDL_FutexWait(&cond->sequence.value, sequence, timeoutNS);
+    SDL_LockMutex(mutex);
+
+    SDL_AtomicDecRef(&cond->waiters);
+    return retval;
+}
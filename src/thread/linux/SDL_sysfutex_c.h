@@ -0,0 +1,72 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_sysfutex_c_h_
+#define SDL_sysfutex_c_h_
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* How many times to check a busy lock before going to sleep in the kernel.
+   Spinning only helps if the thread holding the lock can run at the same time. */
+#define SDL_FUTEX_SPIN_COUNT 100
+
+static SDL_INLINE int SDL_GetFutexSpinCount(void)
+{
+    static int spin_count = -1;
+
+    if (spin_count < 0) {
+        spin_count = (SDL_GetCPUCount() > 1) ? SDL_FUTEX_SPIN_COUNT : 0;
+    }
+    return spin_count;
+}
+
+/* Sleep while `*addr` is `expected`, for at most `timeoutNS`, or forever if it's negative.
+   This returns SDL_MUTEX_TIMEDOUT if the time ran out, or 0 if the thread was
+   woken up, `*addr` didn't match, or for no reason at all; callers check their
+   condition again either way. */
+static SDL_INLINE int SDL_FutexWait(int *addr, int expected, Sint64 timeoutNS)
+{
+    struct timespec timeout;
+    struct timespec *ptimeout = NULL;
+
+    if (timeoutNS >= 0) {
+        timeout.tv_sec = (time_t)(timeoutNS / SDL_NS_PER_SECOND);
+        timeout.tv_nsec = (long)(timeoutNS % SDL_NS_PER_SECOND);
+        ptimeout = &timeout;
+    }
+    if (syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, ptimeout, NULL, 0) < 0 && errno == ETIMEDOUT) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+    return 0;
+}
+
+/* Wake up to `count` threads sleeping on `addr` */
+static SDL_INLINE void SDL_FutexWake(int *addr, int count)
+{
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+#endif /* SDL_sysfutex_c_h_ */
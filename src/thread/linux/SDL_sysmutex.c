@@ -0,0 +1,143 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+// An implementation of mutexes using Linux futexes
+
+#include "SDL_sysfutex_c.h"
+
+/* The lock word is 0 when the mutex is unlocked, 1 when it's locked, and 2
+   when it's locked and other threads may be sleeping on it, so unlocking an
+   uncontended mutex never needs a system call. The uncontended paths use the
+   compiler atomics directly, since they're about as cheap as a function call. */
+#define SDL_MUTEX_UNLOCKED  0
+#define SDL_MUTEX_LOCKED    1
+#define SDL_MUTEX_CONTENDED 2
+
+struct SDL_Mutex
+{
+    SDL_AtomicInt state;
+    SDL_threadID owner;
+    int recursive;
+};
+
+SDL_Mutex *SDL_CreateMutex(void)
+{
+    SDL_Mutex *mutex;
+
+    // Allocate the structure
+    mutex = (SDL_Mutex *)SDL_calloc(1, sizeof(*mutex));
+    return mutex;
+}
+
+void SDL_DestroyMutex(SDL_Mutex *mutex)
+{
+    if (mutex) {
+        SDL_free(mutex);
+    }
+}
+
+static void SDL_LockMutexContended(SDL_Mutex *mutex)
+{
+    int spins = SDL_GetFutexSpinCount();
+
+    // The owner is likely to be done soon, so try for a while before sleeping
+    while (spins-- > 0) {
+        if (SDL_AtomicGet(&mutex->state) == SDL_MUTEX_UNLOCKED &&
+            SDL_AtomicCAS(&mutex->state, SDL_MUTEX_UNLOCKED, SDL_MUTEX_LOCKED)) {
+            return;
+        }
+        SDL_CPUPauseInstruction();
+    }
+
+    /* Once a thread has slept on the mutex, it takes it as contended, since
+       there may be others still sleeping that the next unlock has to wake. */
+    while (SDL_AtomicSet(&mutex->state, SDL_MUTEX_CONTENDED) != SDL_MUTEX_UNLOCKED) {
+        SDL_FutexWait(&mutex->state.value, SDL_MUTEX_CONTENDED, -1);
+    }
+}
+
+void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex != NULL) {
+        SDL_threadID this_thread = SDL_ThreadID();
+        if (mutex->owner == this_thread) {
+            ++mutex->recursive;
+        } else {
+            /* The order of operations is important.
+               We set the locking thread id after we obtain the lock
+               so unlocks from other threads will fail.
+             */
+            int expected = SDL_MUTEX_UNLOCKED;
+            if (!__atomic_compare_exchange_n(&mutex->state.value, &expected, SDL_MUTEX_LOCKED, SDL_FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+                SDL_LockMutexContended(mutex);
+            }
+            mutex->owner = this_thread;
+            mutex->recursive = 0;
+        }
+    }
+}
+
+int SDL_TryLockMutex(SDL_Mutex *mutex)
+{
+    int retval = 0;
+
+    if (mutex) {
+        SDL_threadID this_thread = SDL_ThreadID();
+        if (mutex->owner == this_thread) {
+            ++mutex->recursive;
+        } else if (SDL_AtomicCAS(&mutex->state, SDL_MUTEX_UNLOCKED, SDL_MUTEX_LOCKED)) {
+            mutex->owner = this_thread;
+            mutex->recursive = 0;
+        } else {
+            retval = SDL_MUTEX_TIMEDOUT;
+        }
+    }
+
+    return retval;
+}
+
+void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex != NULL) {
+        // If we don't own the mutex, we can't unlock it
+        if (SDL_ThreadID() != mutex->owner) {
+            SDL_assert(!"Tried to unlock a mutex we don't own!");
+            return; // (undefined behavior!) SDL_SetError("mutex not owned by this thread");
+        }
+
+        if (mutex->recursive) {
+            --mutex->recursive;
+        } else {
+            /* The order of operations is important.
+               First reset the owner so another thread doesn't lock
+               the mutex and set the ownership before we reset it,
+               then release the lock.
+             */
+            mutex->owner = 0;
+            if (__atomic_fetch_sub(&mutex->state.value, 1, __ATOMIC_RELEASE) != SDL_MUTEX_LOCKED) {
+                // Someone may be sleeping on the mutex, wake one of them up
+                SDL_AtomicSet(&mutex->state, SDL_MUTEX_UNLOCKED);
+                SDL_FutexWake(&mutex->state.value, 1);
+            }
+        }
+    }
+}
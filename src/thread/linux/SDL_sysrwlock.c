@@ -0,0 +1,160 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+// An implementation of rwlocks using Linux futexes
+
+#include "SDL_sysfutex_c.h"
+
+/* The lock word holds the number of readers, or -1 while a writer holds the
+   lock. Blocked threads sleep until the sequence number changes, which
+   happens whenever the lock becomes free while someone is waiting.
+
+   Readers can take the lock while writers wait, like the default pthread
+   rwlock, so that a thread can lock it for reading recursively. */
+#define SDL_RWLOCK_WRITER (-1)
+
+struct SDL_RWLock
+{
+    SDL_AtomicInt state;
+    SDL_AtomicInt sequence;
+    SDL_AtomicInt waiters;
+};
+
+SDL_RWLock *SDL_CreateRWLock(void)
+{
+    SDL_RWLock *rwlock;
+
+    /* Allocate the structure */
+    rwlock = (SDL_RWLock *)SDL_calloc(1, sizeof(*rwlock));
+    return rwlock;
+}
+
+void SDL_DestroyRWLock(SDL_RWLock *rwlock)
+{
+    if (rwlock) {
+        SDL_free(rwlock);
+    }
+}
+
+static SDL_bool SDL_TryLockForReading(SDL_RWLock *rwlock)
+{
+    int state = SDL_AtomicGet(&rwlock->state);
+
+    while (state != SDL_RWLOCK_WRITER) {
+        if (SDL_AtomicCAS(&rwlock->state, state, state + 1)) {
+            return SDL_TRUE;
+        }
+        state = SDL_AtomicGet(&rwlock->state);
+    }
+    return SDL_FALSE;
+}
+
+static SDL_bool SDL_TryLockForWriting(SDL_RWLock *rwlock)
+{
+    return SDL_AtomicCAS(&rwlock->state, 0, SDL_RWLOCK_WRITER);
+}
+
+static void SDL_LockRWLockContended(SDL_RWLock *rwlock, SDL_bool (*trylock)(SDL_RWLock *))
+{
+    int spins = SDL_GetFutexSpinCount();
+
+    // The lock is likely to be free soon, so try for a while before sleeping
+    while (spins-- > 0) {
+        SDL_CPUPauseInstruction();
+        if (trylock(rwlock)) {
+            return;
+        }
+    }
+
+    for (;;) {
+        /* Read the sequence number before the last try, so an unlock after
+           the try changes it and the wait returns right away. */
+        const int sequence = SDL_AtomicGet(&rwlock->sequence);
+        SDL_AtomicIncRef(&rwlock->waiters);
+        if (trylock(rwlock)) {
+            SDL_AtomicDecRef(&rwlock->waiters);
+            return;
+        }
+        SDL_FutexWait(&rwlock->sequence.value, sequence, -1);
+        SDL_AtomicDecRef(&rwlock->waiters);
+    }
+}
+
+void SDL_LockRWLockForReading(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
+{
+    if (rwlock && !SDL_TryLockForReading(rwlock)) {
+        SDL_LockRWLockContended(rwlock, SDL_TryLockForReading);
+    }
+}
+
+void SDL_LockRWLockForWriting(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
+{
+    if (rwlock && !SDL_TryLockForWriting(rwlock)) {
+        SDL_LockRWLockContended(rwlock, SDL_TryLockForWriting);
+    }
+}
+
+int SDL_TryLockRWLockForReading(SDL_RWLock *rwlock)
+{
+    int retval = 0;
+
+    if (rwlock && !SDL_TryLockForReading(rwlock)) {
+        retval = SDL_RWLOCK_TIMEDOUT;
+    }
+
+    return retval;
+}
+
+int SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
+{
+    int retval = 0;
+
+    if (rwlock && !SDL_TryLockForWriting(rwlock)) {
+        retval = SDL_RWLOCK_TIMEDOUT;
+    }
+
+    return retval;
+}
+
+void SDL_UnlockRWLock(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
+{
+    if (rwlock) {
+        SDL_bool released;
+
+        /* Only the threads holding the lock can change it away from a writer
+           or a count of readers, so this tells which kind of lock we hold. */
+        if (SDL_AtomicGet(&rwlock->state) == SDL_RWLOCK_WRITER) {
+            SDL_AtomicAdd(&rwlock->state, 1);
+            released = SDL_TRUE;
+        } else {
+            const int readers = SDL_AtomicAdd(&rwlock->state, -1);
+            SDL_assert(readers > 0);  // assume we're in a lot of trouble if this assert fails.
+            released = (readers == 1);
+        }
+
+        if (released && SDL_AtomicGet(&rwlock->waiters) > 0) {
+            // The lock is free, let everyone waiting try for it
+            SDL_AtomicIncRef(&rwlock->sequence);
+            SDL_FutexWake(&rwlock->sequence.value, SDL_MAX_SINT32);
+        }
+    }
+}
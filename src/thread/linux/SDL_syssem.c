@@ -0,0 +1,143 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+// An implementation of semaphores using Linux futexes
+
+#include "SDL_sysfutex_c.h"
+
+struct SDL_Semaphore
+{
+    SDL_AtomicInt count;
+    SDL_AtomicInt waiters;
+};
+
+/* Create a semaphore, initialized with value */
+SDL_Semaphore *SDL_CreateSemaphore(Uint32 initial_value)
+{
+    SDL_Semaphore *sem;
+
+    if (initial_value > SDL_MAX_SINT32) {
+        SDL_InvalidParamError("initial_value");
+        return NULL;
+    }
+
+    sem = (SDL_Semaphore *)SDL_calloc(1, sizeof(*sem));
+    if (sem) {
+        SDL_AtomicSet(&sem->count, (int)initial_value);
+    }
+    return sem;
+}
+
+void SDL_DestroySemaphore(SDL_Semaphore *sem)
+{
+    if (sem) {
+        SDL_free(sem);
+    }
+}
+
+static SDL_bool SDL_TryTakeSemaphore(SDL_Semaphore *sem)
+{
+    int count = SDL_AtomicGet(&sem->count);
+
+    while (count > 0) {
+        if (SDL_AtomicCAS(&sem->count, count, count - 1)) {
+            return SDL_TRUE;
+        }
+        count = SDL_AtomicGet(&sem->count);
+    }
+    return SDL_FALSE;
+}
+
+int SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
+{
+    Uint64 end = 0;
+    int spins;
+
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    /* Try the easy cases first */
+    if (SDL_TryTakeSemaphore(sem)) {
+        return 0;
+    }
+    if (timeoutNS == 0) {
+        return SDL_MUTEX_TIMEDOUT;
+    }
+
+    // A post is likely to come soon if we're in a producer/consumer loop
+    for (spins = SDL_GetFutexSpinCount(); spins > 0; --spins) {
+        SDL_CPUPauseInstruction();
+        if (SDL_TryTakeSemaphore(sem)) {
+            return 0;
+        }
+    }
+
+    if (timeoutNS > 0) {
+        end = SDL_GetTicksNS() + timeoutNS;
+    }
+    for (;;) {
+        Sint64 remaining = -1;
+
+        if (timeoutNS > 0) {
+            const Uint64 now = SDL_GetTicksNS();
+            if (now >= end) {
+                return SDL_MUTEX_TIMEDOUT;
+            }
+            remaining = (Sint64)(end - now);
+        }
+
+        /* Posts check for waiters after raising the count, and the kernel
+           checks the count is still zero before sleeping, so a post can't
+           slip in between without waking us up. */
+        SDL_AtomicIncRef(&sem->waiters);
+        SDL_FutexWait(&sem->count.value, 0, remaining);
+        SDL_AtomicDecRef(&sem->waiters);
+
+        if (SDL_TryTakeSemaphore(sem)) {
+            return 0;
+        }
+    }
+}
+
+Uint32 SDL_GetSemaphoreValue(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        SDL_InvalidParamError("sem");
+        return 0;
+    }
+
+    return (Uint32)SDL_AtomicGet(&sem->count);
+}
+
+int SDL_PostSemaphore(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        return SDL_InvalidParamError("sem");
+    }
+
+    SDL_AtomicIncRef(&sem->count);
+    if (SDL_AtomicGet(&sem->waiters) > 0) {
+        SDL_FutexWake(&sem->count.value, 1);
+    }
+    return 0;
+}
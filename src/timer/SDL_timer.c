@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_timer_c.h"
+#include "../SDL_hashtable.h"
 #include "../thread/SDL_systhread.h"
 
 /* #define DEBUG_TIMERS */
@@ -36,22 +37,16 @@ typedef struct SDL_Timer
     Uint64 scheduled;
     SDL_AtomicInt canceled;
     struct SDL_Timer *next;
+    struct SDL_Timer *child;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    int timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-/* The timers are kept in a sorted list */
+/* The timers are kept in a pairing heap, ordered by scheduling time */
 typedef struct
 {
     /* Data used by the main thread */
     SDL_Thread *thread;
     SDL_AtomicInt nextID;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     /* Padding to separate cache lines between threads */
@@ -64,7 +59,7 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    /* List of timers - this is only touched by the timer thread */
+    /* Heap of timers - this is only touched by the timer thread */
     SDL_Timer *timers;
 } SDL_TimerData;
 
@@ -73,27 +68,78 @@ static SDL_TimerData SDL_timer_data;
 /* The idea here is that any thread might add a timer, but a single
  * thread manages the active timer queue, sorted by scheduling time.
  *
+ * The queue is a pairing heap: the root is the next timer to fire, and
+ * each timer links to its first child, with siblings chained through
+ * `next`. Adding a timer is O(1) and removing the first one is amortized
+ * O(log n), without any allocations in the timer thread.
+ *
  * Timers are removed by simply setting a canceled flag
  */
 
+static SDL_Timer *SDL_MergeTimers(SDL_Timer *a, SDL_Timer *b)
+{
+    SDL_Timer *tmp;
+
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+    if (b->scheduled < a->scheduled) {
+        tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->next = a->child;
+    a->child = b;
+    return a;
+}
+
 static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    timer->next = NULL;
+    timer->child = NULL;
+    data->timers = SDL_MergeTimers(data->timers, timer);
+}
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+static SDL_Timer *SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *first = data->timers;
+    SDL_Timer *children = first->child;
+    SDL_Timer *pairs = NULL;
+    SDL_Timer *a, *b, *merged;
+
+    /* Merge the children in pairs, left to right... */
+    while (children) {
+        a = children;
+        b = a->next;
+        if (!b) {
+            a->next = pairs;
+            pairs = a;
             break;
         }
+        children = b->next;
+        merged = SDL_MergeTimers(a, b);
+        merged->next = pairs;
+        pairs = merged;
     }
 
-    /* Insert the timer here! */
-    if (prev) {
-        prev->next = timer;
-    } else {
-        data->timers = timer;
+    /* ... and then merge the pairs into one heap, right to left */
+    merged = NULL;
+    while (pairs) {
+        a = pairs;
+        pairs = a->next;
+        merged = SDL_MergeTimers(a, merged);
+    }
+    if (merged) {
+        merged->next = NULL;
     }
-    timer->next = curr;
+    data->timers = merged;
+
+    first->next = NULL;
+    first->child = NULL;
+    return first;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -156,7 +202,7 @@ static int SDLCALL SDL_TimerThread(void *_data)
             }
 
             /* We're going to do something with this timer */
-            data->timers = current->next;
+            SDL_RemoveFirstTimer(data);
 
             if (SDL_AtomicGet(&current->canceled)) {
                 interval = 0;
@@ -202,6 +248,11 @@ static int SDLCALL SDL_TimerThread(void *_data)
     return 0;
 }
 
+/* The map only refers to timers, which are owned by the timer lists */
+static void SDL_NukeTimerMapEntry(const void *key, const void *value, void *unused)
+{
+}
+
 int SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
@@ -213,9 +264,19 @@ int SDL_InitTimers(void)
             return -1;
         }
 
+        data->timermap = SDL_CreateHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, SDL_NukeTimerMapEntry, SDL_FALSE);
+        if (!data->timermap) {
+            SDL_DestroyMutex(data->timermap_lock);
+            data->timermap_lock = NULL;
+            return -1;
+        }
+
         data->sem = SDL_CreateSemaphore(0);
         if (!data->sem) {
+            SDL_DestroyHashTable(data->timermap);
+            data->timermap = NULL;
             SDL_DestroyMutex(data->timermap_lock);
+            data->timermap_lock = NULL;
             return -1;
         }
 
@@ -237,7 +298,6 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
 
     if (SDL_AtomicCAS(&data->active, 1, 0)) { /* active? Move to inactive. */
         /* Shutdown the timer thread */
@@ -252,8 +312,7 @@ void SDL_QuitTimers(void)
 
         /* Clean up the timer entries */
         while (data->timers) {
-            timer = data->timers;
-            data->timers = timer->next;
+            timer = SDL_RemoveFirstTimer(data);
             SDL_free(timer);
         }
         while (data->freelist) {
@@ -261,11 +320,8 @@ void SDL_QuitTimers(void)
             data->freelist = timer->next;
             SDL_free(timer);
         }
-        while (data->timermap) {
-            entry = data->timermap;
-            data->timermap = entry->next;
-            SDL_free(entry);
-        }
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
 
         SDL_DestroyMutex(data->timermap_lock);
         data->timermap_lock = NULL;
@@ -276,7 +332,8 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    SDL_TimerID timerID;
+    SDL_bool mapped;
 
     SDL_AtomicLock(&data->lock);
     if (!SDL_AtomicGet(&data->active)) {
@@ -306,19 +363,15 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     timer->interval = SDL_MS_TO_NS(interval);
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_AtomicSet(&timer->canceled, 0);
+    timerID = timer->timerID;
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    mapped = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timerID, timer);
+    SDL_UnlockMutex(data->timermap_lock);
+    if (!mapped) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     /* Add the timer to the pending list for the timer thread */
     SDL_AtomicLock(&data->lock);
@@ -329,36 +382,30 @@ SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *para
     /* Wake up the timer thread if necessary */
     SDL_PostSemaphore(data->sem);
 
-    return entry->timerID;
+    return timerID;
 }
 
 SDL_bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    const void *key = (const void *)(uintptr_t)id;
+    const void *value = NULL;
+    SDL_Timer *timer = NULL;
     SDL_bool canceled = SDL_FALSE;
 
     /* Find the timer */
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
+    if (SDL_FindInHashTable(data->timermap, key, &value)) {
+        timer = (SDL_Timer *)value;
+        SDL_RemoveFromHashTable(data->timermap, key);
     }
     SDL_UnlockMutex(data->timermap_lock);
 
-    if (entry) {
-        if (!SDL_AtomicGet(&entry->timer->canceled)) {
-            SDL_AtomicSet(&entry->timer->canceled, 1);
+    if (timer) {
+        if (!SDL_AtomicGet(&timer->canceled)) {
+            SDL_AtomicSet(&timer->canceled, 1);
             canceled = SDL_TRUE;
         }
-        SDL_free(entry);
     }
     return canceled;
 }
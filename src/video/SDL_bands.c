@@ -0,0 +1,78 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_bands_c.h"
+
+/* Bands smaller than this aren't worth handing to another thread */
+#define SDL_BAND_MIN_PIXELS (64 * 1024)
+
+typedef struct SDL_Bands
+{
+    SDL_BandFunc func;
+    void *data;
+    int h;
+    int band_h;
+} SDL_Bands;
+
+static void SDLCALL SDL_ProcessBands(void *userdata, int start, int end)
+{
+    SDL_Bands *bands = (SDL_Bands *)userdata;
+    int i;
+
+    for (i = start; i < end; ++i) {
+        const int y = i * bands->band_h;
+        bands->func(bands->data, y, SDL_min(bands->band_h, bands->h - y));
+    }
+}
+
+static int SDL_GetBandThreadCount(void)
+{
+    const char *hint = SDL_GetHint(SDL_HINT_SURFACE_THREADS);
+
+    if (!hint) {
+        return 1;
+    }
+    return SDL_clamp(SDL_atoi(hint), 1, 256);
+}
+
+void SDL_RunBands(int w, int h, int align, SDL_BandFunc func, void *data)
+{
+    SDL_Bands bands;
+    int num_bands;
+
+    num_bands = (int)SDL_min(((Sint64)w * h) / SDL_BAND_MIN_PIXELS, h / align);
+    if (num_bands >= 2) {
+        num_bands = SDL_min(num_bands, SDL_GetBandThreadCount());
+    }
+    if (num_bands < 2) {
+        func(data, 0, h);
+        return;
+    }
+
+    bands.func = func;
+    bands.data = data;
+    bands.h = h;
+    bands.band_h = (((h + num_bands - 1) / num_bands + align - 1) / align) * align;
+    num_bands = (h + bands.band_h - 1) / bands.band_h;
+
+    SDL_ParallelFor(0, num_bands, 1, SDL_ProcessBands, &bands);
+}
@@ -0,0 +1,40 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef SDL_bands_c_h_
+#define SDL_bands_c_h_
+
+#include "SDL_internal.h"
+
+/* Process `h` rows of `data`, starting at row `y` */
+typedef void (SDLCALL *SDL_BandFunc)(void *data, int y, int h);
+
+/* Run `func` over all the rows of a `w` x `h` image.
+
+   If SDL_HINT_SURFACE_THREADS allows it and the image is large enough, the
+   rows are split into horizontal bands that are processed in parallel on the
+   SDL job threads, and this returns when they are all done. Every band
+   except the last one is a multiple of `align` rows high. Otherwise `func`
+   is called once for all the rows, on the calling thread.
+*/
+extern void SDL_RunBands(int w, int h, int align, SDL_BandFunc func, void *data);
+
+#endif /* SDL_bands_c_h_ */
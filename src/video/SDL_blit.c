@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_sysvideo.h"
+#include "SDL_bands_c.h"
 #include "SDL_blit.h"
 #include "SDL_blit_auto.h"
 #include "SDL_blit_copy.h"
@@ -28,6 +29,24 @@
 #include "SDL_RLEaccel_c.h"
 #include "SDL_pixels_c.h"
 
+typedef struct
+{
+    SDL_BlitFunc func;
+    const SDL_BlitInfo *info;
+} SDL_BlitBands;
+
+static void SDLCALL SDL_SoftBlitBand(void *data, int y, int h)
+{
+    const SDL_BlitBands *bands = (const SDL_BlitBands *)data;
+    SDL_BlitInfo info = *bands->info;
+
+    info.src += y * info.src_pitch;
+    info.src_h = h;
+    info.dst += y * info.dst_pitch;
+    info.dst_h = h;
+    bands->func(&info);
+}
+
 /* The general purpose software blit routine */
 static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
                                 SDL_Surface *dst, const SDL_Rect *dstrect)
@@ -82,8 +101,17 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
             info->dst_pitch - info->dst_w * info->dst_fmt->BytesPerPixel;
         RunBlit = (SDL_BlitFunc)src->map->data;
 
-        /* Run the actual software blit */
-        RunBlit(info);
+        /* Run the actual software blit, in parallel if it's large enough.
+           Scaled rows depend on their position in the whole blit, and
+           overlapping rows need to be copied in order. */
+        if (!(info->flags & SDL_COPY_NEAREST) && src->pixels != dst->pixels) {
+            SDL_BlitBands bands;
+            bands.func = RunBlit;
+            bands.info = info;
+            SDL_RunBands(info->dst_w, info->dst_h, 1, SDL_SoftBlitBand, &bands);
+        } else {
+            RunBlit(info);
+        }
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -97,8 +125,6 @@ static int SDLCALL SDL_SoftBlit(SDL_Surface *src, const SDL_Rect *srcrect,
     return okay ? 0 : -1;
 }
 
-#if SDL_HAVE_BLIT_AUTO
-
 #ifdef __MACOS__
 #include <sys/sysctl.h>
 
@@ -122,10 +148,9 @@ static SDL_bool SDL_UseAltivecPrefetch(void)
 }
 #endif /* __MACOS__ */
 
-static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
-                                       SDL_BlitFuncEntry *entries)
+/* The SDL_CPU_* features the blitters may use */
+Uint32 SDL_GetBlitCPUFeatures(void)
 {
-    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
     static unsigned int features = 0x7fffffff;
 
     /* Get the available CPU features */
@@ -147,6 +172,15 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int
             if (SDL_HasSSE2()) {
                 features |= SDL_CPU_SSE2;
             }
+            if (SDL_HasSSE41()) {
+                features |= SDL_CPU_SSE41;
+            }
+            if (SDL_HasAVX2()) {
+                features |= SDL_CPU_AVX2;
+            }
+            if (SDL_HasNEON()) {
+                features |= SDL_CPU_NEON;
+            }
             if (SDL_HasAltiVec()) {
                 if (SDL_UseAltivecPrefetch()) {
                     features |= SDL_CPU_ALTIVEC_PREFETCH;
@@ -156,6 +190,15 @@ static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int
             }
         }
     }
+    return features;
+}
+
+#if SDL_HAVE_BLIT_AUTO
+static SDL_BlitFunc SDL_ChooseBlitFunc(Uint32 src_format, Uint32 dst_format, int flags,
+                                       SDL_BlitFuncEntry *entries)
+{
+    int i, flagcheck = (flags & (SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL | SDL_COPY_COLORKEY | SDL_COPY_NEAREST));
+    const Uint32 features = SDL_GetBlitCPUFeatures();
 
     for (i = 0; entries[i].func; ++i) {
         /* Check for matching pixel formats */
@@ -411,6 +411,309 @@ static void SDL_TARGETING("mmx") BlitRGBtoRGBPixelAlphaMMX(SDL_BlitInfo *info)
 
 #endif /* SDL_MMX_INTRINSICS */
 
+#if defined(SDL_SSE4_1_INTRINSICS) || defined(SDL_AVX2_INTRINSICS)
+
+/* Blending between any two 32-bit formats with 8-bit channels, with per-pixel
+   and/or surface alpha. These give exactly the same results as SDL_Blit_Slow():
+
+      srcA = srcA * surfaceA / 255
+      dstRGB = srcRGB * srcA / 255 + dstRGB * (255 - srcA) / 255
+      dstA = srcA + dstA * (255 - srcA) / 255
+
+   x86 is little endian, so byte N of a pixel in memory holds bits 8N to 8N+7.
+ */
+typedef struct
+{
+    Uint8 shuffle[16]; /* moves the src bytes of 4 pixels to where they go in dst */
+    Uint8 alpha[16];   /* spreads the alpha byte of each pixel (in dst order) across the pixel */
+    Uint32 src_fill;   /* opaque alpha, if src doesn't have any */
+    Uint32 dst_fill;   /* opaque alpha, if dst doesn't have any */
+    Uint32 alpha_mask; /* the alpha byte, in dst order */
+    Uint32 dst_mask;   /* the bytes written to dst, without alpha if it doesn't have any */
+} Blend8888Info;
+
+static SDL_bool Is8888Format(const SDL_PixelFormat *fmt)
+{
+    return fmt->BytesPerPixel == 4 && fmt->Rloss == 0 && fmt->Gloss == 0 && fmt->Bloss == 0 &&
+           fmt->Rshift % 8 == 0 && fmt->Gshift % 8 == 0 && fmt->Bshift % 8 == 0 &&
+           (fmt->Amask == 0 || (fmt->Aloss == 0 && fmt->Ashift % 8 == 0));
+}
+
+static void GetBlend8888Info(const SDL_PixelFormat *sf, const SDL_PixelFormat *df, Blend8888Info *bi)
+{
+    /* If dst has no alpha, use the unused byte for it while blending */
+    const int dsta = df->Amask ? (df->Ashift / 8) : (6 - (df->Rshift + df->Gshift + df->Bshift) / 8);
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        Uint8 *shuffle = &bi->shuffle[i * 4];
+        shuffle[df->Rshift / 8] = (Uint8)(i * 4 + sf->Rshift / 8);
+        shuffle[df->Gshift / 8] = (Uint8)(i * 4 + sf->Gshift / 8);
+        shuffle[df->Bshift / 8] = (Uint8)(i * 4 + sf->Bshift / 8);
+        shuffle[dsta] = sf->Amask ? (Uint8)(i * 4 + sf->Ashift / 8) : 0x80;
+        SDL_memset(&bi->alpha[i * 4], i * 4 + dsta, 4);
+    }
+    bi->alpha_mask = 0xFFu << (dsta * 8);
+    bi->src_fill = sf->Amask ? 0 : bi->alpha_mask;
+    bi->dst_fill = df->Amask ? 0 : bi->alpha_mask;
+    bi->dst_mask = df->Amask ? 0xFFFFFFFF : ~bi->alpha_mask;
+}
+
+#endif /* SDL_SSE4_1_INTRINSICS || SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_SSE4_1_INTRINSICS
+
+typedef struct
+{
+    __m128i shuffle;
+    __m128i alpha;
+    __m128i src_fill;
+    __m128i dst_fill;
+    __m128i alpha_mask;
+    __m128i alpha_lane; /* 0x00FF in the 16-bit alpha channels */
+    __m128i dst_mask;
+    __m128i modulate;
+} Blend8888VectorsSSE41;
+
+/* x / 255 for 0 <= x <= 255 * 255 */
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse4.1") Div255SSE41(__m128i x)
+{
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Blend 2 pixels that have been unpacked to 16 bits per channel */
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse4.1") Blend8888HalfSSE41(const Blend8888VectorsSSE41 *v, __m128i s, __m128i d, __m128i a, SDL_bool modulated)
+{
+    if (modulated) {
+        a = Div255SSE41(_mm_mullo_epi16(a, v->modulate));
+        s = _mm_blendv_epi8(s, a, v->alpha_lane);
+    }
+    /* The alpha channel is multiplied by 255, so it stays as it is */
+    s = Div255SSE41(_mm_mullo_epi16(s, _mm_or_si128(a, v->alpha_lane)));
+    d = Div255SSE41(_mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(255), a)));
+    return _mm_add_epi16(s, d);
+}
+
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse4.1") Blend8888SSE41(const Blend8888VectorsSSE41 *v, __m128i src, __m128i dst, SDL_bool modulated)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i s = _mm_or_si128(_mm_shuffle_epi8(src, v->shuffle), v->src_fill);
+    const __m128i d = _mm_or_si128(dst, v->dst_fill);
+    const __m128i a = _mm_shuffle_epi8(s, v->alpha);
+    __m128i lo, hi;
+
+    if (!modulated) {
+        if (_mm_testz_si128(s, v->alpha_mask)) {
+            return _mm_and_si128(d, v->dst_mask); /* all transparent */
+        }
+        if (_mm_testc_si128(s, v->alpha_mask)) {
+            return _mm_and_si128(s, v->dst_mask); /* all opaque */
+        }
+    }
+
+    lo = Blend8888HalfSSE41(v, _mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(a, zero), modulated);
+    hi = Blend8888HalfSSE41(v, _mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(a, zero), modulated);
+    return _mm_and_si128(_mm_packus_epi16(lo, hi), v->dst_mask);
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse4.1") Blit8888to8888AlphaSSE41(SDL_BlitInfo *info, SDL_bool modulated)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    Blend8888Info bi;
+    Blend8888VectorsSSE41 v;
+
+    GetBlend8888Info(info->src_fmt, info->dst_fmt, &bi);
+    v.shuffle = _mm_loadu_si128((const __m128i *)bi.shuffle);
+    v.alpha = _mm_loadu_si128((const __m128i *)bi.alpha);
+    v.src_fill = _mm_set1_epi32((int)bi.src_fill);
+    v.dst_fill = _mm_set1_epi32((int)bi.dst_fill);
+    v.alpha_mask = _mm_set1_epi32((int)bi.alpha_mask);
+    v.alpha_lane = _mm_unpacklo_epi8(v.alpha_mask, _mm_setzero_si128());
+    v.dst_mask = _mm_set1_epi32((int)bi.dst_mask);
+    v.modulate = _mm_set1_epi16(info->a);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 4; n -= 4) {
+            const __m128i s = _mm_loadu_si128((const __m128i *)src);
+            const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+            _mm_storeu_si128((__m128i *)dst, Blend8888SSE41(&v, s, d, modulated));
+            src += 16;
+            dst += 16;
+        }
+        if (n) {
+            /* Do the last few pixels the same way, so they come out exactly the same */
+            Uint32 s[4] = { 0, 0, 0, 0 };
+            Uint32 d[4] = { 0, 0, 0, 0 };
+            SDL_memcpy(s, src, n * 4);
+            SDL_memcpy(d, dst, n * 4);
+            _mm_storeu_si128((__m128i *)d, Blend8888SSE41(&v, _mm_loadu_si128((const __m128i *)s), _mm_loadu_si128((const __m128i *)d), modulated));
+            SDL_memcpy(dst, d, n * 4);
+            src += n * 4;
+            dst += n * 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("sse4.1") Blit8888to8888PixelAlphaSSE41(SDL_BlitInfo *info)
+{
+    Blit8888to8888AlphaSSE41(info, SDL_FALSE);
+}
+
+static void SDL_TARGETING("sse4.1") Blit8888to8888SurfaceAlphaSSE41(SDL_BlitInfo *info)
+{
+    Blit8888to8888AlphaSSE41(info, SDL_TRUE);
+}
+
+#endif /* SDL_SSE4_1_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+
+typedef struct
+{
+    __m256i shuffle;
+    __m256i alpha;
+    __m256i src_fill;
+    __m256i dst_fill;
+    __m256i alpha_mask;
+    __m256i alpha_lane; /* 0x00FF in the 16-bit alpha channels */
+    __m256i dst_mask;
+    __m256i modulate;
+} Blend8888VectorsAVX2;
+
+/* x / 255 for 0 <= x <= 255 * 255 */
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") Div255AVX2(__m256i x)
+{
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+}
+
+/* Blend 4 pixels that have been unpacked to 16 bits per channel */
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") Blend8888HalfAVX2(const Blend8888VectorsAVX2 *v, __m256i s, __m256i d, __m256i a, SDL_bool modulated)
+{
+    if (modulated) {
+        a = Div255AVX2(_mm256_mullo_epi16(a, v->modulate));
+        s = _mm256_blendv_epi8(s, a, v->alpha_lane);
+    }
+    /* The alpha channel is multiplied by 255, so it stays as it is */
+    s = Div255AVX2(_mm256_mullo_epi16(s, _mm256_or_si256(a, v->alpha_lane)));
+    d = Div255AVX2(_mm256_mullo_epi16(d, _mm256_sub_epi16(_mm256_set1_epi16(255), a)));
+    return _mm256_add_epi16(s, d);
+}
+
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") Blend8888AVX2(const Blend8888VectorsAVX2 *v, __m256i src, __m256i dst, SDL_bool modulated)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i s = _mm256_or_si256(_mm256_shuffle_epi8(src, v->shuffle), v->src_fill);
+    const __m256i d = _mm256_or_si256(dst, v->dst_fill);
+    const __m256i a = _mm256_shuffle_epi8(s, v->alpha);
+    __m256i lo, hi;
+
+    if (!modulated) {
+        if (_mm256_testz_si256(s, v->alpha_mask)) {
+            return _mm256_and_si256(d, v->dst_mask); /* all transparent */
+        }
+        if (_mm256_testc_si256(s, v->alpha_mask)) {
+            return _mm256_and_si256(s, v->dst_mask); /* all opaque */
+        }
+    }
+
+    /* These unpack and pack within each 128-bit lane, so the order is preserved */
+    lo = Blend8888HalfAVX2(v, _mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(a, zero), modulated);
+    hi = Blend8888HalfAVX2(v, _mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(a, zero), modulated);
+    return _mm256_and_si256(_mm256_packus_epi16(lo, hi), v->dst_mask);
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") Blit8888to8888AlphaAVX2(SDL_BlitInfo *info, SDL_bool modulated)
+{
+    int width = info->dst_w;
+    int height = info->dst_h;
+    Uint8 *src = info->src;
+    int srcskip = info->src_skip;
+    Uint8 *dst = info->dst;
+    int dstskip = info->dst_skip;
+    Blend8888Info bi;
+    Blend8888VectorsAVX2 v;
+
+    /* The shuffles work within each 128-bit lane, so both lanes get the same tables */
+    GetBlend8888Info(info->src_fmt, info->dst_fmt, &bi);
+    v.shuffle = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)bi.shuffle));
+    v.alpha = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)bi.alpha));
+    v.src_fill = _mm256_set1_epi32((int)bi.src_fill);
+    v.dst_fill = _mm256_set1_epi32((int)bi.dst_fill);
+    v.alpha_mask = _mm256_set1_epi32((int)bi.alpha_mask);
+    v.alpha_lane = _mm256_unpacklo_epi8(v.alpha_mask, _mm256_setzero_si256());
+    v.dst_mask = _mm256_set1_epi32((int)bi.dst_mask);
+    v.modulate = _mm256_set1_epi16(info->a);
+
+    while (height--) {
+        int n = width;
+
+        for (; n >= 8; n -= 8) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *)src);
+            const __m256i d = _mm256_loadu_si256((const __m256i *)dst);
+            _mm256_storeu_si256((__m256i *)dst, Blend8888AVX2(&v, s, d, modulated));
+            src += 32;
+            dst += 32;
+        }
+        if (n) {
+            /* Do the last few pixels the same way, so they come out exactly the same */
+            Uint32 s[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+            Uint32 d[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+            SDL_memcpy(s, src, n * 4);
+            SDL_memcpy(d, dst, n * 4);
+            _mm256_storeu_si256((__m256i *)d, Blend8888AVX2(&v, _mm256_loadu_si256((const __m256i *)s), _mm256_loadu_si256((const __m256i *)d), modulated));
+            SDL_memcpy(dst, d, n * 4);
+            src += n * 4;
+            dst += n * 4;
+        }
+        src += srcskip;
+        dst += dstskip;
+    }
+}
+
+static void SDL_TARGETING("avx2") Blit8888to8888PixelAlphaAVX2(SDL_BlitInfo *info)
+{
+    Blit8888to8888AlphaAVX2(info, SDL_FALSE);
+}
+
+static void SDL_TARGETING("avx2") Blit8888to8888SurfaceAlphaAVX2(SDL_BlitInfo *info)
+{
+    Blit8888to8888AlphaAVX2(info, SDL_TRUE);
+}
+
+#endif /* SDL_AVX2_INTRINSICS */
+
+/* Choose an SSE4.1 or AVX2 blitter for blending between 32-bit formats with 8-bit channels */
+static SDL_BlitFunc SDL_ChooseBlit8888to8888Alpha(SDL_Surface *surface, SDL_bool modulated)
+{
+#if defined(SDL_SSE4_1_INTRINSICS) || defined(SDL_AVX2_INTRINSICS)
+    const Uint32 features = SDL_GetBlitCPUFeatures();
+
+    if (!Is8888Format(surface->format) || !Is8888Format(surface->map->dst->format)) {
+        return NULL;
+    }
+#ifdef SDL_AVX2_INTRINSICS
+    if (features & SDL_CPU_AVX2) {
+        return modulated ? Blit8888to8888SurfaceAlphaAVX2 : Blit8888to8888PixelAlphaAVX2;
+    }
+#endif
+#ifdef SDL_SSE4_1_INTRINSICS
+    if (features & SDL_CPU_SSE41) {
+        return modulated ? Blit8888to8888SurfaceAlphaSSE41 : Blit8888to8888PixelAlphaSSE41;
+    }
+#endif
+#endif /* SDL_SSE4_1_INTRINSICS || SDL_AVX2_INTRINSICS */
+    return NULL;
+}
+
 #ifdef SDL_ARM_SIMD_BLITTERS
 void BlitARGBto565PixelAlphaARMSIMDAsm(int32_t w, int32_t h, uint16_t *dst, int32_t dst_stride, uint32_t *src, int32_t src_stride);
 
@@ -1320,9 +1623,15 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
 {
     SDL_PixelFormat *sf = surface->format;
     SDL_PixelFormat *df = surface->map->dst->format;
+    SDL_BlitFunc blit;
 
     switch (surface->map->info.flags & ~SDL_COPY_RLE_MASK) {
     case SDL_COPY_BLEND:
+        blit = SDL_ChooseBlit8888to8888Alpha(surface, SDL_FALSE);
+        if (blit) {
+            return blit;
+        }
+
         /* Per-pixel alpha blits */
         switch (df->BytesPerPixel) {
         case 1:
@@ -1393,6 +1702,11 @@ SDL_BlitFunc SDL_CalculateBlitA(SDL_Surface *surface)
         return BlitNtoNPixelAlpha;
 
     case SDL_COPY_MODULATE_ALPHA | SDL_COPY_BLEND:
+        blit = SDL_ChooseBlit8888to8888Alpha(surface, SDL_TRUE);
+        if (blit) {
+            return blit;
+        }
+
         if (sf->Amask == 0) {
             /* Per-surface alpha blits */
             switch (df->BytesPerPixel) {
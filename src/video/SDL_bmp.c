@@ -195,6 +195,7 @@ static void CorrectAlphaChannel(SDL_Surface *surface)
 
 SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
 {
+    SDL_RWops *base = src;
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset = 0;
     int i, pad;
@@ -204,6 +205,8 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
     Uint32 Bmask = 0;
     Uint32 Amask = 0;
     SDL_Palette *palette;
+    const Uint8 *entries;
+    Uint32 entrysize;
     Uint8 *bits;
     Uint8 *top, *end;
     SDL_bool topDown;
@@ -233,11 +236,22 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
 
     /* Make sure we are passed a valid data source */
     surface = NULL;
-    if (!src) {
+    if (!base) {
         SDL_InvalidParamError("src");
         goto done;
     }
 
+    /* The headers, palette and RLE data are read a few bytes at a time,
+       so buffer them unless they're already in memory */
+    if (base->type == SDL_RWOPS_MEMORY || base->type == SDL_RWOPS_MEMORY_RO) {
+        src = base;
+    } else {
+        src = SDL_CreateBufferedRW(base, 0);
+        if (!src) {
+            goto done;
+        }
+    }
+
     /* Read in the BMP file header */
     fp_offset = SDL_RWtell(src);
     if (fp_offset < 0) {
@@ -463,31 +477,25 @@ SDL_Surface *SDL_LoadBMP_RW(SDL_RWops *src, SDL_bool freesrc)
             }
         }
 
-        if (biSize == 12) {
-            for (i = 0; i < (int)biClrUsed; ++i) {
-                if (!SDL_ReadU8(src, &palette->colors[i].b) ||
-                    !SDL_ReadU8(src, &palette->colors[i].g) ||
-                    !SDL_ReadU8(src, &palette->colors[i].r)) {
-                    goto done;
-                }
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
-        } else {
-            for (i = 0; i < (int)biClrUsed; ++i) {
-                if (!SDL_ReadU8(src, &palette->colors[i].b) ||
-                    !SDL_ReadU8(src, &palette->colors[i].g) ||
-                    !SDL_ReadU8(src, &palette->colors[i].r) ||
-                    !SDL_ReadU8(src, &palette->colors[i].a)) {
-                    goto done;
-                }
+        /* The palette is at most 256 entries, which fits in the buffer */
+        entrysize = (biSize == 12) ? 3 : 4;
+        entries = (const Uint8 *)SDL_RWpeek(src, biClrUsed * entrysize);
+        if (!entries) {
+            goto done;
+        }
+        for (i = 0; i < (int)biClrUsed; ++i) {
+            palette->colors[i].b = entries[0];
+            palette->colors[i].g = entries[1];
+            palette->colors[i].r = entries[2];
 
-                /* According to Microsoft documentation, the fourth element
-                   is reserved and must be zero, so we shouldn't treat it as
-                   alpha.
-                */
-                palette->colors[i].a = SDL_ALPHA_OPAQUE;
-            }
+            /* According to Microsoft documentation, the fourth element
+               is reserved and must be zero, so we shouldn't treat it as
+               alpha.
+            */
+            palette->colors[i].a = SDL_ALPHA_OPAQUE;
+            entries += entrysize;
         }
+        SDL_RWconsume(src, biClrUsed * entrysize);
         palette->ncolors = biClrUsed;
     }
 
@@ -577,9 +585,12 @@ done:
         SDL_DestroySurface(surface);
         surface = NULL;
     }
-    if (freesrc && src) {
+    if (src && src != base) {
         SDL_RWclose(src);
     }
+    if (freesrc && base) {
+        SDL_RWclose(base);
+    }
     return surface;
 }
 
@@ -590,6 +601,7 @@ SDL_Surface *SDL_LoadBMP(const char *file)
 
 int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
 {
+    SDL_RWops *base = dst;
     SDL_bool was_error = SDL_TRUE;
     Sint64 fp_offset, new_offset;
     int i, pad;
@@ -693,6 +705,15 @@ int SDL_SaveBMP_RW(SDL_Surface *surface, SDL_RWops *dst, SDL_bool freedst)
         saveLegacyBMP = SDL_GetHintBoolean(SDL_HINT_BMP_SAVE_LEGACY_FORMAT, SDL_FALSE);
     }
 
+    /* The headers are written a few bytes at a time, so buffer them
+       unless they're going straight to memory */
+    if (base->type != SDL_RWOPS_MEMORY) {
+        dst = SDL_CreateBufferedRW(base, 0);
+        if (!dst) {
+            goto done;
+        }
+    }
+
     if (SDL_LockSurface(intermediate_surface) == 0) {
         const size_t bw = intermediate_surface->w * intermediate_surface->format->BytesPerPixel;
 
@@ -856,11 +877,17 @@ done:
     if (intermediate_surface && intermediate_surface != surface) {
         SDL_DestroySurface(intermediate_surface);
     }
-    if (freedst && dst) {
+    if (dst && dst != base) {
+        /* This writes out anything that's still buffered */
         if (SDL_RWclose(dst) < 0) {
             was_error = SDL_TRUE;
         }
     }
+    if (freedst && base) {
+        if (SDL_RWclose(base) < 0) {
+            was_error = SDL_TRUE;
+        }
+    }
     if (was_error) {
         return -1;
     }
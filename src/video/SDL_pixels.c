@@ -543,13 +543,128 @@ Uint32 SDL_GetPixelFormatEnumForMasks(int bpp, Uint32 Rmask, Uint32 Gmask, Uint3
     return SDL_PIXELFORMAT_UNKNOWN;
 }
 
+/* The formats that don't use a palette are shared and never freed, so they
+   can be looked up without taking a lock or counting references. */
+#if SDL_HAVE_YUV
+#define SDL_STATIC_FOURCC_FORMATS(X) \
+    X(YV12)                          \
+    X(IYUV)                          \
+    X(YUY2)                          \
+    X(UYVY)                          \
+    X(YVYU)                          \
+    X(NV12)                          \
+    X(NV21)                          \
+    X(EXTERNAL_OES)
+#else
+#define SDL_STATIC_FOURCC_FORMATS(X)
+#endif
+
+#define SDL_STATIC_FORMATS(X) \
+    X(RGB332)                 \
+    X(XRGB4444)               \
+    X(XBGR4444)               \
+    X(XRGB1555)               \
+    X(XBGR1555)               \
+    X(ARGB4444)               \
+    X(RGBA4444)               \
+    X(ABGR4444)               \
+    X(BGRA4444)               \
+    X(ARGB1555)               \
+    X(RGBA5551)               \
+    X(ABGR1555)               \
+    X(BGRA5551)               \
+    X(RGB565)                 \
+    X(BGR565)                 \
+    X(RGB24)                  \
+    X(BGR24)                  \
+    X(XRGB8888)               \
+    X(RGBX8888)               \
+    X(XBGR8888)               \
+    X(BGRX8888)               \
+    X(ARGB8888)               \
+    X(RGBA8888)               \
+    X(ABGR8888)               \
+    X(BGRA8888)               \
+    X(XRGB2101010)            \
+    X(XBGR2101010)            \
+    X(ARGB2101010)            \
+    X(ABGR2101010)            \
+    SDL_STATIC_FOURCC_FORMATS(X)
+
+enum
+{
+#define SDL_STATIC_FORMAT_INDEX(name) SDL_STATIC_FORMAT_##name,
+    SDL_STATIC_FORMATS(SDL_STATIC_FORMAT_INDEX)
+#undef SDL_STATIC_FORMAT_INDEX
+    SDL_NUM_STATIC_FORMATS
+};
+
+static const Uint32 static_format_enums[SDL_NUM_STATIC_FORMATS] = {
+#define SDL_STATIC_FORMAT_ENUM(name) SDL_PIXELFORMAT_##name,
+    SDL_STATIC_FORMATS(SDL_STATIC_FORMAT_ENUM)
+#undef SDL_STATIC_FORMAT_ENUM
+};
+
+static SDL_PixelFormat static_formats[SDL_NUM_STATIC_FORMATS];
+static SDL_AtomicInt static_formats_ready;
+static SDL_SpinLock static_formats_lock = 0;
+
+/* The palettized formats, and any others that aren't in the static table */
 static SDL_PixelFormat *formats;
 static SDL_SpinLock formats_lock = 0;
 
+static int SDL_GetStaticFormatIndex(Uint32 pixel_format)
+{
+    switch (pixel_format) {
+#define SDL_STATIC_FORMAT_CASE(name) \
+    case SDL_PIXELFORMAT_##name:     \
+        return SDL_STATIC_FORMAT_##name;
+        SDL_STATIC_FORMATS(SDL_STATIC_FORMAT_CASE)
+#undef SDL_STATIC_FORMAT_CASE
+    default:
+        return -1;
+    }
+}
+
+static SDL_PixelFormat *SDL_GetStaticFormat(Uint32 pixel_format)
+{
+    const int index = SDL_GetStaticFormatIndex(pixel_format);
+
+    if (index < 0) {
+        return NULL;
+    }
+
+    /* They're all set up the first time any of them is needed */
+    if (!SDL_AtomicGet(&static_formats_ready)) {
+        SDL_AtomicLock(&static_formats_lock);
+        if (!SDL_AtomicGet(&static_formats_ready)) {
+            int i;
+
+            for (i = 0; i < SDL_NUM_STATIC_FORMATS; ++i) {
+                if (SDL_InitFormat(&static_formats[i], static_format_enums[i]) < 0) {
+                    SDL_AtomicUnlock(&static_formats_lock);
+                    return NULL;
+                }
+            }
+            /* SDL_AtomicSet() isn't a release barrier everywhere, and the formats
+               need to be visible before threads that skip the lock see the flag */
+            SDL_MemoryBarrierRelease();
+            SDL_AtomicSet(&static_formats_ready, 1);
+        }
+        SDL_AtomicUnlock(&static_formats_lock);
+    }
+    return &static_formats[index];
+}
+
 SDL_PixelFormat *SDL_CreatePixelFormat(Uint32 pixel_format)
 {
     SDL_PixelFormat *format;
 
+    format = SDL_GetStaticFormat(pixel_format);
+    if (format) {
+        return format;
+    }
+
     SDL_AtomicLock(&formats_lock);
 
     /* Look it up in our list of previously allocated formats */
@@ -659,11 +774,18 @@ int SDL_InitFormat(SDL_PixelFormat *format, Uint32 pixel_format)
 void SDL_DestroyPixelFormat(SDL_PixelFormat *format)
 {
     SDL_PixelFormat *prev;
+    int index;
 
     if (!format) {
         return;
     }
 
+    /* The static formats are never freed */
+    index = SDL_GetStaticFormatIndex(format->format);
+    if (index >= 0 && format == &static_formats[index]) {
+        return;
+    }
+
     SDL_AtomicLock(&formats_lock);
 
     if (--format->refcount > 0) {
@@ -20,20 +20,29 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_bands_c.h"
 #include "SDL_blit.h"
 
-static int SDL_LowerSoftStretchNearest(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
-static int SDL_LowerSoftStretchLinear(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *dstrect);
+typedef struct
+{
+    SDL_Surface *src;
+    const SDL_Rect *srcrect;
+    SDL_Surface *dst;
+    const SDL_Rect *dstrect;
+} SDL_StretchBands;
+
+static void SDLCALL SDL_LowerSoftStretchNearest(void *data, int band_y, int band_h);
+static void SDLCALL SDL_LowerSoftStretchLinear(void *data, int band_y, int band_h);
 
 int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
                     SDL_Surface *dst, const SDL_Rect *dstrect,
                     SDL_ScaleMode scaleMode)
 {
-    int ret;
     int src_locked;
     int dst_locked;
     SDL_Rect full_src;
     SDL_Rect full_dst;
+    SDL_StretchBands bands;
 
 
     if (src->format->format != dst->format->format) {
@@ -111,10 +120,22 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
         src_locked = 1;
     }
 
-    if (scaleMode == SDL_SCALEMODE_NEAREST) {
-        ret = SDL_LowerSoftStretchNearest(src, srcrect, dst, dstrect);
+    /* Each destination row only depends on its position, so large stretches
+       can be done in parallel, unless they read and write the same pixels. */
+    bands.src = src;
+    bands.srcrect = srcrect;
+    bands.dst = dst;
+    bands.dstrect = dstrect;
+    if (src->pixels == dst->pixels) {
+        if (scaleMode == SDL_SCALEMODE_NEAREST) {
+            SDL_LowerSoftStretchNearest(&bands, 0, dstrect->h);
+        } else {
+            SDL_LowerSoftStretchLinear(&bands, 0, dstrect->h);
+        }
+    } else if (scaleMode == SDL_SCALEMODE_NEAREST) {
+        SDL_RunBands(dstrect->w, dstrect->h, 1, SDL_LowerSoftStretchNearest, &bands);
     } else {
-        ret = SDL_LowerSoftStretchLinear(src, srcrect, dst, dstrect);
+        SDL_RunBands(dstrect->w, dstrect->h, 1, SDL_LowerSoftStretchLinear, &bands);
     }
 
     /* We need to unlock the surfaces if they're locked */
@@ -125,7 +146,7 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
         SDL_UnlockSurface(src);
     }
 
-    return ret;
+    return 0;
 }
 
 /* bilinear interpolation precision must be < 8
@@ -149,6 +170,7 @@ int SDL_SoftStretch(SDL_Surface *src, const SDL_Rect *srcrect,
     int fp_sum_w_init, left_pad_w_init, right_pad_w_init, dst_gap, middle_init;       \
     get_scaler_datas(src_h, dst_h, &fp_sum_h, &fp_step_h, &left_pad_h, &right_pad_h); \
     get_scaler_datas(src_w, dst_w, &fp_sum_w, &fp_step_w, &left_pad_w, &right_pad_w); \
+    fp_sum_h += band_y * fp_step_h;                                                   \
     fp_sum_w_init = fp_sum_w + left_pad_w * fp_step_w;                                \
     left_pad_w_init = left_pad_w;                                                     \
     right_pad_w_init = right_pad_w;                                                   \
@@ -280,11 +302,11 @@ static SDL_INLINE void INTERPOL_BILINEAR(const Uint32 *s0, const Uint32 *s1, int
 }
 
 static int scale_mat(const Uint32 *src, int src_w, int src_h, int src_pitch,
-                     Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                     Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = band_y; i < band_y + band_h; i++) {
 
         BILINEAR___HEIGHT
 
@@ -400,11 +422,11 @@ static SDL_INLINE void SDL_TARGETING("sse2") INTERPOL_BILINEAR_SSE(const Uint32
     *dst = _mm_cvtsi128_si32(e0);
 }
 
-static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static int SDL_TARGETING("sse2") scale_mat_SSE(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = band_y; i < band_y + band_h; i++) {
         int nb_block2;
         __m128i v_frac_h0;
         __m128i v_frac_h1;
@@ -564,11 +586,11 @@ static SDL_INLINE void INTERPOL_BILINEAR_NEON(const Uint32 *s0, const Uint32 *s1
     *dst = vget_lane_u32(CAST_uint32x2_t e0, 0);
 }
 
-static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch, Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     BILINEAR___START
 
-    for (i = 0; i < dst_h; i++) {
+    for (i = band_y; i < band_y + band_h; i++) {
         int nb_block4;
         uint8x8_t v_frac_h0, v_frac_h1;
 
@@ -782,9 +804,13 @@ static int scale_mat_NEON(const Uint32 *src, int src_w, int src_h, int src_pitch
 }
 #endif
 
-int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
-                               SDL_Surface *d, const SDL_Rect *dstrect)
+static void SDLCALL SDL_LowerSoftStretchLinear(void *data, int band_y, int band_h)
 {
+    const SDL_StretchBands *bands = (const SDL_StretchBands *)data;
+    SDL_Surface *s = bands->src;
+    SDL_Surface *d = bands->dst;
+    const SDL_Rect *srcrect = bands->srcrect;
+    const SDL_Rect *dstrect = bands->dstrect;
     int ret = -1;
     int src_w = srcrect->w;
     int src_h = srcrect->h;
@@ -793,25 +819,23 @@ int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     int src_pitch = s->pitch;
     int dst_pitch = d->pitch;
     Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * 4 + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + dstrect->y * dst_pitch);
+    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * 4 + (dstrect->y + band_y) * dst_pitch);
 
 #ifdef SDL_NEON_INTRINSICS
     if (ret == -1 && hasNEON()) {
-        ret = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        ret = scale_mat_NEON(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     }
 #endif
 
 #ifdef SDL_SSE2_INTRINSICS
     if (ret == -1 && hasSSE2()) {
-        ret = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        ret = scale_mat_SSE(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     }
 #endif
 
     if (ret == -1) {
-        ret = scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        scale_mat(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     }
-
-    return ret;
 }
 
 #define SDL_SCALE_NEAREST__START       \
@@ -824,7 +848,7 @@ int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     incy = (src_h << 16) / dst_h;      \
     incx = (src_w << 16) / dst_w;      \
     dst_gap = dst_pitch - bpp * dst_w; \
-    posy = incy / 2;
+    posy = incy / 2 + band_y * incy;
 
 #define SDL_SCALE_NEAREST__HEIGHT                                         \
     srcy = (posy >> 16);                                                  \
@@ -834,11 +858,11 @@ int SDL_LowerSoftStretchLinear(SDL_Surface *s, const SDL_Rect *srcrect,
     n = dst_w;
 
 static int scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     Uint32 bpp = 1;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < band_h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -854,11 +878,11 @@ static int scale_mat_nearest_1(const Uint32 *src_ptr, int src_w, int src_h, int
 }
 
 static int scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     Uint32 bpp = 2;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < band_h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint16 *src;
@@ -874,11 +898,11 @@ static int scale_mat_nearest_2(const Uint32 *src_ptr, int src_w, int src_h, int
 }
 
 static int scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     Uint32 bpp = 3;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < band_h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint8 *src;
@@ -896,11 +920,11 @@ static int scale_mat_nearest_3(const Uint32 *src_ptr, int src_w, int src_h, int
 }
 
 static int scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int src_pitch,
-                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch)
+                               Uint32 *dst, int dst_w, int dst_h, int dst_pitch, int band_y, int band_h)
 {
     Uint32 bpp = 4;
     SDL_SCALE_NEAREST__START
-    for (i = 0; i < dst_h; i++) {
+    for (i = 0; i < band_h; i++) {
         SDL_SCALE_NEAREST__HEIGHT
         while (n--) {
             const Uint32 *src;
@@ -915,9 +939,13 @@ static int scale_mat_nearest_4(const Uint32 *src_ptr, int src_w, int src_h, int
     return 0;
 }
 
-int SDL_LowerSoftStretchNearest(SDL_Surface *s, const SDL_Rect *srcrect,
-                                SDL_Surface *d, const SDL_Rect *dstrect)
+static void SDLCALL SDL_LowerSoftStretchNearest(void *data, int band_y, int band_h)
 {
+    const SDL_StretchBands *bands = (const SDL_StretchBands *)data;
+    SDL_Surface *s = bands->src;
+    SDL_Surface *d = bands->dst;
+    const SDL_Rect *srcrect = bands->srcrect;
+    const SDL_Rect *dstrect = bands->dstrect;
     int src_w = srcrect->w;
     int src_h = srcrect->h;
     int dst_w = dstrect->w;
@@ -928,15 +956,15 @@ int SDL_LowerSoftStretchNearest(SDL_Surface *s, const SDL_Rect *srcrect,
     const int bpp = d->format->BytesPerPixel;
 
     Uint32 *src = (Uint32 *)((Uint8 *)s->pixels + srcrect->x * bpp + srcrect->y * src_pitch);
-    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + dstrect->y * dst_pitch);
+    Uint32 *dst = (Uint32 *)((Uint8 *)d->pixels + dstrect->x * bpp + (dstrect->y + band_y) * dst_pitch);
 
     if (bpp == 4) {
-        return scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        scale_mat_nearest_4(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     } else if (bpp == 3) {
-        return scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        scale_mat_nearest_3(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     } else if (bpp == 2) {
-        return scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        scale_mat_nearest_2(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     } else {
-        return scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch);
+        scale_mat_nearest_1(src, src_w, src_h, src_pitch, dst, dst_w, dst_h, dst_pitch, band_y, band_h);
     }
 }
@@ -1492,24 +1492,190 @@ int SDL_ConvertPixels(int width, int height,
     return ret;
 }
 
-/*
- * Premultiply the alpha on a block of pixels
- *
- * This is currently only implemented for SDL_PIXELFORMAT_ARGB8888
- *
- * Here are some ideas for optimization:
- * https://github.com/Wizermil/premultiply_alpha/tree/master/premultiply_alpha
- * https://developer.arm.com/documentation/101964/0201/Pre-multiplied-alpha-channel-data
+/* The shift of the alpha channel in the pixels, or -1 if the format can't be premultiplied */
+static int SDL_GetPremultiplyAlphaShift(Uint32 format)
+{
+    switch (format) {
+    case SDL_PIXELFORMAT_ARGB8888:
+    case SDL_PIXELFORMAT_ABGR8888:
+        return 24;
+    case SDL_PIXELFORMAT_RGBA8888:
+    case SDL_PIXELFORMAT_BGRA8888:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+typedef void (*SDL_PremultiplyAlphaFunc)(const Uint32 *src, Uint32 *dst, int n, int ashift);
+
+/* Every color channel becomes (x * a + 127) / 255, which is exactly
+ * (t + (t >> 8)) >> 8 with t = x * a + 128. Two channels at a time fit
+ * in 32 bits, since x * a + 128 never carries into the next channel.
  */
-int SDL_PremultiplyAlpha(int width, int height,
-                         Uint32 src_format, const void *src, int src_pitch,
-                         Uint32 dst_format, void *dst, int dst_pitch)
+static void SDL_PremultiplyAlphaPixels(const Uint32 *src, Uint32 *dst, int n, int ashift)
+{
+    const Uint32 amask = 0xFFu << ashift;
+
+    while (n--) {
+        const Uint32 pixel = *src++;
+        const Uint32 a = (pixel >> ashift) & 0xFF;
+        Uint32 rb = (pixel & 0x00FF00FF) * a + 0x00800080;
+        Uint32 ga = ((pixel >> 8) & 0x00FF00FF) * a + 0x00800080;
+
+        rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        ga = ((ga + ((ga >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+        *dst++ = ((rb | (ga << 8)) & ~amask) | (pixel & amask);
+    }
+}
+
+#ifdef SDL_SSE2_INTRINSICS
+/* Multiply 8 channels, each widened to 16 bits, by the alpha of their pixel */
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") SDL_PremultiplyChannelsSSE2(__m128i x, int ashift)
+{
+    const __m128i a = (ashift == 24) ? _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF)
+                                     : _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0x00), 0x00);
+
+    x = _mm_add_epi16(_mm_mullo_epi16(x, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+static void SDL_TARGETING("sse2") SDL_PremultiplyAlphaPixelsSSE2(const Uint32 *src, Uint32 *dst, int n, int ashift)
+{
+    const __m128i amask = _mm_set1_epi32((int)(0xFFu << ashift));
+    const __m128i zero = _mm_setzero_si128();
+    int i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        const __m128i pixels = _mm_loadu_si128((const __m128i *)(src + i));
+        const __m128i lo = SDL_PremultiplyChannelsSSE2(_mm_unpacklo_epi8(pixels, zero), ashift);
+        const __m128i hi = SDL_PremultiplyChannelsSSE2(_mm_unpackhi_epi8(pixels, zero), ashift);
+        const __m128i result = _mm_packus_epi16(lo, hi);
+
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_andnot_si128(amask, result), _mm_and_si128(amask, pixels)));
+    }
+    SDL_PremultiplyAlphaPixels(src + i, dst + i, n - i, ashift);
+}
+#endif
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") SDL_PremultiplyChannelsAVX2(__m256i x, int ashift)
+{
+    const __m256i a = (ashift == 24) ? _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF)
+                                     : _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0x00), 0x00);
+
+    x = _mm256_add_epi16(_mm256_mullo_epi16(x, a), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+static void SDL_TARGETING("avx2") SDL_PremultiplyAlphaPixelsAVX2(const Uint32 *src, Uint32 *dst, int n, int ashift)
+{
+    const __m256i amask = _mm256_set1_epi32((int)(0xFFu << ashift));
+    const __m256i zero = _mm256_setzero_si256();
+    int i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        const __m256i pixels = _mm256_loadu_si256((const __m256i *)(src + i));
+        const __m256i lo = SDL_PremultiplyChannelsAVX2(_mm256_unpacklo_epi8(pixels, zero), ashift);
+        const __m256i hi = SDL_PremultiplyChannelsAVX2(_mm256_unpackhi_epi8(pixels, zero), ashift);
+        const __m256i result = _mm256_packus_epi16(lo, hi);
+
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(_mm256_andnot_si256(amask, result), _mm256_and_si256(amask, pixels)));
+    }
+    SDL_PremultiplyAlphaPixels(src + i, dst + i, n - i, ashift);
+}
+#endif
+
+#ifdef SDL_NEON_INTRINSICS
+/* vraddhn_u16(t, vrshrq_n_u16(t, 8)) is the same (t + 128 + ((t + 128) >> 8)) >> 8 */
+SDL_FORCE_INLINE uint8x16_t SDL_PremultiplyChannelsNEON(uint8x16_t x, uint8x16_t a)
+{
+    const uint16x8_t lo = vmull_u8(vget_low_u8(x), vget_low_u8(a));
+    const uint16x8_t hi = vmull_u8(vget_high_u8(x), vget_high_u8(a));
+
+    return vcombine_u8(vraddhn_u16(lo, vrshrq_n_u16(lo, 8)), vraddhn_u16(hi, vrshrq_n_u16(hi, 8)));
+}
+
+static void SDL_PremultiplyAlphaPixelsNEON(const Uint32 *src, Uint32 *dst, int n, int ashift)
+{
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    const int aindex = ashift / 8;
+#else
+    const int aindex = 3 - ashift / 8;
+#endif
+    int i, c;
+
+    for (i = 0; i + 16 <= n; i += 16) {
+        uint8x16x4_t pixels = vld4q_u8((const uint8_t *)(src + i));
+        const uint8x16_t a = pixels.val[aindex];
+
+        for (c = 0; c < 4; ++c) {
+            if (c != aindex) {
+                pixels.val[c] = SDL_PremultiplyChannelsNEON(pixels.val[c], a);
+            }
+        }
+        vst4q_u8((uint8_t *)(dst + i), pixels);
+    }
+    SDL_PremultiplyAlphaPixels(src + i, dst + i, n - i, ashift);
+}
+#endif
+
+static SDL_PremultiplyAlphaFunc SDL_ChoosePremultiplyAlphaFunc(void)
 {
-    int c;
-    Uint32 srcpixel;
-    Uint32 srcR, srcG, srcB, srcA;
-    Uint32 dstpixel;
-    Uint32 dstR, dstG, dstB, dstA;
+    const Uint32 features = SDL_GetBlitCPUFeatures();
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (features & SDL_CPU_AVX2) {
+        return SDL_PremultiplyAlphaPixelsAVX2;
+    }
+#endif
+#ifdef SDL_SSE2_INTRINSICS
+    if (features & SDL_CPU_SSE2) {
+        return SDL_PremultiplyAlphaPixelsSSE2;
+    }
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    if (features & SDL_CPU_NEON) {
+        return SDL_PremultiplyAlphaPixelsNEON;
+    }
+#endif
+    (void)features;
+    return SDL_PremultiplyAlphaPixels;
+}
+
+/* Every color channel becomes x * 255 / a, rounded to nearest and clamped to 255.
+ * Pixels with no alpha become transparent black.
+ */
+static void SDL_UnpremultiplyAlphaPixels(const Uint32 *src, Uint32 *dst, int n, int ashift)
+{
+    const Uint32 amask = 0xFFu << ashift;
+    int shift;
+
+    while (n--) {
+        const Uint32 pixel = *src++;
+        const Uint32 a = (pixel >> ashift) & 0xFF;
+        Uint32 result = pixel & amask;
+
+        if (a == 255) {
+            result = pixel;
+        } else if (a) {
+            for (shift = 0; shift < 32; shift += 8) {
+                if (shift != ashift) {
+                    const Uint32 x = (((pixel >> shift) & 0xFF) * 255 + a / 2) / a;
+                    result |= SDL_min(x, 255) << shift;
+                }
+            }
+        }
+        *dst++ = result;
+    }
+}
+
+static int SDL_ConvertAlpha(int width, int height,
+                            Uint32 src_format, const void *src, int src_pitch,
+                            Uint32 dst_format, void *dst, int dst_pitch,
+                            SDL_PremultiplyAlphaFunc func)
+{
+    const int ashift = SDL_GetPremultiplyAlphaShift(src_format);
 
     if (!src) {
         return SDL_InvalidParamError("src");
@@ -1523,37 +1689,77 @@ int SDL_PremultiplyAlpha(int width, int height,
     if (!dst_pitch) {
         return SDL_InvalidParamError("dst_pitch");
     }
-    if (src_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (ashift < 0) {
         return SDL_InvalidParamError("src_format");
     }
-    if (dst_format != SDL_PIXELFORMAT_ARGB8888) {
+    if (SDL_GetPremultiplyAlphaShift(dst_format) < 0) {
         return SDL_InvalidParamError("dst_format");
     }
+    if (width <= 0 || height <= 0) {
+        return 0;
+    }
 
-    while (height--) {
-        const Uint32 *src_px = (const Uint32 *)src;
-        Uint32 *dst_px = (Uint32 *)dst;
-        for (c = width; c; --c) {
-            /* Component bytes extraction. */
-            srcpixel = *src_px++;
-            RGBA_FROM_ARGB8888(srcpixel, srcR, srcG, srcB, srcA);
-
-            /* Alpha pre-multiplication of each component. */
-            dstA = srcA;
-            dstR = (srcA * srcR) / 255;
-            dstG = (srcA * srcG) / 255;
-            dstB = (srcA * srcB) / 255;
+    /* Convert in the source format, and then reorder the channels in place */
+    {
+        const Uint8 *src_row = (const Uint8 *)src;
+        Uint8 *dst_row = (Uint8 *)dst;
+        SDL_PixelFormat *src_fmt = NULL;
+        SDL_PixelFormat *dst_fmt = NULL;
+        int h = height;
+
+        if (dst_format != src_format) {
+            src_fmt = SDL_CreatePixelFormat(src_format);
+            dst_fmt = SDL_CreatePixelFormat(dst_format);
+            if (!src_fmt || !dst_fmt) {
+                SDL_DestroyPixelFormat(src_fmt);
+                SDL_DestroyPixelFormat(dst_fmt);
+                return -1;
+            }
+        }
 
-            /* ARGB8888 pixel recomposition. */
-            ARGB8888_FROM_RGBA(dstpixel, dstR, dstG, dstB, dstA);
-            *dst_px++ = dstpixel;
+        while (h-- > 0) {
+            func((const Uint32 *)src_row, (Uint32 *)dst_row, width, ashift);
+            if (src_fmt) {
+                Uint32 *pixels = (Uint32 *)dst_row;
+                int n = width;
+
+                while (n-- > 0) {
+                    const Uint32 pixel = *pixels;
+                    *pixels++ = (((pixel >> src_fmt->Rshift) & 0xFF) << dst_fmt->Rshift) |
+                                (((pixel >> src_fmt->Gshift) & 0xFF) << dst_fmt->Gshift) |
+                                (((pixel >> src_fmt->Bshift) & 0xFF) << dst_fmt->Bshift) |
+                                (((pixel >> src_fmt->Ashift) & 0xFF) << dst_fmt->Ashift);
+                }
+            }
+            src_row += src_pitch;
+            dst_row += dst_pitch;
         }
-        src = (const Uint8 *)src + src_pitch;
-        dst = (Uint8 *)dst + dst_pitch;
+        SDL_DestroyPixelFormat(src_fmt);
+        SDL_DestroyPixelFormat(dst_fmt);
     }
     return 0;
 }
 
+/*
+ * Premultiply the alpha on a block of pixels
+ */
+int SDL_PremultiplyAlpha(int width, int height,
+                         Uint32 src_format, const void *src, int src_pitch,
+                         Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertAlpha(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, SDL_ChoosePremultiplyAlphaFunc());
+}
+
+/*
+ * Undo the alpha premultiplication on a block of pixels
+ */
+int SDL_UnpremultiplyAlpha(int width, int height,
+                           Uint32 src_format, const void *src, int src_pitch,
+                           Uint32 dst_format, void *dst, int dst_pitch)
+{
+    return SDL_ConvertAlpha(width, height, src_format, src, src_pitch, dst_format, dst, dst_pitch, SDL_UnpremultiplyAlphaPixels);
+}
+
 /*
  * Free a surface created by the above function.
  */
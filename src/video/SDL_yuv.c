@@ -20,6 +20,7 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_bands_c.h"
 #include "SDL_pixels_c.h"
 #include "SDL_yuv_c.h"
 
@@ -577,34 +578,83 @@ static SDL_bool yuv_rgb_std(
     return SDL_FALSE;
 }
 
+typedef struct
+{
+    Uint32 src_format;
+    Uint32 dst_format;
+    int width;
+    const Uint8 *y;
+    const Uint8 *u;
+    const Uint8 *v;
+    Uint32 y_stride;
+    Uint32 uv_stride;
+    Uint8 *rgb;
+    Uint32 rgb_stride;
+    YCbCrType yuv_type;
+    SDL_AtomicInt unsupported;
+} YUVToRGBBands;
+
+/* Bands start on even rows, so they start on a row of chroma in 4:2:0 formats */
+static void SDLCALL yuv_rgb_band(void *data, int row, int rows)
+{
+    YUVToRGBBands *bands = (YUVToRGBBands *)data;
+    const int uv_row = (bands->src_format == SDL_PIXELFORMAT_YV12 ||
+                        bands->src_format == SDL_PIXELFORMAT_IYUV ||
+                        bands->src_format == SDL_PIXELFORMAT_NV12 ||
+                        bands->src_format == SDL_PIXELFORMAT_NV21) ? (row / 2) : row;
+    const Uint8 *y = bands->y + (size_t)row * bands->y_stride;
+    const Uint8 *u = bands->u + (size_t)uv_row * bands->uv_stride;
+    const Uint8 *v = bands->v + (size_t)uv_row * bands->uv_stride;
+    Uint8 *rgb = bands->rgb + (size_t)row * bands->rgb_stride;
+
+    if (yuv_rgb_sse(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    if (yuv_rgb_lsx(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    if (yuv_rgb_std(bands->src_format, bands->dst_format, bands->width, rows, y, u, v, bands->y_stride, bands->uv_stride, rgb, bands->rgb_stride, bands->yuv_type)) {
+        return;
+    }
+
+    SDL_AtomicSet(&bands->unsupported, 1);
+}
+
 int SDL_ConvertPixels_YUV_to_RGB(int width, int height,
                                  Uint32 src_format, const void *src, int src_pitch,
                                  Uint32 dst_format, void *dst, int dst_pitch)
 {
-    const Uint8 *y = NULL;
-    const Uint8 *u = NULL;
-    const Uint8 *v = NULL;
-    Uint32 y_stride = 0;
-    Uint32 uv_stride = 0;
-    YCbCrType yuv_type = YCBCR_601;
-
-    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &y, &u, &v, &y_stride, &uv_stride) < 0) {
-        return -1;
-    }
+    YUVToRGBBands bands;
+
+    SDL_zero(bands);
+    bands.src_format = src_format;
+    bands.dst_format = dst_format;
+    bands.width = width;
+    bands.rgb = (Uint8 *)dst;
+    bands.rgb_stride = dst_pitch;
+    bands.yuv_type = YCBCR_601;
 
-    if (GetYUVConversionType(width, height, &yuv_type) < 0) {
+    if (GetYUVPlanes(width, height, src_format, src, src_pitch, &bands.y, &bands.u, &bands.v, &bands.y_stride, &bands.uv_stride) < 0) {
         return -1;
     }
 
-    if (yuv_rgb_sse(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
+    if (GetYUVConversionType(width, height, &bands.yuv_type) < 0) {
+        return -1;
     }
 
-    if (yuv_rgb_lsx(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
-        return 0;
+    /* Whether there's a fast path only depends on the formats, so either every band is converted or none are.
+       The SSE code converts the last row of packed 4:2:2 data with the C code, which rounds a little
+       differently, so those are done in one band to give the same results as always. */
+    if (src_format == SDL_PIXELFORMAT_YUY2 ||
+        src_format == SDL_PIXELFORMAT_UYVY ||
+        src_format == SDL_PIXELFORMAT_YVYU) {
+        yuv_rgb_band(&bands, 0, height);
+    } else {
+        SDL_RunBands(width, height, 2, yuv_rgb_band, &bands);
     }
-
-    if (yuv_rgb_std(src_format, dst_format, width, height, y, u, v, y_stride, uv_stride, (Uint8 *)dst, dst_pitch, yuv_type)) {
+    if (!SDL_AtomicGet(&bands.unsupported)) {
         return 0;
     }
 
@@ -85,6 +85,26 @@ my %set_rgba_string = (
     "BGRA8888" => "_pixel = (_B << 24) | (_G << 16) | (_R << 8) | _A;",
 );
 
+# The SIMD instruction sets we generate blitters for, fastest first
+my @simd_isas = (
+    [ "AVX2", "SDL_AVX2_INTRINSICS", "SDL_CPU_AVX2" ],
+    [ "SSE2", "SDL_SSE2_INTRINSICS", "SDL_CPU_SSE2" ],
+    [ "NEON", "SDL_NEON_INTRINSICS", "SDL_CPU_NEON" ],
+);
+
+# The SIMD blitters are small, so they're generated for every 8888 destination
+my @simd_dst_formats = @src_formats;
+
+# The shifts of the R, G, B and A channels, -1 if there's no alpha
+my %format_shifts = (
+    "XRGB8888" => "16, 8, 0, -1",
+    "XBGR8888" => "0, 8, 16, -1",
+    "ARGB8888" => "16, 8, 0, 24",
+    "RGBA8888" => "24, 16, 8, 0",
+    "ABGR8888" => "0, 8, 16, 24",
+    "BGRA8888" => "8, 16, 24, 0",
+);
+
 sub open_file {
     my $name = shift;
     open(FILE, ">$name.new") || die "Can't open $name.new: $!";
@@ -152,6 +172,7 @@ sub output_copyfuncname
     my $scale = shift;
     my $args = shift;
     my $suffix = shift;
+    my $isa = shift;
 
     print FILE "$prefix SDL_Blit_${src}_${dst}";
     if ( $modulate ) {
@@ -163,6 +184,9 @@ sub output_copyfuncname
     if ( $scale ) {
         print FILE "_Scale";
     }
+    if ( $isa ) {
+        print FILE "_$isa";
+    }
     if ( $args ) {
         print FILE "(SDL_BlitInfo *info)";
     }
@@ -595,12 +619,16 @@ SDL_BlitFuncEntry SDL_GeneratedBlitFuncTable[] = {
 __EOF__
     for (my $i = 0; $i <= $#src_formats; ++$i) {
         my $src = $src_formats[$i];
-        for (my $j = 0; $j <= $#dst_formats; ++$j) {
-            my $dst = $dst_formats[$j];
+        for (my $j = 0; $j <= $#simd_dst_formats; ++$j) {
+            my $dst = $simd_dst_formats[$j];
+            my $has_c = grep { $_ eq $dst } @dst_formats;
             for (my $modulate = 0; $modulate <= 1; ++$modulate) {
                 for (my $blend = 0; $blend <= 1; ++$blend) {
                     for (my $scale = 0; $scale <= 1; ++$scale) {
-                        if ( $modulate || $blend || $scale ) {
+                        if ( has_simd($modulate, $blend, $scale) ) {
+                            output_simdtableentries($src, $dst, $modulate, $blend, $scale);
+                        }
+                        if ( $has_c && ($modulate || $blend || $scale) ) {
                             print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ";
                             my $flags = "";
                             my $flag = "";
@@ -632,7 +660,7 @@ __EOF__
                                 $flags = "0";
                             }
                             print FILE "($flags), SDL_CPU_ANY,";
-                            output_copyfuncname("", $src_formats[$i], $dst_formats[$j], $modulate, $blend, $scale, 0, " },\n");
+                            output_copyfuncname("", $src, $dst, $modulate, $blend, $scale, 0, " },\n");
                         }
                     }
                 }
@@ -662,6 +690,478 @@ sub output_copyfunc_c
     }
 }
 
+# Whether there's a SIMD version of a blitter. Blending is only done with
+# SDL_COPY_BLEND, the other blend modes use the C version. The unscaled
+# blend without modulation is handled by SDL_CalculateBlitA().
+sub has_simd
+{
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+
+    return ($modulate || ($blend && $scale)) ? 1 : 0;
+}
+
+sub output_simdhelpers
+{
+    my $format;
+
+    print FILE <<__EOF__;
+#if defined(SDL_SSE2_INTRINSICS) || defined(SDL_AVX2_INTRINSICS) || defined(SDL_NEON_INTRINSICS)
+
+/* The SIMD blitters work on 8-bit channels unpacked to 16 bits, so they can
+   give exactly the same results as the C versions, and only need the shifts
+   of the channels to handle any pair of formats. */
+
+__EOF__
+    foreach $format (@src_formats) {
+        print FILE "static const Sint8 SDL_Shifts_${format}[4] = { $format_shifts{$format} };\n";
+    }
+    print FILE <<'__EOF__';
+
+#endif /* SDL_SSE2_INTRINSICS || SDL_AVX2_INTRINSICS || SDL_NEON_INTRINSICS */
+
+#ifdef SDL_AVX2_INTRINSICS
+
+typedef struct
+{
+    __m128i src_shift[4]; /* R, G, B, A */
+    __m128i dst_shift[4];
+    __m256i mask;         /* 0xFF in each 32-bit lane */
+    __m256i src_amask;    /* 0xFF in each 16-bit lane if src has alpha */
+    __m256i src_afill;    /* 0xFF in each 16-bit lane if src doesn't have alpha */
+    __m256i dst_amask;
+    __m256i dst_afill;
+    __m256i modulate[4];
+} SDL_Blit8888State_AVX2;
+
+/* x * y / 255 for 0 <= x, y <= 255 */
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") SDL_Mul255_AVX2(__m256i x, __m256i y)
+{
+    x = _mm256_mullo_epi16(x, y);
+    return _mm256_srli_epi16(_mm256_add_epi16(_mm256_add_epi16(x, _mm256_set1_epi16(1)), _mm256_srli_epi16(x, 8)), 8);
+}
+
+/* Unpack one channel of 16 pixels to 16-bit lanes */
+SDL_FORCE_INLINE __m256i SDL_TARGETING("avx2") SDL_GetChannel_AVX2(__m256i lo, __m256i hi, __m128i shift, __m256i mask)
+{
+    return _mm256_packs_epi32(_mm256_and_si256(_mm256_srl_epi32(lo, shift), mask), _mm256_and_si256(_mm256_srl_epi32(hi, shift), mask));
+}
+
+/* The reverse of SDL_GetChannel_AVX2(), the unpack undoes the lane order of the pack */
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") SDL_PutChannel_AVX2(__m256i *lo, __m256i *hi, __m256i c, __m128i shift)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    *lo = _mm256_or_si256(*lo, _mm256_sll_epi32(_mm256_unpacklo_epi16(c, zero), shift));
+    *hi = _mm256_or_si256(*hi, _mm256_sll_epi32(_mm256_unpackhi_epi16(c, zero), shift));
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") SDL_Blit8888Pixels_AVX2(const SDL_Blit8888State_AVX2 *v, const Uint32 *src, Uint32 *dst, SDL_bool modulate, SDL_bool blend)
+{
+    const __m256i s0 = _mm256_loadu_si256((const __m256i *)src);
+    const __m256i s1 = _mm256_loadu_si256((const __m256i *)(src + 8));
+    __m256i R = SDL_GetChannel_AVX2(s0, s1, v->src_shift[0], v->mask);
+    __m256i G = SDL_GetChannel_AVX2(s0, s1, v->src_shift[1], v->mask);
+    __m256i B = SDL_GetChannel_AVX2(s0, s1, v->src_shift[2], v->mask);
+    __m256i A = _mm256_or_si256(_mm256_and_si256(SDL_GetChannel_AVX2(s0, s1, v->src_shift[3], v->mask), v->src_amask), v->src_afill);
+    __m256i lo = _mm256_setzero_si256();
+    __m256i hi = _mm256_setzero_si256();
+
+    if (modulate) {
+        R = SDL_Mul255_AVX2(R, v->modulate[0]);
+        G = SDL_Mul255_AVX2(G, v->modulate[1]);
+        B = SDL_Mul255_AVX2(B, v->modulate[2]);
+        A = SDL_Mul255_AVX2(A, v->modulate[3]);
+    }
+    if (blend) {
+        const __m256i d0 = _mm256_loadu_si256((const __m256i *)dst);
+        const __m256i d1 = _mm256_loadu_si256((const __m256i *)(dst + 8));
+        const __m256i dstA = _mm256_or_si256(_mm256_and_si256(SDL_GetChannel_AVX2(d0, d1, v->dst_shift[3], v->mask), v->dst_amask), v->dst_afill);
+        const __m256i inv = _mm256_sub_epi16(_mm256_set1_epi16(255), A);
+        R = _mm256_add_epi16(SDL_Mul255_AVX2(R, A), SDL_Mul255_AVX2(SDL_GetChannel_AVX2(d0, d1, v->dst_shift[0], v->mask), inv));
+        G = _mm256_add_epi16(SDL_Mul255_AVX2(G, A), SDL_Mul255_AVX2(SDL_GetChannel_AVX2(d0, d1, v->dst_shift[1], v->mask), inv));
+        B = _mm256_add_epi16(SDL_Mul255_AVX2(B, A), SDL_Mul255_AVX2(SDL_GetChannel_AVX2(d0, d1, v->dst_shift[2], v->mask), inv));
+        A = _mm256_add_epi16(A, SDL_Mul255_AVX2(dstA, inv));
+    }
+
+    SDL_PutChannel_AVX2(&lo, &hi, R, v->dst_shift[0]);
+    SDL_PutChannel_AVX2(&lo, &hi, G, v->dst_shift[1]);
+    SDL_PutChannel_AVX2(&lo, &hi, B, v->dst_shift[2]);
+    SDL_PutChannel_AVX2(&lo, &hi, _mm256_and_si256(A, v->dst_amask), v->dst_shift[3]);
+    _mm256_storeu_si256((__m256i *)dst, lo);
+    _mm256_storeu_si256((__m256i *)(dst + 8), hi);
+}
+
+static void SDL_TARGETING("avx2") SDL_Blit8888Init_AVX2(SDL_BlitInfo *info, const Sint8 *src_shifts, const Sint8 *dst_shifts, SDL_Blit8888State_AVX2 *v)
+{
+    const int flags = info->flags;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        v->src_shift[i] = _mm_cvtsi32_si128(SDL_max(src_shifts[i], 0));
+        v->dst_shift[i] = _mm_cvtsi32_si128(SDL_max(dst_shifts[i], 0));
+    }
+    v->mask = _mm256_set1_epi32(0xFF);
+    v->src_amask = _mm256_set1_epi16(src_shifts[3] < 0 ? 0 : 0xFF);
+    v->src_afill = _mm256_set1_epi16(src_shifts[3] < 0 ? 0xFF : 0);
+    v->dst_amask = _mm256_set1_epi16(dst_shifts[3] < 0 ? 0 : 0xFF);
+    v->dst_afill = _mm256_set1_epi16(dst_shifts[3] < 0 ? 0xFF : 0);
+    v->modulate[0] = _mm256_set1_epi16((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255);
+    v->modulate[1] = _mm256_set1_epi16((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255);
+    v->modulate[2] = _mm256_set1_epi16((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255);
+    v->modulate[3] = _mm256_set1_epi16((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255);
+}
+
+__EOF__
+    output_simdrows("AVX2", "SDL_TARGETING(\"avx2\") ", 16);
+    print FILE <<'__EOF__';
+#endif /* SDL_AVX2_INTRINSICS */
+
+#ifdef SDL_SSE2_INTRINSICS
+
+typedef struct
+{
+    __m128i src_shift[4]; /* R, G, B, A */
+    __m128i dst_shift[4];
+    __m128i mask;         /* 0xFF in each 32-bit lane */
+    __m128i src_amask;    /* 0xFF in each 16-bit lane if src has alpha */
+    __m128i src_afill;    /* 0xFF in each 16-bit lane if src doesn't have alpha */
+    __m128i dst_amask;
+    __m128i dst_afill;
+    __m128i modulate[4];
+} SDL_Blit8888State_SSE2;
+
+/* x * y / 255 for 0 <= x, y <= 255 */
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") SDL_Mul255_SSE2(__m128i x, __m128i y)
+{
+    x = _mm_mullo_epi16(x, y);
+    return _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8)), 8);
+}
+
+/* Unpack one channel of 8 pixels to 16-bit lanes */
+SDL_FORCE_INLINE __m128i SDL_TARGETING("sse2") SDL_GetChannel_SSE2(__m128i lo, __m128i hi, __m128i shift, __m128i mask)
+{
+    return _mm_packs_epi32(_mm_and_si128(_mm_srl_epi32(lo, shift), mask), _mm_and_si128(_mm_srl_epi32(hi, shift), mask));
+}
+
+/* The reverse of SDL_GetChannel_SSE2() */
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") SDL_PutChannel_SSE2(__m128i *lo, __m128i *hi, __m128i c, __m128i shift)
+{
+    const __m128i zero = _mm_setzero_si128();
+    *lo = _mm_or_si128(*lo, _mm_sll_epi32(_mm_unpacklo_epi16(c, zero), shift));
+    *hi = _mm_or_si128(*hi, _mm_sll_epi32(_mm_unpackhi_epi16(c, zero), shift));
+}
+
+SDL_FORCE_INLINE void SDL_TARGETING("sse2") SDL_Blit8888Pixels_SSE2(const SDL_Blit8888State_SSE2 *v, const Uint32 *src, Uint32 *dst, SDL_bool modulate, SDL_bool blend)
+{
+    const __m128i s0 = _mm_loadu_si128((const __m128i *)src);
+    const __m128i s1 = _mm_loadu_si128((const __m128i *)(src + 4));
+    __m128i R = SDL_GetChannel_SSE2(s0, s1, v->src_shift[0], v->mask);
+    __m128i G = SDL_GetChannel_SSE2(s0, s1, v->src_shift[1], v->mask);
+    __m128i B = SDL_GetChannel_SSE2(s0, s1, v->src_shift[2], v->mask);
+    __m128i A = _mm_or_si128(_mm_and_si128(SDL_GetChannel_SSE2(s0, s1, v->src_shift[3], v->mask), v->src_amask), v->src_afill);
+    __m128i lo = _mm_setzero_si128();
+    __m128i hi = _mm_setzero_si128();
+
+    if (modulate) {
+        R = SDL_Mul255_SSE2(R, v->modulate[0]);
+        G = SDL_Mul255_SSE2(G, v->modulate[1]);
+        B = SDL_Mul255_SSE2(B, v->modulate[2]);
+        A = SDL_Mul255_SSE2(A, v->modulate[3]);
+    }
+    if (blend) {
+        const __m128i d0 = _mm_loadu_si128((const __m128i *)dst);
+        const __m128i d1 = _mm_loadu_si128((const __m128i *)(dst + 4));
+        const __m128i dstA = _mm_or_si128(_mm_and_si128(SDL_GetChannel_SSE2(d0, d1, v->dst_shift[3], v->mask), v->dst_amask), v->dst_afill);
+        const __m128i inv = _mm_sub_epi16(_mm_set1_epi16(255), A);
+        R = _mm_add_epi16(SDL_Mul255_SSE2(R, A), SDL_Mul255_SSE2(SDL_GetChannel_SSE2(d0, d1, v->dst_shift[0], v->mask), inv));
+        G = _mm_add_epi16(SDL_Mul255_SSE2(G, A), SDL_Mul255_SSE2(SDL_GetChannel_SSE2(d0, d1, v->dst_shift[1], v->mask), inv));
+        B = _mm_add_epi16(SDL_Mul255_SSE2(B, A), SDL_Mul255_SSE2(SDL_GetChannel_SSE2(d0, d1, v->dst_shift[2], v->mask), inv));
+        A = _mm_add_epi16(A, SDL_Mul255_SSE2(dstA, inv));
+    }
+
+    SDL_PutChannel_SSE2(&lo, &hi, R, v->dst_shift[0]);
+    SDL_PutChannel_SSE2(&lo, &hi, G, v->dst_shift[1]);
+    SDL_PutChannel_SSE2(&lo, &hi, B, v->dst_shift[2]);
+    SDL_PutChannel_SSE2(&lo, &hi, _mm_and_si128(A, v->dst_amask), v->dst_shift[3]);
+    _mm_storeu_si128((__m128i *)dst, lo);
+    _mm_storeu_si128((__m128i *)(dst + 4), hi);
+}
+
+static void SDL_TARGETING("sse2") SDL_Blit8888Init_SSE2(SDL_BlitInfo *info, const Sint8 *src_shifts, const Sint8 *dst_shifts, SDL_Blit8888State_SSE2 *v)
+{
+    const int flags = info->flags;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        v->src_shift[i] = _mm_cvtsi32_si128(SDL_max(src_shifts[i], 0));
+        v->dst_shift[i] = _mm_cvtsi32_si128(SDL_max(dst_shifts[i], 0));
+    }
+    v->mask = _mm_set1_epi32(0xFF);
+    v->src_amask = _mm_set1_epi16(src_shifts[3] < 0 ? 0 : 0xFF);
+    v->src_afill = _mm_set1_epi16(src_shifts[3] < 0 ? 0xFF : 0);
+    v->dst_amask = _mm_set1_epi16(dst_shifts[3] < 0 ? 0 : 0xFF);
+    v->dst_afill = _mm_set1_epi16(dst_shifts[3] < 0 ? 0xFF : 0);
+    v->modulate[0] = _mm_set1_epi16((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255);
+    v->modulate[1] = _mm_set1_epi16((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255);
+    v->modulate[2] = _mm_set1_epi16((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255);
+    v->modulate[3] = _mm_set1_epi16((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255);
+}
+
+__EOF__
+    output_simdrows("SSE2", "SDL_TARGETING(\"sse2\") ", 8);
+    print FILE <<'__EOF__';
+#endif /* SDL_SSE2_INTRINSICS */
+
+#ifdef SDL_NEON_INTRINSICS
+
+typedef struct
+{
+    int32x4_t src_shift[4]; /* R, G, B, A, negative to shift right */
+    int32x4_t dst_shift[4];
+    uint32x4_t mask;        /* 0xFF in each 32-bit lane */
+    uint16x8_t src_amask;   /* 0xFF in each 16-bit lane if src has alpha */
+    uint16x8_t src_afill;   /* 0xFF in each 16-bit lane if src doesn't have alpha */
+    uint16x8_t dst_amask;
+    uint16x8_t dst_afill;
+    uint16x8_t modulate[4];
+} SDL_Blit8888State_NEON;
+
+/* x * y / 255 for 0 <= x, y <= 255 */
+SDL_FORCE_INLINE uint16x8_t SDL_Mul255_NEON(uint16x8_t x, uint16x8_t y)
+{
+    x = vmulq_u16(x, y);
+    return vshrq_n_u16(vaddq_u16(vaddq_u16(x, vdupq_n_u16(1)), vshrq_n_u16(x, 8)), 8);
+}
+
+/* Unpack one channel of 8 pixels to 16-bit lanes */
+SDL_FORCE_INLINE uint16x8_t SDL_GetChannel_NEON(uint32x4_t lo, uint32x4_t hi, int32x4_t shift, uint32x4_t mask)
+{
+    return vcombine_u16(vmovn_u32(vandq_u32(vshlq_u32(lo, vnegq_s32(shift)), mask)), vmovn_u32(vandq_u32(vshlq_u32(hi, vnegq_s32(shift)), mask)));
+}
+
+/* The reverse of SDL_GetChannel_NEON() */
+SDL_FORCE_INLINE void SDL_PutChannel_NEON(uint32x4_t *lo, uint32x4_t *hi, uint16x8_t c, int32x4_t shift)
+{
+    *lo = vorrq_u32(*lo, vshlq_u32(vmovl_u16(vget_low_u16(c)), shift));
+    *hi = vorrq_u32(*hi, vshlq_u32(vmovl_u16(vget_high_u16(c)), shift));
+}
+
+SDL_FORCE_INLINE void SDL_Blit8888Pixels_NEON(const SDL_Blit8888State_NEON *v, const Uint32 *src, Uint32 *dst, SDL_bool modulate, SDL_bool blend)
+{
+    const uint32x4_t s0 = vld1q_u32(src);
+    const uint32x4_t s1 = vld1q_u32(src + 4);
+    uint16x8_t R = SDL_GetChannel_NEON(s0, s1, v->src_shift[0], v->mask);
+    uint16x8_t G = SDL_GetChannel_NEON(s0, s1, v->src_shift[1], v->mask);
+    uint16x8_t B = SDL_GetChannel_NEON(s0, s1, v->src_shift[2], v->mask);
+    uint16x8_t A = vorrq_u16(vandq_u16(SDL_GetChannel_NEON(s0, s1, v->src_shift[3], v->mask), v->src_amask), v->src_afill);
+    uint32x4_t lo = vdupq_n_u32(0);
+    uint32x4_t hi = vdupq_n_u32(0);
+
+    if (modulate) {
+        R = SDL_Mul255_NEON(R, v->modulate[0]);
+        G = SDL_Mul255_NEON(G, v->modulate[1]);
+        B = SDL_Mul255_NEON(B, v->modulate[2]);
+        A = SDL_Mul255_NEON(A, v->modulate[3]);
+    }
+    if (blend) {
+        const uint32x4_t d0 = vld1q_u32(dst);
+        const uint32x4_t d1 = vld1q_u32(dst + 4);
+        const uint16x8_t dstA = vorrq_u16(vandq_u16(SDL_GetChannel_NEON(d0, d1, v->dst_shift[3], v->mask), v->dst_amask), v->dst_afill);
+        const uint16x8_t inv = vsubq_u16(vdupq_n_u16(255), A);
+        R = vaddq_u16(SDL_Mul255_NEON(R, A), SDL_Mul255_NEON(SDL_GetChannel_NEON(d0, d1, v->dst_shift[0], v->mask), inv));
+        G = vaddq_u16(SDL_Mul255_NEON(G, A), SDL_Mul255_NEON(SDL_GetChannel_NEON(d0, d1, v->dst_shift[1], v->mask), inv));
+        B = vaddq_u16(SDL_Mul255_NEON(B, A), SDL_Mul255_NEON(SDL_GetChannel_NEON(d0, d1, v->dst_shift[2], v->mask), inv));
+        A = vaddq_u16(A, SDL_Mul255_NEON(dstA, inv));
+    }
+
+    SDL_PutChannel_NEON(&lo, &hi, R, v->dst_shift[0]);
+    SDL_PutChannel_NEON(&lo, &hi, G, v->dst_shift[1]);
+    SDL_PutChannel_NEON(&lo, &hi, B, v->dst_shift[2]);
+    SDL_PutChannel_NEON(&lo, &hi, vandq_u16(A, v->dst_amask), v->dst_shift[3]);
+    vst1q_u32(dst, lo);
+    vst1q_u32(dst + 4, hi);
+}
+
+static void SDL_Blit8888Init_NEON(SDL_BlitInfo *info, const Sint8 *src_shifts, const Sint8 *dst_shifts, SDL_Blit8888State_NEON *v)
+{
+    const int flags = info->flags;
+    int i;
+
+    for (i = 0; i < 4; ++i) {
+        v->src_shift[i] = vdupq_n_s32(SDL_max(src_shifts[i], 0));
+        v->dst_shift[i] = vdupq_n_s32(SDL_max(dst_shifts[i], 0));
+    }
+    v->mask = vdupq_n_u32(0xFF);
+    v->src_amask = vdupq_n_u16(src_shifts[3] < 0 ? 0 : 0xFF);
+    v->src_afill = vdupq_n_u16(src_shifts[3] < 0 ? 0xFF : 0);
+    v->dst_amask = vdupq_n_u16(dst_shifts[3] < 0 ? 0 : 0xFF);
+    v->dst_afill = vdupq_n_u16(dst_shifts[3] < 0 ? 0xFF : 0);
+    v->modulate[0] = vdupq_n_u16((flags & SDL_COPY_MODULATE_COLOR) ? info->r : 255);
+    v->modulate[1] = vdupq_n_u16((flags & SDL_COPY_MODULATE_COLOR) ? info->g : 255);
+    v->modulate[2] = vdupq_n_u16((flags & SDL_COPY_MODULATE_COLOR) ? info->b : 255);
+    v->modulate[3] = vdupq_n_u16((flags & SDL_COPY_MODULATE_ALPHA) ? info->a : 255);
+}
+
+__EOF__
+    output_simdrows("NEON", "", 8);
+    print FILE <<'__EOF__';
+#endif /* SDL_NEON_INTRINSICS */
+
+__EOF__
+}
+
+# The row loop is the same for every instruction set
+sub output_simdrows
+{
+    my $isa = shift;
+    my $target = shift;
+    my $n = shift;
+
+    print FILE <<__EOF__;
+SDL_FORCE_INLINE void ${target}SDL_Blit8888Rows_${isa}(SDL_BlitInfo *info, const SDL_Blit8888State_${isa} *v, SDL_bool modulate, SDL_bool blend, SDL_bool scale)
+{
+    Uint32 srcbuf[$n];
+    Uint32 dstbuf[$n];
+    int incy = 0, incx = 0;
+    Uint32 posy = 0, posx = 0;
+
+    SDL_zeroa(srcbuf);
+    SDL_zeroa(dstbuf);
+
+    if (scale) {
+        incy = (info->src_h << 16) / info->dst_h;
+        incx = (info->src_w << 16) / info->dst_w;
+        posy = incy / 2;
+    }
+
+    while (info->dst_h--) {
+        const Uint32 *src = (const Uint32 *)info->src;
+        Uint32 *dst = (Uint32 *)info->dst;
+        int n = info->dst_w;
+
+        if (scale) {
+            src = (const Uint32 *)(info->src + ((posy >> 16) * info->src_pitch));
+            posx = incx / 2;
+        }
+        while (n > 0) {
+            const int count = SDL_min(n, $n);
+            const Uint32 *s = src;
+            Uint32 *d = dst;
+            int i;
+
+            if (scale) {
+                for (i = 0; i < count; ++i) {
+                    srcbuf[i] = src[posx >> 16];
+                    posx += incx;
+                }
+                s = srcbuf;
+            } else if (count < $n) {
+                SDL_memcpy(srcbuf, src, count * sizeof(Uint32));
+                s = srcbuf;
+            }
+            if (count < $n) {
+                /* Do the last few pixels the same way, so they come out exactly the same */
+                SDL_memcpy(dstbuf, dst, count * sizeof(Uint32));
+                d = dstbuf;
+            }
+            SDL_Blit8888Pixels_${isa}(v, s, d, modulate, blend);
+            if (count < $n) {
+                SDL_memcpy(dst, dstbuf, count * sizeof(Uint32));
+            }
+            if (!scale) {
+                src += count;
+            }
+            dst += count;
+            n -= count;
+        }
+        if (scale) {
+            posy += incy;
+        } else {
+            info->src += info->src_pitch;
+        }
+        info->dst += info->dst_pitch;
+    }
+}
+
+static void ${target}SDL_Blit8888_${isa}(SDL_BlitInfo *info, const Sint8 *src_shifts, const Sint8 *dst_shifts, SDL_bool modulate, SDL_bool blend, SDL_bool scale)
+{
+    SDL_Blit8888State_${isa} v;
+
+    SDL_Blit8888Init_${isa}(info, src_shifts, dst_shifts, &v);
+    if (!blend) {
+        SDL_Blit8888Rows_${isa}(info, &v, SDL_TRUE, SDL_FALSE, scale);
+    } else if (modulate) {
+        SDL_Blit8888Rows_${isa}(info, &v, SDL_TRUE, SDL_TRUE, scale);
+    } else {
+        SDL_Blit8888Rows_${isa}(info, &v, SDL_FALSE, SDL_TRUE, scale);
+    }
+}
+
+__EOF__
+}
+
+sub output_simdfuncs
+{
+    my $src = shift;
+    my $dst = shift;
+
+    foreach my $isa (@simd_isas) {
+        my ($name, $define) = @$isa;
+
+        print FILE "#ifdef $define\n\n";
+        for (my $modulate = 0; $modulate <= 1; ++$modulate) {
+            for (my $blend = 0; $blend <= 1; ++$blend) {
+                for (my $scale = 0; $scale <= 1; ++$scale) {
+                    if ( has_simd($modulate, $blend, $scale) ) {
+                        my $m = $modulate ? "SDL_TRUE" : "SDL_FALSE";
+                        my $b = $blend ? "SDL_TRUE" : "SDL_FALSE";
+                        my $s = $scale ? "SDL_TRUE" : "SDL_FALSE";
+                        output_copyfuncname("static void", $src, $dst, $modulate, $blend, $scale, 1, "\n", $name);
+                        print FILE <<__EOF__;
+{
+    SDL_Blit8888_${name}(info, SDL_Shifts_${src}, SDL_Shifts_${dst}, $m, $b, $s);
+}
+
+__EOF__
+                    }
+                }
+            }
+        }
+        print FILE "#endif /* $define */\n\n";
+    }
+}
+
+sub output_simdtableentries
+{
+    my $src = shift;
+    my $dst = shift;
+    my $modulate = shift;
+    my $blend = shift;
+    my $scale = shift;
+
+    my @flags = ();
+    if ( $modulate ) {
+        push(@flags, "SDL_COPY_MODULATE_COLOR | SDL_COPY_MODULATE_ALPHA");
+    }
+    if ( $blend ) {
+        push(@flags, "SDL_COPY_BLEND");
+    }
+    if ( $scale ) {
+        push(@flags, "SDL_COPY_NEAREST");
+    }
+    my $flags = join(" | ", @flags);
+
+    foreach my $isa (@simd_isas) {
+        my ($name, $define, $cpu) = @$isa;
+
+        print FILE "#ifdef $define\n";
+        print FILE "    { SDL_PIXELFORMAT_$src, SDL_PIXELFORMAT_$dst, ($flags), $cpu,";
+        output_copyfuncname("", $src, $dst, $modulate, $blend, $scale, 0, " },\n", $name);
+        print FILE "#endif\n";
+    }
+}
+
 open_file("SDL_blit_auto.h");
 output_copydefs();
 for (my $i = 0; $i <= $#src_formats; ++$i) {
@@ -679,5 +1179,11 @@ for (my $i = 0; $i <= $#src_formats; ++$i) {
         output_copyfunc_c($src_formats[$i], $dst_formats[$j]);
     }
 }
+output_simdhelpers();
+for (my $i = 0; $i <= $#src_formats; ++$i) {
+    for (my $j = 0; $j <= $#simd_dst_formats; ++$j) {
+        output_simdfuncs($src_formats[$i], $simd_dst_formats[$j]);
+    }
+}
 output_copyfunctable();
 close_file("SDL_blit_auto.c");
@@ -0,0 +1,228 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how long a playback device takes to convert and mix its bound
+   streams each iteration, as the number of streams grows, with and without
+   SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT.
+
+   Each iteration is timed from the first stream asking for data to the
+   postmix callback, which runs after all the streams are mixed.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define MAX_STREAMS 256
+
+static int nb_threads = 0;
+static int nb_frames = 256;
+static int duration_ms = 500;
+static float noise[4096];
+
+static SDL_SpinLock timing_lock;
+static Uint64 iteration_start;
+static Uint64 total_ns;
+static int iterations;
+
+static void SDLCALL GetCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    Uint64 now = SDL_GetTicksNS();
+
+    SDL_AtomicLock(&timing_lock);
+    if (!iteration_start) {
+        iteration_start = now;
+    }
+    SDL_AtomicUnlock(&timing_lock);
+
+    while (additional_amount > 0) {
+        const int len = SDL_min(additional_amount, (int)sizeof(noise));
+        SDL_PutAudioStreamData(stream, noise, len);
+        additional_amount -= len;
+    }
+}
+
+static void SDLCALL PostmixCallback(void *userdata, const SDL_AudioSpec *spec, float *buffer, int buflen)
+{
+    Uint64 now = SDL_GetTicksNS();
+
+    SDL_AtomicLock(&timing_lock);
+    if (iteration_start) {
+        total_ns += now - iteration_start;
+        ++iterations;
+        iteration_start = 0;
+    }
+    SDL_AtomicUnlock(&timing_lock);
+}
+
+static int RunBenchmark(SDL_bool parallel, int num_streams)
+{
+    SDL_AudioStream *streams[MAX_STREAMS];
+    SDL_AudioSpec src_spec, dst_spec;
+    SDL_AudioDeviceID devid;
+    char value[32];
+    int i, result = 0;
+
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT, parallel ? "1" : "0");
+    (void)SDL_snprintf(value, sizeof(value), "%d", nb_frames);
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_SAMPLE_FRAMES, value);
+
+    if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize audio: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    /* Every stream needs resampling, which is the expensive part */
+    src_spec.format = SDL_AUDIO_F32;
+    src_spec.channels = 2;
+    src_spec.freq = 44100;
+    dst_spec.format = SDL_AUDIO_F32;
+    dst_spec.channels = 2;
+    dst_spec.freq = 48000;
+
+    devid = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &dst_spec);
+    if (!devid) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open audio device: %s\n", SDL_GetError());
+        SDL_QuitSubSystem(SDL_INIT_AUDIO);
+        return -1;
+    }
+    SDL_PauseAudioDevice(devid);
+
+    SDL_zeroa(streams);
+    for (i = 0; i < num_streams; ++i) {
+        streams[i] = SDL_CreateAudioStream(&src_spec, &dst_spec);
+        if (!streams[i] || SDL_SetAudioStreamGetCallback(streams[i], GetCallback, NULL) < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create audio stream: %s\n", SDL_GetError());
+            result = -1;
+            goto done;
+        }
+    }
+    if (SDL_BindAudioStreams(devid, streams, num_streams) < 0 ||
+        SDL_SetAudioPostmixCallback(devid, PostmixCallback, NULL) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set up audio device: %s\n", SDL_GetError());
+        result = -1;
+        goto done;
+    }
+
+    SDL_AtomicLock(&timing_lock);
+    iteration_start = 0;
+    total_ns = 0;
+    iterations = 0;
+    SDL_AtomicUnlock(&timing_lock);
+
+    SDL_ResumeAudioDevice(devid);
+    SDL_Delay(duration_ms);
+    SDL_PauseAudioDevice(devid);
+
+    SDL_AtomicLock(&timing_lock);
+    SDL_Log("%3d streams, %-8s: %5d iterations, %8.3f us per iteration\n",
+            num_streams, parallel ? "parallel" : "serial", iterations, iterations ? (total_ns / 1000.0) / iterations : 0.0);
+    SDL_AtomicUnlock(&timing_lock);
+
+done:
+    SDL_CloseAudioDevice(devid);
+    for (i = 0; i < num_streams; ++i) {
+        SDL_DestroyAudioStream(streams[i]);
+    }
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int stream_counts[] = { 1, 4, 16, 64 };
+    SDLTest_CommonState *state;
+    int i;
+    int result = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--threads") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_threads = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_threads > 0) {
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--frames") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_frames = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_frames > 0) {
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--duration") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    duration_ms = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && duration_ms > 0) {
+                        consumed = 2;
+                    }
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--threads N]",
+                "[--frames N]",
+                "[--duration MS]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    /* By default the job system picks the number of threads */
+    if (nb_threads > 0) {
+        char value[32];
+
+        (void)SDL_snprintf(value, sizeof(value), "%d", nb_threads);
+        SDL_SetHint(SDL_HINT_JOB_THREADS, value);
+    }
+
+    for (i = 0; i < SDL_arraysize(noise); ++i) {
+        noise[i] = ((float)(i * 7919 % 2001) / 1000.0f) - 1.0f;
+    }
+
+    /* This measures SDL, not the audio hardware, so don't use a real device unless asked to */
+    SDL_SetHintWithPriority(SDL_HINT_AUDIO_DRIVER, "dummy", SDL_HINT_DEFAULT);
+
+    for (i = 0; i < SDL_arraysize(stream_counts); ++i) {
+        if (RunBenchmark(SDL_FALSE, stream_counts[i]) < 0 ||
+            RunBenchmark(SDL_TRUE, stream_counts[i]) < 0) {
+            result = 1;
+            break;
+        }
+    }
+
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
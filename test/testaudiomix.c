@@ -0,0 +1,276 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Check that SDL_MixAudioFormat() gives the same results for native and
+   byte-swapped samples, and measure how many samples per second it mixes.
+
+   Native byte order samples go through the SIMD mixers, while the other
+   byte order always uses the generic code, so comparing them checks the
+   SIMD mixers against the original implementation.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+#define SWAPPED_FORMAT(x) ((x) | SDL_AUDIO_MASK_BIG_ENDIAN)
+#else
+#define SWAPPED_FORMAT(x) ((x) & ~SDL_AUDIO_MASK_BIG_ENDIAN)
+#endif
+
+static const struct
+{
+    SDL_AudioFormat format;
+    const char *name;
+} formats[] = {
+    { SDL_AUDIO_S16, "S16" },
+    { SDL_AUDIO_S32, "S32" },
+    { SDL_AUDIO_F32, "F32" },
+};
+
+static int nb_streams = 64;
+static int nb_samples = 4096;
+static int nb_rounds = 100;
+
+static void SwapSamples(Uint8 *buf, int bytes, int size)
+{
+    int i;
+
+    for (i = 0; i < bytes; i += size) {
+        if (size == 2) {
+            Uint16 x;
+            SDL_memcpy(&x, &buf[i], sizeof(x));
+            x = SDL_Swap16(x);
+            SDL_memcpy(&buf[i], &x, sizeof(x));
+        } else {
+            Uint32 x;
+            SDL_memcpy(&x, &buf[i], sizeof(x));
+            x = SDL_Swap32(x);
+            SDL_memcpy(&buf[i], &x, sizeof(x));
+        }
+    }
+}
+
+static void FillSamples(SDL_AudioFormat format, Uint8 *buf, int num_samples)
+{
+    int i;
+
+    for (i = 0; i < num_samples; ++i) {
+        /* Mostly random values, with some at the limits to check clamping */
+        const int kind = SDLTest_RandomIntegerInRange(0, 7);
+
+        if (format == SDL_AUDIO_S16) {
+            Sint16 x = kind == 0 ? SDL_MAX_SINT16 : kind == 1 ? SDL_MIN_SINT16 : SDLTest_RandomSint16();
+            SDL_memcpy(&buf[i * 2], &x, sizeof(x));
+        } else if (format == SDL_AUDIO_S32) {
+            Sint32 x = kind == 0 ? SDL_MAX_SINT32 : kind == 1 ? SDL_MIN_SINT32 : SDLTest_RandomSint32();
+            SDL_memcpy(&buf[i * 4], &x, sizeof(x));
+        } else {
+            float x = kind == 0 ? 3.0e+38f : kind == 1 ? -3.0e+38f : SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+            SDL_memcpy(&buf[i * 4], &x, sizeof(x));
+        }
+    }
+}
+
+static int CheckFormat(SDL_AudioFormat format, const char *name)
+{
+    static const int volumes[] = { 1, 33, 64, 127, SDL_MIX_MAXVOLUME };
+    const int size = SDL_AUDIO_BYTESIZE(format);
+    const int max_samples = 300;
+    Uint8 *src = (Uint8 *)SDL_malloc(max_samples * size + 64);
+    Uint8 *dst = (Uint8 *)SDL_malloc(max_samples * size + 64);
+    Uint8 *expected = (Uint8 *)SDL_malloc(max_samples * size + 64);
+    Uint8 *swapped = (Uint8 *)SDL_malloc(max_samples * size + 64);
+    int v, offset, num_samples;
+    int result = 0;
+
+    if (!src || !dst || !expected || !swapped) {
+        result = -1;
+        goto done;
+    }
+
+    for (v = 0; v < SDL_arraysize(volumes); ++v) {
+        /* Offsets move the buffers off vector and sample alignment, to check the head and tail handling */
+        for (offset = 0; offset < 32; ++offset) {
+            for (num_samples = 0; num_samples < max_samples; num_samples += 1 + num_samples / 4) {
+                const int bytes = num_samples * size;
+
+                FillSamples(format, src + offset, num_samples);
+                FillSamples(format, dst + offset, num_samples);
+
+                /* The expected result, using the generic code for the other byte order */
+                SDL_memcpy(expected, dst + offset, bytes);
+                SDL_memcpy(swapped, src + offset, bytes);
+                SwapSamples(expected, bytes, size);
+                SwapSamples(swapped, bytes, size);
+                if (SDL_MixAudioFormat(expected, swapped, SWAPPED_FORMAT(format), bytes, volumes[v]) < 0) {
+                    SDL_Log("Couldn't mix %s: %s\n", name, SDL_GetError());
+                    result = -1;
+                    goto done;
+                }
+                SwapSamples(expected, bytes, size);
+
+                if (SDL_MixAudioFormat(dst + offset, src + offset, format, bytes, volumes[v]) < 0) {
+                    SDL_Log("Couldn't mix %s: %s\n", name, SDL_GetError());
+                    result = -1;
+                    goto done;
+                }
+                if (SDL_memcmp(dst + offset, expected, bytes) != 0) {
+                    SDL_Log("Mixing %d %s samples at offset %d with volume %d doesn't match the generic code\n",
+                            num_samples, name, offset, volumes[v]);
+                    result = -1;
+                    goto done;
+                }
+            }
+        }
+    }
+
+done:
+    SDL_free(src);
+    SDL_free(dst);
+    SDL_free(expected);
+    SDL_free(swapped);
+    return result;
+}
+
+static double MixRate(SDL_AudioFormat format, Uint8 **streams, Uint8 *dst, int volume)
+{
+    const Uint32 bytes = (Uint32)(nb_samples * SDL_AUDIO_BYTESIZE(format));
+    Uint64 start, elapsed;
+    int i, r;
+
+    start = SDL_GetTicksNS();
+    for (r = 0; r < nb_rounds; ++r) {
+        SDL_memset(dst, 0, bytes);
+        for (i = 0; i < nb_streams; ++i) {
+            SDL_MixAudioFormat(dst, streams[i], format, bytes, volume);
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    return elapsed ? ((double)nb_rounds * nb_streams * nb_samples * 1000000000.0) / elapsed : 0.0;
+}
+
+static void Benchmark(SDL_AudioFormat format, const char *name)
+{
+    const int bytes = nb_samples * SDL_AUDIO_BYTESIZE(format);
+    Uint8 **streams = (Uint8 **)SDL_calloc(nb_streams, sizeof(*streams));
+    Uint8 *dst = (Uint8 *)SDL_malloc(bytes);
+    int i;
+
+    if (!streams || !dst) {
+        SDL_free(streams);
+        SDL_free(dst);
+        return;
+    }
+    for (i = 0; i < nb_streams; ++i) {
+        streams[i] = (Uint8 *)SDL_malloc(bytes);
+        if (streams[i]) {
+            FillSamples(format, streams[i], nb_samples);
+        } else {
+            nb_streams = i;
+        }
+    }
+
+    SDL_Log("%s: %d streams of %d samples, native %.0f samples/sec, swapped %.0f samples/sec, native at half volume %.0f samples/sec\n",
+            name, nb_streams, nb_samples,
+            MixRate(format, streams, dst, SDL_MIX_MAXVOLUME),
+            MixRate(SWAPPED_FORMAT(format), streams, dst, SDL_MIX_MAXVOLUME),
+            MixRate(format, streams, dst, SDL_MIX_MAXVOLUME / 2));
+
+    for (i = 0; i < nb_streams; ++i) {
+        SDL_free(streams[i]);
+    }
+    SDL_free(streams);
+    SDL_free(dst);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int i;
+    int result = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--streams") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_streams = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_streams > 0) {
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--samples") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_samples = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_samples > 0) {
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--rounds") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_rounds = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_rounds > 0) {
+                        consumed = 2;
+                    }
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--streams N]",
+                "[--samples N]",
+                "[--rounds N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDLTest_FuzzerInit(SDL_GetPerformanceCounter());
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        if (CheckFormat(formats[i].format, formats[i].name) < 0) {
+            result = 1;
+        }
+    }
+    if (result == 0) {
+        SDL_Log("Mixer checks passed\n");
+    }
+
+    for (i = 0; i < SDL_arraysize(formats); ++i) {
+        Benchmark(formats[i].format, formats[i].name);
+    }
+
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
@@ -0,0 +1,266 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Stress an audio stream with one producer thread and one consumer thread,
+   the way a decoder thread feeds an audio device.
+
+   The consumer wakes up every 2 ms and reads exactly one buffer, like a
+   real-time audio thread with tiny buffers. The producer stays a little
+   ahead of it, but puts blocks of random sizes at random intervals. Every
+   sample is a running counter, so the consumer can check nothing was lost,
+   duplicated or reordered.
+
+   This fails if the data is wrong in either mode. Underruns depend on how
+   busy the machine is, so they are only logged, unless --strict is given,
+   in which case the consumer coming up short in single producer mode fails
+   the test too.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define FREQ 48000
+
+static int period_us = 2000;
+static int lead_ms = 20;
+static int jitter_ms = 8;
+static int duration_ms = 1000;
+static SDL_bool strict = SDL_FALSE;
+
+typedef struct
+{
+    SDL_AudioStream *stream;
+    SDL_AtomicInt done;
+    int frames_per_period;
+    int underruns;
+    int errors;
+    Uint64 max_get_ns;
+    Uint64 total_get_ns;
+    int periods;
+} ConsumerData;
+
+static int SDLCALL ConsumerThread(void *ptr)
+{
+    ConsumerData *data = (ConsumerData *)ptr;
+    Sint32 *buf = (Sint32 *)SDL_malloc(data->frames_per_period * sizeof(Sint32));
+    const Uint64 period_ns = SDL_US_TO_NS(period_us);
+    Uint64 next = SDL_GetTicksNS();
+    Sint32 expected = 0;
+    Uint64 now;
+
+    if (!buf) {
+        data->errors++;
+        return -1;
+    }
+
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_TIME_CRITICAL);
+
+    while (!SDL_AtomicGet(&data->done)) {
+        const Uint64 start = SDL_GetTicksNS();
+        const int len = SDL_GetAudioStreamData(data->stream, buf, data->frames_per_period * (int)sizeof(Sint32));
+        const Uint64 elapsed = SDL_GetTicksNS() - start;
+        int i;
+
+        data->total_get_ns += elapsed;
+        data->max_get_ns = SDL_max(data->max_get_ns, elapsed);
+        data->periods++;
+
+        if (len < 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_GetAudioStreamData() failed: %s\n", SDL_GetError());
+            data->errors++;
+            break;
+        }
+        if (len < data->frames_per_period * (int)sizeof(Sint32)) {
+            data->underruns++;
+        }
+        for (i = 0; i < len / (int)sizeof(Sint32); ++i) {
+            if (buf[i] != expected) {
+                if (data->errors++ == 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Expected sample %" SDL_PRIs32 ", got %" SDL_PRIs32 "\n", expected, buf[i]);
+                }
+                expected = buf[i];
+            }
+            ++expected;
+        }
+
+        next += period_ns;
+        now = SDL_GetTicksNS();
+        if (next > now) {
+            SDL_DelayNS(next - now);
+        }
+    }
+
+    SDL_free(buf);
+    return 0;
+}
+
+static int RunTest(SDL_bool single_producer)
+{
+    const SDL_AudioSpec spec = { SDL_AUDIO_S32, 1, FREQ };
+    const int max_put_frames = 1024;
+    Sint32 *buf;
+    ConsumerData data;
+    SDL_Thread *thread;
+    Uint64 start, now;
+    Sint32 counter = 0;
+    Sint64 produced = 0;
+    Sint64 target;
+    int puts = 0;
+
+    SDL_zero(data);
+    data.frames_per_period = (int)(((Sint64)FREQ * period_us) / 1000000);
+    data.stream = SDL_CreateAudioStream(&spec, &spec);
+    buf = (Sint32 *)SDL_malloc(max_put_frames * sizeof(Sint32));
+    if (!data.stream || !buf || SDL_SetAudioStreamSingleProducer(data.stream, single_producer) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't set up audio stream: %s\n", SDL_GetError());
+        SDL_DestroyAudioStream(data.stream);
+        SDL_free(buf);
+        return -1;
+    }
+
+    start = SDL_GetTicksNS();
+    thread = NULL;
+
+    do {
+        now = SDL_GetTicksNS();
+
+        /* Stay `lead_ms` ahead of a consumer that started at `start` */
+        target = (Sint64)(((now - start) / 1000 + (Uint64)lead_ms * 1000) * FREQ / 1000000);
+
+        while (produced < target) {
+            const int frames = (int)SDL_min(SDLTest_RandomIntegerInRange(1, max_put_frames), target - produced);
+            int i;
+
+            for (i = 0; i < frames; ++i) {
+                buf[i] = counter++;
+            }
+            if (SDL_PutAudioStreamData(data.stream, buf, frames * (int)sizeof(Sint32)) < 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_PutAudioStreamData() failed: %s\n", SDL_GetError());
+                data.errors++;
+                break;
+            }
+            produced += frames;
+            ++puts;
+        }
+
+        if (!thread) {
+            thread = SDL_CreateThread(ConsumerThread, "Consumer", &data);
+            if (!thread) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create thread: %s\n", SDL_GetError());
+                data.errors++;
+                break;
+            }
+        }
+
+        SDL_DelayNS(SDL_MS_TO_NS(SDLTest_RandomIntegerInRange(0, jitter_ms)) + SDLTest_RandomIntegerInRange(0, 999999));
+    } while (!data.errors && (now - start) < SDL_MS_TO_NS(duration_ms));
+
+    SDL_AtomicSet(&data.done, 1);
+    SDL_WaitThread(thread, NULL);
+
+    SDL_Log("%-15s: %6d puts, %5d periods of %d frames, %d underruns, %d errors, get takes %.3f us on average, %.3f us at most\n",
+            single_producer ? "single producer" : "locked", puts, data.periods, data.frames_per_period, data.underruns, data.errors,
+            data.periods ? (data.total_get_ns / 1000.0) / data.periods : 0.0, data.max_get_ns / 1000.0);
+
+    SDL_DestroyAudioStream(data.stream);
+    SDL_free(buf);
+
+    if (data.errors || (strict && single_producer && data.underruns)) {
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    Uint64 seed = 0;
+    int i;
+    int result = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value = NULL;
+
+            if (SDL_strcmp(argv[i], "--period") == 0) {
+                value = &period_us;
+            } else if (SDL_strcmp(argv[i], "--lead") == 0) {
+                value = &lead_ms;
+            } else if (SDL_strcmp(argv[i], "--jitter") == 0) {
+                value = &jitter_ms;
+            } else if (SDL_strcmp(argv[i], "--duration") == 0) {
+                value = &duration_ms;
+            } else if (SDL_strcmp(argv[i], "--strict") == 0) {
+                strict = SDL_TRUE;
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--seed") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    seed = SDL_strtoull(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0') {
+                        consumed = 2;
+                    }
+                }
+            }
+            if (value && argv[i + 1]) {
+                char *endptr;
+                *value = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value >= 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--period US]",
+                "[--lead MS]",
+                "[--jitter MS]",
+                "[--duration MS]",
+                "[--seed N]",
+                "[--strict]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Random seed: %" SDL_PRIu64 "\n", seed);
+    SDLTest_FuzzerInit(seed);
+
+    if (RunTest(SDL_FALSE) < 0 || RunTest(SDL_TRUE) < 0) {
+        result = 1;
+    }
+
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
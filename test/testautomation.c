@@ -28,6 +28,7 @@ static SDLTest_TestSuiteReference *testSuites[] = {
     &guidTestSuite,
     &hintsTestSuite,
     &intrinsicsTestSuite,
+    &jobsTestSuite,
     &joystickTestSuite,
     &keyboardTestSuite,
     &mainTestSuite,
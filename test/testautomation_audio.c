@@ -1249,6 +1249,85 @@ cleanup:
 
     return status;
 }
+static SDL_AudioDeviceID g_convert_threads_id;
+static SDL_AtomicInt g_convert_threads_calls;
+
+static void SDLCALL audio_convertThreadsCallback(void *userdata, SDL_AudioStream *stream, int additional_amount, int total_amount)
+{
+    static const float silence[256];
+    SDL_AudioSpec spec;
+
+    /* This locks the physical device, which the device thread holds while the jobs convert */
+    SDL_GetAudioDeviceFormat(g_convert_threads_id, &spec, NULL);
+    while (additional_amount > 0) {
+        const int len = SDL_min(additional_amount, (int)sizeof(silence));
+        SDL_PutAudioStreamData(stream, silence, len);
+        additional_amount -= len;
+    }
+    SDL_AtomicAdd(&g_convert_threads_calls, 1);
+}
+
+/**
+ * Check that stream callbacks can lock the device while converting on the job threads
+ *
+ * \sa SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT
+ */
+static int audio_convertThreads(void *arg)
+{
+    SDL_AudioSpec src_spec, dst_spec;
+    SDL_AudioStream *streams[4];
+    int i, result, total_delay;
+
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    SDL_SetHint(SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT, "1");
+    result = SDL_InitSubSystem(SDL_INIT_AUDIO);
+    SDLTest_AssertPass("Call to SDL_InitSubSystem(SDL_INIT_AUDIO) with SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT");
+    SDLTest_AssertCheck(result == 0, "Validate result value; expected: 0 got: %d", result);
+
+    src_spec.format = SDL_AUDIO_F32;
+    src_spec.channels = 2;
+    src_spec.freq = 44100;
+    dst_spec.format = SDL_AUDIO_F32;
+    dst_spec.channels = 2;
+    dst_spec.freq = 48000;
+
+    g_convert_threads_id = SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &dst_spec);
+    SDLTest_AssertPass("Call to SDL_OpenAudioDevice(SDL_AUDIO_DEVICE_DEFAULT_OUTPUT, &dst_spec)");
+    SDLTest_AssertCheck(g_convert_threads_id > 0, "Verify return value; expected > 0 got: %d", (int)g_convert_threads_id);
+    if (g_convert_threads_id > 0) {
+        SDL_AtomicSet(&g_convert_threads_calls, 0);
+        for (i = 0; i < SDL_arraysize(streams); ++i) {
+            streams[i] = SDL_CreateAudioStream(&src_spec, &dst_spec);
+            SDL_SetAudioStreamGetCallback(streams[i], audio_convertThreadsCallback, NULL);
+        }
+        result = SDL_BindAudioStreams(g_convert_threads_id, streams, SDL_arraysize(streams));
+        SDLTest_AssertCheck(result == 0, "Verify SDL_BindAudioStreams() result; expected: 0 got: %d", result);
+
+        /* Wait for a few device iterations */
+        total_delay = 0;
+        while (SDL_AtomicGet(&g_convert_threads_calls) < 4 * SDL_arraysize(streams) && total_delay < 2000) {
+            SDL_Delay(10);
+            total_delay += 10;
+        }
+        SDLTest_AssertCheck(SDL_AtomicGet(&g_convert_threads_calls) >= 4 * SDL_arraysize(streams),
+                            "Verify callbacks kept running; got %d calls", SDL_AtomicGet(&g_convert_threads_calls));
+
+        SDL_CloseAudioDevice(g_convert_threads_id);
+        SDLTest_AssertPass("Call to SDL_CloseAudioDevice()");
+        for (i = 0; i < SDL_arraysize(streams); ++i) {
+            SDL_DestroyAudioStream(streams[i]);
+        }
+    }
+
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    SDL_ResetHint(SDL_HINT_AUDIO_DEVICE_PARALLEL_CONVERT);
+
+    /* Restart audio again */
+    audioSetUp(NULL);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test Case References ================== */
 
 /* Audio test cases */
@@ -1326,12 +1405,16 @@ static const SDLTest_TestCaseReference audioTest18 = {
     audio_formatChange, "audio_formatChange", "Check handling of format changes.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference audioTest19 = {
+    audio_convertThreads, "audio_convertThreads", "Check stream callbacks with parallel stream conversion.", TEST_ENABLED
+};
+
 /* Sequence of Audio test cases */
 static const SDLTest_TestCaseReference *audioTests[] = {
     &audioTest1, &audioTest2, &audioTest3, &audioTest4, &audioTest5, &audioTest6,
     &audioTest7, &audioTest8, &audioTest9, &audioTest10, &audioTest11,
     &audioTest12, &audioTest13, &audioTest14, &audioTest15, &audioTest16,
-    &audioTest17, &audioTest18, NULL
+    &audioTest17, &audioTest18, &audioTest19, NULL
 };
 
 /* Audio test suite (global) */
@@ -175,6 +175,138 @@ static int events_addDelEventWatchWithUserdata(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Event filter that drops user events with an odd code */
+static int SDLCALL events_oddCodeEventFilter(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_USER && (event->user.code & 1)) {
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * Pushes a batch of events, some of which are filtered out
+ *
+ * \sa SDL_PushEvents
+ * \sa SDL_SetEventFilter
+ */
+static int events_pushEventsFiltered(void *arg)
+{
+    SDL_Event events[8];
+    SDL_Event event;
+    int i, result, received;
+
+    SDL_zeroa(events);
+    for (i = 0; i < SDL_arraysize(events); ++i) {
+        events[i].type = SDL_EVENT_USER;
+        events[i].user.code = i;
+    }
+
+    SDL_SetEventFilter(events_oddCodeEventFilter, NULL);
+    SDLTest_AssertPass("Call to SDL_SetEventFilter()");
+
+    result = SDL_PushEvents(events, SDL_arraysize(events));
+    SDLTest_AssertPass("Call to SDL_PushEvents()");
+    SDLTest_AssertCheck(result == SDL_arraysize(events) / 2, "Check result from SDL_PushEvents, expected: %d, got: %d", (int)SDL_arraysize(events) / 2, result);
+    for (i = 0; i < result; ++i) {
+        SDLTest_AssertCheck(events[i].user.code == i * 2, "Check queued event %d, expected code: %d, got: %d", i, i * 2, events[i].user.code);
+    }
+
+    SDL_SetEventFilter(NULL, NULL);
+    SDLTest_AssertPass("Call to SDL_SetEventFilter(NULL, NULL)");
+
+    /* SDL_SetEventFilter() flushes the queue, so push again and check the order */
+    result = SDL_PushEvents(events, 4);
+    SDLTest_AssertCheck(result == 4, "Check result from SDL_PushEvents, expected: 4, got: %d", result);
+    received = 0;
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_EVENT_USER) {
+            SDLTest_AssertCheck(event.user.code == received * 2, "Check polled event %d, expected code: %d, got: %d", received, received * 2, event.user.code);
+            ++received;
+        }
+    }
+    SDLTest_AssertCheck(received == 4, "Check number of polled events, expected: 4, got: %d", received);
+
+    result = SDL_PushEvents(NULL, 1);
+    SDLTest_AssertCheck(result < 0, "Check result from SDL_PushEvents(NULL), expected: <0, got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Pushes several mouse motion events with motion coalescing enabled
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+static int events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    int i, received = 0;
+
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "1");
+    SDLTest_AssertPass("Call to SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, \"1\")");
+
+    for (i = 1; i <= 3; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.which = 1;
+        event.motion.x = (float)(i * 10);
+        event.motion.y = (float)(i * 20);
+        event.motion.xrel = 10.0f;
+        event.motion.yrel = 20.0f;
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertPass("Call to SDL_PushEvent() for 3 motion events");
+
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_EVENT_MOUSE_MOTION && event.motion.which == 1) {
+            ++received;
+            SDLTest_AssertCheck(event.motion.x == 30.0f && event.motion.y == 60.0f, "Check motion position, expected: 30,60, got: %g,%g", event.motion.x, event.motion.y);
+            SDLTest_AssertCheck(event.motion.xrel == 30.0f && event.motion.yrel == 60.0f, "Check relative motion, expected: 30,60, got: %g,%g", event.motion.xrel, event.motion.yrel);
+        }
+    }
+    SDLTest_AssertCheck(received == 1, "Check number of motion events, expected: 1, got: %d", received);
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Allocates event memory of various sizes
+ *
+ * \sa SDL_AllocateEventMemory
+ */
+static int events_allocateEventMemory(void *arg)
+{
+    static const size_t sizes[] = { 1, 7, 16, 100, 4096, 70000, 3, 200000, 64 };
+    Uint8 *memory[SDL_arraysize(sizes)];
+    SDL_Event event;
+    int i;
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        memory[i] = (Uint8 *)SDL_AllocateEventMemory(sizes[i]);
+        SDLTest_AssertCheck(memory[i] != NULL, "Check result from SDL_AllocateEventMemory(%d), expected: non-NULL", (int)sizes[i]);
+        if (memory[i]) {
+            SDLTest_AssertCheck(((uintptr_t)memory[i] % sizeof(void *)) == 0, "Check alignment of event memory");
+            SDL_memset(memory[i], i, sizes[i]);
+        }
+    }
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        if (memory[i]) {
+            SDLTest_AssertCheck(memory[i][0] == i && memory[i][sizes[i] - 1] == i, "Check contents of event memory %d", i);
+        }
+    }
+
+    /* Event memory is released once the queue is drained */
+    while (SDL_PollEvent(&event)) {
+    }
+    SDL_PumpEvents();
+    SDLTest_AssertPass("Call to SDL_PumpEvents()");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -190,9 +322,21 @@ static const SDLTest_TestCaseReference eventsTest3 = {
     (SDLTest_TestCaseFp)events_addDelEventWatchWithUserdata, "events_addDelEventWatchWithUserdata", "Adds and deletes an event watch function with userdata", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest4 = {
+    (SDLTest_TestCaseFp)events_pushEventsFiltered, "events_pushEventsFiltered", "Pushes a batch of events through an event filter", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest5 = {
+    (SDLTest_TestCaseFp)events_coalesceMotion, "events_coalesceMotion", "Merges mouse motion events in the event queue", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest6 = {
+    (SDLTest_TestCaseFp)events_allocateEventMemory, "events_allocateEventMemory", "Allocates event memory of various sizes", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
-    &eventsTest1, &eventsTest2, &eventsTest3, NULL
+    &eventsTest1, &eventsTest2, &eventsTest3, &eventsTest4, &eventsTest5, &eventsTest6, NULL
 };
 
 /* Events test suite (global) */
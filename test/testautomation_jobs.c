@@ -0,0 +1,325 @@
+/**
+ * Jobs test suite
+ */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_test.h>
+#include "testautomation_suites.h"
+
+/* Helper functions */
+
+#define NUM_JOBS 256
+
+static void SDLCALL increment_job(void *userdata)
+{
+    SDL_AtomicIncRef((SDL_AtomicInt *)userdata);
+}
+
+typedef struct
+{
+    SDL_AtomicInt *sequence;
+    int order;
+} OrderedJob;
+
+static void SDLCALL ordered_job(void *userdata)
+{
+    OrderedJob *job = (OrderedJob *)userdata;
+
+    /* Give jobs that start too early a chance to be noticed */
+    SDL_Delay(1);
+    job->order = SDL_AtomicIncRef(job->sequence);
+}
+
+static void SDLCALL count_indices(void *userdata, int start, int end)
+{
+    Uint8 *visited = (Uint8 *)userdata;
+    int i;
+
+    for (i = start; i < end; ++i) {
+        ++visited[i];
+    }
+}
+
+static SDL_bool check_visited(const Uint8 *visited, int start, int end, int size)
+{
+    int i;
+
+    for (i = 0; i < size; ++i) {
+        const int expected = (i >= start && i < end) ? 1 : 0;
+        if (visited[i] != expected) {
+            SDLTest_LogError("Index %d was visited %d times, expected %d", i, visited[i], expected);
+            return SDL_FALSE;
+        }
+    }
+    return SDL_TRUE;
+}
+
+static void SDLCALL nested_job(void *userdata)
+{
+    SDL_AtomicInt *count = (SDL_AtomicInt *)userdata;
+    SDL_Job *child;
+    Uint8 visited[100];
+
+    /* Wait for a job from inside a job */
+    child = SDL_SubmitJob(increment_job, count, NULL, 0);
+    SDL_WaitJob(child);
+
+    /* Run a parallel loop from inside a job */
+    SDL_zeroa(visited);
+    SDL_ParallelFor(0, SDL_arraysize(visited), 1, count_indices, visited);
+    if (check_visited(visited, 0, SDL_arraysize(visited), SDL_arraysize(visited))) {
+        SDL_AtomicIncRef(count);
+    }
+}
+
+typedef struct
+{
+    SDL_SpinLock lock;
+    Sint64 total;
+    SDL_bool out_of_range;
+} range_sum;
+
+static void SDLCALL sum_ranges(void *userdata, int start, int end)
+{
+    range_sum *sum = (range_sum *)userdata;
+
+    SDL_AtomicLock(&sum->lock);
+    if (end <= start) {
+        sum->out_of_range = SDL_TRUE;
+    }
+    sum->total += (Sint64)end - start;
+    SDL_AtomicUnlock(&sum->lock);
+}
+
+/* Test case functions */
+
+/**
+ * Test submitting and waiting for independent jobs.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ * \sa SDL_DetachJob
+ * \sa SDL_IsJobFinished
+ */
+static int jobs_testSubmit(void *arg)
+{
+    SDL_Job *jobs[NUM_JOBS];
+    SDL_AtomicInt count;
+    SDL_Job *job;
+    int i;
+
+    SDL_AtomicSet(&count, 0);
+    for (i = 0; i < NUM_JOBS; ++i) {
+        jobs[i] = SDL_SubmitJob(increment_job, &count, NULL, 0);
+    }
+    SDLTest_AssertPass("Call to SDL_SubmitJob() %d times", NUM_JOBS);
+    for (i = 0; i < NUM_JOBS; ++i) {
+        SDLTest_AssertCheck(jobs[i] != NULL, "Verify job %d was submitted", i);
+        SDL_WaitJob(jobs[i]);
+    }
+    SDLTest_AssertPass("Call to SDL_WaitJob() %d times", NUM_JOBS);
+    SDLTest_AssertCheck(SDL_AtomicGet(&count) == NUM_JOBS,
+        "Verify all jobs ran, expected %d, got %d", NUM_JOBS, SDL_AtomicGet(&count));
+
+    /* Detached jobs still run */
+    SDL_AtomicSet(&count, 0);
+    job = SDL_SubmitJob(increment_job, &count, NULL, 0);
+    for (i = 0; i < NUM_JOBS; ++i) {
+        SDL_DetachJob(SDL_SubmitJob(increment_job, &count, NULL, 0));
+    }
+    SDL_DetachJob(job);
+    SDLTest_AssertPass("Call to SDL_DetachJob() %d times", NUM_JOBS + 1);
+
+    job = SDL_SubmitJob(increment_job, &count, NULL, 0);
+    while (!SDL_IsJobFinished(job)) {
+        SDL_Delay(1);
+    }
+    SDLTest_AssertPass("Call to SDL_IsJobFinished() until the job finished");
+    SDL_WaitJob(job);
+    while (SDL_AtomicGet(&count) < NUM_JOBS + 2) {
+        SDL_Delay(1);
+    }
+    SDLTest_AssertCheck(SDL_AtomicGet(&count) == NUM_JOBS + 2,
+        "Verify all jobs ran, expected %d, got %d", NUM_JOBS + 2, SDL_AtomicGet(&count));
+
+    /* Invalid parameters */
+    job = SDL_SubmitJob(NULL, NULL, NULL, 0);
+    SDLTest_AssertCheck(job == NULL, "Verify SDL_SubmitJob(NULL) fails");
+    job = SDL_SubmitJob(increment_job, &count, NULL, 1);
+    SDLTest_AssertCheck(job == NULL, "Verify SDL_SubmitJob() with missing dependencies fails");
+    SDL_WaitJob(NULL);
+    SDL_DetachJob(NULL);
+    SDLTest_AssertPass("Call to SDL_WaitJob(NULL) and SDL_DetachJob(NULL)");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that jobs start only after their dependencies finish.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ */
+static int jobs_testDependencies(void *arg)
+{
+    SDL_AtomicInt sequence;
+    OrderedJob ordered[4];
+    SDL_Job *jobs[4];
+    SDL_Job *dependencies[2];
+    int i;
+
+    for (i = 0; i < 10; ++i) {
+        SDL_AtomicSet(&sequence, 0);
+        SDL_zeroa(ordered);
+        ordered[0].sequence = ordered[1].sequence = ordered[2].sequence = ordered[3].sequence = &sequence;
+
+        /* A diamond: 0 runs first, then 1 and 2, then 3 */
+        jobs[0] = SDL_SubmitJob(ordered_job, &ordered[0], NULL, 0);
+        jobs[1] = SDL_SubmitJob(ordered_job, &ordered[1], &jobs[0], 1);
+        jobs[2] = SDL_SubmitJob(ordered_job, &ordered[2], &jobs[0], 1);
+        dependencies[0] = jobs[1];
+        dependencies[1] = jobs[2];
+        jobs[3] = SDL_SubmitJob(ordered_job, &ordered[3], dependencies, SDL_arraysize(dependencies));
+
+        SDL_WaitJob(jobs[3]);
+        SDL_WaitJob(jobs[2]);
+        SDL_WaitJob(jobs[1]);
+        SDL_WaitJob(jobs[0]);
+
+        SDLTest_AssertCheck(ordered[0].order == 0 &&
+                            SDL_min(ordered[1].order, ordered[2].order) == 1 &&
+                            SDL_max(ordered[1].order, ordered[2].order) == 2 &&
+                            ordered[3].order == 3,
+            "Verify jobs ran in dependency order, got %d, %d, %d, %d",
+            ordered[0].order, ordered[1].order, ordered[2].order, ordered[3].order);
+    }
+
+    /* A dependency that has already finished doesn't hold anything up */
+    SDL_AtomicSet(&sequence, 0);
+    jobs[0] = SDL_SubmitJob(ordered_job, &ordered[0], NULL, 0);
+    while (!SDL_IsJobFinished(jobs[0])) {
+        SDL_Delay(1);
+    }
+    jobs[1] = SDL_SubmitJob(ordered_job, &ordered[1], &jobs[0], 1);
+    SDL_WaitJob(jobs[1]);
+    SDL_WaitJob(jobs[0]);
+    SDLTest_AssertCheck(ordered[0].order == 0 && ordered[1].order == 1,
+        "Verify job with a finished dependency ran, got %d, %d", ordered[0].order, ordered[1].order);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that SDL_ParallelFor() covers each index exactly once.
+ *
+ * \sa SDL_ParallelFor
+ */
+static int jobs_testParallelFor(void *arg)
+{
+    const int chunk_sizes[] = { 0, 1, 7, 64, 1000 };
+    const int size = 1000;
+    Uint8 *visited;
+    int i, result;
+
+    visited = (Uint8 *)SDL_malloc(size);
+    SDLTest_AssertCheck(visited != NULL, "Verify memory allocation");
+    if (!visited) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < SDL_arraysize(chunk_sizes); ++i) {
+        SDL_memset(visited, 0, size);
+        result = SDL_ParallelFor(10, size - 10, chunk_sizes[i], count_indices, visited);
+        SDLTest_AssertPass("Call to SDL_ParallelFor() with chunk size %d", chunk_sizes[i]);
+        SDLTest_AssertCheck(result == 0, "Verify result value, expected 0, got %d", result);
+        SDLTest_AssertCheck(check_visited(visited, 10, size - 10, size),
+            "Verify every index was visited once with chunk size %d", chunk_sizes[i]);
+    }
+
+    /* Empty ranges don't call the function */
+    SDL_memset(visited, 0, size);
+    result = SDL_ParallelFor(5, 5, 0, count_indices, visited);
+    SDLTest_AssertCheck(result == 0, "Verify empty range result, expected 0, got %d", result);
+    result = SDL_ParallelFor(5, 4, 0, count_indices, visited);
+    SDLTest_AssertCheck(result == 0, "Verify reversed range result, expected 0, got %d", result);
+    SDLTest_AssertCheck(check_visited(visited, 0, 0, size), "Verify no index was visited");
+
+    result = SDL_ParallelFor(0, size, 0, NULL, NULL);
+    SDLTest_AssertCheck(result < 0, "Verify SDL_ParallelFor(NULL) fails, got %d", result);
+
+    /* The whole int range, where chunk offsets don't fit in an int */
+    for (i = 0; i < 2; ++i) {
+        const int chunk_size = i ? (1 << 28) : 0;
+        range_sum sum;
+
+        SDL_zero(sum);
+        result = SDL_ParallelFor(SDL_MIN_SINT32, SDL_MAX_SINT32, chunk_size, sum_ranges, &sum);
+        SDLTest_AssertCheck(result == 0, "Verify full range result, expected 0, got %d", result);
+        SDLTest_AssertCheck(!sum.out_of_range && sum.total == (Sint64)SDL_MAX_SINT32 - SDL_MIN_SINT32,
+            "Verify full range with chunk size %d covered %" SDL_PRIs64 " indices, expected %" SDL_PRIs64,
+            chunk_size, sum.total, (Sint64)SDL_MAX_SINT32 - SDL_MIN_SINT32);
+    }
+
+    SDL_free(visited);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test waiting for jobs and running parallel loops from inside jobs.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ * \sa SDL_ParallelFor
+ */
+static int jobs_testNested(void *arg)
+{
+    SDL_Job *jobs[32];
+    SDL_AtomicInt count;
+    int i;
+
+    SDL_AtomicSet(&count, 0);
+    for (i = 0; i < SDL_arraysize(jobs); ++i) {
+        jobs[i] = SDL_SubmitJob(nested_job, &count, NULL, 0);
+    }
+    for (i = 0; i < SDL_arraysize(jobs); ++i) {
+        SDL_WaitJob(jobs[i]);
+    }
+    SDLTest_AssertPass("Call to SDL_WaitJob() on %d nested jobs", (int)SDL_arraysize(jobs));
+    SDLTest_AssertCheck(SDL_AtomicGet(&count) == 2 * SDL_arraysize(jobs),
+        "Verify nested work was done, expected %d, got %d", 2 * (int)SDL_arraysize(jobs), SDL_AtomicGet(&count));
+
+    return TEST_COMPLETED;
+}
+
+/* ================= Test References ================== */
+
+/* Jobs test cases */
+static const SDLTest_TestCaseReference jobsTest1 = {
+    (SDLTest_TestCaseFp)jobs_testSubmit, "jobs_testSubmit", "Test submitting and waiting for jobs", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference jobsTest2 = {
+    (SDLTest_TestCaseFp)jobs_testDependencies, "jobs_testDependencies", "Test job dependencies", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference jobsTest3 = {
+    (SDLTest_TestCaseFp)jobs_testParallelFor, "jobs_testParallelFor", "Test parallel loops", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference jobsTest4 = {
+    (SDLTest_TestCaseFp)jobs_testNested, "jobs_testNested", "Test jobs that wait for other jobs", TEST_ENABLED
+};
+
+/* Sequence of Jobs test cases */
+static const SDLTest_TestCaseReference *jobsTests[] = {
+    &jobsTest1, &jobsTest2, &jobsTest3, &jobsTest4, NULL
+};
+
+/* Jobs test suite (global) */
+SDLTest_TestSuiteReference jobsTestSuite = {
+    "Jobs",
+    NULL,
+    jobsTests,
+    NULL
+};
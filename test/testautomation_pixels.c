@@ -359,6 +359,87 @@ static int pixels_allocFreePalette(void *arg)
     return TEST_COMPLETED;
 }
 
+static SDL_AtomicInt g_sharedFormatErrors;
+
+static int SDLCALL pixels_sharedFormatThread(void *arg)
+{
+    int i;
+
+    for (i = 0; i < 2000; i++) {
+        const Uint32 format = g_AllFormats[(i * 7 + (int)(uintptr_t)arg) % g_numAllFormats];
+        SDL_PixelFormat *result = SDL_CreatePixelFormat(format);
+        if (!result || result->format != format) {
+            SDL_AtomicIncRef(&g_sharedFormatErrors);
+        }
+        SDL_DestroyPixelFormat(result);
+    }
+    return 0;
+}
+
+/**
+ * Check that formats without a palette are shared, outlive
+ * SDL_DestroyPixelFormat and can be used from several threads.
+ *
+ * \sa SDL_CreatePixelFormat
+ * \sa SDL_DestroyPixelFormat
+ */
+static int pixels_sharedFormats(void *arg)
+{
+    SDL_Thread *threads[4];
+    int i, j;
+
+    for (i = 0; i < g_numAllFormats; i++) {
+        const Uint32 format = g_AllFormats[i];
+        SDL_PixelFormat *first = SDL_CreatePixelFormat(format);
+        SDL_PixelFormat *second = SDL_CreatePixelFormat(format);
+        SDL_PixelFormat *third;
+        int bpp;
+        Uint32 Rmask, Gmask, Bmask, Amask;
+
+        SDLTest_AssertCheck(first != NULL && second != NULL, "Verify SDL_CreatePixelFormat(%s) succeeded", g_AllFormatsVerbose[i]);
+        if (!first || !second) {
+            SDL_DestroyPixelFormat(first);
+            SDL_DestroyPixelFormat(second);
+            continue;
+        }
+
+        if (SDL_ISPIXELFORMAT_INDEXED(format)) {
+            SDLTest_AssertCheck(first != second, "Verify %s formats are not shared", g_AllFormatsVerbose[i]);
+            SDL_DestroyPixelFormat(first);
+            SDL_DestroyPixelFormat(second);
+            continue;
+        }
+
+        SDLTest_AssertCheck(first == second, "Verify %s formats are shared", g_AllFormatsVerbose[i]);
+        for (j = 0; j < 3; j++) {
+            SDL_DestroyPixelFormat(first);
+        }
+        SDL_DestroyPixelFormat(second);
+
+        third = SDL_CreatePixelFormat(format);
+        SDLTest_AssertCheck(third == first, "Verify %s format is the same after it was destroyed", g_AllFormatsVerbose[i]);
+        if (third && SDL_GetMasksForPixelFormatEnum(format, &bpp, &Rmask, &Gmask, &Bmask, &Amask)) {
+            SDLTest_AssertCheck(third->format == format && third->BitsPerPixel == bpp &&
+                                    third->Rmask == Rmask && third->Gmask == Gmask && third->Bmask == Bmask && third->Amask == Amask,
+                                "Verify %s format values are intact", g_AllFormatsVerbose[i]);
+        }
+        SDL_DestroyPixelFormat(third);
+    }
+
+    SDL_AtomicSet(&g_sharedFormatErrors, 0);
+    for (i = 0; i < (int)SDL_arraysize(threads); i++) {
+        threads[i] = SDL_CreateThread(pixels_sharedFormatThread, "SharedFormats", (void *)(uintptr_t)i);
+        SDLTest_AssertCheck(threads[i] != NULL, "Verify SDL_CreateThread() succeeded");
+    }
+    for (i = 0; i < (int)SDL_arraysize(threads); i++) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDLTest_AssertCheck(SDL_AtomicGet(&g_sharedFormatErrors) == 0, "Verify formats created on several threads, expected 0 errors, got %d",
+                        SDL_AtomicGet(&g_sharedFormatErrors));
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Pixels test cases */
@@ -374,9 +455,13 @@ static const SDLTest_TestCaseReference pixelsTest3 = {
     (SDLTest_TestCaseFp)pixels_getPixelFormatName, "pixels_getPixelFormatName", "Call to SDL_GetPixelFormatName", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference pixelsTest4 = {
+    (SDLTest_TestCaseFp)pixels_sharedFormats, "pixels_sharedFormats", "Check that formats without a palette are shared and thread safe", TEST_ENABLED
+};
+
 /* Sequence of Pixels test cases */
 static const SDLTest_TestCaseReference *pixelsTests[] = {
-    &pixelsTest1, &pixelsTest2, &pixelsTest3, NULL
+    &pixelsTest1, &pixelsTest2, &pixelsTest3, &pixelsTest4, NULL
 };
 
 /* Pixels test suite (global) */
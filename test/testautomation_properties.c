@@ -221,9 +221,24 @@ static void SDLCALL cleanup(void *userdata, void *value)
     int *count = (int *)userdata;
     ++(*count);
 }
+static void SDLCALL cleanup_nested(void *userdata, void *value)
+{
+    SDL_PropertiesID *nested = (SDL_PropertiesID *)userdata;
+
+    /* Cleanup functions may use and destroy other properties */
+    SDL_SetNumberProperty(*nested, "cleaned", 1);
+    SDL_DestroyProperties(*nested);
+    *nested = 0;
+}
+static void SDLCALL clear_properties(void *userdata, SDL_PropertiesID props, const char *name)
+{
+    int *count = (int *)userdata;
+    ++(*count);
+    SDL_ClearProperty(props, name);
+}
 static int properties_testCleanup(void *arg)
 {
-    SDL_PropertiesID props;
+    SDL_PropertiesID props, nested;
     char key[2], expected_value[2];
     int i, count;
 
@@ -247,6 +262,33 @@ static int properties_testCleanup(void *arg)
     SDLTest_AssertCheck(count == 10,
         "Verify cleanup for destroying properties, got %d, expected 10", count);
 
+    SDLTest_AssertPass("Call to SDL_DestroyProperties() with nested cleanup");
+    props = SDL_CreateProperties();
+    nested = SDL_CreateProperties();
+    SDL_SetPropertyWithCleanup(props, "a", "0", cleanup_nested, &nested);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(nested == 0,
+        "Verify nested properties were destroyed in cleanup");
+
+    SDLTest_AssertPass("Call to SDL_EnumerateProperties() clearing properties");
+    props = SDL_CreateProperties();
+    count = 0;
+    for (i = 0; i < 10; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "%c", 'a' + i);
+        SDL_SetPropertyWithCleanup(props, key, "0", cleanup, &count);
+    }
+    i = 0;
+    SDL_EnumerateProperties(props, clear_properties, &i);
+    SDLTest_AssertCheck(i == 10,
+        "Verify enumerated properties, got %d, expected 10", i);
+    SDLTest_AssertCheck(count == 10,
+        "Verify cleanup for cleared properties, got %d, expected 10", count);
+    i = 0;
+    SDL_EnumerateProperties(props, count_properties, &i);
+    SDLTest_AssertCheck(i == 0,
+        "Verify properties were cleared, got %d, expected 0", i);
+    SDL_DestroyProperties(props);
+
     return TEST_COMPLETED;
 }
 
@@ -321,6 +363,98 @@ static int properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test property atoms
+ */
+static int properties_testAtoms(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_PropertyAtom atom, other;
+    const char *string;
+
+    SDLTest_AssertPass("Call to SDL_GetPropertyAtom()");
+    atom = SDL_GetPropertyAtom("atom");
+    SDLTest_AssertCheck(atom != 0,
+        "Verify property atom, got %" SDL_PRIu32 ", expected non-zero", atom);
+    other = SDL_GetPropertyAtom("atom");
+    SDLTest_AssertCheck(atom == other,
+        "Verify the same name returns the same atom, got %" SDL_PRIu32 ", expected %" SDL_PRIu32, other, atom);
+    other = SDL_GetPropertyAtom("other_atom");
+    SDLTest_AssertCheck(other != 0 && atom != other,
+        "Verify a different name returns a different atom, got %" SDL_PRIu32, other);
+    SDLTest_AssertCheck(SDL_GetPropertyAtom("") == 0,
+        "Verify empty name returns 0");
+
+    props = SDL_CreateProperties();
+
+    SDLTest_AssertPass("Call to SDL_Get*PropertyByAtom() on an unset property");
+    SDLTest_AssertCheck(SDL_GetPropertyByAtom(props, atom, NULL) == NULL,
+        "Verify unset pointer property");
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByAtom(props, atom, 7) == 7,
+        "Verify unset number property");
+
+    SDLTest_AssertPass("Call to SDL_SetNumberProperty(\"atom\", 42)");
+    SDL_SetNumberProperty(props, "atom", 42);
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByAtom(props, atom, 0) == 42,
+        "Verify number property by atom, expected 42");
+    SDLTest_AssertCheck(SDL_GetFloatPropertyByAtom(props, atom, 0.0f) == 42.0f,
+        "Verify float property by atom, expected 42.0");
+    SDLTest_AssertCheck(SDL_GetBooleanPropertyByAtom(props, atom, SDL_FALSE) == SDL_TRUE,
+        "Verify boolean property by atom, expected SDL_TRUE");
+    string = SDL_GetStringPropertyByAtom(props, atom, NULL);
+    SDLTest_AssertCheck(string && SDL_strcmp(string, "42") == 0,
+        "Verify string property by atom, got %s, expected 42", string ? string : "NULL");
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByAtom(props, other, 0) == 0,
+        "Verify other atom is not set");
+
+    SDLTest_AssertPass("Call to SDL_SetProperty(\"atom\", \"ptr\")");
+    SDL_SetProperty(props, "atom", "ptr");
+    string = (const char *)SDL_GetPropertyByAtom(props, atom, NULL);
+    SDLTest_AssertCheck(string && SDL_strcmp(string, "ptr") == 0,
+        "Verify pointer property by atom, got %s, expected ptr", string ? string : "NULL");
+
+    SDLTest_AssertPass("Call to SDL_ClearProperty(\"atom\")");
+    SDL_ClearProperty(props, "atom");
+    SDLTest_AssertCheck(SDL_GetPropertyByAtom(props, atom, NULL) == NULL,
+        "Verify cleared property by atom");
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test that destroyed properties can't be used, even after their storage is reused
+ */
+static int properties_testDestroyed(void *arg)
+{
+    SDL_PropertiesID props, other;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "number", 1);
+    SDL_DestroyProperties(props);
+
+    SDLTest_AssertPass("Call to SDL_CreateProperties() after SDL_DestroyProperties()");
+    other = SDL_CreateProperties();
+    SDLTest_AssertCheck(other != 0 && other != props,
+        "Verify new properties have a new ID, got %" SDL_PRIu32 ", destroyed %" SDL_PRIu32, other, props);
+    SDL_SetNumberProperty(other, "number", 2);
+
+    SDLTest_AssertPass("Call to SDL_Get*Property() on destroyed properties");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "number", 0) == 0,
+        "Verify destroyed properties are not found");
+    SDLTest_AssertCheck(SDL_GetNumberPropertyByAtom(props, SDL_GetPropertyAtom("number"), 0) == 0,
+        "Verify destroyed properties are not found by atom");
+    SDLTest_AssertCheck(SDL_SetNumberProperty(props, "number", 3) < 0,
+        "Verify destroyed properties can't be set");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(other, "number", 0) == 2,
+        "Verify new properties are unchanged, expected 2");
+
+    SDL_DestroyProperties(other);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -336,9 +470,17 @@ static const SDLTest_TestCaseReference propertiesTest3 = {
     (SDLTest_TestCaseFp)properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTest4 = {
+    (SDLTest_TestCaseFp)properties_testAtoms, "properties_testAtoms", "Test property atom functionality", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTest5 = {
+    (SDLTest_TestCaseFp)properties_testDestroyed, "properties_testDestroyed", "Test destroyed properties can't be used", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
-    &propertiesTest1, &propertiesTest2, &propertiesTest3, NULL
+    &propertiesTest1, &propertiesTest2, &propertiesTest3, &propertiesTest4, &propertiesTest5, NULL
 };
 
 /* Properties test suite (global) */
@@ -815,6 +815,245 @@ static int render_testViewport(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Draws a rectangle as two separate triangles with SDL_RenderGeometry(), so it can't be
+ * drawn as a rectangle fill or copy instead. Helper function.
+ */
+static void
+drawQuad(SDL_Texture *texture, float x, float y, float w, float h, Uint8 r, Uint8 g, Uint8 b)
+{
+    static const int corners[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+    SDL_Vertex verts[3];
+    int i, j;
+
+    for (i = 0; i < 2; i++) {
+        for (j = 0; j < 3; j++) {
+            const int corner = corners[i][j];
+            verts[j].position.x = (corner == 1 || corner == 2) ? x + w : x;
+            verts[j].position.y = (corner >= 2) ? y + h : y;
+            verts[j].color.r = r;
+            verts[j].color.g = g;
+            verts[j].color.b = b;
+            verts[j].color.a = SDL_ALPHA_OPAQUE;
+            verts[j].tex_coord.x = (corner == 1 || corner == 2) ? 1.0f : 0.0f;
+            verts[j].tex_coord.y = (corner >= 2) ? 1.0f : 0.0f;
+        }
+        CHECK_FUNC(SDL_RenderGeometry, (renderer, texture, verts, 3, NULL, 0))
+    }
+}
+
+/**
+ * Flushes the renderer and returns how many render commands were merged since the last call. Helper function.
+ */
+static int
+flushAndCountMerged(void)
+{
+    static Sint64 last_merged = 0;
+    SDL_PropertiesID props;
+    Sint64 merged;
+    int retval;
+
+    CHECK_FUNC(SDL_FlushRenderer, (renderer))
+    props = SDL_GetRendererProperties(renderer);
+    merged = SDL_GetNumberProperty(props, "SDL.renderer.commands_queued", 0) -
+             SDL_GetNumberProperty(props, "SDL.renderer.commands_submitted", 0);
+    retval = (int)(merged - last_merged);
+    last_merged = merged;
+    return retval;
+}
+
+/**
+ * Creates a 1x1 texture of a single color. Helper function.
+ */
+static SDL_Texture *
+createColorTexture(Uint32 color)
+{
+    SDL_Texture *texture = SDL_CreateTexture(renderer, RENDER_COMPARE_FORMAT, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    SDLTest_AssertCheck(texture != NULL, "Verify result from SDL_CreateTexture is not NULL");
+    if (texture) {
+        CHECK_FUNC(SDL_UpdateTexture, (texture, NULL, &color, sizeof(color)))
+    }
+    return texture;
+}
+
+/**
+ * Tests merging and reordering draws
+ *
+ * \sa SDL_CreateRendererWithProperties
+ * \sa SDL_GetRendererProperties
+ * \sa SDL_RenderGeometry
+ */
+static int render_testBatching(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Texture *red, *blue;
+    SDL_PropertiesID props;
+    SDL_Rect rect;
+    int i, merged;
+
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+
+    /* Consecutive draws with the same state are merged */
+    clearScreen();
+    flushAndCountMerged();
+    for (i = 0; i < 8; i++) {
+        drawQuad(NULL, (float)(i * 10), 0.0f, 10.0f, 10.0f, 0, 255, 0);
+    }
+    merged = flushAndCountMerged();
+    SDLTest_AssertCheck(merged == 15, "Validate merged draws, expected: 15, got: %i", merged);
+
+    rect.x = 0;
+    rect.y = 0;
+    rect.w = TESTRENDER_SCREEN_W;
+    rect.h = 10;
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, RENDER_COLOR_GREEN))
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    /* Recreate the renderer, letting it reorder draws */
+    SDL_DestroyRenderer(renderer);
+    props = SDL_CreateProperties();
+    SDL_SetProperty(props, "window", window);
+    SDL_SetBooleanProperty(props, "reorder_draws", SDL_TRUE);
+    renderer = SDL_CreateRendererWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRendererWithProperties result");
+    if (renderer == NULL) {
+        SDL_DestroySurface(referenceSurface);
+        return TEST_ABORTED;
+    }
+    red = createColorTexture(0xFFFF0000);
+    blue = createColorTexture(0xFF0000FF);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+
+    /* Draws that don't overlap are grouped by texture */
+    clearScreen();
+    flushAndCountMerged();
+    for (i = 0; i < 8; i++) {
+        drawQuad((i & 1) ? blue : red, (float)(i * 10), 20.0f, 8.0f, 8.0f, 255, 255, 255);
+        rect.x = i * 10;
+        rect.y = 20;
+        rect.w = 8;
+        rect.h = 8;
+        CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, (i & 1) ? 0xFF0000FF : 0xFFFF0000))
+    }
+    merged = flushAndCountMerged();
+    SDLTest_AssertCheck(merged == 14, "Validate merged draws, expected: 14, got: %i", merged);
+
+    /* Draws that overlap stay in order, and only the halves of each rectangle are merged */
+    drawQuad(red, 0.0f, 40.0f, 20.0f, 10.0f, 255, 255, 255);
+    drawQuad(blue, 10.0f, 40.0f, 20.0f, 10.0f, 255, 255, 255);
+    drawQuad(red, 20.0f, 40.0f, 20.0f, 10.0f, 255, 255, 255);
+    for (i = 0; i < 3; i++) {
+        rect.x = i * 10;
+        rect.y = 40;
+        rect.w = 20;
+        rect.h = 10;
+        CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, (i & 1) ? 0xFF0000FF : 0xFFFF0000))
+    }
+    merged = flushAndCountMerged();
+    SDLTest_AssertCheck(merged == 3, "Validate merged draws, expected: 3, got: %i", merged);
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    SDL_DestroyTexture(red);
+    SDL_DestroyTexture(blue);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests queueing more vertex data than fits in a single block
+ *
+ * \sa SDL_SetRenderViewport
+ * \sa SDL_SetRenderClipRect
+ * \sa SDL_RenderFillRect
+ */
+static int render_testLargeQueue(void *arg)
+{
+    SDL_Surface *referenceSurface;
+    SDL_Rect viewport, cliprect, rect;
+    SDL_FRect pixel;
+    int i, x, y;
+
+    viewport.x = 16;
+    viewport.y = 8;
+    viewport.w = 160;
+    viewport.h = 120;
+    cliprect.x = 0;
+    cliprect.y = 0;
+    cliprect.w = 150;
+    cliprect.h = 110;
+
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, RENDER_COLOR_CLEAR))
+    for (y = 0; y < cliprect.h; y++) {
+        rect.x = viewport.x;
+        rect.y = viewport.y + y;
+        rect.w = cliprect.w;
+        rect.h = 1;
+        CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, &rect, (y & 1) ? 0xFF0000FF : 0xFFFF0000))
+    }
+
+    /* Draw every pixel on its own, a few times over, so the queue has to move on to new blocks
+       in the middle of a row, and the viewport, clip rect and color have to carry over */
+    clearScreen();
+    CHECK_FUNC(SDL_SetRenderViewport, (renderer, &viewport))
+    CHECK_FUNC(SDL_SetRenderClipRect, (renderer, &cliprect))
+    for (i = 0; i < 4; i++) {
+        for (y = 0; y < viewport.h; y++) {
+            if (y & 1) {
+                CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 0, 0, 255, SDL_ALPHA_OPAQUE))
+            } else {
+                CHECK_FUNC(SDL_SetRenderDrawColor, (renderer, 255, 0, 0, SDL_ALPHA_OPAQUE))
+            }
+            for (x = 0; x < viewport.w; x++) {
+                pixel.x = (float)x;
+                pixel.y = (float)y;
+                pixel.w = 1.0f;
+                pixel.h = 1.0f;
+                CHECK_FUNC(SDL_RenderFillRect, (renderer, &pixel))
+            }
+        }
+    }
+    CHECK_FUNC(SDL_SetRenderClipRect, (renderer, NULL))
+    CHECK_FUNC(SDL_SetRenderViewport, (renderer, NULL))
+
+    compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+
+    SDL_DestroySurface(referenceSurface);
+
+    /* Vertex data in system memory grows instead, so nothing is drawn before the queue is flushed */
+    referenceSurface = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, RENDER_COMPARE_FORMAT);
+    SDLTest_AssertCheck(referenceSurface != NULL, "Verify surface creation");
+    if (referenceSurface) {
+        SDL_Renderer *swrenderer = SDL_CreateSoftwareRenderer(referenceSurface);
+        SDLTest_AssertCheck(swrenderer != NULL, "Verify software renderer creation");
+        if (swrenderer) {
+            Uint32 pixel_value;
+
+            CHECK_FUNC(SDL_FillSurfaceRect, (referenceSurface, NULL, 0))
+            CHECK_FUNC(SDL_SetRenderDrawColor, (swrenderer, 255, 255, 255, SDL_ALPHA_OPAQUE))
+            for (i = 0; i < 32768; i++) {
+                pixel.x = (float)(i % TESTRENDER_SCREEN_W);
+                pixel.y = (float)((i / TESTRENDER_SCREEN_W) % TESTRENDER_SCREEN_H);
+                pixel.w = 1.0f;
+                pixel.h = 1.0f;
+                CHECK_FUNC(SDL_RenderFillRect, (swrenderer, &pixel))
+            }
+            pixel_value = *(Uint32 *)referenceSurface->pixels;
+            SDLTest_AssertCheck(pixel_value == 0, "Verify nothing was drawn before flushing, got 0x%.8" SDL_PRIx32, pixel_value);
+            CHECK_FUNC(SDL_FlushRenderer, (swrenderer))
+            pixel_value = *(Uint32 *)referenceSurface->pixels;
+            SDLTest_AssertCheck(pixel_value != 0, "Verify the queue was drawn after flushing");
+            SDL_DestroyRenderer(swrenderer);
+        }
+        SDL_DestroySurface(referenceSurface);
+    }
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Test logical size
  */
@@ -1275,11 +1514,19 @@ static const SDLTest_TestCaseReference renderTest9 = {
     (SDLTest_TestCaseFp)render_testLogicalSize, "render_testLogicalSize", "Tests logical size", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTest10 = {
+    (SDLTest_TestCaseFp)render_testBatching, "render_testBatching", "Tests merging and reordering draws", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTest11 = {
+    (SDLTest_TestCaseFp)render_testLargeQueue, "render_testLargeQueue", "Tests queueing more vertex data than fits in one block", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTest1, &renderTest2, &renderTest3, &renderTest4,
     &renderTest5, &renderTest6, &renderTest7, &renderTest8,
-    &renderTest9, NULL
+    &renderTest9, &renderTest10, &renderTest11, NULL
 };
 
 /* Render test suite (global) */
@@ -635,6 +635,217 @@ static int rwops_testFileWriteReadEndian(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests reading and writing through a buffered stream.
+ *
+ * \sa SDL_CreateBufferedRW
+ * \sa SDL_RWClose
+ */
+static int rwops_testBuffered(void *arg)
+{
+    char mem[sizeof(RWopsHelloWorldTestString)];
+    Uint8 data[64];
+    SDL_RWops *base;
+    SDL_RWops *rw;
+    Uint32 value;
+    Sint64 position;
+    int i, result;
+
+    /* Run the generic tests on buffered writable and read-only memory */
+    SDL_zeroa(mem);
+    base = SDL_RWFromMem(mem, sizeof(RWopsHelloWorldTestString) - 1);
+    rw = SDL_CreateBufferedRW(base, 0);
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_CreateBufferedRW() does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    testGenericRWopsValidations(rw, SDL_TRUE);
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+    SDL_RWclose(base);
+
+    base = SDL_RWFromConstMem(RWopsHelloWorldCompString, sizeof(RWopsHelloWorldCompString) - 1);
+    rw = SDL_CreateBufferedRW(base, 0);
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_CreateBufferedRW() does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    testGenericRWopsValidations(rw, SDL_FALSE);
+    SDL_RWclose(rw);
+    SDL_RWclose(base);
+
+    /* Use a buffer smaller than the values, so they straddle refills */
+    SDL_zeroa(data);
+    base = SDL_RWFromMem(data, sizeof(data));
+    rw = SDL_CreateBufferedRW(base, 7);
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_CreateBufferedRW() does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < 16; ++i) {
+        SDLTest_AssertCheck(SDL_WriteU32BE(rw, 0x01020304 * i), "Verify SDL_WriteU32BE() of value %d", i);
+    }
+    position = SDL_RWseek(rw, 8, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(position == 8, "Verify seek to 8, got %" SDL_PRIs64, position);
+    SDLTest_AssertCheck(data[63] == (Uint8)(0x04 * 15), "Verify written data reached the base stream");
+    for (i = 2; i < 16; ++i) {
+        SDLTest_AssertCheck(SDL_ReadU32BE(rw, &value) && value == (Uint32)(0x01020304 * i),
+            "Verify SDL_ReadU32BE() of value %d, got 0x%.8x", i, (unsigned int)value);
+    }
+    SDLTest_AssertCheck(!SDL_ReadU32BE(rw, &value), "Verify reading past the end fails");
+    SDLTest_AssertCheck(rw->status == SDL_RWOPS_STATUS_EOF, "Verify status is SDL_RWOPS_STATUS_EOF, got %" SDL_PRIu32, rw->status);
+
+    /* Writing after reading goes to the right place */
+    position = SDL_RWseek(rw, 4, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(SDL_ReadU32LE(rw, &value), "Verify SDL_ReadU32LE()");
+    SDLTest_AssertCheck(SDL_WriteU8(rw, 0xFF), "Verify SDL_WriteU8()");
+    position = SDL_RWtell(rw);
+    SDLTest_AssertCheck(position == 9, "Verify position after read and write, expected 9, got %" SDL_PRIs64, position);
+    SDL_RWseek(rw, 12, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(data[8] == 0xFF, "Verify write after read landed at offset 8, got 0x%.2x", data[8]);
+
+    /* Closing leaves the base stream where the buffered stream was */
+    SDLTest_AssertCheck(SDL_ReadU8(rw, NULL), "Verify SDL_ReadU8()");
+    result = SDL_RWclose(rw);
+    SDLTest_AssertCheck(result == 0, "Verify result value is 0; got: %d", result);
+    position = SDL_RWtell(base);
+    SDLTest_AssertCheck(position == 13, "Verify base stream position, expected 13, got %" SDL_PRIs64, position);
+    SDL_RWclose(base);
+
+    rw = SDL_CreateBufferedRW(NULL, 0);
+    SDLTest_AssertCheck(rw == NULL, "Verify SDL_CreateBufferedRW(NULL) returns NULL");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests looking at stream data without copying it.
+ *
+ * \sa SDL_RWpeek
+ * \sa SDL_RWconsume
+ */
+static int rwops_testPeek(void *arg)
+{
+    const Uint8 *data;
+    SDL_RWops *base;
+    SDL_RWops *rw;
+    Sint64 position;
+    int result;
+
+    /* Memory streams */
+    rw = SDL_RWFromConstMem(RWopsAlphabetString, sizeof(RWopsAlphabetString) - 1);
+    data = (const Uint8 *)SDL_RWpeek(rw, 4);
+    SDLTest_AssertCheck(data != NULL && SDL_memcmp(data, "ABCD", 4) == 0, "Verify SDL_RWpeek() on memory returns the data");
+    data = (const Uint8 *)SDL_RWpeek(rw, 8);
+    SDLTest_AssertCheck(data != NULL && SDL_memcmp(data, "ABCDEFGH", 8) == 0, "Verify SDL_RWpeek() doesn't move the stream");
+    result = SDL_RWconsume(rw, 8);
+    SDLTest_AssertCheck(result == 0, "Verify SDL_RWconsume() result is 0, got %d", result);
+    position = SDL_RWtell(rw);
+    SDLTest_AssertCheck(position == 8, "Verify position after SDL_RWconsume(), expected 8, got %" SDL_PRIs64, position);
+    data = (const Uint8 *)SDL_RWpeek(rw, 32);
+    SDLTest_AssertCheck(data == NULL, "Verify SDL_RWpeek() past the end returns NULL");
+    SDLTest_AssertCheck(rw->status == SDL_RWOPS_STATUS_EOF, "Verify status is SDL_RWOPS_STATUS_EOF, got %" SDL_PRIu32, rw->status);
+    SDL_RWclose(rw);
+
+    /* Buffered streams */
+    base = SDL_RWFromFile(RWopsAlphabetFilename, "rb");
+    SDLTest_AssertCheck(base != NULL, "Verify opening file '%s' does not return NULL", RWopsAlphabetFilename);
+    if (base == NULL) {
+        return TEST_ABORTED;
+    }
+    rw = SDL_CreateBufferedRW(base, 8);
+    SDL_RWseek(rw, 4, SDL_RW_SEEK_SET);
+    data = (const Uint8 *)SDL_RWpeek(rw, 8);
+    SDLTest_AssertCheck(data != NULL && SDL_memcmp(data, "EFGHIJKL", 8) == 0, "Verify SDL_RWpeek() on a buffered stream returns the data");
+    SDL_RWconsume(rw, 6);
+    data = (const Uint8 *)SDL_RWpeek(rw, 8);
+    SDLTest_AssertCheck(data != NULL && SDL_memcmp(data, "KLMNOPQR", 8) == 0, "Verify SDL_RWpeek() refills the buffer");
+    data = (const Uint8 *)SDL_RWpeek(rw, 9);
+    SDLTest_AssertCheck(data == NULL, "Verify SDL_RWpeek() of more than the buffer size returns NULL");
+    result = SDL_RWconsume(rw, 9);
+    SDLTest_AssertCheck(result < 0, "Verify SDL_RWconsume() of more than was peeked fails, got %d", result);
+    position = SDL_RWtell(rw);
+    SDLTest_AssertCheck(position == 10, "Verify position after SDL_RWconsume(), expected 10, got %" SDL_PRIs64, position);
+    SDL_RWseek(rw, -4, SDL_RW_SEEK_END);
+    data = (const Uint8 *)SDL_RWpeek(rw, 8);
+    SDLTest_AssertCheck(data == NULL, "Verify SDL_RWpeek() past the end returns NULL");
+    SDLTest_AssertCheck(rw->status == SDL_RWOPS_STATUS_EOF, "Verify status is SDL_RWOPS_STATUS_EOF, got %" SDL_PRIu32, rw->status);
+    data = (const Uint8 *)SDL_RWpeek(rw, 4);
+    SDLTest_AssertCheck(data != NULL && SDL_memcmp(data, "WXYZ", 4) == 0, "Verify SDL_RWpeek() of the last bytes returns the data");
+    SDL_RWclose(rw);
+    SDL_RWclose(base);
+
+    /* Other streams don't support it */
+    rw = SDL_CreateRW();
+    data = (const Uint8 *)SDL_RWpeek(rw, 1);
+    SDLTest_AssertCheck(data == NULL, "Verify SDL_RWpeek() on an unsupported stream returns NULL");
+    SDL_DestroyRW(rw);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests reading memory-mapped files.
+ *
+ * \sa SDL_RWFromFile
+ * \sa SDL_MapFile
+ * \sa SDL_UnmapFile
+ */
+static int rwops_testMapped(void *arg)
+{
+    const size_t len = sizeof(RWopsAlphabetString) - 1;
+    char buf[sizeof(RWopsAlphabetString)];
+    const Uint8 *data;
+    const void *mem;
+    SDL_RWops *rw;
+    size_t size, s;
+    Sint64 i;
+
+    /* The mode flag is a hint, so the stream works the same either way */
+    rw = SDL_RWFromFile(RWopsAlphabetFilename, "rbm");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file '%s' with mode \"rbm\" does not return NULL", RWopsAlphabetFilename);
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+    i = SDL_RWsize(rw);
+    SDLTest_AssertCheck(i == (Sint64)len, "Verify size, expected %d, got %" SDL_PRIs64, (int)len, i);
+    i = SDL_RWseek(rw, 4, SDL_RW_SEEK_SET);
+    SDLTest_AssertCheck(i == 4, "Verify seek to 4, got %" SDL_PRIs64, i);
+    SDL_zeroa(buf);
+    s = SDL_RWread(rw, buf, 4);
+    SDLTest_AssertCheck(s == 4 && SDL_memcmp(buf, "EFGH", 4) == 0, "Verify read data, expected 'EFGH', got '%s'", buf);
+    s = SDL_RWwrite(rw, buf, 4);
+    SDLTest_AssertCheck(s == 0, "Verify writing to a read-only file fails, got %d", (int)s);
+
+    data = (const Uint8 *)SDL_GetProperty(SDL_GetRWProperties(rw), "SDL.rwops.mapped.base", NULL);
+    if (data) {
+        SDLTest_AssertCheck(SDL_memcmp(data, RWopsAlphabetString, len) == 0, "Verify mapped data matches the file");
+        i = SDL_GetNumberProperty(SDL_GetRWProperties(rw), "SDL.rwops.mapped.size", 0);
+        SDLTest_AssertCheck(i == (Sint64)len, "Verify mapped size, expected %d, got %" SDL_PRIs64, (int)len, i);
+        data = (const Uint8 *)SDL_RWpeek(rw, len - 8);
+        SDLTest_AssertCheck(data != NULL && SDL_memcmp(data, RWopsAlphabetString + 8, len - 8) == 0, "Verify SDL_RWpeek() returns the rest of the file");
+    } else {
+        SDLTest_Log("File mapping isn't supported on this platform");
+    }
+    SDL_RWclose(rw);
+
+    mem = SDL_MapFile(RWopsAlphabetFilename, &size);
+    SDLTest_AssertCheck(mem != NULL, "Verify SDL_MapFile() does not return NULL");
+    SDLTest_AssertCheck(size == len, "Verify SDL_MapFile() size, expected %d, got %d", (int)len, (int)size);
+    if (mem) {
+        SDLTest_AssertCheck(SDL_memcmp(mem, RWopsAlphabetString, len) == 0, "Verify SDL_MapFile() data matches the file");
+    }
+    SDL_UnmapFile(mem, size);
+    SDLTest_AssertPass("Call to SDL_UnmapFile() succeeded");
+
+    mem = SDL_MapFile("rwops_nonexistent", &size);
+    SDLTest_AssertCheck(mem == NULL, "Verify SDL_MapFile() of a missing file returns NULL");
+    SDL_UnmapFile(NULL, 0);
+    SDLTest_AssertPass("Call to SDL_UnmapFile(NULL) succeeded");
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* RWops test cases */
@@ -670,10 +881,22 @@ static const SDLTest_TestCaseReference rwopsTest8 = {
     (SDLTest_TestCaseFp)rwops_testCompareRWFromMemWithRWFromFile, "rwops_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile RWops for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference rwopsTest9 = {
+    (SDLTest_TestCaseFp)rwops_testBuffered, "rwops_testBuffered", "Tests reading and writing through a buffered stream", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest10 = {
+    (SDLTest_TestCaseFp)rwops_testPeek, "rwops_testPeek", "Tests looking at stream data without copying it", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference rwopsTest11 = {
+    (SDLTest_TestCaseFp)rwops_testMapped, "rwops_testMapped", "Tests reading memory-mapped files", TEST_ENABLED
+};
+
 /* Sequence of RWops test cases */
 static const SDLTest_TestCaseReference *rwopsTests[] = {
     &rwopsTest1, &rwopsTest2, &rwopsTest3, &rwopsTest4, &rwopsTest5, &rwopsTest6,
-    &rwopsTest7, &rwopsTest8, NULL
+    &rwopsTest7, &rwopsTest8, &rwopsTest9, &rwopsTest10, &rwopsTest11, NULL
 };
 
 /* RWops test suite (global) */
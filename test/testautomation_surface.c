@@ -576,6 +576,531 @@ static int surface_testBlitBlendLoop(void *arg)
     return TEST_COMPLETED;
 }
 
+/* Pixel formats with 8-bit channels that have fast alpha blending paths */
+static const SDL_PixelFormatEnum blend8888Formats[] = {
+    SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888
+};
+
+/* Blit one pixel the way SDL_Blit_Slow() does, with color and alpha modulation, and either blending or copying */
+static Uint32 blitPixel8888(const SDL_PixelFormat *sf, Uint32 src, const SDL_PixelFormat *df, Uint32 dst, const SDL_Color *mod, SDL_bool blend)
+{
+    Uint32 sR = (src >> sf->Rshift) & 0xFF;
+    Uint32 sG = (src >> sf->Gshift) & 0xFF;
+    Uint32 sB = (src >> sf->Bshift) & 0xFF;
+    Uint32 sA = sf->Amask ? ((src >> sf->Ashift) & 0xFF) : 0xFF;
+    Uint32 dR = (dst >> df->Rshift) & 0xFF;
+    Uint32 dG = (dst >> df->Gshift) & 0xFF;
+    Uint32 dB = (dst >> df->Bshift) & 0xFF;
+    Uint32 dA = df->Amask ? ((dst >> df->Ashift) & 0xFF) : 0xFF;
+    Uint32 result;
+
+    sR = (sR * mod->r) / 255;
+    sG = (sG * mod->g) / 255;
+    sB = (sB * mod->b) / 255;
+    sA = (sA * mod->a) / 255;
+    if (blend) {
+        if (sA < 255) {
+            sR = (sR * sA) / 255;
+            sG = (sG * sA) / 255;
+            sB = (sB * sA) / 255;
+        }
+        dR = sR + ((255 - sA) * dR) / 255;
+        dG = sG + ((255 - sA) * dG) / 255;
+        dB = sB + ((255 - sA) * dB) / 255;
+        dA = sA + ((255 - sA) * dA) / 255;
+    } else {
+        dR = sR;
+        dG = sG;
+        dB = sB;
+        dA = sA;
+    }
+
+    result = (dR << df->Rshift) | (dG << df->Gshift) | (dB << df->Bshift);
+    if (df->Amask) {
+        result |= (dA << df->Ashift);
+    }
+    return result;
+}
+
+/* Compare the color channels of two pixels, allowing for rounding differences */
+static SDL_bool comparePixel8888(const SDL_PixelFormat *fmt, Uint32 a, Uint32 b, int tolerance)
+{
+    return SDL_abs((int)((a >> fmt->Rshift) & 0xFF) - (int)((b >> fmt->Rshift) & 0xFF)) <= tolerance &&
+           SDL_abs((int)((a >> fmt->Gshift) & 0xFF) - (int)((b >> fmt->Gshift) & 0xFF)) <= tolerance &&
+           SDL_abs((int)((a >> fmt->Bshift) & 0xFF) - (int)((b >> fmt->Bshift) & 0xFF)) <= tolerance;
+}
+
+/* Blit src to dst at (x, y), or scaled to all of dst, and check every pixel of dst against the reference.
+   The generated blitters, C or SIMD, match it exactly. Without SSE4.1 the unscaled blend with no
+   color mod goes through the C versions in SDL_blit_A.c instead, which round differently and
+   don't all keep the destination alpha, so only the colors are roughly checked there. */
+static int checkBlit8888(SDL_Surface *src, SDL_Surface *dst, int x, int y, const SDL_Color *mod, SDL_bool blend, SDL_bool scaled)
+{
+    const SDL_bool blit_a = blend && !scaled && mod->r == 255 && mod->g == 255 && mod->b == 255;
+    const int tolerance = (blit_a && !SDL_HasSSE41()) ? 3 : 0;
+    SDL_Surface *expected = SDL_DuplicateSurface(dst);
+    SDL_Rect rect;
+    int incx = 1 << 16, incy = 1 << 16;
+    int errors = 0;
+    int result;
+    int i, j;
+
+    SDLTest_AssertCheck(expected != NULL, "Verify result from SDL_DuplicateSurface is not NULL");
+    if (!expected) {
+        return -1;
+    }
+
+    SDL_SetSurfaceBlendMode(src, blend ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+    SDL_SetSurfaceColorMod(src, mod->r, mod->g, mod->b);
+    SDL_SetSurfaceAlphaMod(src, mod->a);
+    if (scaled) {
+        /* This is how the blitters step through the source */
+        incx = (src->w << 16) / dst->w;
+        incy = (src->h << 16) / dst->h;
+        x = y = 0;
+        result = SDL_BlitSurfaceScaled(src, NULL, dst, NULL, SDL_SCALEMODE_NEAREST);
+    } else {
+        rect.x = x;
+        rect.y = y;
+        rect.w = src->w;
+        rect.h = src->h;
+        result = SDL_BlitSurface(src, NULL, dst, &rect);
+    }
+    if (result < 0) {
+        SDLTest_AssertCheck(SDL_FALSE, "SDL_BlitSurface() failed: %s", SDL_GetError());
+        SDL_DestroySurface(expected);
+        return -1;
+    }
+
+    for (j = 0; j < dst->h; ++j) {
+        const Uint32 *actual = (const Uint32 *)((const Uint8 *)dst->pixels + j * dst->pitch);
+        Uint32 *row = (Uint32 *)((Uint8 *)expected->pixels + j * expected->pitch);
+
+        if (scaled) {
+            const Uint32 *srcrow = (const Uint32 *)((const Uint8 *)src->pixels + ((incy / 2 + j * incy) >> 16) * src->pitch);
+            for (i = 0; i < dst->w; ++i) {
+                row[i] = blitPixel8888(src->format, srcrow[(incx / 2 + i * incx) >> 16], dst->format, row[i], mod, blend);
+            }
+        } else if (j >= y && j < y + src->h) {
+            const Uint32 *srcrow = (const Uint32 *)((const Uint8 *)src->pixels + (j - y) * src->pitch);
+            for (i = SDL_max(x, 0); i < SDL_min(x + src->w, dst->w); ++i) {
+                row[i] = blitPixel8888(src->format, srcrow[i - x], dst->format, row[i], mod, blend);
+            }
+        }
+        for (i = 0; i < dst->w; ++i) {
+            if (actual[i] != row[i] && (tolerance == 0 || !comparePixel8888(dst->format, actual[i], row[i], tolerance))) {
+                if (errors++ == 0) {
+                    SDLTest_LogError("%s to %s with mod %d,%d,%d,%d%s%s: expected 0x%.8" SDL_PRIx32 " at %d,%d, got 0x%.8" SDL_PRIx32,
+                                     SDL_GetPixelFormatName(src->format->format), SDL_GetPixelFormatName(dst->format->format),
+                                     mod->r, mod->g, mod->b, mod->a, blend ? ", blended" : "", scaled ? ", scaled" : "",
+                                     row[i], i, j, actual[i]);
+                }
+            }
+        }
+    }
+    SDL_DestroySurface(expected);
+    return errors;
+}
+
+/* Fill a surface with random bytes */
+static void fillRandom(SDL_Surface *surface)
+{
+    Uint8 *p = (Uint8 *)surface->pixels;
+    int i;
+
+    for (i = 0; i < surface->h * surface->pitch; ++i) {
+        p[i] = SDLTest_RandomUint8();
+    }
+}
+
+/**
+ * Tests alpha blending between 32-bit formats against the reference formula,
+ * for every combination of source color and alpha.
+ *
+ * \sa SDL_BlitSurface
+ */
+static int surface_testBlitBlend8888(void *arg)
+{
+    const int num_formats = (int)SDL_arraysize(blend8888Formats);
+    SDL_Color mod = { 255, 255, 255, 255 };
+    int s, d, k, x, y;
+
+    for (s = 0; s < num_formats; ++s) {
+        for (d = 0; d < num_formats; ++d) {
+            SDL_Surface *src = SDL_CreateSurface(256, 256, blend8888Formats[s]);
+            SDL_Surface *dst = SDL_CreateSurface(256, 256, blend8888Formats[d]);
+            int errors = 0;
+
+            SDLTest_AssertCheck(src && dst, "Verify result from SDL_CreateSurface is not NULL");
+            if (!src || !dst) {
+                SDL_DestroySurface(src);
+                SDL_DestroySurface(dst);
+                return TEST_ABORTED;
+            }
+
+            /* Every color value against every alpha value */
+            for (y = 0; y < 256; ++y) {
+                Uint32 *row = (Uint32 *)((Uint8 *)src->pixels + y * src->pitch);
+                for (x = 0; x < 256; ++x) {
+                    row[x] = SDL_MapRGBA(src->format, (Uint8)x, (Uint8)(255 - x), (Uint8)(x ^ y), (Uint8)y);
+                }
+            }
+
+            /* ... on top of a range of destination colors, with and without alpha mod */
+            for (k = 0; k < 256; k += 51) {
+                const Uint32 color = SDL_MapRGBA(dst->format, (Uint8)k, (Uint8)(255 - k), (Uint8)(k * 7), (Uint8)(k * 13));
+                SDL_FillSurfaceRect(dst, NULL, color);
+                mod.a = 255;
+                errors += checkBlit8888(src, dst, 0, 0, &mod, SDL_TRUE, SDL_FALSE);
+                SDL_FillSurfaceRect(dst, NULL, color);
+                mod.a = (Uint8)(255 - k);
+                errors += checkBlit8888(src, dst, 0, 0, &mod, SDL_TRUE, SDL_FALSE);
+            }
+            SDLTest_AssertCheck(errors == 0, "Blend %s to %s, expected 0 errors, got %d",
+                                SDL_GetPixelFormatName(blend8888Formats[s]), SDL_GetPixelFormatName(blend8888Formats[d]), errors);
+
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+        }
+    }
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests alpha blending between 32-bit formats with random sizes and positions,
+ * to cover the ends of rows that don't fill a whole SIMD register.
+ *
+ * \sa SDL_BlitSurface
+ */
+static int surface_testBlitBlend8888Random(void *arg)
+{
+    const int num_formats = (int)SDL_arraysize(blend8888Formats);
+    int n;
+
+    for (n = 0; n < 200; ++n) {
+        const SDL_PixelFormatEnum src_format = blend8888Formats[SDLTest_RandomIntegerInRange(0, num_formats - 1)];
+        const SDL_PixelFormatEnum dst_format = blend8888Formats[SDLTest_RandomIntegerInRange(0, num_formats - 1)];
+        SDL_Surface *src = SDL_CreateSurface(SDLTest_RandomIntegerInRange(1, 37), SDLTest_RandomIntegerInRange(1, 5), src_format);
+        SDL_Surface *dst = SDL_CreateSurface(SDLTest_RandomIntegerInRange(1, 45), SDLTest_RandomIntegerInRange(1, 7), dst_format);
+        SDL_Color mod = { 255, 255, 255, 255 };
+        int errors;
+
+        SDLTest_AssertCheck(src && dst, "Verify result from SDL_CreateSurface is not NULL");
+        if (!src || !dst) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            return TEST_ABORTED;
+        }
+
+        fillRandom(src);
+        fillRandom(dst);
+        if (SDLTest_RandomIntegerInRange(0, 1)) {
+            mod.a = SDLTest_RandomUint8();
+        }
+        errors = checkBlit8888(src, dst, SDLTest_RandomIntegerInRange(-8, dst->w - 1), SDLTest_RandomIntegerInRange(-2, dst->h - 1),
+                               &mod, SDL_TRUE, SDL_FALSE);
+        SDLTest_AssertCheck(errors == 0, "Blend %dx%d %s to %dx%d %s, expected 0 errors, got %d",
+                            src->w, src->h, SDL_GetPixelFormatName(src_format), dst->w, dst->h, SDL_GetPixelFormatName(dst_format), errors);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests color and alpha modulation between 32-bit formats, with and without
+ * blending and nearest neighbor scaling, with random sizes and positions.
+ *
+ * \sa SDL_BlitSurface
+ * \sa SDL_BlitSurfaceScaled
+ */
+static int surface_testBlitModulate8888Random(void *arg)
+{
+    const int num_formats = (int)SDL_arraysize(blend8888Formats);
+    int n;
+
+    for (n = 0; n < 300; ++n) {
+        const SDL_PixelFormatEnum src_format = blend8888Formats[SDLTest_RandomIntegerInRange(0, num_formats - 1)];
+        const SDL_PixelFormatEnum dst_format = blend8888Formats[SDLTest_RandomIntegerInRange(0, num_formats - 1)];
+        SDL_Surface *src = SDL_CreateSurface(SDLTest_RandomIntegerInRange(1, 37), SDLTest_RandomIntegerInRange(1, 5), src_format);
+        SDL_Surface *dst = SDL_CreateSurface(SDLTest_RandomIntegerInRange(1, 45), SDLTest_RandomIntegerInRange(1, 7), dst_format);
+        const SDL_bool blend = SDLTest_RandomIntegerInRange(0, 1) ? SDL_TRUE : SDL_FALSE;
+        const SDL_bool scaled = SDLTest_RandomIntegerInRange(0, 1) ? SDL_TRUE : SDL_FALSE;
+        SDL_Color mod;
+        int errors;
+
+        SDLTest_AssertCheck(src && dst, "Verify result from SDL_CreateSurface is not NULL");
+        if (!src || !dst) {
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+            return TEST_ABORTED;
+        }
+
+        fillRandom(src);
+        fillRandom(dst);
+        mod.r = SDLTest_RandomUint8();
+        mod.g = SDLTest_RandomUint8();
+        mod.b = SDLTest_RandomIntegerInRange(0, 1) ? 255 : SDLTest_RandomUint8();
+        mod.a = SDLTest_RandomIntegerInRange(0, 1) ? 255 : SDLTest_RandomUint8();
+        errors = checkBlit8888(src, dst, SDLTest_RandomIntegerInRange(-8, dst->w - 1), SDLTest_RandomIntegerInRange(-2, dst->h - 1),
+                               &mod, blend, scaled);
+        SDLTest_AssertCheck(errors == 0, "Modulate %dx%d %s to %dx%d %s, expected 0 errors, got %d",
+                            src->w, src->h, SDL_GetPixelFormatName(src_format), dst->w, dst->h, SDL_GetPixelFormatName(dst_format), errors);
+
+        SDL_DestroySurface(src);
+        SDL_DestroySurface(dst);
+    }
+    return TEST_COMPLETED;
+}
+
+static const SDL_PixelFormatEnum premultiplyFormats[] = {
+    SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGBA8888,
+    SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_BGRA8888
+};
+
+static Uint8 premultiplyChannel(Uint8 x, Uint8 a)
+{
+    return (Uint8)((x * a + 127) / 255);
+}
+
+static Uint8 unpremultiplyChannel(Uint8 x, Uint8 a)
+{
+    if (a == 0) {
+        return 0;
+    }
+    return (Uint8)SDL_min((x * 255 + a / 2) / a, 255);
+}
+
+/* Count the pixels of `dst` that aren't `src` (un)premultiplied, in the area both are `w` x `h` */
+static int checkPremultiplied(const Uint32 *src, SDL_PixelFormat *src_fmt, const Uint32 *dst, SDL_PixelFormat *dst_fmt,
+                              int w, int h, int pitch, SDL_bool premultiply)
+{
+    int x, y, errors = 0;
+
+    for (y = 0; y < h; ++y) {
+        for (x = 0; x < w; ++x) {
+            Uint8 r, g, b, a;
+            Uint32 expected;
+
+            SDL_GetRGBA(src[y * pitch + x], src_fmt, &r, &g, &b, &a);
+            if (premultiply) {
+                expected = SDL_MapRGBA(dst_fmt, premultiplyChannel(r, a), premultiplyChannel(g, a), premultiplyChannel(b, a), a);
+            } else {
+                expected = SDL_MapRGBA(dst_fmt, unpremultiplyChannel(r, a), unpremultiplyChannel(g, a), unpremultiplyChannel(b, a), a);
+            }
+            if (dst[y * pitch + x] != expected) {
+                if (errors++ == 0) {
+                    SDLTest_LogError("Pixel %d,%d: 0x%.8" SDL_PRIx32 " became 0x%.8" SDL_PRIx32 ", expected 0x%.8" SDL_PRIx32,
+                                     x, y, src[y * pitch + x], dst[y * pitch + x], expected);
+                }
+            }
+        }
+    }
+    return errors;
+}
+
+/**
+ * Tests premultiplying and unpremultiplying alpha between 32-bit formats, for
+ * every combination of color and alpha, in place and with rows that don't
+ * fill a whole SIMD register.
+ *
+ * \sa SDL_PremultiplyAlpha
+ * \sa SDL_UnpremultiplyAlpha
+ */
+static int surface_testPremultiplyAlpha(void *arg)
+{
+    const int num_formats = (int)SDL_arraysize(premultiplyFormats);
+    const int size = 256;
+    Uint32 *src = (Uint32 *)SDL_malloc(size * size * sizeof(Uint32));
+    Uint32 *dst = (Uint32 *)SDL_malloc(size * size * sizeof(Uint32));
+    int s, d, n, x, y;
+
+    SDLTest_AssertCheck(src && dst, "Verify pixel buffers were allocated");
+    if (!src || !dst) {
+        SDL_free(src);
+        SDL_free(dst);
+        return TEST_ABORTED;
+    }
+
+    for (s = 0; s < num_formats; ++s) {
+        SDL_PixelFormat *src_fmt = SDL_CreatePixelFormat(premultiplyFormats[s]);
+
+        /* Every color value against every alpha value */
+        for (y = 0; y < size; ++y) {
+            for (x = 0; x < size; ++x) {
+                src[y * size + x] = SDL_MapRGBA(src_fmt, (Uint8)x, (Uint8)(255 - x), (Uint8)(x ^ y), (Uint8)y);
+            }
+        }
+
+        for (d = 0; d < num_formats; ++d) {
+            SDL_PixelFormat *dst_fmt = SDL_CreatePixelFormat(premultiplyFormats[d]);
+            const char *src_name = SDL_GetPixelFormatName(premultiplyFormats[s]);
+            const char *dst_name = SDL_GetPixelFormatName(premultiplyFormats[d]);
+            int ret, errors;
+
+            ret = SDL_PremultiplyAlpha(size, size, premultiplyFormats[s], src, size * 4, premultiplyFormats[d], dst, size * 4);
+            errors = checkPremultiplied(src, src_fmt, dst, dst_fmt, size, size, size, SDL_TRUE);
+            SDLTest_AssertCheck(ret == 0 && errors == 0, "Premultiply %s to %s, expected 0 errors, got %d", src_name, dst_name, errors);
+
+            ret = SDL_UnpremultiplyAlpha(size, size, premultiplyFormats[s], src, size * 4, premultiplyFormats[d], dst, size * 4);
+            errors = checkPremultiplied(src, src_fmt, dst, dst_fmt, size, size, size, SDL_FALSE);
+            SDLTest_AssertCheck(ret == 0 && errors == 0, "Unpremultiply %s to %s, expected 0 errors, got %d", src_name, dst_name, errors);
+
+            /* Odd sizes at odd offsets, in place */
+            for (n = 0; n < 20; ++n) {
+                const int w = SDLTest_RandomIntegerInRange(1, 37);
+                const int h = SDLTest_RandomIntegerInRange(1, 5);
+                const int offset = SDLTest_RandomIntegerInRange(0, 7);
+                const SDL_bool premultiply = (n & 1) ? SDL_TRUE : SDL_FALSE;
+
+                SDL_memcpy(dst, src, size * size * sizeof(Uint32));
+                if (premultiply) {
+                    ret = SDL_PremultiplyAlpha(w, h, premultiplyFormats[s], dst + offset, size * 4, premultiplyFormats[d], dst + offset, size * 4);
+                } else {
+                    ret = SDL_UnpremultiplyAlpha(w, h, premultiplyFormats[s], dst + offset, size * 4, premultiplyFormats[d], dst + offset, size * 4);
+                }
+                errors = checkPremultiplied(src + offset, src_fmt, dst + offset, dst_fmt, w, h, size, premultiply);
+                SDLTest_AssertCheck(ret == 0 && errors == 0, "%s %dx%d %s to %s in place, expected 0 errors, got %d",
+                                    premultiply ? "Premultiply" : "Unpremultiply", w, h, src_name, dst_name, errors);
+                SDLTest_AssertCheck(dst[offset + w] == src[offset + w] && (offset == 0 || dst[offset - 1] == src[offset - 1]),
+                                    "Verify pixels next to the block are untouched");
+            }
+            SDL_DestroyPixelFormat(dst_fmt);
+        }
+        SDL_DestroyPixelFormat(src_fmt);
+    }
+
+    SDLTest_AssertCheck(SDL_PremultiplyAlpha(1, 1, SDL_PIXELFORMAT_RGB565, src, 4, SDL_PIXELFORMAT_ARGB8888, dst, 4) < 0,
+                        "Verify premultiplying a format without alpha fails");
+
+    SDL_free(src);
+    SDL_free(dst);
+    return TEST_COMPLETED;
+}
+
+/* The operations that can be split into bands for SDL_HINT_SURFACE_THREADS */
+typedef enum
+{
+    BANDED_BLEND,
+    BANDED_CONVERT,
+    BANDED_STRETCH_NEAREST,
+    BANDED_STRETCH_LINEAR,
+    BANDED_YUV,
+    NUM_BANDED_OPERATIONS
+} BandedOperation;
+
+static int runBandedOperation(BandedOperation op, SDL_Surface *src, const void *yuv, SDL_PixelFormatEnum yuv_format, SDL_Surface *dst)
+{
+    const SDL_Rect srcrect = { 3, 5, src->w / 2, src->h / 3 };
+
+    switch (op) {
+    case BANDED_BLEND:
+        SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+        SDL_SetSurfaceAlphaMod(src, 200);
+        return SDL_BlitSurface(src, NULL, dst, NULL);
+    case BANDED_CONVERT:
+        return SDL_ConvertPixels(src->w, src->h, src->format->format, src->pixels, src->pitch, dst->format->format, dst->pixels, dst->pitch);
+    case BANDED_STRETCH_NEAREST:
+        return SDL_SoftStretch(src, &srcrect, dst, NULL, SDL_SCALEMODE_NEAREST);
+    case BANDED_STRETCH_LINEAR:
+        return SDL_SoftStretch(src, &srcrect, dst, NULL, SDL_SCALEMODE_LINEAR);
+    case BANDED_YUV:
+        return SDL_ConvertPixels(dst->w, dst->h, yuv_format, yuv, (yuv_format == SDL_PIXELFORMAT_YUY2) ? dst->w * 2 : dst->w,
+                                 dst->format->format, dst->pixels, dst->pitch);
+    default:
+        return -1;
+    }
+}
+
+/**
+ * Tests that large blits, stretches and conversions give the same results
+ * when they're split into bands and run on several threads.
+ *
+ * \sa SDL_BlitSurface
+ * \sa SDL_SoftStretch
+ * \sa SDL_ConvertPixels
+ */
+static int surface_testThreadedOperations(void *arg)
+{
+    static const SDL_PixelFormatEnum dst_formats[] = {
+        SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_RGB565,
+        SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB2101010
+    };
+    static const SDL_PixelFormatEnum yuv_formats[] = {
+        SDL_PIXELFORMAT_IYUV, SDL_PIXELFORMAT_NV12, SDL_PIXELFORMAT_YUY2
+    };
+    /* An odd height, so the last band is shorter and starts in the middle of a chroma row pair */
+    const int w = 640, h = 481;
+    const size_t yuv_size = (size_t)w * h + 2 * ((w + 1) / 2) * ((h + 1) / 2) + (size_t)w * h;
+    SDL_Surface *src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    Uint8 *yuv = (Uint8 *)SDL_malloc(yuv_size);
+    int op, f;
+    size_t i;
+
+    SDLTest_AssertCheck(src && yuv, "Verify source surface and YUV data were allocated");
+    if (!src || !yuv) {
+        SDL_DestroySurface(src);
+        SDL_free(yuv);
+        return TEST_ABORTED;
+    }
+    fillRandom(src);
+    for (i = 0; i < yuv_size; ++i) {
+        yuv[i] = SDLTest_RandomUint8();
+    }
+
+    for (op = 0; op < NUM_BANDED_OPERATIONS; ++op) {
+        for (f = 0; f < (int)SDL_arraysize(dst_formats); ++f) {
+            const SDL_PixelFormatEnum dst_format = dst_formats[f];
+            const SDL_PixelFormatEnum yuv_format = yuv_formats[f % SDL_arraysize(yuv_formats)];
+            SDL_Surface *expected, *actual;
+            int ret, y, mismatched = 0;
+
+            /* Stretching only works between surfaces of the same format */
+            if ((op == BANDED_STRETCH_NEAREST || op == BANDED_STRETCH_LINEAR) && dst_format != src->format->format) {
+                continue;
+            }
+
+            expected = SDL_CreateSurface(w, h, dst_format);
+            actual = SDL_CreateSurface(w, h, dst_format);
+            SDLTest_AssertCheck(expected && actual, "Verify result from SDL_CreateSurface is not NULL");
+            if (!expected || !actual) {
+                SDL_DestroySurface(expected);
+                SDL_DestroySurface(actual);
+                break;
+            }
+            fillRandom(expected);
+            SDL_memcpy(actual->pixels, expected->pixels, (size_t)h * expected->pitch);
+
+            SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+            ret = runBandedOperation((BandedOperation)op, src, yuv, yuv_format, expected);
+            SDLTest_AssertCheck(ret == 0, "Operation %d to %s on one thread, expected 0, got %d", op, SDL_GetPixelFormatName(dst_format), ret);
+
+            SDL_SetHint(SDL_HINT_SURFACE_THREADS, "4");
+            ret = runBandedOperation((BandedOperation)op, src, yuv, yuv_format, actual);
+            SDLTest_AssertCheck(ret == 0, "Operation %d to %s on 4 threads, expected 0, got %d", op, SDL_GetPixelFormatName(dst_format), ret);
+
+            for (y = 0; y < h; ++y) {
+                if (SDL_memcmp((Uint8 *)expected->pixels + y * expected->pitch, (Uint8 *)actual->pixels + y * actual->pitch,
+                               (size_t)w * expected->format->BytesPerPixel) != 0) {
+                    ++mismatched;
+                }
+            }
+            SDLTest_AssertCheck(mismatched == 0, "Operation %d to %s, expected 0 mismatched rows, got %d",
+                                op, SDL_GetPixelFormatName(dst_format), mismatched);
+
+            SDL_DestroySurface(expected);
+            SDL_DestroySurface(actual);
+        }
+    }
+    SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+
+    SDL_DestroySurface(src);
+    SDL_free(yuv);
+    return TEST_COMPLETED;
+}
+
 static int surface_testOverflow(void *arg)
 {
     char buf[1024];
@@ -835,6 +1360,26 @@ static const SDLTest_TestCaseReference surfaceTest12 = {
     (SDLTest_TestCaseFp)surface_testBlitBlendMod, "surface_testBlitBlendMod", "Tests blitting routines with mod blending mode.", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference surfaceTestBlitBlend8888 = {
+    surface_testBlitBlend8888, "surface_testBlitBlend8888", "Tests alpha blending between 32-bit formats for every color and alpha value.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitBlend8888Random = {
+    surface_testBlitBlend8888Random, "surface_testBlitBlend8888Random", "Tests alpha blending between 32-bit formats with random sizes and positions.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestBlitModulate8888Random = {
+    surface_testBlitModulate8888Random, "surface_testBlitModulate8888Random", "Tests color and alpha modulation between 32-bit formats, with blending and scaling.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestPremultiplyAlpha = {
+    surface_testPremultiplyAlpha, "surface_testPremultiplyAlpha", "Tests premultiplying and unpremultiplying alpha between 32-bit formats.", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference surfaceTestThreadedOperations = {
+    surface_testThreadedOperations, "surface_testThreadedOperations", "Tests that large surface operations give the same results on several threads.", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference surfaceTestOverflow = {
     surface_testOverflow, "surface_testOverflow", "Test overflow detection.", TEST_ENABLED
 };
@@ -843,7 +1388,8 @@ static const SDLTest_TestCaseReference surfaceTestOverflow = {
 static const SDLTest_TestCaseReference *surfaceTests[] = {
     &surfaceTest1, &surfaceTest2, &surfaceTest3, &surfaceTest4, &surfaceTest5,
     &surfaceTest6, &surfaceTest7, &surfaceTest8, &surfaceTest9, &surfaceTest10,
-    &surfaceTest11, &surfaceTest12, &surfaceTestOverflow, NULL
+    &surfaceTest11, &surfaceTest12, &surfaceTestBlitBlend8888, &surfaceTestBlitBlend8888Random,
+    &surfaceTestBlitModulate8888Random, &surfaceTestPremultiplyAlpha, &surfaceTestThreadedOperations, &surfaceTestOverflow, NULL
 };
 
 /* Surface test suite (global) */
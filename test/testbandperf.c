@@ -0,0 +1,253 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how large surface operations scale with SDL_HINT_SURFACE_THREADS:
+   alpha blending, format conversion, bilinear stretching and YUV to RGB
+   conversion, at several image sizes, on 1 thread up to the number of CPU
+   cores.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int iterations = 10;
+static int max_width = 3840;
+static int max_threads = 0;
+
+static const struct
+{
+    int w, h;
+} sizes[] = {
+    { 320, 240 },
+    { 640, 480 },
+    { 1280, 720 },
+    { 1920, 1080 },
+    { 3840, 2160 }
+};
+
+typedef enum
+{
+    OP_BLEND,
+    OP_CONVERT,
+    OP_STRETCH,
+    OP_YUV,
+    NUM_OPS
+} Operation;
+
+static const char *op_names[] = { "Blend", "Convert", "Stretch", "YUV" };
+
+typedef struct
+{
+    SDL_Surface *src;
+    SDL_Surface *dst;
+    SDL_Surface *rgb24;
+    Uint8 *yuv;
+} Images;
+
+static void FillRandom(void *pixels, size_t size)
+{
+    Uint8 *p = (Uint8 *)pixels;
+    size_t i;
+
+    for (i = 0; i < size; ++i) {
+        p[i] = SDLTest_RandomUint8();
+    }
+}
+
+static int RunOperation(Operation op, Images *images)
+{
+    SDL_Surface *src = images->src;
+    SDL_Surface *dst = images->dst;
+    const SDL_Rect half = { 0, 0, src->w / 2, src->h / 2 };
+
+    switch (op) {
+    case OP_BLEND:
+        return SDL_BlitSurface(src, NULL, dst, NULL);
+    case OP_CONVERT:
+        return SDL_ConvertPixels(src->w, src->h, src->format->format, src->pixels, src->pitch,
+                                 images->rgb24->format->format, images->rgb24->pixels, images->rgb24->pitch);
+    case OP_STRETCH:
+        return SDL_SoftStretch(src, &half, dst, NULL, SDL_SCALEMODE_LINEAR);
+    case OP_YUV:
+        return SDL_ConvertPixels(dst->w, dst->h, SDL_PIXELFORMAT_IYUV, images->yuv, dst->w,
+                                 dst->format->format, dst->pixels, dst->pitch);
+    default:
+        return -1;
+    }
+}
+
+/* Returns the number of megapixels processed per second, or a negative value on error */
+static double RunTest(Operation op, Images *images, int threads)
+{
+    char hint[16];
+    Uint64 start, elapsed;
+    int i;
+
+    (void)SDL_snprintf(hint, sizeof(hint), "%d", threads);
+    SDL_SetHint(SDL_HINT_SURFACE_THREADS, hint);
+
+    start = 0;
+    for (i = -1; i < iterations; ++i) {
+        /* The first run sets up the blit and starts the threads */
+        if (i == 0) {
+            start = SDL_GetTicksNS();
+        }
+        if (RunOperation(op, images) < 0) {
+            return -1.0;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    return ((double)images->dst->w * images->dst->h * iterations / 1000000.0) / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND);
+}
+
+static int RunSize(int w, int h)
+{
+    const size_t yuv_size = (size_t)w * h + 2 * ((size_t)(w + 1) / 2) * ((h + 1) / 2);
+    Images images;
+    char line[256];
+    int result = 0;
+    int op, threads;
+
+    images.src = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    images.dst = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_ARGB8888);
+    images.rgb24 = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGB24);
+    images.yuv = (Uint8 *)SDL_malloc(yuv_size);
+    if (!images.src || !images.dst || !images.rgb24 || !images.yuv) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create images: %s\n", SDL_GetError());
+        result = 1;
+    } else {
+        FillRandom(images.src->pixels, (size_t)h * images.src->pitch);
+        FillRandom(images.dst->pixels, (size_t)h * images.dst->pitch);
+        FillRandom(images.yuv, yuv_size);
+        SDL_SetSurfaceBlendMode(images.src, SDL_BLENDMODE_BLEND);
+
+        for (op = 0; op < NUM_OPS && !result; ++op) {
+            size_t len = 0;
+
+            (void)SDL_snprintf(line, sizeof(line), "%4dx%-4d %-8s", w, h, op_names[op]);
+            for (threads = 1; threads <= max_threads && !result; threads *= 2) {
+                const double mps = RunTest((Operation)op, &images, threads);
+                if (mps < 0.0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s failed: %s\n", op_names[op], SDL_GetError());
+                    result = 1;
+                }
+                len = SDL_strlen(line);
+                (void)SDL_snprintf(line + len, sizeof(line) - len, " %9.1f", mps);
+            }
+            if (!result) {
+                SDL_Log("%s\n", line);
+            }
+        }
+    }
+
+    SDL_DestroySurface(images.src);
+    SDL_DestroySurface(images.dst);
+    SDL_DestroySurface(images.rgb24);
+    SDL_free(images.yuv);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    Uint64 seed = 0;
+    char header[256];
+    int i, threads;
+    int result = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value = NULL;
+
+            if (SDL_strcmp(argv[i], "--iterations") == 0) {
+                value = &iterations;
+            } else if (SDL_strcmp(argv[i], "--max-width") == 0) {
+                value = &max_width;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0) {
+                value = &max_threads;
+            } else if (SDL_strcmp(argv[i], "--seed") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    seed = SDL_strtoull(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0') {
+                        consumed = 2;
+                    }
+                }
+            }
+            if (value && argv[i + 1]) {
+                char *endptr;
+                *value = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value > 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--iterations N]",
+                "[--max-width N]",
+                "[--threads N]",
+                "[--seed N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Random seed: %" SDL_PRIu64 "\n", seed);
+    SDLTest_FuzzerInit(seed);
+
+    /* Always compare against a few threads, even on machines with fewer cores */
+    if (max_threads <= 0) {
+        max_threads = SDL_max(SDL_GetCPUCount(), 4);
+    }
+
+    SDL_Log("Megapixels per second, by number of threads:\n");
+    (void)SDL_snprintf(header, sizeof(header), "%-18s", "");
+    for (threads = 1; threads <= max_threads; threads *= 2) {
+        const size_t len = SDL_strlen(header);
+        (void)SDL_snprintf(header + len, sizeof(header) - len, " %9d", threads);
+    }
+    SDL_Log("%s\n", header);
+
+    for (i = 0; i < (int)SDL_arraysize(sizes) && !result; ++i) {
+        if (sizes[i].w <= max_width) {
+            result = RunSize(sizes[i].w, sizes[i].h);
+        }
+    }
+
+    SDL_ResetHint(SDL_HINT_SURFACE_THREADS);
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
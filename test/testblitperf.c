@@ -0,0 +1,187 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how fast surfaces are alpha blended between the 32-bit formats,
+   with per-pixel alpha, with surface alpha, with color modulation, and
+   with color modulation while scaling up 2x with nearest neighbor.
+
+   The blitters are chosen based on the CPU, so to compare against the
+   plain C versions, run this again with SDL_BLIT_CPU_FEATURES=0 in the
+   environment.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int width = 1024;
+static int height = 768;
+static int iterations = 10;
+
+static const SDL_PixelFormatEnum formats[] = {
+    SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888,
+    SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888,
+    SDL_PIXELFORMAT_XRGB8888
+};
+
+static void FillRandom(SDL_Surface *surface)
+{
+    int y, x;
+
+    for (y = 0; y < surface->h; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < surface->w; ++x) {
+            row[x] = SDLTest_RandomUint32();
+        }
+    }
+}
+
+/* Returns the number of megapixels blended per second, or a negative value on error */
+static double RunTest(SDL_Surface *src, SDL_Surface *dst, Uint8 alpha, SDL_bool modulate, SDL_bool scaled)
+{
+    const SDL_Rect half = { 0, 0, SDL_max(src->w / 2, 1), SDL_max(src->h / 2, 1) };
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_SetSurfaceBlendMode(src, SDL_BLENDMODE_BLEND);
+    SDL_SetSurfaceAlphaMod(src, alpha);
+    if (modulate) {
+        SDL_SetSurfaceColorMod(src, 255, 192, 128);
+    } else {
+        SDL_SetSurfaceColorMod(src, 255, 255, 255);
+    }
+
+    start = 0;
+    for (i = -1; i < iterations; ++i) {
+        /* The first blit sets up the blit function */
+        if (i == 0) {
+            start = SDL_GetTicksNS();
+        }
+        if (scaled) {
+            if (SDL_BlitSurfaceScaled(src, &half, dst, NULL, SDL_SCALEMODE_NEAREST) < 0) {
+                return -1.0;
+            }
+        } else {
+            if (SDL_BlitSurface(src, NULL, dst, NULL) < 0) {
+                return -1.0;
+            }
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    return ((double)width * height * iterations / 1000000.0) / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    Uint64 seed = 0;
+    int i, s, d;
+    int result = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value = NULL;
+
+            if (SDL_strcmp(argv[i], "--width") == 0) {
+                value = &width;
+            } else if (SDL_strcmp(argv[i], "--height") == 0) {
+                value = &height;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0) {
+                value = &iterations;
+            } else if (SDL_strcmp(argv[i], "--seed") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    seed = SDL_strtoull(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0') {
+                        consumed = 2;
+                    }
+                }
+            }
+            if (value && argv[i + 1]) {
+                char *endptr;
+                *value = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value > 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--width N]",
+                "[--height N]",
+                "[--iterations N]",
+                "[--seed N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Random seed: %" SDL_PRIu64 "\n", seed);
+    SDLTest_FuzzerInit(seed);
+
+    SDL_Log("Megapixels per second:\n");
+    SDL_Log("%-24s %-24s %13s %13s %13s %13s\n", "Source", "Destination", "Pixel alpha", "Surface alpha", "Color mod", "Scaled");
+
+    for (s = 0; s < (int)SDL_arraysize(formats) && !result; ++s) {
+        for (d = 0; d < (int)SDL_arraysize(formats) && !result; ++d) {
+            SDL_Surface *src = SDL_CreateSurface(width, height, formats[s]);
+            SDL_Surface *dst = SDL_CreateSurface(width, height, formats[d]);
+            double pixel_alpha, surface_alpha, color_mod, scaled;
+
+            if (!src || !dst) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create surfaces: %s\n", SDL_GetError());
+                result = 1;
+            } else {
+                FillRandom(src);
+                FillRandom(dst);
+                pixel_alpha = RunTest(src, dst, 255, SDL_FALSE, SDL_FALSE);
+                surface_alpha = RunTest(src, dst, 128, SDL_FALSE, SDL_FALSE);
+                color_mod = RunTest(src, dst, 255, SDL_TRUE, SDL_FALSE);
+                scaled = RunTest(src, dst, 255, SDL_TRUE, SDL_TRUE);
+                if (pixel_alpha < 0.0 || surface_alpha < 0.0 || color_mod < 0.0 || scaled < 0.0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Blit failed: %s\n", SDL_GetError());
+                    result = 1;
+                } else {
+                    SDL_Log("%-24s %-24s %13.1f %13.1f %13.1f %13.1f\n", SDL_GetPixelFormatName(formats[s]), SDL_GetPixelFormatName(formats[d]),
+                            pixel_alpha, surface_alpha, color_mod, scaled);
+                }
+            }
+            SDL_DestroySurface(src);
+            SDL_DestroySurface(dst);
+        }
+    }
+
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
@@ -0,0 +1,174 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure event queue throughput with several threads pushing events
+   while the main thread polls them, with and without the lock-free queue.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int nb_producers = 4;
+static int nb_events = 100000;
+static SDLTest_CommonState *state;
+
+static int SDLCALL
+ProducerRun(void *data)
+{
+    int id = (int)(intptr_t)data;
+    int i;
+
+    for (i = 0; i < nb_events; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = id;
+        event.user.data1 = (void *)(intptr_t)i;
+        while (SDL_PushEvent(&event) < 0) {
+            /* The queue is full, let the consumer catch up */
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+static int RunBenchmark(SDL_bool lockfree)
+{
+    SDL_Thread **threads;
+    int *expected;
+    Sint64 total = (Sint64)nb_producers * nb_events;
+    Sint64 received = 0;
+    Uint64 start, elapsed;
+    int i, result = 0;
+
+    SDL_SetHint(SDL_HINT_EVENT_QUEUE_LOCKFREE, lockfree ? "1" : "0");
+    if (SDL_Init(SDL_INIT_EVENTS) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    threads = (SDL_Thread **)SDL_calloc(nb_producers, sizeof(*threads));
+    expected = (int *)SDL_calloc(nb_producers, sizeof(*expected));
+    if (!threads || !expected) {
+        SDL_free(threads);
+        SDL_free(expected);
+        SDL_Quit();
+        return -1;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < nb_producers; ++i) {
+        char name[64];
+        (void)SDL_snprintf(name, sizeof(name), "Producer%d", i);
+        threads[i] = SDL_CreateThread(ProducerRun, name, (void *)(intptr_t)i);
+        if (!threads[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create producer thread: %s\n", SDL_GetError());
+            total -= nb_events;
+        }
+    }
+
+    while (received < total) {
+        SDL_Event event;
+
+        if (!SDL_PollEvent(&event)) {
+            continue;
+        }
+        if (event.type != SDL_EVENT_USER) {
+            continue;
+        }
+        if ((int)(intptr_t)event.user.data1 != expected[event.user.code]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Producer %d: got event %d, expected %d\n",
+                         (int)event.user.code, (int)(intptr_t)event.user.data1, expected[event.user.code]);
+            result = -1;
+        }
+        expected[event.user.code] = (int)(intptr_t)event.user.data1 + 1;
+        ++received;
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    for (i = 0; i < nb_producers; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+
+    SDL_Log("%s queue: %d producers, %" SDL_PRIs64 " events in %.3f ms, %.0f events/sec\n",
+            lockfree ? "Lock-free" : "Locked", nb_producers, received,
+            elapsed / 1000000.0, elapsed ? (received * 1000000000.0) / elapsed : 0.0);
+
+    SDL_free(threads);
+    SDL_free(expected);
+    SDL_Quit();
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    int i;
+    int result = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--producers") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_producers = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_producers > 0) {
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--events") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    nb_events = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && nb_events > 0) {
+                        consumed = 2;
+                    }
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--producers N]",
+                "[--events N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (RunBenchmark(SDL_FALSE) < 0) {
+        result = 1;
+    }
+    if (RunBenchmark(SDL_TRUE) < 0) {
+        result = 1;
+    }
+
+    SDLTest_CommonDestroyState(state);
+    return result;
+}
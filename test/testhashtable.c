@@ -0,0 +1,377 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Check the internal hash table, and compare its insert, lookup and
+   iteration speed against a chained hash table with a fixed bucket count,
+   which is how SDL_HashTable used to be implemented.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Hack to avoid dynapi renaming */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+#include "../src/SDL_hashtable.c"
+
+/* The previous chained implementation, for comparison */
+typedef struct ChainedItem
+{
+    const void *key;
+    const void *value;
+    struct ChainedItem *next;
+} ChainedItem;
+
+typedef struct ChainedTable
+{
+    ChainedItem **table;
+    Uint32 table_len;
+} ChainedTable;
+
+static ChainedTable *Chained_Create(Uint32 num_buckets)
+{
+    ChainedTable *table = (ChainedTable *)SDL_calloc(1, sizeof(*table));
+    if (table) {
+        table->table = (ChainedItem **)SDL_calloc(num_buckets, sizeof(ChainedItem *));
+        table->table_len = num_buckets;
+    }
+    return table;
+}
+
+static SDL_bool Chained_Find(const ChainedTable *table, const void *key, const void **_value)
+{
+    const Uint32 hash = SDL_HashID(key, NULL) & (table->table_len - 1);
+    ChainedItem *i;
+
+    for (i = table->table[hash]; i; i = i->next) {
+        if (SDL_KeyMatchID(key, i->key, NULL)) {
+            if (_value) {
+                *_value = i->value;
+            }
+            return SDL_TRUE;
+        }
+    }
+    return SDL_FALSE;
+}
+
+static SDL_bool Chained_Insert(ChainedTable *table, const void *key, const void *value)
+{
+    const Uint32 hash = SDL_HashID(key, NULL) & (table->table_len - 1);
+    ChainedItem *item;
+
+    if (Chained_Find(table, key, NULL)) {
+        return SDL_FALSE;
+    }
+    item = (ChainedItem *)SDL_malloc(sizeof(*item));
+    if (!item) {
+        return SDL_FALSE;
+    }
+    item->key = key;
+    item->value = value;
+    item->next = table->table[hash];
+    table->table[hash] = item;
+    return SDL_TRUE;
+}
+
+static SDL_bool Chained_Iterate(const ChainedTable *table, const void **_key, const void **_value, void **iter)
+{
+    ChainedItem *item = (ChainedItem *)*iter;
+    Uint32 idx = 0;
+
+    if (item) {
+        const ChainedItem *orig = item;
+        item = item->next;
+        if (!item) {
+            idx = (SDL_HashID(orig->key, NULL) & (table->table_len - 1)) + 1;
+        }
+    }
+
+    while (!item && (idx < table->table_len)) {
+        item = table->table[idx++];
+    }
+
+    if (!item) {
+        *_key = NULL;
+        *iter = NULL;
+        return SDL_FALSE;
+    }
+
+    *_key = item->key;
+    *_value = item->value;
+    *iter = item;
+    return SDL_TRUE;
+}
+
+static void Chained_Destroy(ChainedTable *table)
+{
+    Uint32 i;
+
+    for (i = 0; i < table->table_len; i++) {
+        ChainedItem *item = table->table[i];
+        while (item) {
+            ChainedItem *next = item->next;
+            SDL_free(item);
+            item = next;
+        }
+    }
+    SDL_free(table->table);
+    SDL_free(table);
+}
+
+static int nuked;
+
+static void SDLCALL NukeCounter(const void *key, const void *value, void *data)
+{
+    ++nuked;
+}
+
+static int CheckTable(void)
+{
+    const int count = 10000;
+    SDL_HashTable *table;
+    const void *key;
+    const void *value;
+    void *iter = NULL;
+    int i, found;
+
+    table = SDL_CreateHashTable(NULL, 4, SDL_HashID, SDL_KeyMatchID, NukeCounter, SDL_FALSE);
+    if (!table) {
+        SDL_Log("Couldn't create hash table: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    for (i = 1; i <= count; ++i) {
+        if (!SDL_InsertIntoHashTable(table, (const void *)(uintptr_t)i, (const void *)(uintptr_t)(i * 2))) {
+            SDL_Log("Couldn't insert key %d\n", i);
+            return -1;
+        }
+    }
+    if (SDL_InsertIntoHashTable(table, (const void *)(uintptr_t)1, NULL)) {
+        SDL_Log("Inserted duplicate key in a non-stackable table\n");
+        return -1;
+    }
+
+    /* Remove every third key */
+    nuked = 0;
+    for (i = 3; i <= count; i += 3) {
+        if (!SDL_RemoveFromHashTable(table, (const void *)(uintptr_t)i)) {
+            SDL_Log("Couldn't remove key %d\n", i);
+            return -1;
+        }
+    }
+    if (nuked != count / 3) {
+        SDL_Log("Nuke callback called %d times, expected %d\n", nuked, count / 3);
+        return -1;
+    }
+
+    for (i = 1; i <= count; ++i) {
+        const SDL_bool expected = (i % 3) != 0;
+        value = NULL;
+        if (SDL_FindInHashTable(table, (const void *)(uintptr_t)i, &value) != expected ||
+            (expected && (uintptr_t)value != (uintptr_t)(i * 2))) {
+            SDL_Log("Lookup of key %d returned the wrong result\n", i);
+            return -1;
+        }
+    }
+
+    found = 0;
+    while (SDL_IterateHashTable(table, &key, &value, &iter)) {
+        if ((uintptr_t)value != (uintptr_t)key * 2) {
+            SDL_Log("Iteration returned the wrong value for key %d\n", (int)(uintptr_t)key);
+            return -1;
+        }
+        ++found;
+    }
+    if (found != count - count / 3) {
+        SDL_Log("Iteration found %d items, expected %d\n", found, count - count / 3);
+        return -1;
+    }
+
+    SDL_DestroyHashTable(table);
+
+    /* Stackable tables keep every value for a key */
+    table = SDL_CreateHashTable(NULL, 4, SDL_HashString, SDL_KeyMatchString, NukeCounter, SDL_TRUE);
+    if (!table) {
+        return -1;
+    }
+    for (i = 0; i < 100; ++i) {
+        SDL_InsertIntoHashTable(table, "a", (const void *)(uintptr_t)(i + 1));
+        SDL_InsertIntoHashTable(table, "b", (const void *)(uintptr_t)(i + 1));
+    }
+    /* The newest value comes first, even after the table has grown */
+    found = 0;
+    iter = NULL;
+    while (SDL_IterateHashTableKey(table, "a", &value, &iter)) {
+        if ((uintptr_t)value != (uintptr_t)(100 - found)) {
+            SDL_Log("Stackable iteration returned value %d at position %d, expected %d\n", (int)(uintptr_t)value, found, 100 - found);
+            return -1;
+        }
+        ++found;
+    }
+    if (found != 100) {
+        SDL_Log("Stackable iteration found %d values, expected 100\n", found);
+        return -1;
+    }
+    if (!SDL_FindInHashTable(table, "b", &value) || (uintptr_t)value != 100) {
+        SDL_Log("Stackable lookup didn't return the newest value\n");
+        return -1;
+    }
+    nuked = 0;
+    SDL_DestroyHashTable(table);
+    if (nuked != 200) {
+        SDL_Log("Nuke callback called %d times on destroy, expected 200\n", nuked);
+        return -1;
+    }
+
+    /* Many keys sharing runs of slots, with removals, still come back newest first */
+    table = SDL_CreateHashTable(NULL, 4, SDL_HashID, SDL_KeyMatchID, NukeCounter, SDL_TRUE);
+    if (!table) {
+        return -1;
+    }
+    for (i = 1; i <= 4000; ++i) {
+        SDL_InsertIntoHashTable(table, (const void *)(uintptr_t)(i % 37), (const void *)(uintptr_t)i);
+        if ((i % 5) == 0) {
+            SDL_RemoveFromHashTable(table, (const void *)(uintptr_t)(i % 11));
+        }
+    }
+    for (i = 0; i < 37; ++i) {
+        uintptr_t previous = ~(uintptr_t)0;
+
+        iter = NULL;
+        while (SDL_IterateHashTableKey(table, (const void *)(uintptr_t)i, &value, &iter)) {
+            if ((uintptr_t)value >= previous) {
+                SDL_Log("Stackable iteration of key %d returned %d after %d\n", i, (int)(uintptr_t)value, (int)previous);
+                return -1;
+            }
+            previous = (uintptr_t)value;
+        }
+    }
+    SDL_DestroyHashTable(table);
+
+    return 0;
+}
+
+static void Benchmark(int count, int rounds)
+{
+    SDL_HashTable *table;
+    ChainedTable *chained;
+    const void *key;
+    const void *value;
+    void *iter;
+    Uint64 start, sum;
+    Uint64 insert_ns[2], find_ns[2], iterate_ns[2];
+    int i, r;
+
+    /* Open addressing */
+    start = SDL_GetTicksNS();
+    table = SDL_CreateHashTable(NULL, 16, SDL_HashID, SDL_KeyMatchID, NukeCounter, SDL_FALSE);
+    for (i = 1; i <= count; ++i) {
+        SDL_InsertIntoHashTable(table, (const void *)(uintptr_t)i, (const void *)(uintptr_t)i);
+    }
+    insert_ns[0] = SDL_GetTicksNS() - start;
+
+    sum = 0;
+    start = SDL_GetTicksNS();
+    for (r = 0; r < rounds; ++r) {
+        for (i = 1; i <= count; ++i) {
+            if (SDL_FindInHashTable(table, (const void *)(uintptr_t)i, &value)) {
+                sum += (uintptr_t)value;
+            }
+        }
+    }
+    find_ns[0] = SDL_GetTicksNS() - start;
+
+    start = SDL_GetTicksNS();
+    for (r = 0; r < rounds; ++r) {
+        iter = NULL;
+        while (SDL_IterateHashTable(table, &key, &value, &iter)) {
+            sum += (uintptr_t)value;
+        }
+    }
+    iterate_ns[0] = SDL_GetTicksNS() - start;
+    SDL_DestroyHashTable(table);
+
+    /* Chained, with the fixed bucket count */
+    start = SDL_GetTicksNS();
+    chained = Chained_Create(16);
+    for (i = 1; i <= count; ++i) {
+        Chained_Insert(chained, (const void *)(uintptr_t)i, (const void *)(uintptr_t)i);
+    }
+    insert_ns[1] = SDL_GetTicksNS() - start;
+
+    start = SDL_GetTicksNS();
+    for (r = 0; r < rounds; ++r) {
+        for (i = 1; i <= count; ++i) {
+            if (Chained_Find(chained, (const void *)(uintptr_t)i, &value)) {
+                sum += (uintptr_t)value;
+            }
+        }
+    }
+    find_ns[1] = SDL_GetTicksNS() - start;
+
+    start = SDL_GetTicksNS();
+    for (r = 0; r < rounds; ++r) {
+        iter = NULL;
+        while (Chained_Iterate(chained, &key, &value, &iter)) {
+            sum += (uintptr_t)value;
+        }
+    }
+    iterate_ns[1] = SDL_GetTicksNS() - start;
+    Chained_Destroy(chained);
+
+    SDL_Log("%6d items: insert %8.3f ms vs %8.3f ms, lookup %8.3f ms vs %8.3f ms, iterate %8.3f ms vs %8.3f ms (open addressing vs chained, checksum %" SDL_PRIu64 ")\n",
+            count,
+            insert_ns[0] / 1000000.0, insert_ns[1] / 1000000.0,
+            find_ns[0] / 1000000.0, find_ns[1] / 1000000.0,
+            iterate_ns[0] / 1000000.0, iterate_ns[1] / 1000000.0,
+            sum);
+}
+
+int main(int argc, char *argv[])
+{
+    static const int sizes[] = { 16, 256, 4096, 32768 };
+    SDLTest_CommonState *state;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    if (CheckTable() < 0) {
+        SDLTest_CommonDestroyState(state);
+        return 1;
+    }
+    SDL_Log("Hash table checks passed\n");
+
+    for (i = 0; i < SDL_arraysize(sizes); ++i) {
+        Benchmark(sizes[i], SDL_max(1, 65536 / sizes[i]));
+    }
+
+    SDLTest_CommonDestroyState(state);
+    return 0;
+}
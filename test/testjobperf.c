@@ -0,0 +1,245 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure how the SDL job system scales with the number of job threads:
+   many small independent jobs, a parallel loop, and a tree of jobs that
+   wait for their children.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int num_jobs = 4096;
+static int work_size = 2000;
+static int loop_size = 1 << 20;
+static int tree_depth = 12;
+
+/* Some work that the compiler can't optimize away */
+static Uint32 DoWork(Uint32 seed, int amount)
+{
+    int i;
+
+    for (i = 0; i < amount; ++i) {
+        seed = seed * 1664525 + 1013904223;
+    }
+    return seed;
+}
+
+typedef struct
+{
+    Uint32 seed;
+    Uint32 result;
+} WorkItem;
+
+static void SDLCALL WorkJob(void *userdata)
+{
+    WorkItem *item = (WorkItem *)userdata;
+    item->result = DoWork(item->seed, work_size);
+}
+
+static void SDLCALL WorkLoop(void *userdata, int start, int end)
+{
+    Uint32 *values = (Uint32 *)userdata;
+    int i;
+
+    for (i = start; i < end; ++i) {
+        values[i] = DoWork((Uint32)i, 16);
+    }
+}
+
+typedef struct
+{
+    int depth;
+    Uint32 index;
+    Uint32 result;
+} TreeNode;
+
+static void SDLCALL TreeJob(void *userdata)
+{
+    TreeNode *node = (TreeNode *)userdata;
+
+    if (node->depth == 0) {
+        node->result = DoWork(node->index, work_size);
+    } else {
+        TreeNode children[2];
+        SDL_Job *jobs[2];
+        int i;
+
+        for (i = 0; i < 2; ++i) {
+            children[i].depth = node->depth - 1;
+            children[i].index = node->index * 2 + i;
+            children[i].result = 0;
+            jobs[i] = SDL_SubmitJob(TreeJob, &children[i], NULL, 0);
+        }
+        for (i = 0; i < 2; ++i) {
+            SDL_WaitJob(jobs[i]);
+        }
+        node->result = children[0].result + children[1].result;
+    }
+}
+
+static double ElapsedMS(Uint64 start)
+{
+    return (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS;
+}
+
+/* Run each workload, returning a checksum of the results */
+static Uint32 RunTest(int num_threads, WorkItem *items, SDL_Job **jobs, Uint32 *values, double *times)
+{
+    TreeNode root;
+    Uint32 checksum = 0;
+    Uint64 start;
+    char threads[16];
+    int i;
+
+    /* The job threads are started with the first job, and stopped by SDL_Quit() */
+    SDL_snprintf(threads, sizeof(threads), "%d", num_threads);
+    SDL_SetHint(SDL_HINT_JOB_THREADS, threads);
+    SDL_WaitJob(SDL_SubmitJob(WorkJob, &items[0], NULL, 0));
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_jobs; ++i) {
+        items[i].seed = (Uint32)i;
+        jobs[i] = SDL_SubmitJob(WorkJob, &items[i], NULL, 0);
+    }
+    for (i = 0; i < num_jobs; ++i) {
+        SDL_WaitJob(jobs[i]);
+    }
+    times[0] = ElapsedMS(start);
+    for (i = 0; i < num_jobs; ++i) {
+        checksum += items[i].result;
+    }
+
+    start = SDL_GetTicksNS();
+    SDL_ParallelFor(0, loop_size, 0, WorkLoop, values);
+    times[1] = ElapsedMS(start);
+    for (i = 0; i < loop_size; ++i) {
+        checksum += values[i];
+    }
+
+    start = SDL_GetTicksNS();
+    root.depth = tree_depth;
+    root.index = 1;
+    root.result = 0;
+    SDL_WaitJob(SDL_SubmitJob(TreeJob, &root, NULL, 0));
+    times[2] = ElapsedMS(start);
+    checksum += root.result;
+
+    SDL_Quit();
+    return checksum;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    WorkItem *items = NULL;
+    SDL_Job **jobs = NULL;
+    Uint32 *values = NULL;
+    Uint32 expected = 0;
+    double baseline[3];
+    int max_threads = 0;
+    int i, num_threads;
+    int result = 1;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value = NULL;
+
+            if (SDL_strcmp(argv[i], "--jobs") == 0) {
+                value = &num_jobs;
+            } else if (SDL_strcmp(argv[i], "--work") == 0) {
+                value = &work_size;
+            } else if (SDL_strcmp(argv[i], "--loop") == 0) {
+                value = &loop_size;
+            } else if (SDL_strcmp(argv[i], "--depth") == 0) {
+                value = &tree_depth;
+            } else if (SDL_strcmp(argv[i], "--max-threads") == 0) {
+                value = &max_threads;
+            }
+            if (value && argv[i + 1]) {
+                char *endptr;
+                *value = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value > 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--jobs N]",
+                "[--work N]",
+                "[--loop N]",
+                "[--depth N]",
+                "[--max-threads N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+    tree_depth = SDL_min(tree_depth, 20);
+    if (!max_threads) {
+        max_threads = SDL_GetCPUCount();
+    }
+
+    items = (WorkItem *)SDL_calloc(num_jobs, sizeof(*items));
+    jobs = (SDL_Job **)SDL_calloc(num_jobs, sizeof(*jobs));
+    values = (Uint32 *)SDL_calloc(loop_size, sizeof(*values));
+    if (!items || !jobs || !values) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        goto done;
+    }
+
+    SDL_Log("%-8s %12s %12s %12s\n", "Threads", "Jobs", "ParallelFor", "Tree");
+
+    /* No job threads, then doubling up to the number of cores */
+    for (num_threads = 0; num_threads <= max_threads; num_threads = num_threads ? num_threads * 2 : 1) {
+        double times[3];
+        Uint32 checksum = RunTest(num_threads, items, jobs, values, times);
+
+        if (num_threads == 0) {
+            expected = checksum;
+            SDL_memcpy(baseline, times, sizeof(baseline));
+        } else if (checksum != expected) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Results with %d threads don't match\n", num_threads);
+            goto done;
+        }
+        SDL_Log("%-8d %9.3f ms %9.3f ms %9.3f ms  (%.2fx, %.2fx, %.2fx)\n", num_threads,
+                times[0], times[1], times[2],
+                baseline[0] / times[0], baseline[1] / times[1], baseline[2] / times[2]);
+    }
+    result = 0;
+
+done:
+    SDL_free(values);
+    SDL_free(jobs);
+    SDL_free(items);
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
@@ -27,6 +27,7 @@ static SDL_AtomicInt doterminate;
 static int nb_threads = 6;
 static SDL_Thread **threads;
 static int worktime = 1000;
+static int benchmark_iterations = 0;
 static SDLTest_CommonState *state;
 
 /**
@@ -97,6 +98,101 @@ Run(void *data)
     return 0;
 }
 
+/* Contention benchmark: every thread bumps a shared counter under a lock */
+static SDL_SpinLock benchmark_spinlock;
+static int benchmark_counter;
+static SDL_Condition *benchmark_cond;
+static int benchmark_turn;
+
+static int SDLCALL
+RunMutexBenchmark(void *data)
+{
+    int i;
+
+    for (i = 0; i < benchmark_iterations; ++i) {
+        SDL_LockMutex(mutex);
+        ++benchmark_counter;
+        SDL_UnlockMutex(mutex);
+    }
+    return 0;
+}
+
+static int SDLCALL
+RunSpinLockBenchmark(void *data)
+{
+    int i;
+
+    for (i = 0; i < benchmark_iterations; ++i) {
+        SDL_AtomicLock(&benchmark_spinlock);
+        ++benchmark_counter;
+        SDL_AtomicUnlock(&benchmark_spinlock);
+    }
+    return 0;
+}
+
+/* Two threads take turns, handing off through a condition variable */
+static int SDLCALL
+RunConditionBenchmark(void *data)
+{
+    const int me = (int)(intptr_t)data;
+    int i;
+
+    SDL_LockMutex(mutex);
+    for (i = 0; i < benchmark_iterations; ++i) {
+        while (benchmark_turn != me) {
+            SDL_WaitCondition(benchmark_cond, mutex);
+        }
+        ++benchmark_counter;
+        benchmark_turn = !me;
+        SDL_BroadcastCondition(benchmark_cond);
+    }
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
+
+static SDL_bool RunBenchmark(const char *name, SDL_ThreadFunction fn, int num_threads, int expected)
+{
+    Uint64 start, elapsed;
+    int i;
+
+    benchmark_counter = 0;
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_threads; ++i) {
+        threads[i] = SDL_CreateThread(fn, "Benchmark", (void *)(intptr_t)i);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-10s %2d threads: %8.3f ms, %7.1f ns per lock\n", name, num_threads,
+            (double)elapsed / SDL_NS_PER_MS, (double)elapsed / SDL_max(expected, 1));
+    if (benchmark_counter != expected) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: counted %d, expected %d\n", name, benchmark_counter, expected);
+        return SDL_FALSE;
+    }
+    return SDL_TRUE;
+}
+
+static int Benchmark(void)
+{
+    SDL_bool passed = SDL_TRUE;
+
+    benchmark_cond = SDL_CreateCondition();
+    if (!benchmark_cond) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create condition: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    passed &= RunBenchmark("Mutex", RunMutexBenchmark, nb_threads, nb_threads * benchmark_iterations);
+    passed &= RunBenchmark("SpinLock", RunSpinLockBenchmark, nb_threads, nb_threads * benchmark_iterations);
+    benchmark_turn = 0;
+    passed &= RunBenchmark("Condition", RunConditionBenchmark, 2, 2 * benchmark_iterations);
+
+    SDL_DestroyCondition(benchmark_cond);
+    return passed ? 0 : 1;
+}
+
 #ifndef _WIN32
 static Uint32 hit_timeout(Uint32 interval, void *param) {
     SDL_Log("Hit timeout! Sending SIGINT!");
@@ -134,6 +230,14 @@ int main(int argc, char *argv[])
                         consumed = 2;
                     }
                 }
+            } else if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    benchmark_iterations = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && benchmark_iterations > 0) {
+                        consumed = 2;
+                    }
+                }
             } else if (SDL_strcmp(argv[i], "--worktime") == 0) {
                 if (argv[i + 1]) {
                     char *endptr;
@@ -158,6 +262,7 @@ int main(int argc, char *argv[])
             static const char *options[] = {
                 "[--nbthreads NB]",
                 "[--worktime ms]",
+                "[--benchmark iterations]",
 #ifndef _WIN32
                 "[--timeout ms]",
 #endif
@@ -170,7 +275,7 @@ int main(int argc, char *argv[])
         i += consumed;
     }
 
-    threads = SDL_malloc(nb_threads * sizeof(SDL_Thread*));
+    threads = SDL_malloc(SDL_max(nb_threads, 2) * sizeof(SDL_Thread*));
 
     /* Load the SDL library */
     if (SDL_Init(0) < 0) {
@@ -187,6 +292,14 @@ int main(int argc, char *argv[])
         exit(1);
     }
 
+    if (benchmark_iterations) {
+        int result = Benchmark();
+        SDL_free(threads);
+        threads = NULL;
+        SDL_DestroyMutex(mutex);
+        return result;
+    }
+
     mainthread = SDL_ThreadID();
     SDL_Log("Main thread: %lu\n", mainthread);
     (void)atexit(printid);
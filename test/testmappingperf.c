@@ -0,0 +1,178 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure gamepad startup with a large mapping database: initializing the
+   gamepad subsystem, loading a generated database the size of a community
+   gamecontrollerdb.txt, and looking up mappings by GUID.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int num_mappings = 5000;
+
+static SDL_JoystickGUID RandomGUID(int i)
+{
+    SDL_JoystickGUID guid;
+    Uint16 *words = (Uint16 *)guid.data;
+
+    SDL_zero(guid);
+    words[0] = SDL_SwapLE16(0x03); /* USB */
+    words[2] = SDL_SwapLE16((Uint16)SDLTest_RandomIntegerInRange(1, 0xFFFF));
+    words[4] = SDL_SwapLE16((Uint16)i);
+    words[6] = SDL_SwapLE16((Uint16)SDLTest_RandomIntegerInRange(0, 3));
+    return guid;
+}
+
+static char *CreateDatabase(SDL_JoystickGUID *guids, size_t *size)
+{
+    const size_t line_size = 512;
+    char *db = (char *)SDL_malloc(num_mappings * line_size);
+    size_t length = 0;
+    int i;
+
+    if (!db) {
+        return NULL;
+    }
+    for (i = 0; i < num_mappings; ++i) {
+        char guid[33];
+
+        guids[i] = RandomGUID(i);
+        SDL_GetJoystickGUIDString(guids[i], guid, sizeof(guid));
+        length += SDL_snprintf(db + length, line_size, "%s,Generated Gamepad %d,a:b0,b:b1,back:b6,dpdown:h0.4,dpleft:h0.8,"
+                                                       "dpright:h0.2,dpup:h0.1,guide:b8,leftshoulder:b4,leftstick:b9,"
+                                                       "lefttrigger:a2,leftx:a0,lefty:a1,rightshoulder:b5,rightstick:b10,"
+                                                       "righttrigger:a5,rightx:a3,righty:a4,start:b7,x:b2,y:b3,platform:%s,\n",
+                               guid, i, SDL_GetPlatform());
+    }
+    *size = length;
+    return db;
+}
+
+static double ElapsedMS(Uint64 start)
+{
+    return (double)(SDL_GetTicksNS() - start) / SDL_NS_PER_MS;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_JoystickGUID *guids = NULL;
+    char *db = NULL;
+    size_t db_size = 0;
+    Uint64 seed = 0;
+    Uint64 start;
+    int i, found, loaded;
+    int result = 1;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--mappings") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    num_mappings = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && num_mappings > 0 && num_mappings <= 0xFFFF) {
+                        consumed = 2;
+                    }
+                }
+            } else if (SDL_strcmp(argv[i], "--seed") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    seed = SDL_strtoull(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0') {
+                        consumed = 2;
+                    }
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--mappings N]",
+                "[--seed N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Random seed: %" SDL_PRIu64 "\n", seed);
+    SDLTest_FuzzerInit(seed);
+
+    guids = (SDL_JoystickGUID *)SDL_malloc(num_mappings * sizeof(*guids));
+    if (guids) {
+        db = CreateDatabase(guids, &db_size);
+    }
+    if (!db) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create mapping database\n");
+        goto done;
+    }
+
+    start = SDL_GetTicksNS();
+    if (SDL_Init(SDL_INIT_GAMEPAD) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        goto done;
+    }
+    SDL_Log("Initialized gamepads in %.3f ms\n", ElapsedMS(start));
+
+    start = SDL_GetTicksNS();
+    loaded = SDL_AddGamepadMappingsFromRW(SDL_RWFromConstMem(db, db_size), SDL_TRUE);
+    SDL_Log("Loaded %d mappings in %.3f ms\n", loaded, ElapsedMS(start));
+
+    /* Adding the same database again only updates the existing mappings */
+    start = SDL_GetTicksNS();
+    i = SDL_AddGamepadMappingsFromRW(SDL_RWFromConstMem(db, db_size), SDL_TRUE);
+    SDL_Log("Reloaded %d mappings in %.3f ms, %d were new\n", num_mappings, ElapsedMS(start), i);
+
+    found = 0;
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_mappings; ++i) {
+        char *mapping = SDL_GetGamepadMappingForGUID(guids[i]);
+        if (mapping) {
+            ++found;
+            SDL_free(mapping);
+        }
+    }
+    SDL_Log("Looked up %d mappings in %.3f ms\n", num_mappings, ElapsedMS(start));
+
+    if (loaded != num_mappings || found != num_mappings) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Expected %d mappings, loaded %d and found %d\n", num_mappings, loaded, found);
+        goto done;
+    }
+    result = 0;
+
+done:
+    SDL_free(db);
+    SDL_free(guids);
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
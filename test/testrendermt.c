@@ -0,0 +1,343 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Draw the same scene with the "software" and "software-mt" renderers,
+   and check that they produce exactly the same pixels.
+
+   The scene mixes everything the tiled renderer draws in parallel (clears,
+   fills, unscaled copies and triangles) with the things it draws directly
+   (points, lines, scaled and rotated copies), with and without blending,
+   color modulation, viewports and clip rects. Each renderer draws it a few
+   times so you can compare how long a frame takes.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define WINDOW_WIDTH  640
+#define WINDOW_HEIGHT 480
+#define SPRITE_SIZE   48
+
+static int num_objects = 200;
+static int num_frames = 20;
+
+static SDL_Texture *CreateSprite(SDL_Renderer *renderer, Uint32 format, SDL_BlendMode blend)
+{
+    SDL_Surface *surface = SDL_CreateSurface(SPRITE_SIZE, SPRITE_SIZE, format);
+    SDL_Texture *texture = NULL;
+    int x, y;
+
+    if (!surface) {
+        return NULL;
+    }
+
+    /* A soft edged disc with a checkerboard in it */
+    for (y = 0; y < SPRITE_SIZE; ++y) {
+        Uint32 *row = (Uint32 *)((Uint8 *)surface->pixels + y * surface->pitch);
+        for (x = 0; x < SPRITE_SIZE; ++x) {
+            const int dx = x - SPRITE_SIZE / 2;
+            const int dy = y - SPRITE_SIZE / 2;
+            const int d = SDL_max(0, SPRITE_SIZE * SPRITE_SIZE / 4 - (dx * dx + dy * dy));
+            const Uint8 a = (Uint8)SDL_min(255, d / 2);
+            const Uint8 c = ((x / 6) ^ (y / 6)) & 1 ? 255 : 64;
+            row[x] = SDL_MapRGBA(surface->format, c, (Uint8)(x * 5), (Uint8)(y * 5), a);
+        }
+    }
+
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_DestroySurface(surface);
+    if (texture) {
+        SDL_SetTextureBlendMode(texture, blend);
+    }
+    return texture;
+}
+
+static void RandomColor(SDL_Color *color)
+{
+    color->r = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    color->g = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    color->b = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    color->a = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+}
+
+static float RandomCoord(int max)
+{
+    return (float)SDLTest_RandomIntegerInRange(-SPRITE_SIZE, max + SPRITE_SIZE) + (float)SDLTest_RandomIntegerInRange(0, 3) / 4.0f;
+}
+
+static void DrawScene(SDL_Renderer *renderer, SDL_Texture **sprites, int num_sprites)
+{
+    static const SDL_BlendMode blend_modes[] = {
+        SDL_BLENDMODE_NONE, SDL_BLENDMODE_BLEND, SDL_BLENDMODE_ADD, SDL_BLENDMODE_MOD, SDL_BLENDMODE_MUL
+    };
+    SDL_Color color;
+    SDL_FRect rect;
+    SDL_Rect clip;
+    SDL_Vertex verts[3];
+    int i, j;
+
+    SDL_SetRenderViewport(renderer, NULL);
+    SDL_SetRenderClipRect(renderer, NULL);
+    SDL_SetRenderDrawColor(renderer, 32, 48, 64, 255);
+    SDL_RenderClear(renderer);
+
+    for (i = 0; i < num_objects; ++i) {
+        const int what = SDLTest_RandomIntegerInRange(0, 99);
+        SDL_Texture *sprite = sprites[SDLTest_RandomIntegerInRange(0, num_sprites - 1)];
+
+        RandomColor(&color);
+
+        if (what < 40) {
+            rect.x = RandomCoord(WINDOW_WIDTH);
+            rect.y = RandomCoord(WINDOW_HEIGHT);
+            rect.w = SPRITE_SIZE;
+            rect.h = SPRITE_SIZE;
+            SDL_SetTextureColorMod(sprite, color.r, color.g, color.b);
+            SDL_SetTextureAlphaMod(sprite, (what & 1) ? 255 : color.a);
+            SDL_RenderTexture(renderer, sprite, NULL, &rect);
+        } else if (what < 55) {
+            rect.x = RandomCoord(WINDOW_WIDTH);
+            rect.y = RandomCoord(WINDOW_HEIGHT);
+            rect.w = (float)SDLTest_RandomIntegerInRange(1, 200);
+            rect.h = (float)SDLTest_RandomIntegerInRange(1, 200);
+            SDL_SetRenderDrawBlendMode(renderer, blend_modes[what % SDL_arraysize(blend_modes)]);
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_RenderFillRect(renderer, &rect);
+        } else if (what < 75) {
+            for (j = 0; j < 3; ++j) {
+                verts[j].position.x = RandomCoord(WINDOW_WIDTH);
+                verts[j].position.y = RandomCoord(WINDOW_HEIGHT);
+                RandomColor(&verts[j].color);
+                /* Stay off the far edges: a triangle with all its texture coordinates there reads outside the texture */
+                verts[j].tex_coord.x = (float)SDLTest_RandomIntegerInRange(0, 3) / 4.0f;
+                verts[j].tex_coord.y = (float)SDLTest_RandomIntegerInRange(0, 3) / 4.0f;
+            }
+            if (what & 1) {
+                SDL_SetTextureColorMod(sprite, 255, 255, 255);
+                SDL_SetTextureAlphaMod(sprite, 255);
+                SDL_RenderGeometry(renderer, sprite, verts, 3, NULL, 0);
+            } else {
+                SDL_SetRenderDrawBlendMode(renderer, blend_modes[what % SDL_arraysize(blend_modes)]);
+                SDL_RenderGeometry(renderer, NULL, verts, 3, NULL, 0);
+            }
+        } else if (what < 85) {
+            rect.x = RandomCoord(WINDOW_WIDTH);
+            rect.y = RandomCoord(WINDOW_HEIGHT);
+            rect.w = (float)SDLTest_RandomIntegerInRange(8, 120);
+            rect.h = (float)SDLTest_RandomIntegerInRange(8, 120);
+            SDL_SetTextureColorMod(sprite, color.r, color.g, color.b);
+            SDL_SetTextureAlphaMod(sprite, 255);
+            if (what & 1) {
+                SDL_RenderTextureRotated(renderer, sprite, NULL, &rect, (double)SDLTest_RandomIntegerInRange(0, 359), NULL, SDL_FLIP_NONE);
+            } else {
+                SDL_RenderTexture(renderer, sprite, NULL, &rect);
+            }
+        } else if (what < 95) {
+            SDL_SetRenderDrawBlendMode(renderer, blend_modes[what % SDL_arraysize(blend_modes)]);
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_RenderLine(renderer, RandomCoord(WINDOW_WIDTH), RandomCoord(WINDOW_HEIGHT), RandomCoord(WINDOW_WIDTH), RandomCoord(WINDOW_HEIGHT));
+            SDL_RenderPoint(renderer, RandomCoord(WINDOW_WIDTH), RandomCoord(WINDOW_HEIGHT));
+        } else if (what < 98) {
+            clip.x = SDLTest_RandomIntegerInRange(-50, WINDOW_WIDTH / 2);
+            clip.y = SDLTest_RandomIntegerInRange(-50, WINDOW_HEIGHT / 2);
+            clip.w = SDLTest_RandomIntegerInRange(50, WINDOW_WIDTH);
+            clip.h = SDLTest_RandomIntegerInRange(50, WINDOW_HEIGHT);
+            SDL_SetRenderClipRect(renderer, (what & 1) ? &clip : NULL);
+        } else {
+            clip.x = SDLTest_RandomIntegerInRange(0, WINDOW_WIDTH / 2);
+            clip.y = SDLTest_RandomIntegerInRange(0, WINDOW_HEIGHT / 2);
+            clip.w = SDLTest_RandomIntegerInRange(50, WINDOW_WIDTH - clip.x);
+            clip.h = SDLTest_RandomIntegerInRange(50, WINDOW_HEIGHT - clip.y);
+            SDL_SetRenderViewport(renderer, (what & 1) ? &clip : NULL);
+        }
+    }
+}
+
+/* Draw the scene with the given renderer, and read the result back into `pixels` */
+static int RenderScene(SDL_Window *window, const char *driver, Uint64 seed, Uint32 *pixels, double *ms_per_frame)
+{
+    static const Uint32 formats[] = { SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_XRGB8888 };
+    SDL_Renderer *renderer = SDL_CreateRenderer(window, driver, 0);
+    SDL_Texture *sprites[SDL_arraysize(formats) * 2];
+    int num_sprites = 0;
+    Uint64 start;
+    int i, result = 0;
+
+    if (!renderer) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create %s renderer: %s\n", driver, SDL_GetError());
+        return -1;
+    }
+
+    for (i = 0; i < (int)SDL_arraysize(formats); ++i) {
+        sprites[num_sprites] = CreateSprite(renderer, formats[i], SDL_BLENDMODE_BLEND);
+        if (sprites[num_sprites]) {
+            ++num_sprites;
+        }
+        sprites[num_sprites] = CreateSprite(renderer, formats[i], (i & 1) ? SDL_BLENDMODE_ADD : SDL_BLENDMODE_NONE);
+        if (sprites[num_sprites]) {
+            ++num_sprites;
+        }
+    }
+    if (num_sprites == 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create sprites: %s\n", SDL_GetError());
+        SDL_DestroyRenderer(renderer);
+        return -1;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_frames; ++i) {
+        /* Every frame is the same, so the last one is the one we compare */
+        SDLTest_FuzzerInit(seed);
+        DrawScene(renderer, sprites, num_sprites);
+        SDL_FlushRenderer(renderer);
+    }
+    *ms_per_frame = (double)(SDL_GetTicksNS() - start) / num_frames / 1000000.0;
+
+    SDL_SetRenderViewport(renderer, NULL);
+    if (SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, pixels, WINDOW_WIDTH * (int)sizeof(Uint32)) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't read pixels: %s\n", SDL_GetError());
+        result = -1;
+    }
+
+    for (i = 0; i < num_sprites; ++i) {
+        SDL_DestroyTexture(sprites[i]);
+    }
+    SDL_DestroyRenderer(renderer);
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_Window *window = NULL;
+    Uint32 *expected = NULL;
+    Uint32 *actual = NULL;
+    Uint64 seed = 0;
+    const char *threads = "4";
+    double sw_ms = 0.0, mt_ms = 0.0;
+    int i, mismatches = 0;
+    int result = 1;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value = NULL;
+
+            if (SDL_strcmp(argv[i], "--objects") == 0) {
+                value = &num_objects;
+            } else if (SDL_strcmp(argv[i], "--frames") == 0) {
+                value = &num_frames;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0) {
+                if (argv[i + 1]) {
+                    threads = argv[i + 1];
+                    consumed = 2;
+                }
+            } else if (SDL_strcmp(argv[i], "--seed") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    seed = SDL_strtoull(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0') {
+                        consumed = 2;
+                    }
+                }
+            }
+            if (value && argv[i + 1]) {
+                char *endptr;
+                *value = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value > 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--objects N]",
+                "[--frames N]",
+                "[--threads N]",
+                "[--seed N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Random seed: %" SDL_PRIu64 "\n", seed);
+
+    /* "0" lets the renderer use a thread per CPU */
+    SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, threads);
+
+    /* This runs unattended, so without a video driver that can make windows there's nothing to test */
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_Log("Couldn't initialize SDL, skipping test: %s\n", SDL_GetError());
+        result = 0;
+        goto done;
+    }
+
+    window = SDL_CreateWindow("testrendermt", WINDOW_WIDTH, WINDOW_HEIGHT, 0);
+    if (!window) {
+        SDL_Log("Couldn't create window, skipping test: %s\n", SDL_GetError());
+        result = 0;
+        goto done;
+    }
+
+    expected = (Uint32 *)SDL_malloc(WINDOW_WIDTH * WINDOW_HEIGHT * sizeof(Uint32));
+    actual = (Uint32 *)SDL_malloc(WINDOW_WIDTH * WINDOW_HEIGHT * sizeof(Uint32));
+    if (!expected || !actual) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        goto done;
+    }
+
+    if (RenderScene(window, "software", seed, expected, &sw_ms) < 0 ||
+        RenderScene(window, "software-mt", seed, actual, &mt_ms) < 0) {
+        goto done;
+    }
+
+    for (i = 0; i < WINDOW_WIDTH * WINDOW_HEIGHT; ++i) {
+        if (expected[i] != actual[i]) {
+            if (mismatches++ == 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Pixel (%d,%d) is 0x%.8" SDL_PRIx32 ", expected 0x%.8" SDL_PRIx32 "\n",
+                             i % WINDOW_WIDTH, i / WINDOW_WIDTH, actual[i], expected[i]);
+            }
+        }
+    }
+
+    SDL_Log("%d objects: software takes %.3f ms per frame, software-mt with %s threads takes %.3f ms, %d pixels differ\n",
+            num_objects, sw_ms, threads, mt_ms, mismatches);
+    result = mismatches ? 1 : 0;
+
+done:
+    SDL_free(expected);
+    SDL_free(actual);
+    SDL_DestroyWindow(window);
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
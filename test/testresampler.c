@@ -0,0 +1,205 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Check that the SIMD resampler kernels and the polyphase filter tables
+   give the same output as the scalar resampler, for a range of rates and
+   channel counts, over several calls that carry the position along like an
+   audio stream does.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Hack to avoid dynapi renaming */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_internal.h"
+#include "../src/audio/SDL_audioresample.c"
+
+/* The largest difference allowed from the scalar output, for input in [-1, 1].
+   The kernels add up the filter taps in a different order, so they aren't bit exact. */
+#define RESAMPLER_TOLERANCE 1e-5f
+
+typedef void (*ResampleFramesFunc)(const float *const *src, const float *const *raw_filter, const float *interp, int frames, float *dst, int chans);
+
+typedef struct
+{
+    const char *name;
+    ResampleFramesFunc func;
+    SDL_bool supported;
+} ResamplerKernel;
+
+static const int chunk_frames[] = { 1, 63, 64, 65, 7, 1000, 129 };
+
+/* Resample `input` in chunks, with `kernel`, and the polyphase table if there is one */
+static void Resample(ResampleFramesFunc kernel, const SDL_ResamplerPolyphase *polyphase, int chans, Sint64 resample_rate,
+                     const float *input, float *output)
+{
+    Sint64 offset = 0;
+    int i;
+
+    ResampleFrames = kernel;
+    for (i = 0; i < SDL_arraysize(chunk_frames); ++i) {
+        const int outframes = chunk_frames[i];
+        const int inframes = (int)SDL_GetResamplerInputFrames(outframes, resample_rate, offset);
+
+        SDL_ResampleAudio(chans, input, inframes, output, outframes, resample_rate, &offset, polyphase);
+        input += inframes * chans;
+        output += outframes * chans;
+    }
+}
+
+static float MaxDifference(const float *a, const float *b, int count)
+{
+    float max = 0.0f;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        max = SDL_max(max, SDL_fabsf(a[i] - b[i]));
+    }
+    return max;
+}
+
+static int CheckResampler(const ResamplerKernel *kernels, int num_kernels, int src_rate, int dst_rate, int chans)
+{
+    const Sint64 resample_rate = SDL_GetResampleRate(src_rate, dst_rate);
+    const int padding = SDL_GetResamplerPaddingFrames(resample_rate);
+    SDL_ResamplerPolyphase *polyphase = SDL_CreateResamplerPolyphase(src_rate, dst_rate);
+    int total_out = 0, total_in, i, k, retval = 0;
+    float *input, *expected, *actual;
+
+    for (i = 0; i < SDL_arraysize(chunk_frames); ++i) {
+        total_out += chunk_frames[i];
+    }
+    total_in = (int)(((Sint64)total_out * src_rate) / dst_rate) + SDL_arraysize(chunk_frames) * 2 + 2 * padding;
+
+    input = (float *)SDL_malloc(total_in * chans * sizeof(float));
+    expected = (float *)SDL_malloc(total_out * chans * sizeof(float));
+    actual = (float *)SDL_malloc(total_out * chans * sizeof(float));
+    if (!input || !expected || !actual) {
+        SDL_Log("Out of memory\n");
+        retval = -1;
+        goto done;
+    }
+    for (i = 0; i < total_in * chans; ++i) {
+        input[i] = SDLTest_RandomUnitFloat() * 2.0f - 1.0f;
+    }
+
+    Resample(ResampleFrames_Scalar, NULL, chans, resample_rate, input + padding * chans, expected);
+
+    for (k = 0; k < num_kernels; ++k) {
+        int pass;
+
+        if (!kernels[k].supported) {
+            continue;
+        }
+        for (pass = 0; pass < 2; ++pass) {
+            const SDL_ResamplerPolyphase *table = pass ? polyphase : NULL;
+            float diff;
+
+            if (pass && !table) {
+                continue;
+            }
+            Resample(kernels[k].func, table, chans, resample_rate, input + padding * chans, actual);
+            diff = MaxDifference(expected, actual, total_out * chans);
+            if (!(diff <= RESAMPLER_TOLERANCE)) {
+                SDL_Log("%s resampler%s differs from scalar by %g, %d Hz -> %d Hz, %d channels\n",
+                        kernels[k].name, table ? " with polyphase table" : "", diff, src_rate, dst_rate, chans);
+                retval = -1;
+            }
+        }
+    }
+
+done:
+    SDL_free(input);
+    SDL_free(expected);
+    SDL_free(actual);
+    SDL_DestroyResamplerPolyphase(polyphase);
+    return retval;
+}
+
+int main(int argc, char *argv[])
+{
+    static const int rates[][2] = {
+        { 44100, 48000 }, { 48000, 44100 }, { 22050, 48000 }, { 11025, 48000 }, { 48000, 96000 },
+        { 96000, 48000 }, { 96000, 44100 }, { 8000, 44100 }, { 48000, 8000 }, { 44100, 37123 }
+    };
+    static const int channels[] = { 1, 2, 3, 4, 5, 6, 8 };
+    ResamplerKernel kernels[4];
+    int num_kernels = 0;
+    SDLTest_CommonState *state;
+    int i, j, failed = 0;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    if (!SDLTest_CommonDefaultArgs(state, argc, argv)) {
+        return 1;
+    }
+
+    SDLTest_FuzzerInit(SDL_GetPerformanceCounter());
+    SDL_SetupAudioResampler();
+
+    kernels[num_kernels].name = "Scalar";
+    kernels[num_kernels].func = ResampleFrames_Scalar;
+    kernels[num_kernels].supported = SDL_TRUE;
+    ++num_kernels;
+#ifdef SDL_SSE_INTRINSICS
+    kernels[num_kernels].name = "SSE";
+    kernels[num_kernels].func = ResampleFrames_SSE;
+    kernels[num_kernels].supported = SDL_HasSSE();
+    ++num_kernels;
+#endif
+#ifdef SDL_AVX2_INTRINSICS
+    kernels[num_kernels].name = "AVX2";
+    kernels[num_kernels].func = ResampleFrames_AVX2;
+    kernels[num_kernels].supported = SDL_HasAVX2();
+    ++num_kernels;
+#endif
+#ifdef SDL_NEON_INTRINSICS
+    kernels[num_kernels].name = "NEON";
+    kernels[num_kernels].func = ResampleFrames_NEON;
+    kernels[num_kernels].supported = SDL_HasNEON();
+    ++num_kernels;
+#endif
+
+    for (i = 0; i < num_kernels; ++i) {
+        SDL_Log("%s resampler: %s\n", kernels[i].name, kernels[i].supported ? "checked" : "not supported by this CPU");
+    }
+
+    for (i = 0; i < SDL_arraysize(rates); ++i) {
+        for (j = 0; j < SDL_arraysize(channels); ++j) {
+            if (CheckResampler(kernels, num_kernels, rates[i][0], rates[i][1], channels[j]) < 0) {
+                failed = 1;
+            }
+        }
+    }
+
+    if (!failed) {
+        SDL_Log("Resampler checks passed\n");
+    }
+
+    SDLTest_CommonDestroyState(state);
+    return failed;
+}
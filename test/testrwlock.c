@@ -26,6 +26,7 @@ static SDL_Thread **threads;
 static int worktime = 1000;
 static int writerworktime = 100;
 static int timeout = 10000;
+static int benchmark_iterations = 0;
 static SDLTest_CommonState *state;
 
 static void DoWork(const int workticks)  /* "Work" */
@@ -61,6 +62,59 @@ ReaderRun(void *data)
     return 0;
 }
 
+/* Contention benchmark: readers check a pair of values that the writer
+   keeps equal, so a reader getting in during a write shows up as an error */
+static int benchmark_values[2];
+static SDL_AtomicInt benchmark_errors;
+
+static int SDLCALL
+BenchmarkReaderRun(void *data)
+{
+    int i;
+
+    for (i = 0; i < benchmark_iterations; ++i) {
+        SDL_LockRWLockForReading(rwlock);
+        if (benchmark_values[0] != benchmark_values[1]) {
+            SDL_AtomicIncRef(&benchmark_errors);
+        }
+        SDL_UnlockRWLock(rwlock);
+    }
+    return 0;
+}
+
+static int Benchmark(void)
+{
+    const int num_writes = benchmark_iterations / 16;
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_AtomicSet(&benchmark_errors, 0);
+    start = SDL_GetTicksNS();
+    for (i = 0; i < nb_threads; ++i) {
+        threads[i] = SDL_CreateThread(BenchmarkReaderRun, "Reader", NULL);
+    }
+    for (i = 0; i < num_writes; ++i) {
+        SDL_LockRWLockForWriting(rwlock);
+        ++benchmark_values[0];
+        ++benchmark_values[1];
+        SDL_UnlockRWLock(rwlock);
+    }
+    for (i = 0; i < nb_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%d readers x %d reads, %d writes: %.3f ms, %.1f ns per lock\n",
+            nb_threads, benchmark_iterations, num_writes, (double)elapsed / SDL_NS_PER_MS,
+            (double)elapsed / ((Sint64)nb_threads * benchmark_iterations + num_writes));
+    if (SDL_AtomicGet(&benchmark_errors) || benchmark_values[0] != num_writes) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Saw %d inconsistent reads, and %d of %d writes\n",
+                     SDL_AtomicGet(&benchmark_errors), benchmark_values[0], num_writes);
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     int i;
@@ -105,6 +159,14 @@ int main(int argc, char *argv[])
                         consumed = 2;
                     }
                 }
+            } else if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    benchmark_iterations = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && benchmark_iterations > 0) {
+                        consumed = 2;
+                    }
+                }
             } else if (SDL_strcmp(argv[i], "--timeout") == 0) {
                 if (argv[i + 1]) {
                     char *endptr;
@@ -121,6 +183,7 @@ int main(int argc, char *argv[])
                 "[--worktime ms]",
                 "[--writerworktime ms]",
                 "[--timeout ms]",
+                "[--benchmark iterations]",
                 NULL,
             };
             SDLTest_CommonLogUsage(state, argv[0], options);
@@ -148,6 +211,15 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (benchmark_iterations) {
+        int result = Benchmark();
+        SDL_free(threads);
+        SDL_DestroyRWLock(rwlock);
+        SDLTest_CommonDestroyState(state);
+        SDL_Quit();
+        return result;
+    }
+
     mainthread = SDL_ThreadID();
     SDL_Log("Writer thread: %lu\n", mainthread);
     for (i = 0; i < nb_threads; ++i) {
@@ -0,0 +1,191 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure the per-call overhead of small reads and writes through SDL_RWops,
+   reading and writing one value at a time from memory, from a file, and
+   from a file through SDL_CreateBufferedRW().
+*/
+
+#include <stdio.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int num_values = 1 << 20;
+static int num_loops = 10;
+
+static double ElapsedNS(Uint64 start, int count)
+{
+    return (double)(SDL_GetTicksNS() - start) / count;
+}
+
+/* Write and read back num_values values one at a time, returning SDL_FALSE if the data didn't match */
+static SDL_bool RunTest(const char *name, SDL_RWops *rw, Uint32 expected)
+{
+    double read_ns = 0.0, write_ns = 0.0;
+    Uint64 start;
+    Uint32 value, checksum;
+    int i, loop;
+
+    for (loop = 0; loop < num_loops; ++loop) {
+        SDL_RWseek(rw, 0, SDL_RW_SEEK_SET);
+        start = SDL_GetTicksNS();
+        for (i = 0; i < num_values; ++i) {
+            SDL_WriteU32LE(rw, (Uint32)i);
+        }
+        write_ns += ElapsedNS(start, num_values);
+
+        SDL_RWseek(rw, 0, SDL_RW_SEEK_SET);
+        checksum = 0;
+        start = SDL_GetTicksNS();
+        for (i = 0; i < num_values; ++i) {
+            if (!SDL_ReadU32LE(rw, &value)) {
+                break;
+            }
+            checksum += value;
+        }
+        read_ns += ElapsedNS(start, num_values);
+        if (checksum != expected) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s: read back 0x%.8x, expected 0x%.8x\n", name, (unsigned int)checksum, (unsigned int)expected);
+            return SDL_FALSE;
+        }
+    }
+
+    SDL_Log("%-16s %12.2f ns %12.2f ns\n", name, write_ns / num_loops, read_ns / num_loops);
+    return SDL_TRUE;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    Uint32 *data = NULL;
+    const char *filename = "testrwperf.dat";
+    SDL_RWops *rw = NULL;
+    SDL_RWops *file = NULL;
+    SDL_RWops *buffered = NULL;
+    Uint64 start;
+    Uint32 expected;
+    int i, loop;
+    int result = 1;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value_arg = NULL;
+
+            if (SDL_strcmp(argv[i], "--values") == 0) {
+                value_arg = &num_values;
+            } else if (SDL_strcmp(argv[i], "--loops") == 0) {
+                value_arg = &num_loops;
+            }
+            if (value_arg && argv[i + 1]) {
+                char *endptr;
+                *value_arg = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value_arg > 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--values N]",
+                "[--loops N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    data = (Uint32 *)SDL_malloc(num_values * sizeof(*data));
+    if (!data) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Out of memory\n");
+        goto done;
+    }
+    rw = SDL_RWFromMem(data, num_values * sizeof(*data));
+    if (!rw) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create RWops: %s\n", SDL_GetError());
+        goto done;
+    }
+
+    /* Applications usually have an error buffer by now, so measure with one */
+    SDL_SetError("Error buffer");
+    SDL_ClearError();
+
+    expected = 0;
+    for (i = 0; i < num_values; ++i) {
+        expected += (Uint32)i;
+    }
+
+    SDL_Log("%-16s %15s %15s\n", "Stream", "SDL_WriteU32LE", "SDL_ReadU32LE");
+    if (!RunTest("Memory", rw, expected)) {
+        goto done;
+    }
+
+    file = SDL_RWFromFile(filename, "w+b");
+    if (!file) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create %s: %s\n", filename, SDL_GetError());
+        goto done;
+    }
+    if (!RunTest("File", file, expected)) {
+        goto done;
+    }
+    buffered = SDL_CreateBufferedRW(file, 0);
+    if (!buffered) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create buffered RWops: %s\n", SDL_GetError());
+        goto done;
+    }
+    if (!RunTest("Buffered file", buffered, expected)) {
+        goto done;
+    }
+
+    /* The error state that every read and write touches */
+    start = SDL_GetTicksNS();
+    for (loop = 0; loop < num_loops; ++loop) {
+        for (i = 0; i < num_values; ++i) {
+            SDL_ClearError();
+        }
+    }
+    SDL_Log("SDL_ClearError: %.2f ns/call\n", ElapsedNS(start, num_values * num_loops));
+    result = 0;
+
+done:
+    if (buffered) {
+        SDL_RWclose(buffered);
+    }
+    if (file) {
+        SDL_RWclose(file);
+        remove(filename);
+    }
+    if (rw) {
+        SDL_RWclose(rw);
+    }
+    SDL_free(data);
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}
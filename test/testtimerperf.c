@@ -0,0 +1,185 @@
+/*
+  Copyright (C) 1997-2023 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measure the throughput of SDL timers with many of them active at once:
+   adding them, canceling them, and firing them on the timer thread.
+*/
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static int num_timers = 10000;
+static int max_interval = 50;
+static SDL_AtomicInt fired;
+
+static Uint32 SDLCALL IdleCallback(Uint32 interval, void *param)
+{
+    return interval;
+}
+
+static Uint32 SDLCALL FireCallback(Uint32 interval, void *param)
+{
+    SDL_AtomicIncRef(&fired);
+    return 0;
+}
+
+static void LogRate(const char *name, int count, Uint64 elapsed)
+{
+    SDL_Log("%-8s %8d timers in %8.3f ms, %12.0f per second\n", name, count,
+            (double)elapsed / SDL_NS_PER_MS,
+            (double)count / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND));
+}
+
+static int RunTest(SDL_TimerID *ids)
+{
+    Uint64 start, elapsed, timeout;
+    int i, canceled = 0;
+
+    /* Add timers far enough in the future that none of them fire */
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_timers; ++i) {
+        ids[i] = SDL_AddTimer(3600 * 1000 + SDLTest_RandomIntegerInRange(0, 1000), IdleCallback, NULL);
+        if (!ids[i]) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't add timer: %s\n", SDL_GetError());
+            return 1;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    LogRate("Add", num_timers, elapsed);
+
+    /* Cancel them in random order */
+    for (i = num_timers - 1; i > 0; --i) {
+        const int j = SDLTest_RandomIntegerInRange(0, i);
+        const SDL_TimerID id = ids[i];
+        ids[i] = ids[j];
+        ids[j] = id;
+    }
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_timers; ++i) {
+        if (SDL_RemoveTimer(ids[i])) {
+            ++canceled;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    LogRate("Cancel", num_timers, elapsed);
+    if (canceled != num_timers) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only canceled %d of %d timers\n", canceled, num_timers);
+        return 1;
+    }
+
+    /* Fire one shot timers spread over a short interval, and wait for all of them */
+    SDL_AtomicSet(&fired, 0);
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_timers; ++i) {
+        if (!SDL_AddTimer(SDLTest_RandomIntegerInRange(1, max_interval), FireCallback, NULL)) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't add timer: %s\n", SDL_GetError());
+            return 1;
+        }
+    }
+    timeout = SDL_GetTicksNS() + 10 * SDL_NS_PER_SECOND;
+    while (SDL_AtomicGet(&fired) < num_timers) {
+        if (SDL_GetTicksNS() > timeout) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Only %d of %d timers fired\n", SDL_AtomicGet(&fired), num_timers);
+            return 1;
+        }
+        SDL_Delay(1);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    LogRate("Fire", num_timers, elapsed);
+    SDL_Log("%-8s %8.3f ms after the last timer was due\n", "Late",
+            (double)elapsed / SDL_NS_PER_MS - max_interval);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_TimerID *ids;
+    Uint64 seed = 0;
+    int i, result;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Enable standard application logging */
+    SDL_LogSetPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_INFO);
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            int *value = NULL;
+
+            if (SDL_strcmp(argv[i], "--timers") == 0) {
+                value = &num_timers;
+            } else if (SDL_strcmp(argv[i], "--max-interval") == 0) {
+                value = &max_interval;
+            } else if (SDL_strcmp(argv[i], "--seed") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    seed = SDL_strtoull(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0') {
+                        consumed = 2;
+                    }
+                }
+            }
+            if (value && argv[i + 1]) {
+                char *endptr;
+                *value = SDL_strtol(argv[i + 1], &endptr, 0);
+                if (endptr != argv[i + 1] && *endptr == '\0' && *value > 0) {
+                    consumed = 2;
+                }
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = {
+                "[--timers N]",
+                "[--max-interval MS]",
+                "[--seed N]",
+                NULL,
+            };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    SDL_Log("Random seed: %" SDL_PRIu64 "\n", seed);
+    SDLTest_FuzzerInit(seed);
+
+    if (SDL_Init(SDL_INIT_TIMER) < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize SDL: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    ids = (SDL_TimerID *)SDL_malloc(num_timers * sizeof(*ids));
+    if (!ids) {
+        result = 1;
+    } else {
+        result = RunTest(ids);
+        SDL_free(ids);
+    }
+
+    SDLTest_CommonDestroyState(state);
+    SDL_Quit();
+    return result;
+}